@@ -0,0 +1,192 @@
+//
+// Filename:        "main.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This program runs the robot cell simulator headless
+//                  (no Qt, OpenGL, or wall-clock ticks) for a number of
+//                  ticks of a given formation, seed, and swarm size,
+//                  streaming the poses of the cells at each tick.
+//
+//                  usage: BatchRunner [option value]...
+//                      -cells      number of cells         (default 100)
+//                      -ticks      number of ticks         (default 1000)
+//                      -formation  formation index         (default 0)
+//                      -radius     formation radius        (default 0.15)
+//                      -heading    formation heading       (default 90)
+//                      -seed       random seed             (default 1)
+//                      -seedCell   ID of the seed cell     (default n / 2)
+//                      -threads    number of threads       (default 0: cores)
+//                      -layout     random or line          (default random)
+//                      -out        trajectory file         (default none)
+//                      -format     csv or bin              (default csv)
+//
+
+// preprocessor directives
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../ross/Environment.h"
+#include "../ross/Simulator.h"
+#include "../ross/TrajectoryWriter.h"
+using namespace std;
+
+// global variables expected from the host application
+int    gCameraScalePPM = 200;
+int   *gXPos           = NULL;
+int   *gYPos           = NULL;
+float *gHeading        = NULL;
+
+// global constants
+static const GLint   N_FORMATIONS         = 12;
+static const GLint   DEFAULT_BATCH_CELLS  = 100;
+static const GLint   DEFAULT_BATCH_TICKS  = 1000;
+static const GLfloat DEFAULT_BATCH_RADIUS = DEFAULT_ROBOT_RADIUS *
+                                            FACTOR_COLLISION_RADIUS;
+
+
+
+//
+// BatchEnvironment
+//
+// Describes an environment whose cells are laid out by the batch runner.
+//
+class BatchEnvironment: public Environment
+{
+
+    public:
+
+        //
+        // bool init(n, f, line)
+        // Last modified: 17Oct2026
+        //
+        // Attempts to add the parameterized number of cells (at random
+        // positions or in a line) and to send them the parameterized
+        // formation, returning true if successful, false otherwise.
+        //
+        // Returns:     true if successful, false otherwise
+        // Parameters:
+        //      n       in      the number of cells
+        //      f       in      the formation of the cells
+        //      line    in      true to lay the cells out in a line
+        //
+        bool init(const GLint n, const Formation &f, const bool line)
+        {
+            if (line) return initCells(n, f);
+            for (GLint i = 0; i < n; ++i) if (!addCell()) return false;
+            return initNbrs() &&
+                   sendMsg(f, f.getSeedID(), ID_OPERATOR, CHANGE_FORMATION);
+        }   // init(const GLint, const Formation &, const bool)
+};  // BatchEnvironment
+
+
+
+//
+// GLint main(argc, argv)
+// Last modified: 17Oct2026
+//
+// Parses the options, then steps the environment as fast as possible,
+// writing the poses of the cells after each tick.
+//
+// Returns:     0 if successful, 1 otherwise
+// Parameters:
+//      argc    in      an argument counter
+//      argv    in      the options (as name/value pairs)
+//
+int main(int argc, char **argv)
+{
+    GLint            nCells   = DEFAULT_BATCH_CELLS;
+    GLint            nTicks   = DEFAULT_BATCH_TICKS;
+    GLint            index    = 0;
+    GLfloat          radius   = DEFAULT_BATCH_RADIUS;
+    GLfloat          heading  = 90.0f;
+    GLint            seed     = 1;
+    GLint            seedCell = -1;
+    GLint            nThreads = 0;
+    bool             line     = false;
+    const char      *out      = NULL;
+    TrajectoryFormat format   = CSV_TRAJECTORY;
+
+    // parse the options
+    for (GLint i = 1; i < argc; i += 2)
+    {
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "missing value for %s\n", argv[i]);
+            return 1;
+        }
+        const char *name = argv[i], *value = argv[i + 1];
+        if      (!strcmp(name, "-cells"))     nCells   = atoi(value);
+        else if (!strcmp(name, "-ticks"))     nTicks   = atoi(value);
+        else if (!strcmp(name, "-formation")) index    = atoi(value);
+        else if (!strcmp(name, "-radius"))    radius   = (GLfloat)atof(value);
+        else if (!strcmp(name, "-heading"))   heading  = (GLfloat)atof(value);
+        else if (!strcmp(name, "-seed"))      seed     = atoi(value);
+        else if (!strcmp(name, "-seedCell"))  seedCell = atoi(value);
+        else if (!strcmp(name, "-threads"))   nThreads = atoi(value);
+        else if (!strcmp(name, "-layout"))    line     = !strcmp(value, "line");
+        else if (!strcmp(name, "-out"))       out      = value;
+        else if (!strcmp(name, "-format"))
+            format = strcmp(value, "bin") ? CSV_TRAJECTORY : BINARY_TRAJECTORY;
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", name);
+            return 1;
+        }
+    }
+    if (seedCell < 0) seedCell = nCells / 2;
+    if ((nCells <= 0) || (nTicks < 0) || (seedCell >= nCells) ||
+        (index  <  0) || (index >= N_FORMATIONS))
+    {
+        fprintf(stderr, "invalid options\n");
+        return 1;
+    }
+
+    // set up the environment and the trajectory file
+    TrajectoryWriter writer;
+    if ((out != NULL) && (!writer.open(out, format)))
+    {
+        fprintf(stderr, "could not open %s\n", out);
+        return 1;
+    }
+    srand(seed);
+    BatchEnvironment env;
+    env.setNThreads(nThreads);
+    if (!env.init(nCells,
+                  Formation(formations[index], radius, Vec2f(),
+                            seedCell,          0,      heading),
+                  line))
+    {
+        fprintf(stderr, "could not initialize %d cells\n", nCells);
+        return 1;
+    }
+
+    // step the environment as fast as possible
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (GLint tick = 0; tick < nTicks; ++tick)
+    {
+        if (!env.step())
+        {
+            fprintf(stderr, "could not step tick %d\n", tick);
+            return 1;
+        }
+        if ((writer.isOpen()) && (!writer.write(tick, env.getPoses())))
+        {
+            fprintf(stderr, "could not write tick %d\n", tick);
+            return 1;
+        }
+    }
+    if ((writer.isOpen()) && (!writer.close()))
+    {
+        fprintf(stderr, "could not close %s\n", out);
+        return 1;
+    }
+    GLdouble seconds = chrono::duration<GLdouble>(
+        chrono::steady_clock::now() - start).count();
+    fprintf(stderr, "%d cells, %d ticks in %.3f s (%.1f ticks/s)\n",
+            nCells, nTicks, seconds,
+            (seconds > 0.0) ? (GLdouble)nTicks / seconds : 0.0);
+    return 0;
+}   // main(int, char **)
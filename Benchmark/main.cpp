@@ -0,0 +1,780 @@
+//
+// Filename:        "main.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This program benchmarks the hot paths of the robot cell
+//                  simulator headless (formation relationships, neighborhood
+//                  queries and sorts, list indexing, a single cell step, and
+//                  full environment steps at several swarm sizes), the
+//                  camera colour conversions (per frame, for each
+//                  instruction set, each checked against the scalar kernel
+//                  first), and the vision path on simulated and replayed
+//                  frames (each checked to find every rover), reporting
+//                  ns/op, allocations/op, and ops/s (ticks/s for environment
+//                  steps) as CSV, and optionally comparing against a stored
+//                  baseline of a previous run.
+//
+//                  usage: Benchmark [option value]...
+//                      -out        results file            (default stdout)
+//                      -baseline   baseline results file   (default none)
+//                      -tolerance  allowed slowdown        (default 0.10)
+//                      -filter     benchmark name filter   (default none)
+//                      -minTime    seconds per benchmark   (default 0.2)
+//                      -threads    number of threads       (default 0: cores)
+//
+
+// preprocessor directives
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+#include "../ross/Environment.h"
+#include "../ross/LinkedList.h"
+#include "../ross/Simulator.h"
+#include "../portVideoQt/ColourConverter.h"
+#include "../portVideoQt/RoverLocator.h"
+#include "../portVideoQt/fileCamera.h"
+#include "../portVideoQt/simCamera.h"
+using namespace std;
+
+// global variables expected from the host application
+int    gCameraScalePPM = 200;
+int   *gXPos           = NULL;
+int   *gYPos           = NULL;
+float *gHeading        = NULL;
+
+// global constants
+static const GLint    N_FORMATIONS          = 12;
+static const char    *FORMATION_NAMES[]     = {"line",        "x",
+                                               "absX",        "negHalfX",
+                                               "negAbsHalfX", "negAbsX",
+                                               "parabola",    "cubic",
+                                               "condSqrt",    "sine",
+                                               "xRoot3",      "negXRoot3"};
+static const GLint    N_BENCH_CENTERS       = 1024; // defeats the memo
+static const GLint    N_BENCH_NBRS          = 8;
+static const GLint    N_BENCH_ITEMS         = 1024;
+static const GLint    N_BENCH_CELL_ENV      = 64;
+static const GLint    N_BENCH_WARMUP_TICKS  = 10;
+static const GLint    ENV_SIZES[]           = {4, 64, 1000, 10000};
+static const GLint    N_ENV_SIZES           = 4;
+static const GLint    FRAME_WIDTH           = 640;
+static const GLint    FRAME_HEIGHT          = 480;
+static const GLint    N_BENCH_ROVERS        = 8;    // fit the frame in
+static const GLfloat  ROVER_BENCH_RADIUS    = 0.25f; // line formation
+static const GLint    N_REPLAY_FRAMES       = 8;
+static const char    *REPLAY_FILE           = "benchReplay_640x480.raw";
+static const GLdouble DEFAULT_MIN_TIME      = 0.2;
+static const GLdouble DEFAULT_TOLERANCE     = 0.10;
+static const GLfloat  DEFAULT_BENCH_RADIUS  = DEFAULT_ROBOT_RADIUS *
+                                              FACTOR_COLLISION_RADIUS;
+
+// global variables
+static atomic<long long> gNAllocs(0);       // number of heap allocations
+static GLdouble          gMinTime = DEFAULT_MIN_TIME;
+static const char       *gFilter  = NULL;
+static FILE             *gOut     = stdout;
+static GLint             gNThreads = 0;
+static map<string, GLdouble> gBaseline;     // baseline ns/op by name
+static GLdouble          gTolerance = DEFAULT_TOLERANCE;
+static GLint             gNRegressions = 0;
+static GLint             gNMismatches  = 0;     // kernels unlike scalar
+static GLint             gNMissed      = 0;     // frames missing rovers
+static volatile GLfloat  gSink    = 0.0f;   // keeps results observable
+
+
+
+// <allocation counting operators>
+
+void* operator new(size_t size)
+{
+    ++gNAllocs;
+    void *p = malloc((size > 0) ? size : 1);
+    if (p == NULL) throw bad_alloc();
+    return p;
+}   // new(size_t)
+
+void* operator new[](size_t size)
+{
+    ++gNAllocs;
+    void *p = malloc((size > 0) ? size : 1);
+    if (p == NULL) throw bad_alloc();
+    return p;
+}   // new[](size_t)
+
+void operator delete(void *p) throw()
+{
+    free(p);
+}   // delete(void *)
+
+void operator delete[](void *p) throw()
+{
+    free(p);
+}   // delete[](void *)
+
+void operator delete(void *p, size_t) throw()
+{
+    free(p);
+}   // delete(void *, size_t)
+
+void operator delete[](void *p, size_t) throw()
+{
+    free(p);
+}   // delete[](void *, size_t)
+
+
+
+//
+// BenchEnvironment
+//
+// Describes an environment whose cells are laid out in a line
+// for benchmarking, exposing the step of a single cell.
+//
+class BenchEnvironment: public Environment
+{
+
+    public:
+
+        //
+        // bool init(n, f)
+        // Last modified: 17Oct2026
+        //
+        // Attempts to lay the parameterized number of cells out in a line
+        // and to send them the parameterized formation,
+        // returning true if successful, false otherwise
+        // (any earlier environment must already be destroyed).
+        //
+        // Returns:     true if successful, false otherwise
+        // Parameters:
+        //      n       in      the number of cells
+        //      f       in      the formation of the cells
+        //
+        bool init(const GLint n, const Formation &f)
+        {
+            Robot::resetIDs();
+            return initCells(n, f);
+        }   // init(const GLint, const Formation &)
+
+
+
+        //
+        // bool initRovers(n, f)
+        // Last modified: 17Oct2026
+        //
+        // Attempts to place the parameterized number of cells on a grid
+        // (in camera pixels, far enough apart for their markers not to
+        // mix) and to send them the parameterized formation, as
+        // initRobots does, returning true if successful, false otherwise
+        // (any earlier environment must already be destroyed).
+        //
+        // Returns:     true if successful, false otherwise
+        // Parameters:
+        //      n       in      the number of cells
+        //      f       in      the formation of the cells
+        //
+        bool initRovers(const GLint n, const Formation &f)
+        {
+            Robot::resetIDs();
+            for (GLint i = 0; i < n; ++i)
+                if (!addCell(80 + (i % 8) * 72, 120 + (i / 8) * 120, 90.0f))
+                    return false;
+            return initNbrs() &&
+                   sendMsg(f, f.getSeedID(), ID_OPERATOR, CHANGE_FORMATION);
+        }   // initRovers(const GLint, const Formation &)
+
+
+
+        //
+        // void computeCell(pos)
+        // Last modified: 17Oct2026
+        //
+        // Steps only the cell at the parameterized position.
+        //
+        // Returns:     <none>
+        // Parameters:
+        //      pos     in      the position of the cell
+        //
+        void computeCell(const GLint pos)
+        {
+            cells[pos]->compute();
+        }   // computeCell(const GLint)
+};  // BenchEnvironment
+
+
+
+//
+// void report(name, nOps, seconds, nAllocs)
+// Last modified: 17Oct2026
+//
+// Writes the results of a benchmark as a CSV row, then compares
+// its ns/op against the baseline (if any), counting regressions.
+//
+// Returns:     <none>
+// Parameters:
+//      name        in      the name of the benchmark
+//      nOps        in      the number of operations timed
+//      seconds     in      the time taken by the operations
+//      nAllocs     in      the heap allocations made by the operations
+//
+void report(const string    &name,
+            const long long  nOps,
+            const GLdouble   seconds,
+            const long long  nAllocs)
+{
+    GLdouble nsPerOp     = 1.0e9 * seconds / (GLdouble)nOps;
+    GLdouble allocsPerOp = (GLdouble)nAllocs / (GLdouble)nOps;
+    GLdouble opsPerSec   = (seconds > 0.0) ? (GLdouble)nOps / seconds : 0.0;
+    fprintf(gOut, "%s,%lld,%.2f,%.3f,%.1f\n",
+            name.c_str(), nOps, nsPerOp, allocsPerOp, opsPerSec);
+    fflush(gOut);
+
+    map<string, GLdouble>::const_iterator base = gBaseline.find(name);
+    if ((base == gBaseline.end()) || (base->second <= 0.0)) return;
+    GLdouble change = nsPerOp / base->second - 1.0;
+    bool     regressed = change > gTolerance;
+    if (regressed) ++gNRegressions;
+    fprintf(stderr, "%-40s %10.2f ns/op (baseline %10.2f, %+6.1f%%)%s\n",
+            name.c_str(), nsPerOp, base->second, 100.0 * change,
+            regressed ? "  REGRESSION" : "");
+}   // report(const string &, const long long, const GLdouble, ...)
+
+
+
+//
+// void runBenchmark(name, op)
+// Last modified: 17Oct2026
+//
+// Runs the parameterized operation in batches of doubling size until
+// a batch takes at least the minimum time, then reports that batch.
+//
+// Returns:     <none>
+// Parameters:
+//      name    in      the name of the benchmark
+//      op      in      the operation (called with the index of the op)
+//
+void runBenchmark(const string &name, const function<void(GLint)> &op)
+{
+    if ((gFilter != NULL) && (name.find(gFilter) == string::npos)) return;
+    for (long long nOps = 1; ; nOps *= 2)
+    {
+        long long nAllocs = gNAllocs.load();
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (long long i = 0; i < nOps; ++i) op((GLint)(i & 0x7fffffff));
+        GLdouble seconds = chrono::duration<GLdouble>(
+            chrono::steady_clock::now() - start).count();
+        nAllocs = gNAllocs.load() - nAllocs;
+        if ((seconds >= gMinTime) || (nOps >= (1LL << 40)))
+        {
+            report(name, nOps, seconds, nAllocs);
+            return;
+        }
+    }
+}   // runBenchmark(const string &, const function<void(GLint)> &)
+
+
+
+//
+// bool loadBaseline(filename)
+// Last modified: 17Oct2026
+//
+// Loads the ns/op of each benchmark from the parameterized
+// results file, returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      filename    in      the name of the baseline results file
+//
+bool loadBaseline(const char *filename)
+{
+    FILE *file = fopen(filename, "r");
+    if (file == NULL) return false;
+    char      name[256];
+    long long nOps    = 0;
+    double    nsPerOp = 0.0;
+    char      line[512];
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        char *comma = strchr(line, ',');
+        if ((comma == NULL) || (comma - line >= (int)sizeof(name))) continue;
+        memcpy(name, line, comma - line);
+        name[comma - line] = '\0';
+        if (sscanf(comma + 1, "%lld,%lf", &nOps, &nsPerOp) == 2)
+            gBaseline[name] = nsPerOp;
+    }
+    fclose(file);
+    return true;
+}   // loadBaseline(const char *)
+
+
+
+//
+// void benchFormations()
+// Last modified: 17Oct2026
+//
+// Benchmarks the relationship of each formation function
+// for centers spread along the function.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void benchFormations()
+{
+    for (GLint i = 0; i < N_FORMATIONS; ++i)
+    {
+        Function  fn = formations[i];
+        Formation f(fn, DEFAULT_BENCH_RADIUS);
+        vector<Vec2f> centers(N_BENCH_CENTERS);
+        for (GLint j = 0; j < N_BENCH_CENTERS; ++j)
+        {
+            GLfloat x  = DEFAULT_BENCH_RADIUS *
+                         ((GLfloat)j - (GLfloat)N_BENCH_CENTERS / 2.0f) /
+                         16.0f;
+            centers[j] = Vec2f(x, fn(x));
+        }
+        runBenchmark(string("formation.getRelationship.") + FORMATION_NAMES[i],
+                     [&](const GLint k)
+        {
+            gSink = gSink + f.getRelationship(fn, DEFAULT_BENCH_RADIUS,
+                                              centers[k % N_BENCH_CENTERS],
+                                              90.0f).x;
+        });
+    }
+}   // benchFormations()
+
+
+
+//
+// void benchNeighborhood()
+// Last modified: 17Oct2026
+//
+// Benchmarks the minimum gradient query and the sorts
+// of a neighborhood of neighbors with random gradients.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void benchNeighborhood()
+{
+    Neighborhood nh;
+    srand(1);
+    for (GLint i = 0; i < N_BENCH_NBRS; ++i)
+        nh.addNbr(i, State(Formation(), Vec2f(frand(-1.0f, 1.0f),
+                                              frand(-1.0f, 1.0f))),
+                  Vec2f(frand(-1.0f, 1.0f), frand(-1.0f, 1.0f)),
+                  Vec2f(frand(-1.0f, 1.0f), frand(-1.0f, 1.0f)));
+
+    runBenchmark("neighborhood.nbrWithMinGradient", [&](const GLint)
+    {
+        gSink = gSink + (GLfloat)nh.nbrWithMinGradient()->ID;
+    });
+
+    // each sort starts from the unsorted neighborhood
+    Neighborhood copy;
+    runBenchmark("neighborhood.sortByGradient", [&](const GLint)
+    {
+        copy = nh;
+        copy.sortByGradient();
+    });
+    runBenchmark("neighborhood.sortByDistance", [&](const GLint)
+    {
+        copy = nh;
+        copy.sortByDistance();
+    });
+    runBenchmark("neighborhood.sortByAngle", [&](const GLint)
+    {
+        copy = nh;
+        copy.sortByAngle();
+    });
+    runBenchmark("neighborhood.copy", [&](const GLint)
+    {
+        copy = nh;
+    });
+}   // benchNeighborhood()
+
+
+
+//
+// void benchLists()
+// Last modified: 17Oct2026
+//
+// Benchmarks the random access of the linked and array lists.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void benchLists()
+{
+    LinkedList<GLint> linked;
+    ArrayList<GLint>  array;
+    for (GLint i = 0; i < N_BENCH_ITEMS; ++i)
+    {
+        linked.insertTail(i);
+        array.insertTail(i);
+    }
+
+    // strides through the items so that no two accesses are adjacent
+    runBenchmark("linkedList.operator[]", [&](const GLint k)
+    {
+        GLint pos = (k % N_BENCH_ITEMS) * 97 % N_BENCH_ITEMS;
+        gSink = gSink + (GLfloat)linked[pos];
+    });
+    runBenchmark("arrayList.operator[]", [&](const GLint k)
+    {
+        GLint pos = (k % N_BENCH_ITEMS) * 97 % N_BENCH_ITEMS;
+        gSink = gSink + (GLfloat)array[pos];
+    });
+}   // benchLists()
+
+
+
+//
+// void benchCell()
+// Last modified: 17Oct2026
+//
+// Benchmarks the step of a single cell in the middle of
+// a line of cells, forwarding its messages periodically.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void benchCell()
+{
+    BenchEnvironment env;
+    env.setNThreads(1);
+    if (!env.init(N_BENCH_CELL_ENV,
+                  Formation(formations[0], DEFAULT_BENCH_RADIUS, Vec2f(),
+                            N_BENCH_CELL_ENV / 2, 0, 90.0f)))
+    {
+        fprintf(stderr, "could not initialize %d cells\n", N_BENCH_CELL_ENV);
+        return;
+    }
+    for (GLint i = 0; i < N_BENCH_WARMUP_TICKS; ++i) env.step();
+
+    runBenchmark("cell.step", [&](const GLint k)
+    {
+        env.computeCell(N_BENCH_CELL_ENV / 2);
+        if ((k & 7) == 7) env.forwardPackets();
+    });
+}   // benchCell()
+
+
+
+//
+// void benchEnvironment()
+// Last modified: 17Oct2026
+//
+// Benchmarks full environment steps (ticks) for several swarm sizes.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void benchEnvironment()
+{
+    for (GLint i = 0; i < N_ENV_SIZES; ++i)
+    {
+        char name[64];
+        sprintf(name, "environment.step.%d", ENV_SIZES[i]);
+        if ((gFilter != NULL) && (!strstr(name, gFilter))) continue;
+
+        BenchEnvironment env;
+        env.setNThreads(gNThreads);
+        if (!env.init(ENV_SIZES[i],
+                      Formation(formations[0], DEFAULT_BENCH_RADIUS, Vec2f(),
+                                ENV_SIZES[i] / 2, 0, 90.0f)))
+        {
+            fprintf(stderr, "could not initialize %d cells\n", ENV_SIZES[i]);
+            continue;
+        }
+        for (GLint j = 0; j < N_BENCH_WARMUP_TICKS; ++j) env.step();
+        runBenchmark(name, [&](const GLint)
+        {
+            env.step();
+        });
+    }
+}   // benchEnvironment()
+
+
+
+//
+// void benchColourConversion()
+// Last modified: 17Oct2026
+//
+// Benchmarks the conversion of a random camera frame between each pair
+// of pixel formats with each supported instruction set, first checking
+// (both upright and flipped) that the output matches the scalar kernel.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void benchColourConversion()
+{
+    typedef ColourConverter CC;
+    vector<unsigned char> src(CC::frameSize(CC::BGR24, FRAME_WIDTH,
+                                            FRAME_HEIGHT));
+    srand(1);
+    for (size_t i = 0; i < src.size(); ++i) src[i] = (unsigned char)rand();
+
+    for (GLint s = 0; s < CC::FORMAT_COUNT; ++s)
+        for (GLint d = 0; d < CC::FORMAT_COUNT; ++d)
+        {
+            CC::Format sf = (CC::Format)s, df = (CC::Format)d;
+            if ((sf == df) || (!CC::canConvert(sf, df))) continue;
+            GLint size = CC::frameSize(df, FRAME_WIDTH, FRAME_HEIGHT);
+            vector<unsigned char> ref(size), dest(size);
+            for (GLint isa = 0; isa <= CC::supportedIsa(); ++isa)
+            {
+                string name = string("colour.") + CC::formatName(sf) + "." +
+                              CC::formatName(df) + "." +
+                              CC::isaName((CC::Isa)isa);
+                if ((gFilter != NULL) && (name.find(gFilter) == string::npos))
+                    continue;
+                for (GLint flip = 0; flip < 2; ++flip)
+                {
+                    CC::convert(&src[0], sf, &ref[0], df, FRAME_WIDTH,
+                                FRAME_HEIGHT, flip != 0, CC::ISA_SCALAR);
+                    CC::convert(&src[0], sf, &dest[0], df, FRAME_WIDTH,
+                                FRAME_HEIGHT, flip != 0, (CC::Isa)isa);
+                    if (dest != ref)
+                    {
+                        fprintf(stderr, "%s%s does not match scalar\n",
+                                name.c_str(), flip ? " (flipped)" : "");
+                        ++gNMismatches;
+                    }
+                }
+                runBenchmark(name, [&](const GLint)
+                {
+                    CC::convert(&src[0], sf, &dest[0], df, FRAME_WIDTH,
+                                FRAME_HEIGHT, false, (CC::Isa)isa);
+                });
+            }
+        }
+}   // benchColourConversion()
+
+
+
+//
+// bool checkRovers(name, frame, n)
+// Last modified: 17Oct2026
+//
+// Checks that the parameterized pose frame holds every rover,
+// counting (and reporting) it as missed otherwise.
+//
+// Returns:     true if every rover was found, false otherwise
+// Parameters:
+//      name    in      the name of the benchmark
+//      frame   in      the poses found in a frame (if any)
+//      n       in      the number of rovers in the frame
+//
+bool checkRovers(const string &name, const PoseFrame *frame, const GLint n)
+{
+    if ((frame != NULL) && (frame->n == n)) return true;
+    fprintf(stderr, "%s found %d of %d rovers\n", name.c_str(),
+            (frame == NULL) ? 0 : frame->n, n);
+    ++gNMissed;
+    return false;
+}   // checkRovers(const string &, const PoseFrame *, const GLint)
+
+
+
+//
+// void benchVision()
+// Last modified: 17Oct2026
+//
+// Benchmarks the vision path headless: rendering the rovers of an
+// environment with the simulated camera, locating them in a frame (by
+// a full scan and by tracking), the whole capture, locate, and step
+// loop with the camera poses fed back into the environment, and the
+// replay of a recording of simulated frames (each checked to find
+// every rover).
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void benchVision()
+{
+    BenchEnvironment env;
+    env.setNThreads(1);
+    if (!env.initRovers(N_BENCH_ROVERS,
+                        Formation(formations[0], ROVER_BENCH_RADIUS,
+                                  Vec2f(), 0, 0, 90.0f)))
+    {
+        fprintf(stderr, "could not initialize %d rovers\n", N_BENCH_ROVERS);
+        return;
+    }
+    for (GLint i = 0; i < N_BENCH_WARMUP_TICKS; ++i) env.step();
+    const GLint frameSize = FRAME_WIDTH * FRAME_HEIGHT * 3;
+    vector<unsigned char> frame(frameSize), dest(frameSize);
+    simCamera camera(&env, 0);
+    camera.initCamera(FRAME_WIDTH, FRAME_HEIGHT, true);
+    camera.startCamera();
+    camera.getFrame(&frame[0]);
+
+    PoseFeed     poseFeed, motionFeed;
+    RoverLocator locator(&poseFeed);
+    locator.setMotionFeed(&motionFeed);
+    locator.setFlag(RoverLocator::MARK_ROVERS, false);
+    locator.init(FRAME_WIDTH, FRAME_HEIGHT, 3, 3);
+
+    runBenchmark("vision.simCamera.frame", [&](const GLint)
+    {
+        camera.getFrame(&frame[0]);
+    });
+
+    locator.setFlag(RoverLocator::TRACK_ROVERS, false);
+    locator.process(&frame[0], &dest[0]);
+    checkRovers("vision.locate.full", poseFeed.read(), N_BENCH_ROVERS);
+    runBenchmark("vision.locate.full", [&](const GLint)
+    {
+        locator.process(&frame[0], &dest[0]);
+    });
+    locator.setFlag(RoverLocator::TRACK_ROVERS, true);
+    locator.process(&frame[0], &dest[0]);
+    locator.process(&frame[0], &dest[0]);
+    checkRovers("vision.locate.tracked", poseFeed.read(), N_BENCH_ROVERS);
+    runBenchmark("vision.locate.tracked", [&](const GLint)
+    {
+        locator.process(&frame[0], &dest[0]);
+    });
+
+    // the camera sees the rovers where the last step left them
+    char name[64];
+    sprintf(name, "vision.loop.%d", N_BENCH_ROVERS);
+    env.setPoseFeed(&poseFeed);
+    env.setMotionFeed(&motionFeed);
+    PoseEstimate seen[MAX_POSE_ESTIMATES];
+    GLint        nShort = 0;
+    runBenchmark(name, [&](const GLint)
+    {
+        camera.getFrame(&frame[0]);
+        locator.process(&frame[0], &dest[0]);
+        if (locator.getLastPoses(seen, MAX_POSE_ESTIMATES) != N_BENCH_ROVERS)
+            ++nShort;
+        env.step();
+    });
+    if (nShort > 0)
+    {
+        fprintf(stderr, "%s missed rovers in %d frame(s)\n", name, nShort);
+        ++gNMissed;
+    }
+    env.setPoseFeed(NULL);
+    env.setMotionFeed(NULL);
+
+    // a recording of the same rovers, played back as fast as it goes
+    FILE *file = fopen(REPLAY_FILE, "wb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "could not write %s\n", REPLAY_FILE);
+        return;
+    }
+    for (GLint i = 0; i < N_REPLAY_FRAMES; ++i)
+    {
+        camera.getFrame(&frame[0]);
+        fwrite(&frame[0], 1, frameSize, file);
+    }
+    fclose(file);
+    fileCamera replay(REPLAY_FILE, 0);
+    if (replay.findCamera() &&
+        replay.initCamera(FRAME_WIDTH, FRAME_HEIGHT, true) &&
+        replay.startCamera())
+    {
+        replay.getFrame(&frame[0]);
+        locator.setFlag(RoverLocator::TRACK_ROVERS, false);
+        locator.process(&frame[0], &dest[0]);
+        checkRovers("vision.replay.frame", poseFeed.read(), N_BENCH_ROVERS);
+        locator.setFlag(RoverLocator::TRACK_ROVERS, true);
+        runBenchmark("vision.replay.frame", [&](const GLint)
+        {
+            replay.getFrame(&frame[0]);
+        });
+        replay.closeCamera();
+    }
+    else fprintf(stderr, "could not replay %s\n", REPLAY_FILE);
+    remove(REPLAY_FILE);
+}   // benchVision()
+
+
+
+//
+// GLint main(argc, argv)
+// Last modified: 17Oct2026
+//
+// Parses the options, runs each benchmark, and fails if any colour
+// conversion kernel does not match the scalar one or (given a baseline)
+// if any benchmark is slower than the baseline by more than the tolerance.
+//
+// Returns:     0 if successful, 1 otherwise
+// Parameters:
+//      argc    in      an argument counter
+//      argv    in      the options (as name/value pairs)
+//
+int main(int argc, char **argv)
+{
+    const char *out      = NULL;
+    const char *baseline = NULL;
+
+    // parse the options
+    for (GLint i = 1; i + 1 < argc; i += 2)
+    {
+        const char *name = argv[i], *value = argv[i + 1];
+        if      (!strcmp(name, "-out"))       out        = value;
+        else if (!strcmp(name, "-baseline"))  baseline   = value;
+        else if (!strcmp(name, "-tolerance")) gTolerance = atof(value);
+        else if (!strcmp(name, "-filter"))    gFilter    = value;
+        else if (!strcmp(name, "-minTime"))   gMinTime   = atof(value);
+        else if (!strcmp(name, "-threads"))   gNThreads  = atoi(value);
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", name);
+            return 1;
+        }
+    }
+    if ((baseline != NULL) && (!loadBaseline(baseline)))
+    {
+        fprintf(stderr, "could not read %s\n", baseline);
+        return 1;
+    }
+    if ((out != NULL) && ((gOut = fopen(out, "w")) == NULL))
+    {
+        fprintf(stderr, "could not open %s\n", out);
+        return 1;
+    }
+
+    fprintf(gOut, "name,iterations,ns_per_op,allocs_per_op,ops_per_sec\n");
+    benchFormations();
+    benchNeighborhood();
+    benchLists();
+    benchCell();
+    benchEnvironment();
+    benchColourConversion();
+    benchVision();
+    if (gOut != stdout) fclose(gOut);
+
+    if (gNMismatches > 0)
+    {
+        fprintf(stderr, "%d colour conversion(s) do not match scalar\n",
+                gNMismatches);
+        return 1;
+    }
+
+    if (gNMissed > 0)
+    {
+        fprintf(stderr, "%d frame(s) did not show every rover\n", gNMissed);
+        return 1;
+    }
+
+    if (gNRegressions > 0)
+    {
+        fprintf(stderr, "%d benchmark(s) regressed by more than %.0f%%\n",
+                gNRegressions, 100.0 * gTolerance);
+        return 1;
+    }
+    return 0;
+}   // main(int, char **)
@@ -10,7 +10,9 @@ int gCameraScalePPM;
 CameraWidget::CameraWidget(QWidget *parent)
    : QWidget(parent)
 {
-   image = 0;
+   imageWidth  = 0;
+   imageHeight = 0;
+   imageBytes  = 0;
    //gCameraScalePPM = (int)((float)(CAMERA_DISTANCE_MM * CAMERA_SCALE_PPM_DIST) / 1000.0);
    gCameraScalePPM = 200;
 }
@@ -20,23 +22,40 @@ CameraWidget::~CameraWidget()
 
 }
 
-void CameraWidget::updateImage(QImage* img)
+// called from the capture thread; the frame is kept (not copied)
+// until the next one arrives
+void CameraWidget::updateImage(const FrameHandle& frame, int width, int height, int bytes)
 {
-   if(img)
+   if(!frame.isNull())
    {
-      image = img;
-      update();
+      frameMutex.lock();
+      image       = frame;
+      imageWidth  = width;
+      imageHeight = height;
+      imageBytes  = bytes;
+      frameMutex.unlock();
+      QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
    }
 }
 
+void CameraWidget::clearImage()
+{
+   frameMutex.lock();
+   image.release();
+   frameMutex.unlock();
+}
+
 void CameraWidget::paintEvent(QPaintEvent* e)
 {
-   if(image)
+   QMutexLocker locker(&frameMutex);
+   if(!image.isNull())
    {
-      resize(image->size());
+      // wraps the pooled buffer as is; it is already RGB and upright
+      QImage frame(image.data(), imageWidth, imageHeight, imageWidth * imageBytes,
+                   imageBytes == 3 ? QImage::Format_RGB888 : QImage::Format_Grayscale8);
+      resize(frame.size());
       QPainter painter(this);
-      painter.drawImage(0, 0, image->rgbSwapped().mirrored());
+      painter.drawImage(0, 0, frame);
       painter.end();
    }
-}
-
+}
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include <QtWidgets/QWidget>
 #include <QtGui/QImage>
 #include <QtGui/QPaintEvent>
+#include <QtCore/QMutex>
+
+#include "../portVideoQt/FramePool.h"
 
 class CameraWidget : public QWidget
 {
@@ -13,13 +16,19 @@ public:
     CameraWidget(QWidget *parent);
     ~CameraWidget();
 
-    void updateImage(QImage* img);
+    void updateImage(const FrameHandle& frame, int width, int height, int bytes);
+    void clearImage();
 
 protected:
    void paintEvent(QPaintEvent* e);
 
 private:
-   QImage* image;
+   // the frame being shown (RGB or grey, top-down), borrowed from the pool
+   QMutex      frameMutex;
+   FrameHandle image;
+   int         imageWidth;
+   int         imageHeight;
+   int         imageBytes;
 };
 
 #endif // CAMERAWIDGET_H
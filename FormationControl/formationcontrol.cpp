@@ -1,9 +1,11 @@
 #include "formationcontrol.h"
 #include "../portVideoQt/portVideoQt.h"
 #include "../portVideoQt/FrameInverter.h"
+#include "../portVideoQt/RoverLocator.h"
 #include "newterminaldialog.h"
 #include "openportsdialog.h"
-#include "../ross/simulator.h"
+#include "../ross/Simulator.h"
+#include "helpers.h"
 #include <QtCore/QMutex>
 #include <QtCore/QTimer>
 
@@ -22,11 +24,61 @@ FormationControl::FormationControl(QWidget *parent, Qt::WindowFlags flags)
    ui.setupUi(this);
    gGo = false;
    engine = new portVideoQt("Formation Control Demo",true,true, ui.cameraWidget);
+   poseFeed = new PoseFeed();
+   motionFeed = new PoseFeed();
+   locator = new RoverLocator(poseFeed);
+   // track each rover within its marker spacing plus a tick at full speed
+   locator->setMotionFeed(motionFeed);
+   locator->setTrackRadius(LOCATOR_MARKER_SPACING + LOCATOR_SPACING_TOLERANCE +
+                           (int)(gCameraScalePPM * MAX_ROBOT_SPEED_MPS * STI_SEC));
    inverter = new FrameInverter();
    
+   // the locator sees the camera colours, the simulation its poses
+   engine->addFrameProcessor(locator);
    engine->addFrameProcessor(inverter);
+   env.setPoseFeed(poseFeed);
+   env.setMotionFeed(motionFeed);
    engine->start();
 
+   // the rovers are driven through the terminals, one write per port per tick,
+   // and the health of each link is measured (timing the acks of every cell)
+   commandSink = new TerminalSink(this);
+   metrics = new LinkMetrics(DEFAULT_METRIC_LINKS, N_CELLS);
+   scheduler = new CommandScheduler(commandSink);
+   scheduler->setMetrics(metrics);
+   const char* routes = getenv("ROVER_ROUTES");
+   if(routes && !scheduler->getRoutingTable().load(routes))
+      QMessageBox::critical(0, qApp->tr("Critical"),
+         QString(routes) + qApp->tr(" not loaded"), QMessageBox::Ok);
+   scheduler->start();
+   env.setCommandScheduler(scheduler);
+
+   // and report their wheels back through them; the rovers only report
+   // when polled, so their odometry moves the robots only if ROVER_POLL
+   // gives the ticks between polls (the acknowledgements are kept either way)
+   odometryFeed = new OdometryFeed();
+   odometryFeed->setRoutingTable(&scheduler->getRoutingTable());
+   odometryFeed->setMetrics(metrics);
+   const char* poll = getenv("ROVER_POLL");
+   if(poll && atoi(poll) > 0)
+   {
+      scheduler->setPollInterval(atoi(poll));
+      env.setOdometryFeed(odometryFeed);
+   }
+
+   // dumping it every second if asked to
+   metricsFile = NULL;
+   const char* metricsName = getenv("ROVER_METRICS");
+   if(metricsName && !(metricsFile = fopen(metricsName, "w")))
+      QMessageBox::critical(0, qApp->tr("Critical"),
+         QString(metricsName) + qApp->tr(" not opened"), QMessageBox::Ok);
+   if(metricsFile)
+   {
+      QTimer* metricsTimer = new QTimer(this);
+      connect(metricsTimer, SIGNAL(timeout()), this, SLOT(dumpMetrics()));
+      metricsTimer->start(METRICS_INTERVAL_MS);
+   }
+
    QSize cameraSize = engine->getSize();
    ui.lstFormations->setSelectionMode(QAbstractItemView::SingleSelection);
    ui.lstFormations->setCurrentRow(0);
@@ -40,7 +92,7 @@ void FormationControl::on_btnGo_clicked()
 {
 	if (env.areRobotsReady()) {
 		Function f = formations[ui.lstFormations->currentRow()];
-		env.initRobots(Formation(f, 0.09, Vector(), 0, 0, 0));
+		env.initRobots(Formation(f, 0.09, Vec2f(), 0, 0, 0));
 		changeFormation(ui.lstFormations->currentRow());
 		//gGo = true;
 		QTimer::singleShot(1000, this, SLOT(go()));
@@ -56,6 +108,7 @@ void FormationControl::on_btnGo_clicked()
 void FormationControl::on_btnApplyFormation_clicked()
 {
 	if (env.areRobotsReady()) {
+		lock_guard<mutex> lock(simLoop.getEnvMutex());
 		changeFormation(ui.lstFormations->currentRow());
 	} else {
 		QMessageBox msgbox;
@@ -75,21 +128,25 @@ void FormationControl::go()
 
 void FormationControl::on_btnFindRobots_clicked()
 {
-	gXPos = new int[N_CELLS];
-	gYPos = new int[N_CELLS];
-	gHeading = new float[N_CELLS];
-	gXPos[0] = 100;
-	gYPos[0] = 100;
-	gHeading[0] = 90;
-	gXPos[1] = 130;
-	gYPos[1] = 130;
-	gHeading[1] = 90;
-	gXPos[2] = 160;
-	gYPos[2] = 160;
-	gHeading[2] = 90;
-	gXPos[3] = 190;
-	gYPos[3] = 190;
-	gHeading[3] = 90;
+	if (!gXPos) gXPos = new int[N_CELLS];
+	if (!gYPos) gYPos = new int[N_CELLS];
+	if (!gHeading) gHeading = new float[N_CELLS];
+
+	// start from the rovers the camera sees, making up dummy
+	// entries along the diagonal for any it does not
+	PoseEstimate seen[MAX_POSE_ESTIMATES];
+	int nSeen = locator->getLastPoses(seen, N_CELLS);
+	for (int i = 0; i < N_CELLS; ++i) {
+		if (i < nSeen) {
+			gXPos[i] = (int)seen[i].x;
+			gYPos[i] = (int)seen[i].y;
+			gHeading[i] = seen[i].heading;
+		} else {
+			gXPos[i] = 100 + 30*i;
+			gYPos[i] = 100 + 30*i;
+			gHeading[i] = 90;
+		}
+	}
 }
 
 void FormationControl::actionNewTerminalTriggered()
@@ -99,6 +156,10 @@ void FormationControl::actionNewTerminalTriggered()
       Terminal terminal = newTerminalDialog.getTerminal();
       if(openTerminal(&terminal))
       {
+         lock_guard<mutex> lock(scheduler->getSendMutex());
+         TelemetryParser* parser = new TelemetryParser(terminalList.size(), odometryFeed);
+         parser->setMetrics(metrics);
+         parsers.insert(terminal.pSerPort, parser);
          terminalList.push_back(terminal);
          //showTerminalWindow(terminalList.last());
       }
@@ -125,7 +186,11 @@ int FormationControl::openTerminal(Terminal* terminal)
 	int isOpen = 0;
     if(terminal->type == TERMINAL_COM)
     {
+#ifdef _TTY_POSIX_
+        QString terminalString("/dev/ttyUSB");
+#else
         QString terminalString("COM");
+#endif
         QString device = terminalString + QString::number(terminal->port);
         terminal->pSerPort = new QextSerialPort(device.toLocal8Bit().data(),
                                                 terminal->portSettings,
@@ -152,23 +217,56 @@ int FormationControl::openTerminal(Terminal* terminal)
 
 void FormationControl::removeTerminal(int index)
 {
+	lock_guard<mutex> lock(scheduler->getSendMutex());
+	delete parsers.take(terminalList.at(index).pSerPort);
 	terminalList.at(index).pSerPort->close();
 	terminalList.removeAt(index);
+
+	// the terminals after it have moved up a port
+	for(int i=index; i<terminalList.size(); ++i)
+	{
+		TelemetryParser* parser = parsers.value(terminalList.at(i).pSerPort);
+		if(parser)
+			parser->setPort(i);
+	}
+}
+
+void FormationControl::writeTerminal(QObject* port)
+{
+    // the scheduler's sender thread hands its writes over to this thread,
+    // which the ports belong to; a port closed since drops them
+    const std::vector<char>& data = commandSink->take(port);
+    QextSerialPort* serPort = (QextSerialPort*) port;
+    Terminal* terminal = getTerminalBySerPort(serPort);
+    long long queued = 0;
+    if(terminal && terminal->isOpen && !data.empty())
+    {
+        serPort->write(&data[0], (qint64)data.size());
+        queued = serPort->bytesToWrite();
+    }
+    commandSink->written(port, (GLint)data.size(), queued);
 }
 
 void FormationControl::readRS232Terminal()
 {
     QextSerialPort* port = (QextSerialPort*) QObject::sender();
-    if(port)
+    TelemetryParser* parser = parsers.value(port);
+    if(port && parser)
     {
-        QByteArray ba = port->readAll();
-        if(ba.size())
-        {
-            Terminal* pTerm = getTerminalBySerPort(port);
-        }
+        // parse the replies where they are read to, however many ports there are
+        long long now = LinkMetrics::now();
+        qint64 n;
+        while((n = port->read(telemetryBuffer, TELEMETRY_READ_BYTES)) > 0)
+            parser->feed(telemetryBuffer, (int)n, now);
     }
 }
 
+void FormationControl::dumpMetrics()
+{
+    if(metricsFile && metrics->dump(metricsFile, LinkMetrics::now()))
+        fflush(metricsFile);
+}
+
 QString portSettingsToText(PortSettings* portSettings)
 {
 	QString text;
@@ -268,12 +366,31 @@ Terminal* FormationControl::getTerminalBySerPort(QextSerialPort* port)
 
 FormationControl::~FormationControl()
 {
-	delete gXPos;
-	delete gYPos;
-	delete gHeading;
+	simLoop.stop();
+	env.setPoseFeed(NULL);
+	env.setMotionFeed(NULL);
+	env.setCommandScheduler(NULL);
+	env.setOdometryFeed(NULL);
+	delete scheduler;
+	delete commandSink;
+	qDeleteAll(parsers);
+	delete odometryFeed;
+	if(metricsFile)
+	{
+		metrics->dump(metricsFile, LinkMetrics::now());
+		fclose(metricsFile);
+	}
+	delete metrics;
+	delete [] gXPos;
+	delete [] gYPos;
+	delete [] gHeading;
    engine->running_ = false;
    engine->removeFrameProcessor(inverter);
+   engine->removeFrameProcessor(locator);
    engine->quit();
    delete inverter;
+   delete locator;
    delete engine;
+   delete poseFeed;
+   delete motionFeed;
 }
@@ -4,9 +4,13 @@
 #include <QGraphicsView>
 #include <QGraphicsScene>
 #include <QGraphicsItem>
+#include <QtCore/QHash>
 #include <QtWidgets/QMainWindow>
 #include "GeneratedFiles/ui_formationcontrol.h"
 #include "../portVideoQt/portVideoQt.h"
+#include "../portVideoQt/RoverLocator.h"
+#include "../ross/CommandScheduler.h"
+#include "../ross/OdometryFeed.h"
 #include "types.h"
 #include "newterminaldialog.h"
 
@@ -25,6 +29,8 @@ public slots:
 
 private slots:
 	void readRS232Terminal();
+	void writeTerminal(QObject* port);
+	void dumpMetrics();
 
 private slots:
 	void go();
@@ -44,6 +50,16 @@ private:
 
 private:
    FrameProcessor *inverter;
+   RoverLocator *locator;
+   PoseFeed *poseFeed;
+   PoseFeed *motionFeed;
+   TerminalSink *commandSink;
+   CommandScheduler *scheduler;
+   OdometryFeed *odometryFeed;
+   LinkMetrics *metrics;
+   FILE *metricsFile;
+   QHash<QextSerialPort*, TelemetryParser*> parsers;
+   char telemetryBuffer[TELEMETRY_READ_BYTES];
    portVideoQt *engine;
    QGraphicsScene* roboScene;
 
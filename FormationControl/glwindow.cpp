@@ -13,7 +13,7 @@ GLWindow::GLWindow(QWidget *parent)
 	QTimer* pTimer = new QTimer(this);
 	pElapsedTimer = new QElapsedTimer();
 	connect(pTimer, SIGNAL(timeout()), this, SLOT(timerFunc()));
-	pTimer->start(STI_MS);
+	pTimer->start(RENDER_TIME_INTERVAL_MS);
 	pElapsedTimer->start();
 }
 
@@ -35,6 +35,7 @@ void GLWindow::mouseMoveEvent(QMouseEvent* e)
 
 void GLWindow::keyPressEvent(QKeyEvent* e)
 {
+	lock_guard<mutex> lock(simLoop.getEnvMutex());
 	Cell* pCell = env.getCell(sID);
 	switch (e->key())
     {
@@ -67,15 +68,15 @@ void GLWindow::keyPressEvent(QKeyEvent* e)
 extern bool gGo;
 void GLWindow::timerFunc()
 {
+	// the simulation ticks on its own thread; this timer only repaints
 	if(gGo)
 	{
-		if(pElapsedTimer)
+		if(!simLoop.isRunning())
 		{
-			//FormationControl* fc = (FormationControl*) this->parent()->parent();
-			//fc->ui.stdoutput->appendPlainText(QString::number(pElapsedTimer->elapsed()));
-			pElapsedTimer->restart();
+			if(pElapsedTimer)
+				pElapsedTimer->restart();
+			simLoop.start();
 		}
-		env.step();
 		update();
 	}
 }
@@ -94,5 +95,9 @@ void GLWindow::resizeGL(int w, int h)
 void GLWindow::paintGL()
 {
 	if(gGo)
-		display(this);
+	{
+		bool interpolated = simLoop.interpolate(framePoses);
+		lock_guard<mutex> lock(simLoop.getEnvMutex());
+		display(this, interpolated ? &framePoses : NULL);
+	}
 }
@@ -30,8 +30,7 @@ private slots:
 	void timerFunc();
 
 private:
-	
-	
+	PoseStore framePoses;   // poses interpolated for the current frame
 };
 
 #endif // GLWINDOW_H
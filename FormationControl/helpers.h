@@ -15,6 +15,9 @@ extern const float MAX_ROBOT_SPEED_SPS;
 #define DPS_TO_SPS(x)              ( (x * (MAX_ROBOT_SPEED_SPS/MAX_ROBOT_SPEED_DPS)) > MAX_ROBOT_SPEED_SPS ? \
                                       MAX_ROBOT_SPEED_SPS :                                                  \
                                      (x * (MAX_ROBOT_SPEED_SPS/MAX_ROBOT_SPEED_DPS)) )
+#define SPS_TO_DPS(x)              ( (x * (MAX_ROBOT_SPEED_DPS/MAX_ROBOT_SPEED_SPS)) > MAX_ROBOT_SPEED_DPS ? \
+                                      MAX_ROBOT_SPEED_DPS :                                                  \
+                                     (x * (MAX_ROBOT_SPEED_DPS/MAX_ROBOT_SPEED_SPS)) )
 
 
 void f2i(float xf, float yf, int* xi, int* yi, int width, int height);
@@ -36,7 +36,11 @@ void NewTerminalDialog::showEvent(QShowEvent *e)
         {
             for(int i = 0; i < ports.size(); ++i)
             {
-                m_ui->cmbPort->addItem(ports.at(i).portName.mid(3,2).toLocal8Bit().data());
+                // the number ending the name: COM3, ttyUSB3
+                QString name = ports.at(i).portName;
+                int digits = name.size();
+                while(digits > 0 && name.at(digits - 1).isDigit()) --digits;
+                m_ui->cmbPort->addItem(name.mid(digits));
             }
         }
         if(m_ui->cmbPort->count())
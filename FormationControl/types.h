@@ -1,19 +1,22 @@
 #ifndef TYPES_H
 #define TYPES_H
 
+#ifndef ROSS_HEADLESS
 #include <QtCore/QElapsedTimer>
 #include <qextserialport.h>
 #include <QextSerialEnumerator.h>
+#endif
 
-#define SIMULATOR_TIME_INTERVAL_MS  100.0
-#define SIMULATOR_TIME_INTERVAL_SEC (SIMULATOR_TIME_INTERVAL_MS / 1000.0)
-#define STI_MS                      SIMULATOR_TIME_INTERVAL_MS
-#define STI_SEC                     SIMULATOR_TIME_INTERVAL_SEC
+#define RENDER_TIME_INTERVAL_MS     16
+#define METRICS_INTERVAL_MS         1000
 
 #define TERMINAL_COM 1
 #define TERMINAL_TCP 2
 #define TERMINAL_UDP 3
 
+#define TELEMETRY_READ_BYTES 4096
+
+#ifndef ROSS_HEADLESS
 class TerminalDockWidget;
 
 typedef struct _Terminal
@@ -27,7 +30,7 @@ typedef struct _Terminal
 } Terminal;
 
 extern QList<Terminal> terminalList;
-extern int gCameraScalePPM;
 extern QElapsedTimer* pElapsedTimer;
+#endif
 
 #endif // TYPES_H
@@ -0,0 +1,686 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "ColourConverter.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define COLOUR_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define TARGET_SSSE3
+#define TARGET_AVX2
+#else
+#include <cpuid.h>
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+typedef void (*RowKernel)(const unsigned char *src, unsigned char *dest, int width);
+
+// the fixed point YUV to RGB coefficients (scaled by 256)
+#define CB_U 454
+#define CR_V 359
+#define CG_U 88
+#define CG_V 183
+
+// the RGB to luminance weights (scaled by 256)
+#define LUMA_R 77
+#define LUMA_G 151
+#define LUMA_B 28
+
+static inline unsigned char clamp(int c) {
+	if (c & (~255)) { if (c < 0) c = 0; else c = 255; }
+	return (unsigned char)c;
+}
+
+
+// scalar kernels; these define the exact output of every conversion
+
+// Y is at byte YOFF of each two pixel group, U and V at the other two
+template <int YOFF, bool BGR>
+static void yuvToRgb(const unsigned char *src, unsigned char *dest, int width) {
+	const int UOFF = 1-YOFF;
+	for (int x=0;x<width/2;x++) {
+		int u  = src[UOFF] - 128;
+		int v  = src[UOFF+2] - 128;
+		int cB = (u * CB_U) >> 8;
+		int cG = (u * CG_U + v * CG_V) >> 8;
+		int cR = (v * CR_V) >> 8;
+		for (int i=0;i<2;i++) {
+			int y = src[YOFF+2*i];
+			*dest++ = clamp(y + (BGR?cB:cR));
+			*dest++ = clamp(y + cG);
+			*dest++ = clamp(y + (BGR?cR:cB));
+		}
+		src+=4;
+	}
+}
+
+template <int YOFF>
+static void yuvToGray(const unsigned char *src, unsigned char *dest, int width) {
+	src+=YOFF;
+	for (int x=0;x<width;x++) {
+		*dest++ = *src;
+		src+=2;
+	}
+}
+
+template <bool BGR>
+static void rgbToGray(const unsigned char *src, unsigned char *dest, int width) {
+	for (int x=0;x<width;x++) {
+		int r = src[BGR?2:0];
+		int g = src[1];
+		int b = src[BGR?0:2];
+		*dest++ = (unsigned char)((r * LUMA_R + g * LUMA_G + b * LUMA_B) >> 8);
+		src+=3;
+	}
+}
+
+static void swapRgb(const unsigned char *src, unsigned char *dest, int width) {
+	for (int x=0;x<width;x++) {
+		dest[0] = src[2];
+		dest[1] = src[1];
+		dest[2] = src[0];
+		src+=3;
+		dest+=3;
+	}
+}
+
+static void grayToRgb(const unsigned char *src, unsigned char *dest, int width) {
+	for (int x=0;x<width;x++) {
+		dest[0] = dest[1] = dest[2] = *src++;
+		dest+=3;
+	}
+}
+
+static void copy1(const unsigned char *src, unsigned char *dest, int width) {
+	memcpy(dest, src, width);
+}
+
+static void copy2(const unsigned char *src, unsigned char *dest, int width) {
+	memcpy(dest, src, width*2);
+}
+
+static void copy3(const unsigned char *src, unsigned char *dest, int width) {
+	memcpy(dest, src, width*3);
+}
+
+
+#ifdef COLOUR_X86
+
+// pshufb masks that gather one channel of 16 packed 24 bit pixels out of
+// each of the three 16 byte blocks holding them, and scatter it back
+static unsigned char splitMask[3][3][16];	// [block][channel]
+static unsigned char mergeMask[3][3][16];	// [block][channel]
+
+static void initMasks() {
+	for (int block=0;block<3;block++) {
+		for (int channel=0;channel<3;channel++) {
+			for (int i=0;i<16;i++) {
+				int from = 3*i + channel;	// byte of pixel i in the 48
+				splitMask[block][channel][i] = (from/16==block) ? (unsigned char)(from%16) : 0x80;
+				int to = 16*block + i;		// byte i of this block in the 48
+				mergeMask[block][channel][i] = (to%3==channel) ? (unsigned char)(to/3) : 0x80;
+			}
+		}
+	}
+}
+
+
+// SSSE3 kernels, 16 pixels at a time
+
+TARGET_SSSE3 static inline __m128i mask128(const unsigned char *mask) {
+	return _mm_loadu_si128((const __m128i*)mask);
+}
+
+// gathers one 16 byte result from three sources
+TARGET_SSSE3 static inline __m128i gather128(__m128i a, __m128i b, __m128i c,
+                                             const unsigned char *ma,
+                                             const unsigned char *mb,
+                                             const unsigned char *mc) {
+	return _mm_or_si128(_mm_or_si128(
+		_mm_shuffle_epi8(a, mask128(ma)),
+		_mm_shuffle_epi8(b, mask128(mb))),
+		_mm_shuffle_epi8(c, mask128(mc)));
+}
+
+// b0..b2 hold 16 pixels; c0..c2 receive their three channels
+TARGET_SSSE3 static inline void split128(__m128i b0, __m128i b1, __m128i b2,
+                                         __m128i &c0, __m128i &c1, __m128i &c2) {
+	c0 = gather128(b0, b1, b2, splitMask[0][0], splitMask[1][0], splitMask[2][0]);
+	c1 = gather128(b0, b1, b2, splitMask[0][1], splitMask[1][1], splitMask[2][1]);
+	c2 = gather128(b0, b1, b2, splitMask[0][2], splitMask[1][2], splitMask[2][2]);
+}
+
+TARGET_SSSE3 static inline void merge128(__m128i c0, __m128i c1, __m128i c2,
+                                         __m128i &b0, __m128i &b1, __m128i &b2) {
+	b0 = gather128(c0, c1, c2, mergeMask[0][0], mergeMask[0][1], mergeMask[0][2]);
+	b1 = gather128(c0, c1, c2, mergeMask[1][0], mergeMask[1][1], mergeMask[1][2]);
+	b2 = gather128(c0, c1, c2, mergeMask[2][0], mergeMask[2][1], mergeMask[2][2]);
+}
+
+// the luminance of 16 pixels, as the scalar hibyte(r*77 + g*151 + b*28)
+TARGET_SSSE3 static inline __m128i luma128(__m128i r, __m128i g, __m128i b) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i wr = _mm_set1_epi16(LUMA_R);
+	const __m128i wg = _mm_set1_epi16(LUMA_G);
+	const __m128i wb = _mm_set1_epi16(LUMA_B);
+	// the sum stays below 65536, so unsigned 16 bit lanes hold it exactly
+	__m128i lo = _mm_add_epi16(_mm_add_epi16(
+		_mm_mullo_epi16(_mm_unpacklo_epi8(r, zero), wr),
+		_mm_mullo_epi16(_mm_unpacklo_epi8(g, zero), wg)),
+		_mm_mullo_epi16(_mm_unpacklo_epi8(b, zero), wb));
+	__m128i hi = _mm_add_epi16(_mm_add_epi16(
+		_mm_mullo_epi16(_mm_unpackhi_epi8(r, zero), wr),
+		_mm_mullo_epi16(_mm_unpackhi_epi8(g, zero), wg)),
+		_mm_mullo_epi16(_mm_unpackhi_epi8(b, zero), wb));
+	return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+// 8 pixels of luminance (16 bit) and chroma (16 bit U V pairs) to RGB (16 bit)
+TARGET_SSSE3 static inline void yuvPixels128(__m128i y, __m128i uv,
+                                             __m128i &r, __m128i &g, __m128i &b) {
+	const __m128i c = _mm_sub_epi16(uv, _mm_set1_epi16(128));
+	// (u*454)>>8 and (v*359)>>8, as the high half of (u<<8)*454 and (v<<8)*359
+	__m128i cbr = _mm_mulhi_epi16(_mm_slli_epi16(c, 8),
+		_mm_setr_epi16(CB_U, CR_V, CB_U, CR_V, CB_U, CR_V, CB_U, CR_V));
+	// (u*88 + v*183)>>8, summed in 32 bits
+	__m128i cg = _mm_srai_epi32(_mm_madd_epi16(c,
+		_mm_setr_epi16(CG_U, CG_V, CG_U, CG_V, CG_U, CG_V, CG_U, CG_V)), 8);
+	cg = _mm_packs_epi32(cg, cg);
+	// each chroma pair covers two pixels
+	__m128i cb = _mm_shufflehi_epi16(_mm_shufflelo_epi16(cbr, _MM_SHUFFLE(2,2,0,0)), _MM_SHUFFLE(2,2,0,0));
+	__m128i cr = _mm_shufflehi_epi16(_mm_shufflelo_epi16(cbr, _MM_SHUFFLE(3,3,1,1)), _MM_SHUFFLE(3,3,1,1));
+	r = _mm_add_epi16(y, cr);
+	g = _mm_add_epi16(y, _mm_unpacklo_epi16(cg, cg));
+	b = _mm_add_epi16(y, cb);
+}
+
+// splits 8 packed YUV pixels into luminance and chroma (16 bit)
+template <int YOFF>
+TARGET_SSSE3 static inline void yuvSplit128(__m128i p, __m128i &y, __m128i &uv) {
+	const __m128i low = _mm_set1_epi16(0x00ff);
+	if (YOFF==1) {
+		y  = _mm_srli_epi16(p, 8);
+		uv = _mm_and_si128(p, low);
+	} else {
+		y  = _mm_and_si128(p, low);
+		uv = _mm_srli_epi16(p, 8);
+	}
+}
+
+template <int YOFF, bool BGR>
+TARGET_SSSE3 static void yuvToRgbSsse3(const unsigned char *src, unsigned char *dest, int width) {
+	int n = width & ~15;
+	for (int x=0;x<n;x+=16) {
+		__m128i y0, uv0, y1, uv1, r0, g0, b0, r1, g1, b1;
+		yuvSplit128<YOFF>(_mm_loadu_si128((const __m128i*)src), y0, uv0);
+		yuvSplit128<YOFF>(_mm_loadu_si128((const __m128i*)(src+16)), y1, uv1);
+		yuvPixels128(y0, uv0, r0, g0, b0);
+		yuvPixels128(y1, uv1, r1, g1, b1);
+		// packing saturates, as clamp() does
+		__m128i r = _mm_packus_epi16(r0, r1);
+		__m128i g = _mm_packus_epi16(g0, g1);
+		__m128i b = _mm_packus_epi16(b0, b1);
+		__m128i o0, o1, o2;
+		if (BGR) merge128(b, g, r, o0, o1, o2);
+		else merge128(r, g, b, o0, o1, o2);
+		_mm_storeu_si128((__m128i*)dest, o0);
+		_mm_storeu_si128((__m128i*)(dest+16), o1);
+		_mm_storeu_si128((__m128i*)(dest+32), o2);
+		src+=32;
+		dest+=48;
+	}
+	yuvToRgb<YOFF,BGR>(src, dest, width-n);
+}
+
+template <int YOFF>
+TARGET_SSSE3 static void yuvToGraySsse3(const unsigned char *src, unsigned char *dest, int width) {
+	int n = width & ~15;
+	for (int x=0;x<n;x+=16) {
+		__m128i y0, uv0, y1, uv1;
+		yuvSplit128<YOFF>(_mm_loadu_si128((const __m128i*)src), y0, uv0);
+		yuvSplit128<YOFF>(_mm_loadu_si128((const __m128i*)(src+16)), y1, uv1);
+		_mm_storeu_si128((__m128i*)dest, _mm_packus_epi16(y0, y1));
+		src+=32;
+		dest+=16;
+	}
+	yuvToGray<YOFF>(src, dest, width-n);
+}
+
+template <bool BGR>
+TARGET_SSSE3 static void rgbToGraySsse3(const unsigned char *src, unsigned char *dest, int width) {
+	int n = width & ~15;
+	for (int x=0;x<n;x+=16) {
+		__m128i c0, c1, c2;
+		split128(_mm_loadu_si128((const __m128i*)src),
+		         _mm_loadu_si128((const __m128i*)(src+16)),
+		         _mm_loadu_si128((const __m128i*)(src+32)), c0, c1, c2);
+		_mm_storeu_si128((__m128i*)dest, BGR ? luma128(c2, c1, c0) : luma128(c0, c1, c2));
+		src+=48;
+		dest+=16;
+	}
+	rgbToGray<BGR>(src, dest, width-n);
+}
+
+TARGET_SSSE3 static void swapRgbSsse3(const unsigned char *src, unsigned char *dest, int width) {
+	int n = width & ~15;
+	for (int x=0;x<n;x+=16) {
+		__m128i c0, c1, c2, o0, o1, o2;
+		split128(_mm_loadu_si128((const __m128i*)src),
+		         _mm_loadu_si128((const __m128i*)(src+16)),
+		         _mm_loadu_si128((const __m128i*)(src+32)), c0, c1, c2);
+		merge128(c2, c1, c0, o0, o1, o2);
+		_mm_storeu_si128((__m128i*)dest, o0);
+		_mm_storeu_si128((__m128i*)(dest+16), o1);
+		_mm_storeu_si128((__m128i*)(dest+32), o2);
+		src+=48;
+		dest+=48;
+	}
+	swapRgb(src, dest, width-n);
+}
+
+TARGET_SSSE3 static void grayToRgbSsse3(const unsigned char *src, unsigned char *dest, int width) {
+	int n = width & ~15;
+	for (int x=0;x<n;x+=16) {
+		__m128i c = _mm_loadu_si128((const __m128i*)src), o0, o1, o2;
+		merge128(c, c, c, o0, o1, o2);
+		_mm_storeu_si128((__m128i*)dest, o0);
+		_mm_storeu_si128((__m128i*)(dest+16), o1);
+		_mm_storeu_si128((__m128i*)(dest+32), o2);
+		src+=16;
+		dest+=48;
+	}
+	grayToRgb(src, dest, width-n);
+}
+
+
+// AVX2 kernels, 32 pixels at a time; as AVX2 shuffles and packs stay within
+// each 128 bit lane, the low lane works on pixels 0-15, the high on 16-31
+
+TARGET_AVX2 static inline __m256i mask256(const unsigned char *mask) {
+	return _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)mask));
+}
+
+// loads a and b into the low and high lanes
+TARGET_AVX2 static inline __m256i load2x128(const unsigned char *a, const unsigned char *b) {
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(
+		_mm_loadu_si128((const __m128i*)a)), _mm_loadu_si128((const __m128i*)b), 1);
+}
+
+// loads 32 packed 24 bit pixels, 16 per lane
+TARGET_AVX2 static inline void load3x256(const unsigned char *src, __m256i &b0, __m256i &b1, __m256i &b2) {
+	b0 = load2x128(src, src+48);
+	b1 = load2x128(src+16, src+64);
+	b2 = load2x128(src+32, src+80);
+}
+
+TARGET_AVX2 static inline void store3x256(unsigned char *dest, __m256i b0, __m256i b1, __m256i b2) {
+	_mm256_storeu_si256((__m256i*)dest, _mm256_permute2x128_si256(b0, b1, 0x20));
+	_mm256_storeu_si256((__m256i*)(dest+32), _mm256_permute2x128_si256(b2, b0, 0x30));
+	_mm256_storeu_si256((__m256i*)(dest+64), _mm256_permute2x128_si256(b1, b2, 0x31));
+}
+
+TARGET_AVX2 static inline __m256i gather256(__m256i a, __m256i b, __m256i c,
+                                            const unsigned char *ma,
+                                            const unsigned char *mb,
+                                            const unsigned char *mc) {
+	return _mm256_or_si256(_mm256_or_si256(
+		_mm256_shuffle_epi8(a, mask256(ma)),
+		_mm256_shuffle_epi8(b, mask256(mb))),
+		_mm256_shuffle_epi8(c, mask256(mc)));
+}
+
+TARGET_AVX2 static inline void split256(__m256i b0, __m256i b1, __m256i b2,
+                                        __m256i &c0, __m256i &c1, __m256i &c2) {
+	c0 = gather256(b0, b1, b2, splitMask[0][0], splitMask[1][0], splitMask[2][0]);
+	c1 = gather256(b0, b1, b2, splitMask[0][1], splitMask[1][1], splitMask[2][1]);
+	c2 = gather256(b0, b1, b2, splitMask[0][2], splitMask[1][2], splitMask[2][2]);
+}
+
+TARGET_AVX2 static inline void merge256(__m256i c0, __m256i c1, __m256i c2,
+                                        __m256i &b0, __m256i &b1, __m256i &b2) {
+	b0 = gather256(c0, c1, c2, mergeMask[0][0], mergeMask[0][1], mergeMask[0][2]);
+	b1 = gather256(c0, c1, c2, mergeMask[1][0], mergeMask[1][1], mergeMask[1][2]);
+	b2 = gather256(c0, c1, c2, mergeMask[2][0], mergeMask[2][1], mergeMask[2][2]);
+}
+
+TARGET_AVX2 static inline __m256i luma256(__m256i r, __m256i g, __m256i b) {
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i wr = _mm256_set1_epi16(LUMA_R);
+	const __m256i wg = _mm256_set1_epi16(LUMA_G);
+	const __m256i wb = _mm256_set1_epi16(LUMA_B);
+	__m256i lo = _mm256_add_epi16(_mm256_add_epi16(
+		_mm256_mullo_epi16(_mm256_unpacklo_epi8(r, zero), wr),
+		_mm256_mullo_epi16(_mm256_unpacklo_epi8(g, zero), wg)),
+		_mm256_mullo_epi16(_mm256_unpacklo_epi8(b, zero), wb));
+	__m256i hi = _mm256_add_epi16(_mm256_add_epi16(
+		_mm256_mullo_epi16(_mm256_unpackhi_epi8(r, zero), wr),
+		_mm256_mullo_epi16(_mm256_unpackhi_epi8(g, zero), wg)),
+		_mm256_mullo_epi16(_mm256_unpackhi_epi8(b, zero), wb));
+	return _mm256_packus_epi16(_mm256_srli_epi16(lo, 8), _mm256_srli_epi16(hi, 8));
+}
+
+TARGET_AVX2 static inline void yuvPixels256(__m256i y, __m256i uv,
+                                            __m256i &r, __m256i &g, __m256i &b) {
+	const __m256i c = _mm256_sub_epi16(uv, _mm256_set1_epi16(128));
+	__m256i cbr = _mm256_mulhi_epi16(_mm256_slli_epi16(c, 8),
+		_mm256_setr_epi16(CB_U, CR_V, CB_U, CR_V, CB_U, CR_V, CB_U, CR_V,
+		                  CB_U, CR_V, CB_U, CR_V, CB_U, CR_V, CB_U, CR_V));
+	__m256i cg = _mm256_srai_epi32(_mm256_madd_epi16(c,
+		_mm256_setr_epi16(CG_U, CG_V, CG_U, CG_V, CG_U, CG_V, CG_U, CG_V,
+		                  CG_U, CG_V, CG_U, CG_V, CG_U, CG_V, CG_U, CG_V)), 8);
+	cg = _mm256_packs_epi32(cg, cg);
+	__m256i cb = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(cbr, _MM_SHUFFLE(2,2,0,0)), _MM_SHUFFLE(2,2,0,0));
+	__m256i cr = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(cbr, _MM_SHUFFLE(3,3,1,1)), _MM_SHUFFLE(3,3,1,1));
+	r = _mm256_add_epi16(y, cr);
+	g = _mm256_add_epi16(y, _mm256_unpacklo_epi16(cg, cg));
+	b = _mm256_add_epi16(y, cb);
+}
+
+template <int YOFF>
+TARGET_AVX2 static inline void yuvSplit256(__m256i p, __m256i &y, __m256i &uv) {
+	const __m256i low = _mm256_set1_epi16(0x00ff);
+	if (YOFF==1) {
+		y  = _mm256_srli_epi16(p, 8);
+		uv = _mm256_and_si256(p, low);
+	} else {
+		y  = _mm256_and_si256(p, low);
+		uv = _mm256_srli_epi16(p, 8);
+	}
+}
+
+template <int YOFF, bool BGR>
+TARGET_AVX2 static void yuvToRgbAvx2(const unsigned char *src, unsigned char *dest, int width) {
+	int n = width & ~31;
+	for (int x=0;x<n;x+=32) {
+		__m256i y0, uv0, y1, uv1, r0, g0, b0, r1, g1, b1;
+		yuvSplit256<YOFF>(load2x128(src, src+32), y0, uv0);
+		yuvSplit256<YOFF>(load2x128(src+16, src+48), y1, uv1);
+		yuvPixels256(y0, uv0, r0, g0, b0);
+		yuvPixels256(y1, uv1, r1, g1, b1);
+		__m256i r = _mm256_packus_epi16(r0, r1);
+		__m256i g = _mm256_packus_epi16(g0, g1);
+		__m256i b = _mm256_packus_epi16(b0, b1);
+		__m256i o0, o1, o2;
+		if (BGR) merge256(b, g, r, o0, o1, o2);
+		else merge256(r, g, b, o0, o1, o2);
+		store3x256(dest, o0, o1, o2);
+		src+=64;
+		dest+=96;
+	}
+	yuvToRgbSsse3<YOFF,BGR>(src, dest, width-n);
+}
+
+template <int YOFF>
+TARGET_AVX2 static void yuvToGrayAvx2(const unsigned char *src, unsigned char *dest, int width) {
+	int n = width & ~31;
+	for (int x=0;x<n;x+=32) {
+		__m256i y0, uv0, y1, uv1;
+		yuvSplit256<YOFF>(load2x128(src, src+32), y0, uv0);
+		yuvSplit256<YOFF>(load2x128(src+16, src+48), y1, uv1);
+		_mm256_storeu_si256((__m256i*)dest, _mm256_packus_epi16(y0, y1));
+		src+=64;
+		dest+=32;
+	}
+	yuvToGraySsse3<YOFF>(src, dest, width-n);
+}
+
+template <bool BGR>
+TARGET_AVX2 static void rgbToGrayAvx2(const unsigned char *src, unsigned char *dest, int width) {
+	int n = width & ~31;
+	for (int x=0;x<n;x+=32) {
+		__m256i b0, b1, b2, c0, c1, c2;
+		load3x256(src, b0, b1, b2);
+		split256(b0, b1, b2, c0, c1, c2);
+		_mm256_storeu_si256((__m256i*)dest, BGR ? luma256(c2, c1, c0) : luma256(c0, c1, c2));
+		src+=96;
+		dest+=32;
+	}
+	rgbToGraySsse3<BGR>(src, dest, width-n);
+}
+
+TARGET_AVX2 static void swapRgbAvx2(const unsigned char *src, unsigned char *dest, int width) {
+	int n = width & ~31;
+	for (int x=0;x<n;x+=32) {
+		__m256i b0, b1, b2, c0, c1, c2;
+		load3x256(src, b0, b1, b2);
+		split256(b0, b1, b2, c0, c1, c2);
+		merge256(c2, c1, c0, b0, b1, b2);
+		store3x256(dest, b0, b1, b2);
+		src+=96;
+		dest+=96;
+	}
+	swapRgbSsse3(src, dest, width-n);
+}
+
+TARGET_AVX2 static void grayToRgbAvx2(const unsigned char *src, unsigned char *dest, int width) {
+	int n = width & ~31;
+	for (int x=0;x<n;x+=32) {
+		__m256i c = _mm256_loadu_si256((const __m256i*)src), b0, b1, b2;
+		merge256(c, c, c, b0, b1, b2);
+		store3x256(dest, b0, b1, b2);
+		src+=32;
+		dest+=96;
+	}
+	grayToRgbSsse3(src, dest, width-n);
+}
+
+
+static void cpuid(int leaf, int regs[4]) {
+#ifdef _MSC_VER
+	__cpuidex(regs, leaf, 0);
+#else
+	unsigned int a, b, c, d;
+	__cpuid_count(leaf, 0, a, b, c, d);
+	regs[0] = a; regs[1] = b; regs[2] = c; regs[3] = d;
+#endif
+}
+
+static unsigned long long xgetbv0() {
+#ifdef _MSC_VER
+	return _xgetbv(0);
+#else
+	unsigned int lo, hi;
+	__asm__ __volatile__ ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+	return ((unsigned long long)hi << 32) | lo;
+#endif
+}
+
+static ColourConverter::Isa detectIsa() {
+	int regs[4];
+	cpuid(0, regs);
+	int maxLeaf = regs[0];
+	if (maxLeaf < 1) return ColourConverter::ISA_SCALAR;
+
+	cpuid(1, regs);
+	bool ssse3   = (regs[2] & (1<<9)) != 0;
+	bool osxsave = (regs[2] & (1<<27)) != 0;
+	bool avx     = (regs[2] & (1<<28)) != 0;
+	if (!ssse3) return ColourConverter::ISA_SCALAR;
+
+	// AVX2 also needs the operating system to save the ymm registers
+	if (maxLeaf >= 7 && osxsave && avx && (xgetbv0() & 6) == 6) {
+		cpuid(7, regs);
+		if (regs[1] & (1<<5)) return ColourConverter::ISA_AVX2;
+	}
+	return ColourConverter::ISA_SSSE3;
+}
+
+#endif
+
+
+// the kernel of each instruction set for each conversion (NULL where
+// that set has none, so the next set down is used)
+class KernelTable
+{
+public:
+	KernelTable() {
+		memset(kernels, 0, sizeof(kernels));
+		isa = ColourConverter::ISA_SCALAR;
+
+		set(ColourConverter::ISA_SCALAR, ColourConverter::UYVY,  ColourConverter::RGB24, yuvToRgb<1,false>);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::UYVY,  ColourConverter::BGR24, yuvToRgb<1,true>);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::UYVY,  ColourConverter::GRAY8, yuvToGray<1>);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::YUYV,  ColourConverter::RGB24, yuvToRgb<0,false>);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::YUYV,  ColourConverter::BGR24, yuvToRgb<0,true>);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::YUYV,  ColourConverter::GRAY8, yuvToGray<0>);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::RGB24, ColourConverter::GRAY8, rgbToGray<false>);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::BGR24, ColourConverter::GRAY8, rgbToGray<true>);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::RGB24, ColourConverter::BGR24, swapRgb);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::BGR24, ColourConverter::RGB24, swapRgb);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::GRAY8, ColourConverter::RGB24, grayToRgb);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::GRAY8, ColourConverter::BGR24, grayToRgb);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::GRAY8, ColourConverter::GRAY8, copy1);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::RGB24, ColourConverter::RGB24, copy3);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::BGR24, ColourConverter::BGR24, copy3);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::UYVY,  ColourConverter::UYVY,  copy2);
+		set(ColourConverter::ISA_SCALAR, ColourConverter::YUYV,  ColourConverter::YUYV,  copy2);
+
+#ifdef COLOUR_X86
+		initMasks();
+
+		set(ColourConverter::ISA_SSSE3, ColourConverter::UYVY,  ColourConverter::RGB24, yuvToRgbSsse3<1,false>);
+		set(ColourConverter::ISA_SSSE3, ColourConverter::UYVY,  ColourConverter::BGR24, yuvToRgbSsse3<1,true>);
+		set(ColourConverter::ISA_SSSE3, ColourConverter::UYVY,  ColourConverter::GRAY8, yuvToGraySsse3<1>);
+		set(ColourConverter::ISA_SSSE3, ColourConverter::YUYV,  ColourConverter::RGB24, yuvToRgbSsse3<0,false>);
+		set(ColourConverter::ISA_SSSE3, ColourConverter::YUYV,  ColourConverter::BGR24, yuvToRgbSsse3<0,true>);
+		set(ColourConverter::ISA_SSSE3, ColourConverter::YUYV,  ColourConverter::GRAY8, yuvToGraySsse3<0>);
+		set(ColourConverter::ISA_SSSE3, ColourConverter::RGB24, ColourConverter::GRAY8, rgbToGraySsse3<false>);
+		set(ColourConverter::ISA_SSSE3, ColourConverter::BGR24, ColourConverter::GRAY8, rgbToGraySsse3<true>);
+		set(ColourConverter::ISA_SSSE3, ColourConverter::RGB24, ColourConverter::BGR24, swapRgbSsse3);
+		set(ColourConverter::ISA_SSSE3, ColourConverter::BGR24, ColourConverter::RGB24, swapRgbSsse3);
+		set(ColourConverter::ISA_SSSE3, ColourConverter::GRAY8, ColourConverter::RGB24, grayToRgbSsse3);
+		set(ColourConverter::ISA_SSSE3, ColourConverter::GRAY8, ColourConverter::BGR24, grayToRgbSsse3);
+
+		set(ColourConverter::ISA_AVX2, ColourConverter::UYVY,  ColourConverter::RGB24, yuvToRgbAvx2<1,false>);
+		set(ColourConverter::ISA_AVX2, ColourConverter::UYVY,  ColourConverter::BGR24, yuvToRgbAvx2<1,true>);
+		set(ColourConverter::ISA_AVX2, ColourConverter::UYVY,  ColourConverter::GRAY8, yuvToGrayAvx2<1>);
+		set(ColourConverter::ISA_AVX2, ColourConverter::YUYV,  ColourConverter::RGB24, yuvToRgbAvx2<0,false>);
+		set(ColourConverter::ISA_AVX2, ColourConverter::YUYV,  ColourConverter::BGR24, yuvToRgbAvx2<0,true>);
+		set(ColourConverter::ISA_AVX2, ColourConverter::YUYV,  ColourConverter::GRAY8, yuvToGrayAvx2<0>);
+		set(ColourConverter::ISA_AVX2, ColourConverter::RGB24, ColourConverter::GRAY8, rgbToGrayAvx2<false>);
+		set(ColourConverter::ISA_AVX2, ColourConverter::BGR24, ColourConverter::GRAY8, rgbToGrayAvx2<true>);
+		set(ColourConverter::ISA_AVX2, ColourConverter::RGB24, ColourConverter::BGR24, swapRgbAvx2);
+		set(ColourConverter::ISA_AVX2, ColourConverter::BGR24, ColourConverter::RGB24, swapRgbAvx2);
+		set(ColourConverter::ISA_AVX2, ColourConverter::GRAY8, ColourConverter::RGB24, grayToRgbAvx2);
+		set(ColourConverter::ISA_AVX2, ColourConverter::GRAY8, ColourConverter::BGR24, grayToRgbAvx2);
+
+		isa = detectIsa();
+#endif
+	}
+
+	RowKernel get(ColourConverter::Isa i, ColourConverter::Format src, ColourConverter::Format dest) const {
+		if (i > isa) i = isa;
+		for (int k=i;k>=0;k--)
+			if (kernels[k][src][dest] != NULL) return kernels[k][src][dest];
+		return NULL;
+	}
+
+	ColourConverter::Isa isa;	// the best the processor supports
+
+private:
+	void set(ColourConverter::Isa i, ColourConverter::Format src, ColourConverter::Format dest, RowKernel kernel) {
+		kernels[i][src][dest] = kernel;
+	}
+
+	RowKernel kernels[ColourConverter::ISA_COUNT][ColourConverter::FORMAT_COUNT][ColourConverter::FORMAT_COUNT];
+};
+
+static const KernelTable kernelTable;
+
+
+bool ColourConverter::convert(const unsigned char *src, Format srcFormat,
+                              unsigned char *dest, Format destFormat,
+                              int width, int height, bool flip) {
+	return convert(src, srcFormat, dest, destFormat, width, height, flip, kernelTable.isa);
+}
+
+bool ColourConverter::convert(const unsigned char *src, Format srcFormat,
+                              unsigned char *dest, Format destFormat,
+                              int width, int height, bool flip, Isa isa) {
+	if (src==NULL || dest==NULL || width<=0 || height<=0) return false;
+	if (!canConvert(srcFormat, destFormat)) return false;
+	// YUV formats share chroma between pixel pairs
+	if ((width & 1) && (srcFormat==UYVY || srcFormat==YUYV)) return false;
+
+	RowKernel kernel = kernelTable.get(isa, srcFormat, destFormat);
+	int srcStride  = width * bytesPerPixel(srcFormat);
+	int destStride = width * bytesPerPixel(destFormat);
+	if (flip) {
+		dest += (height-1) * destStride;
+		destStride = -destStride;
+	}
+
+	for (int y=0;y<height;y++) {
+		kernel(src, dest, width);
+		src  += srcStride;
+		dest += destStride;
+	}
+	return true;
+}
+
+bool ColourConverter::canConvert(Format srcFormat, Format destFormat) {
+	if (srcFormat<0 || srcFormat>=FORMAT_COUNT || destFormat<0 || destFormat>=FORMAT_COUNT)
+		return false;
+	return kernelTable.get(ISA_SCALAR, srcFormat, destFormat) != NULL;
+}
+
+int ColourConverter::bytesPerPixel(Format format) {
+	switch (format) {
+		case GRAY8: return 1;
+		case RGB24:
+		case BGR24: return 3;
+		case UYVY:
+		case YUYV:  return 2;
+		default:    return 0;
+	}
+}
+
+int ColourConverter::frameSize(Format format, int width, int height) {
+	return width * height * bytesPerPixel(format);
+}
+
+ColourConverter::Isa ColourConverter::supportedIsa() {
+	return kernelTable.isa;
+}
+
+const char* ColourConverter::isaName(Isa isa) {
+	switch (isa) {
+		case ISA_SCALAR: return "scalar";
+		case ISA_SSSE3:  return "ssse3";
+		case ISA_AVX2:   return "avx2";
+		default:         return "unknown";
+	}
+}
+
+const char* ColourConverter::formatName(Format format) {
+	switch (format) {
+		case GRAY8: return "gray8";
+		case RGB24: return "rgb24";
+		case BGR24: return "bgr24";
+		case UYVY:  return "uyvy";
+		case YUYV:  return "yuyv";
+		default:    return "unknown";
+	}
+}
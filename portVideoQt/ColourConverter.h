@@ -0,0 +1,63 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef COLOURCONVERTER_H
+#define COLOURCONVERTER_H
+
+// converts whole frames between pixel formats, a row at a time, using the
+// widest instruction set the processor supports (checked once, at startup);
+// every vector kernel produces exactly the bytes of its scalar counterpart
+class ColourConverter
+{
+public:
+	enum Format {
+		GRAY8,		// one luminance byte per pixel
+		RGB24,
+		BGR24,		// the byte order of DirectShow RGB24
+		UYVY,		// U Y0 V Y1 per two pixels
+		YUYV,		// Y0 U Y1 V per two pixels
+		FORMAT_COUNT
+	};
+
+	enum Isa {
+		ISA_SCALAR,
+		ISA_SSSE3,
+		ISA_AVX2,
+		ISA_COUNT
+	};
+
+	// any format converts to GRAY8, RGB24 and BGR24 (and to itself);
+	// flip writes the rows bottom-up, as in a DIB or a DirectShow sample
+	static bool convert(const unsigned char *src, Format srcFormat,
+	                    unsigned char *dest, Format destFormat,
+	                    int width, int height, bool flip = false);
+	// the same, restricted to the given instruction set (or the best below it)
+	static bool convert(const unsigned char *src, Format srcFormat,
+	                    unsigned char *dest, Format destFormat,
+	                    int width, int height, bool flip, Isa isa);
+
+	static bool canConvert(Format srcFormat, Format destFormat);
+	static int bytesPerPixel(Format format);
+	static int frameSize(Format format, int width, int height);
+
+	static Isa supportedIsa();
+	static const char* isaName(Isa isa);
+	static const char* formatName(Format format);
+};
+
+#endif
@@ -19,8 +19,15 @@
 #include "FrameInverter.h"
 
 void FrameInverter::process(unsigned char *src, unsigned char *dest) {
-	// inverts the image
-	for (int i=0;i<srcSize;i++) {
+	processTile(src, dest, 0, height);
+}
+
+void FrameInverter::processTile(unsigned char *src, unsigned char *dest, int firstRow, int lastRow) {
+	// inverts the rows of the image
+	int rowSize = width*srcBytes;
+	src  += firstRow*rowSize;
+	dest += firstRow*rowSize;
+	for (int i=(lastRow-firstRow)*rowSize;i>0;i--) {
 		*dest++ = 255 - *src++;
 	}
 }
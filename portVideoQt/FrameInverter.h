@@ -28,6 +28,9 @@ public:
 	~FrameInverter() {};
 	
 	void process(unsigned char *src, unsigned char *dest);
+	
+	bool isTileable() { return true; };
+	void processTile(unsigned char *src, unsigned char *dest, int firstRow, int lastRow);
 };
 
 #endif
@@ -0,0 +1,161 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "FramePipeline.h"
+
+FramePipeline::FramePipeline(int tileThreads)
+	: input(STAGE_QUEUE_DEPTH, RingBuffer::LATEST_FRAME)
+	, output(STAGE_QUEUE_DEPTH, RingBuffer::LATEST_FRAME)
+	, tilePool(tileThreads)
+{
+	running = false;
+	frameHeight = 0;
+}
+
+FramePipeline::~FramePipeline() {
+	stop();
+	for (unsigned int i=0;i<stages.size();i++) {
+		delete stages[i]->input;
+		delete stages[i]->pool;
+		delete stages[i];
+	}
+}
+
+bool FramePipeline::addStage(FrameProcessor *fp, int destBytes) {
+	if (running || fp==NULL) return false;
+	Stage *stage = new Stage();
+	stage->fp = fp;
+	stage->srcBytes = 0;
+	stage->destBytes = destBytes;
+	stage->pool = NULL;
+	stage->input = NULL;
+	stages.push_back(stage);
+	return true;
+}
+
+bool FramePipeline::removeStage(FrameProcessor *fp) {
+	if (running) return false;
+	for (unsigned int i=0;i<stages.size();i++) {
+		if (stages[i]->fp==fp) {
+			delete stages[i]->input;
+			delete stages[i]->pool;
+			delete stages[i];
+			stages.erase(stages.begin()+i);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FramePipeline::start(int width, int height, int srcBytes) {
+	if (running) return false;
+	
+	// chain the stages, each reading what the one before writes
+	int bytes = srcBytes;
+	for (unsigned int i=0;i<stages.size();) {
+		Stage *stage = stages[i];
+		int destBytes = (stage->destBytes>0)?stage->destBytes:bytes;
+		if (!stage->fp->init(width, height, bytes, destBytes)) {
+			delete stage->input;
+			delete stage->pool;
+			delete stage;
+			stages.erase(stages.begin()+i);
+			continue;
+		}
+		delete stage->input;
+		delete stage->pool;
+		stage->srcBytes = bytes;
+		stage->destBytes = destBytes;
+		stage->pool = new FramePool(width*height*destBytes, STAGE_POOL_FRAMES);
+		// frames in flight between stages are never dropped
+		stage->input = (i==0)?NULL:new RingBuffer(STAGE_QUEUE_DEPTH, RingBuffer::LOSSLESS);
+		bytes = destBytes;
+		i++;
+	}
+	
+	frameHeight = height;
+	running = true;
+	for (unsigned int i=0;i<stages.size();i++)
+		stages[i]->thread = std::thread(&FramePipeline::run, this, (int)i);
+	return true;
+}
+
+void FramePipeline::stop() {
+	if (!running) return;
+	running = false;
+	for (unsigned int i=0;i<stages.size();i++)
+		stages[i]->thread.join();
+	
+	// hand every frame still queued back to its pool
+	FrameHandle frame;
+	while (input.read(frame)) frame.release();
+	while (output.read(frame)) frame.release();
+	for (unsigned int i=0;i<stages.size();i++)
+		if (stages[i]->input!=NULL)
+			while (stages[i]->input->read(frame)) frame.release();
+}
+
+bool FramePipeline::push(const FrameHandle &frame) {
+	if (!running || stages.empty()) return false;
+	return input.write(frame);
+}
+
+bool FramePipeline::readLatest(FrameHandle &frame) {
+	return output.readLatest(frame);
+}
+
+bool FramePipeline::waitOutput(FrameHandle &frame, int timeout) {
+	if (!output.waitRead(frame, timeout)) return false;
+	FrameHandle newer;
+	if (output.readLatest(newer)) frame = newer;
+	return true;
+}
+
+int FramePipeline::outputBytes() {
+	if (stages.empty()) return 0;
+	return stages.back()->destBytes;
+}
+
+// the thread of one stage: takes a frame from its input, processes it
+// into a frame of its own pool, and passes that on to the next stage
+void FramePipeline::run(int index) {
+	Stage *stage = stages[index];
+	RingBuffer *in = (index==0)?&input:stage->input;
+	RingBuffer *next = (index+1<(int)stages.size())?stages[index+1]->input:&output;
+	
+	while (running) {
+		FrameHandle src;
+		if (!in->waitRead(src, 100)) continue;
+		
+		// the pool runs dry only while later stages hold on to frames
+		FrameHandle dest;
+		while (running && dest.isNull())
+			dest = stage->pool->acquire(100);
+		if (dest.isNull()) break;
+		
+		dest.setNumber(src.number());
+		if (stage->fp->isTileable())
+			tilePool.process(stage->fp, src.data(), dest.data(), frameHeight);
+		else
+			stage->fp->process(src.data(), dest.data());
+		src.release();
+		
+		// wait for the next stage rather than drop a processed frame
+		while (running && !next->waitWrite(dest, 100));
+	}
+}
@@ -0,0 +1,89 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef FRAMEPIPELINE_H
+#define FRAMEPIPELINE_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "FramePool.h"
+#include "FrameProcessor.h"
+#include "RingBuffer.h"
+#include "TilePool.h"
+
+#define STAGE_QUEUE_DEPTH 2
+#define STAGE_POOL_FRAMES 8
+
+// a chain of frame processors, each fed the output of the one before and
+// run on a thread of its own, so that stage k works on frame n while stage
+// k-1 works on frame n+1; tileable stages share a pool of tile threads
+class FramePipeline
+{
+public:
+	// 0 tile threads means one less than the number of cores
+	FramePipeline(int tileThreads = 0);
+	~FramePipeline();
+	
+	// stages are added (in order) while stopped; 0 bytes means the
+	// stage writes as many bytes per pixel as it reads
+	bool addStage(FrameProcessor *fp, int destBytes = 0);
+	bool removeStage(FrameProcessor *fp);
+	int stageCount() { return (int)stages.size(); }
+	FrameProcessor* getStage(int i) { return stages[i]->fp; }
+	
+	// initialises each stage for its input, dropping those that fail,
+	// and starts their threads
+	bool start(int width, int height, int srcBytes);
+	void stop();
+	bool isRunning() { return running; }
+	
+	// hands a frame to the first stage, replacing one still waiting there
+	bool push(const FrameHandle &frame);
+	// the newest frame out of the last stage (if any came out since)
+	bool readLatest(FrameHandle &frame);
+	bool waitOutput(FrameHandle &frame, int timeout);
+	
+	int outputBytes();
+	long dropped() { return input.dropped(); }
+
+private:
+	struct Stage {
+		FrameProcessor *fp;
+		int srcBytes;
+		int destBytes;
+		FramePool *pool;		// the frames this stage writes
+		RingBuffer *input;		// the frames this stage reads
+		std::thread thread;
+	};
+	
+	void run(int index);
+	
+	std::vector<Stage*> stages;
+	RingBuffer input;			// of the first stage
+	RingBuffer output;			// of the last stage
+	TilePool tilePool;
+	std::atomic<bool> running;
+	int frameHeight;
+	
+	FramePipeline(const FramePipeline &);
+	FramePipeline& operator=(const FramePipeline &);
+};
+
+#endif
@@ -0,0 +1,137 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "FramePool.h"
+
+#include <chrono>
+
+FrameHandle::FrameHandle() {
+	pool  = NULL;
+	index = -1;
+}
+
+FrameHandle::FrameHandle(FramePool *p, int i) {
+	// the pool has already counted this reference
+	pool  = p;
+	index = i;
+}
+
+FrameHandle::FrameHandle(const FrameHandle &frame) {
+	pool  = frame.pool;
+	index = frame.index;
+	if (pool!=NULL) pool->retain(index);
+}
+
+FrameHandle::~FrameHandle() {
+	release();
+}
+
+FrameHandle& FrameHandle::operator=(const FrameHandle &frame) {
+	if (frame.pool!=NULL) frame.pool->retain(frame.index);
+	release();
+	pool  = frame.pool;
+	index = frame.index;
+	return *this;
+}
+
+unsigned char* FrameHandle::data() const {
+	if (pool==NULL) return NULL;
+	return pool->buffers[index];
+}
+
+int FrameHandle::size() const {
+	if (pool==NULL) return 0;
+	return pool->size;
+}
+
+long FrameHandle::number() const {
+	if (pool==NULL) return -1;
+	return pool->numbers[index];
+}
+
+void FrameHandle::setNumber(long n) {
+	if (pool!=NULL) pool->numbers[index] = n;
+}
+
+void FrameHandle::release() {
+	if (pool!=NULL) pool->release(index);
+	pool  = NULL;
+	index = -1;
+}
+
+
+FramePool::FramePool(int frameSize, int frameCount) {
+	size = frameSize;
+	refs = new std::atomic<int>[frameCount];
+	for (int i=0;i<frameCount;i++) {
+		buffers.push_back(new unsigned char[size]);
+		numbers.push_back(-1);
+		refs[i] = 0;
+		freeList.push_back(i);
+	}
+}
+
+FramePool::~FramePool() {
+	// every handle must have been released by now
+	for (unsigned int i=0;i<buffers.size();i++)
+		delete [] buffers[i];
+	delete [] refs;
+}
+
+FrameHandle FramePool::acquire() {
+	std::lock_guard<std::mutex> lock(freeMutex);
+	if (freeList.empty()) return FrameHandle();
+
+	int index = freeList.back();
+	freeList.pop_back();
+	refs[index] = 1;
+	numbers[index] = -1;
+	return FrameHandle(this, index);
+}
+
+FrameHandle FramePool::acquire(int timeout) {
+	std::unique_lock<std::mutex> lock(freeMutex);
+	if (!freed.wait_for(lock, std::chrono::milliseconds(timeout), [this]{ return !freeList.empty(); }))
+		return FrameHandle();
+
+	int index = freeList.back();
+	freeList.pop_back();
+	refs[index] = 1;
+	numbers[index] = -1;
+	return FrameHandle(this, index);
+}
+
+int FramePool::freeCount() {
+	std::lock_guard<std::mutex> lock(freeMutex);
+	return (int)freeList.size();
+}
+
+void FramePool::retain(int index) {
+	refs[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+void FramePool::release(int index) {
+	// the last holder hands the buffer (and its writes) back to the pool
+	if (refs[index].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		{
+			std::lock_guard<std::mutex> lock(freeMutex);
+			freeList.push_back(index);
+		}
+		freed.notify_one();
+	}
+}
@@ -0,0 +1,90 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef FRAMEPOOL_H
+#define FRAMEPOOL_H
+
+#include <stddef.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+class FramePool;
+
+// a reference counted handle to a frame buffer of a pool;
+// the buffer returns to the pool when its last handle is released
+class FrameHandle
+{
+public:
+	FrameHandle();
+	FrameHandle(const FrameHandle &frame);
+	~FrameHandle();
+
+	FrameHandle& operator=(const FrameHandle &frame);
+
+	bool isNull() const { return pool == NULL; }
+	unsigned char* data() const;
+	int size() const;
+	long number() const;
+	void setNumber(long n);
+	void release();
+
+private:
+	friend class FramePool;
+	FrameHandle(FramePool *p, int i);
+
+	FramePool *pool;
+	int index;
+};
+
+// a fixed set of equally sized frame buffers, handed out by handle
+// so that a frame is written once and then shared without copying
+class FramePool
+{
+public:
+	FramePool(int frameSize, int frameCount);
+	~FramePool();
+
+	FrameHandle acquire();
+	// waits up to timeout ms for a buffer to come back if none is free
+	FrameHandle acquire(int timeout);
+
+	int frameSize() const { return size; }
+	int frameCount() const { return (int)buffers.size(); }
+	int freeCount();
+
+private:
+	friend class FrameHandle;
+	void retain(int index);
+	void release(int index);
+
+	int size;
+	std::vector<unsigned char*> buffers;
+	std::vector<long> numbers;
+	std::atomic<int> *refs;
+
+	std::mutex freeMutex;
+	std::condition_variable freed;
+	std::vector<int> freeList;
+
+	FramePool(const FramePool &);
+	FramePool& operator=(const FramePool &);
+};
+
+#endif
@@ -50,6 +50,13 @@ public:
 
 	virtual void process(unsigned char *src, unsigned char *dest) = 0;
 	
+	// a stage that keeps no state between rows may be split into tiles of
+	// rows [firstRow, lastRow) processed on several threads at once
+	virtual bool isTileable() { return false; };
+	virtual void processTile(unsigned char *src, unsigned char *dest, int firstRow, int lastRow) {
+		if (firstRow==0 && lastRow==height) process(src, dest);
+	};
+	
 	virtual void finish() {};
 	virtual void setFlag(int flag, bool value) {};
 	virtual void toggleFlag(int flag) {};
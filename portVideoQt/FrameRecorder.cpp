@@ -0,0 +1,184 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "FrameRecorder.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define RECORDER_POLL_MS 50
+
+FrameRecorder::FrameRecorder(int width, int height, int bytes, int queueFrames) {
+	this->width = width;
+	this->height = height;
+	this->bytes = bytes;
+	frameSize = width*height*bytes;
+
+	// one frame more than the queue holds, for the one being written
+	pool = new FramePool(frameSize+(int)sizeof(long long), queueFrames+1);
+	queue = new RingBuffer(queueFrames, RingBuffer::LOSSLESS);
+
+	recording = false;
+	capacity = 0;
+	chunkFrames = RECORDER_CHUNK_FRAMES;
+	failed = false;
+	recordedCount = 0;
+	droppedCount = 0;
+}
+
+FrameRecorder::~FrameRecorder() {
+	stop();
+	delete queue;
+	delete pool;
+}
+
+bool FrameRecorder::start(const char *path, int chunkFrames) {
+	if (recording) return false;
+
+	this->chunkFrames = (chunkFrames<1)?1:chunkFrames;
+	capacity = this->chunkFrames;
+	if (!file.create(path, RECORDING_DATA_OFFSET+capacity*frameSize, RECORDING_DATA_OFFSET)) {
+		printf("could not create recording %s\n", path);
+		return false;
+	}
+	// the frames are written a chunk at a time, through a window over it
+	file.setWindowSize((size_t)this->chunkFrames*frameSize);
+
+	RecordingHeader *header = (RecordingHeader*)file.head();
+	memcpy(header->magic, "PVRC", 4);
+	header->version = RECORDING_VERSION;
+	header->width = width;
+	header->height = height;
+	header->bytes = bytes;
+	header->frameSize = frameSize;
+	header->dataOffset = RECORDING_DATA_OFFSET;
+	header->frameCount = 0;
+
+	index.clear();
+	index.reserve(this->chunkFrames);
+	failed = false;
+	recordedCount = 0;
+	droppedCount = 0;
+
+	recording = true;
+	writer = std::thread(&FrameRecorder::writeLoop, this);
+	return true;
+}
+
+bool FrameRecorder::stop() {
+	{
+		// no frame is queued after this, so the writer can drain the queue
+		std::lock_guard<std::mutex> lock(recordMutex);
+		if (!recording) return false;
+		recording = false;
+	}
+	writer.join();
+	return finish();
+}
+
+bool FrameRecorder::record(const unsigned char *frame, long number, long long timestamp) {
+	std::lock_guard<std::mutex> lock(recordMutex);
+	if (!recording) return false;
+
+	FrameHandle queued = pool->acquire();
+	if (queued.isNull()) {
+		droppedCount++;
+		return false;
+	}
+	memcpy(queued.data(), frame, frameSize);
+	memcpy(queued.data()+frameSize, &timestamp, sizeof(long long));
+	queued.setNumber(number);
+	if (!queue->write(queued)) {
+		droppedCount++;
+		return false;
+	}
+	return true;
+}
+
+void FrameRecorder::writeLoop() {
+	FrameHandle frame;
+	for (;;) {
+		if (queue->waitRead(frame, RECORDER_POLL_MS)) {
+			if (!append(frame)) droppedCount++;
+			frame.release();
+		} else if (!recording) {
+			// stopped: whatever was queued before is still to be written
+			while (queue->read(frame)) {
+				if (!append(frame)) droppedCount++;
+				frame.release();
+			}
+			return;
+		}
+	}
+}
+
+bool FrameRecorder::append(const FrameHandle &frame) {
+	if (failed) return false;
+
+	long long count = (long long)index.size();
+	if (count==capacity) {
+		// grow by a chunk, whose first frame then moves the window onto it
+		if (!file.resize(RECORDING_DATA_OFFSET+(capacity+chunkFrames)*frameSize)) {
+			printf("recording stopped growing after %lld frames\n", count);
+			failed = true;
+			return false;
+		}
+		capacity += chunkFrames;
+	}
+
+	unsigned char *dest = file.view(RECORDING_DATA_OFFSET+count*frameSize, frameSize);
+	if (dest==NULL) {
+		printf("recording could not map frame %lld\n", count);
+		failed = true;
+		return false;
+	}
+	memcpy(dest, frame.data(), frameSize);
+	RecordingIndexEntry entry;
+	entry.number = frame.number();
+	memcpy(&entry.timestamp, frame.data()+frameSize, sizeof(long long));
+	index.push_back(entry);
+	((RecordingHeader*)file.head())->frameCount = count+1;
+	recordedCount++;
+	return true;
+}
+
+bool FrameRecorder::finish() {
+	if (!file.isOpen()) return false;
+
+	long long count = (long long)index.size();
+	long long indexOffset = RECORDING_DATA_OFFSET+count*frameSize;
+	long long indexSize = count*(long long)sizeof(RecordingIndexEntry);
+	long long finalSize = indexOffset+indexSize+(long long)sizeof(RecordingTrailer);
+	unsigned char *dest = NULL;
+	if (file.resize(finalSize)) dest = file.view(indexOffset, (size_t)(finalSize-indexOffset));
+	if (dest==NULL) {
+		// the frames are kept, numbered by position
+		file.close(indexOffset);
+		return false;
+	}
+
+	if (count>0) memcpy(dest, &index[0], (size_t)indexSize);
+	RecordingTrailer trailer;
+	memcpy(trailer.magic, "PVRI", 4);
+	trailer.version = RECORDING_VERSION;
+	trailer.frameCount = count;
+	trailer.indexOffset = indexOffset;
+	memcpy(dest+indexSize, &trailer, sizeof(RecordingTrailer));
+	file.close(finalSize);
+	return true;
+}
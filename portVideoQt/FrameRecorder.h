@@ -0,0 +1,89 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef FRAMERECORDER_H
+#define FRAMERECORDER_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FramePool.h"
+#include "RingBuffer.h"
+#include "FrameRecording.h"
+
+#define RECORDER_QUEUE_FRAMES 32	// frames the disk may fall behind by
+#define RECORDER_CHUNK_FRAMES 64	// frames the file grows by (and maps) at a time
+
+// records a capture session into a single file (see FrameRecording):
+// record() only copies the frame into a queue, and a writer thread of
+// its own copies it on into the file, which is allocated a chunk of frames
+// ahead and written through a window mapped over the chunk being filled,
+// so the camera never waits on the disk and the mapping never grows with
+// the file; a frame is dropped (and counted) only when the queue is full
+class FrameRecorder
+{
+public:
+	FrameRecorder(int width, int height, int bytes, int queueFrames = RECORDER_QUEUE_FRAMES);
+	~FrameRecorder();
+
+	bool start(const char *path, int chunkFrames = RECORDER_CHUNK_FRAMES);
+	// writes the queued frames and the index, and cuts the file to size
+	bool stop();
+	bool isRecording() const { return recording; }
+
+	// called by the capture thread, with the camera time in microseconds
+	bool record(const unsigned char *frame, long number, long long timestamp);
+
+	long getRecorded() const { return recordedCount; }
+	long getDropped() const { return droppedCount; }
+
+private:
+	void writeLoop();
+	bool append(const FrameHandle &frame);
+	bool finish();
+
+	int width;
+	int height;
+	int bytes;
+	int frameSize;
+
+	// each queued frame carries its timestamp after the pixels
+	FramePool *pool;
+	RingBuffer *queue;
+
+	std::mutex recordMutex;
+	std::atomic<bool> recording;
+	std::thread writer;
+
+	// owned by the writer thread while recording
+	MappedFile file;
+	std::vector<RecordingIndexEntry> index;
+	long long capacity;
+	int chunkFrames;
+	bool failed;
+
+	std::atomic<long> recordedCount;
+	std::atomic<long> droppedCount;
+
+	FrameRecorder(const FrameRecorder &);
+	FrameRecorder& operator=(const FrameRecorder &);
+};
+
+#endif
@@ -0,0 +1,119 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "FrameRecording.h"
+
+#include <stdio.h>
+#include <string.h>
+
+FrameRecording::FrameRecording() {
+	header = NULL;
+	indexed = false;
+	frameCount = 0;
+}
+
+FrameRecording::~FrameRecording() {
+	close();
+}
+
+bool FrameRecording::isRecording(const char *path) {
+	FILE *file = fopen(path, "rb");
+	if (file==NULL) return false;
+	char magic[4];
+	bool found = fread(magic, 1, 4, file)==4 && memcmp(magic, "PVRC", 4)==0;
+	fclose(file);
+	return found;
+}
+
+bool FrameRecording::open(const char *path) {
+	close();
+	if (!file.openRead(path, RECORDING_DATA_OFFSET)) return false;
+
+	const RecordingHeader *head = (const RecordingHeader*)file.head();
+	long long size = file.size();
+	if (size<(long long)sizeof(RecordingHeader) || memcmp(head->magic, "PVRC", 4)!=0 || head->version!=RECORDING_VERSION
+		|| head->width<=0 || head->height<=0 || (head->bytes!=1 && head->bytes!=3)
+		|| head->frameSize!=head->width*head->height*head->bytes
+		|| head->dataOffset<(long long)sizeof(RecordingHeader) || head->dataOffset>size) {
+		file.close();
+		return false;
+	}
+	header = head;
+	file.setWindowSize((size_t)RECORDING_WINDOW_FRAMES*head->frameSize);
+
+	// a finished recording ends with its index, right after the last frame
+	RecordingTrailer trailer;
+	const unsigned char *end = NULL;
+	if (size>=head->dataOffset+(long long)sizeof(RecordingTrailer))
+		end = file.view(size-(long long)sizeof(RecordingTrailer), sizeof(RecordingTrailer));
+	if (end!=NULL) memcpy(&trailer, end, sizeof(RecordingTrailer));
+	const unsigned char *entries = NULL;
+	if (end!=NULL && memcmp(trailer.magic, "PVRI", 4)==0 && trailer.version==RECORDING_VERSION
+		&& trailer.indexOffset==head->dataOffset+trailer.frameCount*head->frameSize
+		&& trailer.indexOffset+trailer.frameCount*(long long)sizeof(RecordingIndexEntry)+(long long)sizeof(RecordingTrailer)==size)
+		entries = file.view(trailer.indexOffset, (size_t)(trailer.frameCount*sizeof(RecordingIndexEntry)));
+	if (entries!=NULL) {
+		frameCount = (long)trailer.frameCount;
+		index.assign((const RecordingIndexEntry*)entries, (const RecordingIndexEntry*)entries+frameCount);
+		indexed = true;
+	} else {
+		// otherwise keep the frames known to have been written in full
+		long long written = (size-head->dataOffset)/head->frameSize;
+		frameCount = (long)((head->frameCount<written)?head->frameCount:written);
+	}
+	return true;
+}
+
+void FrameRecording::close() {
+	file.close();
+	header = NULL;
+	index.clear();
+	indexed = false;
+	frameCount = 0;
+}
+
+const unsigned char* FrameRecording::frame(long i) const {
+	if (i<0 || i>=frameCount) return NULL;
+	return file.view(header->dataOffset+(long long)i*header->frameSize, header->frameSize);
+}
+
+long FrameRecording::frameNumber(long i) const {
+	if (!indexed) return i;
+	return (long)index[i].number;
+}
+
+long long FrameRecording::timestamp(long i) const {
+	if (!indexed) return -1;
+	return index[i].timestamp;
+}
+
+long FrameRecording::findFrame(long number) const {
+	if (!indexed) {
+		if (number<0) number = 0;
+		return (number<frameCount)?number:-1;
+	}
+
+	// the camera numbers its frames in order (skipping dropped ones)
+	long low = 0, high = frameCount;
+	while (low<high) {
+		long middle = low+(high-low)/2;
+		if (index[middle].number<number) low = middle+1;
+		else high = middle;
+	}
+	return (low<frameCount)?low:-1;
+}
@@ -0,0 +1,99 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef FRAMERECORDING_H
+#define FRAMERECORDING_H
+
+#include <vector>
+
+#include "MappedFile.h"
+
+#define RECORDING_VERSION 1
+#define RECORDING_DATA_OFFSET 4096	// the frames start a page into the file
+#define RECORDING_WINDOW_FRAMES 64	// frames mapped at a time when reading
+
+// a recording is one file: this header, the frames back to back from
+// dataOffset on, then an index entry per frame and the trailer last;
+// the index and trailer are only written once a recording is stopped
+struct RecordingHeader {
+	char magic[4];			// "PVRC"
+	int version;
+	int width;
+	int height;
+	int bytes;				// per pixel
+	int frameSize;
+	long long dataOffset;
+	long long frameCount;	// kept up to date while recording
+};
+
+struct RecordingIndexEntry {
+	long long number;		// the camera frame number
+	long long timestamp;	// the camera time, in microseconds
+};
+
+struct RecordingTrailer {
+	char magic[4];			// "PVRI"
+	int version;
+	long long frameCount;
+	long long indexOffset;
+};
+
+// reads a recording written by FrameRecorder through a window mapped over
+// the frames asked for, so that any frame can be reached directly, by
+// position or by camera frame number (the index is read in once); a
+// recording cut short (without its index) still plays, but its frames
+// are numbered by position and have no timestamps
+class FrameRecording
+{
+public:
+	FrameRecording();
+	~FrameRecording();
+
+	bool open(const char *path);
+	void close();
+
+	bool isOpen() const { return header!=NULL; }
+	bool hasIndex() const { return indexed; }
+	int getWidth() const { return header->width; }
+	int getHeight() const { return header->height; }
+	int getBytes() const { return header->bytes; }
+	int getFrameSize() const { return header->frameSize; }
+	long getFrameCount() const { return frameCount; }
+
+	// valid until the next frame is asked for, NULL for a frame out of range
+	const unsigned char* frame(long i) const;
+	long frameNumber(long i) const;
+	// -1 if unknown
+	long long timestamp(long i) const;
+	// the position of the first frame numbered number or later, -1 if none
+	long findFrame(long number) const;
+
+	static bool isRecording(const char *path);
+
+private:
+	mutable MappedFile file;
+	const RecordingHeader *header;
+	std::vector<RecordingIndexEntry> index;
+	bool indexed;
+	long frameCount;
+
+	FrameRecording(const FrameRecording &);
+	FrameRecording& operator=(const FrameRecording &);
+};
+
+#endif
@@ -0,0 +1,258 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "MappedFile.h"
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() {
+	headMapping = NULL;
+	headSize = 0;
+	headLength = 0;
+	window = NULL;
+	windowOffset = 0;
+	windowLength = 0;
+	windowSize = MAPPED_WINDOW_SIZE;
+	fileSize = 0;
+	writable = false;
+	sequential = false;
+#ifdef WIN32
+	// views start on a multiple of the allocation granularity (not the page)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	granularity = info.dwAllocationGranularity;
+	fileHandle = INVALID_HANDLE_VALUE;
+#else
+	granularity = (size_t)sysconf(_SC_PAGESIZE);
+	fileHandle = -1;
+#endif
+	headHandle = NULL;
+	windowHandle = NULL;
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+bool MappedFile::isOpen() const {
+#ifdef WIN32
+	return fileHandle!=INVALID_HANDLE_VALUE;
+#else
+	return fileHandle>=0;
+#endif
+}
+
+bool MappedFile::openRead(const char *path, size_t headSize) {
+	close();
+	writable = false;
+	this->headSize = headSize;
+#ifdef WIN32
+	fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (fileHandle==INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx((HANDLE)fileHandle, &size)) {
+		close();
+		return false;
+	}
+	fileSize = size.QuadPart;
+#else
+	fileHandle = open(path, O_RDONLY);
+	if (fileHandle<0) return false;
+	struct stat info;
+	if (fstat(fileHandle, &info)!=0) {
+		close();
+		return false;
+	}
+	fileSize = (long long)info.st_size;
+#endif
+	if (fileSize==0 || !mapHead()) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool MappedFile::create(const char *path, long long size, size_t headSize) {
+	close();
+	writable = true;
+	this->headSize = headSize;
+#ifdef WIN32
+	fileHandle = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (fileHandle==INVALID_HANDLE_VALUE) return false;
+#else
+	fileHandle = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fileHandle<0) return false;
+#endif
+	if (!resize(size)) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool MappedFile::resize(long long size) {
+	if (!writable || size<0) return false;
+#ifdef WIN32
+	// a file cannot change size while any of it is mapped, but only the
+	// head and one window are, so this costs the same however large it is
+	unmapWindow();
+	unmapHead();
+	LARGE_INTEGER end;
+	end.QuadPart = (LONGLONG)size;
+	if (!SetFilePointerEx((HANDLE)fileHandle, end, NULL, FILE_BEGIN) || !SetEndOfFile((HANDLE)fileHandle))
+		return false;
+#else
+	if (ftruncate(fileHandle, (off_t)size)!=0) return false;
+#ifdef __linux__
+	// allocate the blocks grown by now rather than on the first write to each page
+	if (size>fileSize && posix_fallocate(fileHandle, (off_t)fileSize, (off_t)(size-fileSize))!=0) return false;
+#endif
+	// a window reaching past a shorter end would fault on access
+	if (window!=NULL && windowOffset+(long long)windowLength>size) unmapWindow();
+	if (headMapping!=NULL && (long long)headLength>size) unmapHead();
+#endif
+	fileSize = size;
+	return headMapping!=NULL || mapHead();
+}
+
+void MappedFile::setWindowSize(size_t size) {
+	windowSize = (size<1)?1:size;
+}
+
+unsigned char* MappedFile::view(long long offset, size_t length) {
+	if (!isOpen() || offset<0 || offset+(long long)length>fileSize) return NULL;
+
+	if (window==NULL || offset<windowOffset || offset+(long long)length>windowOffset+(long long)windowLength) {
+		unmapWindow();
+		// from the granularity at or below offset, for at least a window
+		long long start = offset-offset%(long long)granularity;
+		long long end = offset+(long long)((length>windowSize)?length:windowSize);
+		end = (end+(long long)granularity-1)/(long long)granularity*(long long)granularity;
+		if (end>fileSize) end = fileSize;
+		window = mapRange(start, (size_t)(end-start), &windowHandle);
+		if (window==NULL) return NULL;
+		windowOffset = start;
+		windowLength = (size_t)(end-start);
+	}
+	return window+(offset-windowOffset);
+}
+
+bool MappedFile::mapHead() {
+	if (headSize==0) return true;
+	headLength = ((long long)headSize<fileSize)?headSize:(size_t)fileSize;
+	if (headLength==0) return true;
+	headMapping = mapRange(0, headLength, &headHandle);
+	return headMapping!=NULL;
+}
+
+unsigned char* MappedFile::mapRange(long long offset, size_t length, void **handle) {
+#ifdef WIN32
+	// a mapping object as long as the view needs, so it never grows the file
+	LARGE_INTEGER end;
+	end.QuadPart = (LONGLONG)(offset+(long long)length);
+	*handle = CreateFileMappingA((HANDLE)fileHandle, NULL, writable?PAGE_READWRITE:PAGE_READONLY,
+		end.HighPart, end.LowPart, NULL);
+	if (*handle==NULL) return NULL;
+	LARGE_INTEGER start;
+	start.QuadPart = (LONGLONG)offset;
+	void *data = MapViewOfFile((HANDLE)*handle, writable?FILE_MAP_WRITE:FILE_MAP_READ, start.HighPart, start.LowPart, length);
+	if (data==NULL) {
+		CloseHandle((HANDLE)*handle);
+		*handle = NULL;
+		return NULL;
+	}
+#else
+	*handle = NULL;
+	void *data = mmap(NULL, length, writable?(PROT_READ | PROT_WRITE):PROT_READ, MAP_SHARED, fileHandle, (off_t)offset);
+	if (data==MAP_FAILED) return NULL;
+	if (sequential) madvise(data, length, MADV_SEQUENTIAL);
+#endif
+	return (unsigned char*)data;
+}
+
+void MappedFile::unmapRange(unsigned char *data, size_t length, void *handle) {
+#ifdef WIN32
+	(void)length;
+	UnmapViewOfFile(data);
+	CloseHandle((HANDLE)handle);
+#else
+	(void)handle;
+	munmap(data, length);
+#endif
+}
+
+void MappedFile::unmapWindow() {
+	if (window==NULL) return;
+	unmapRange(window, windowLength, windowHandle);
+	windowHandle = NULL;
+	window = NULL;
+	windowOffset = 0;
+	windowLength = 0;
+}
+
+void MappedFile::unmapHead() {
+	if (headMapping==NULL) return;
+	unmapRange(headMapping, headLength, headHandle);
+	headHandle = NULL;
+	headMapping = NULL;
+	headLength = 0;
+}
+
+void MappedFile::adviseSequential() {
+	sequential = true;
+#ifndef WIN32
+	if (window!=NULL) madvise(window, windowLength, MADV_SEQUENTIAL);
+#endif
+}
+
+void MappedFile::close(long long finalSize) {
+	unmapWindow();
+	unmapHead();
+#ifdef WIN32
+	if (fileHandle!=INVALID_HANDLE_VALUE) {
+		if (writable && finalSize>=0) {
+			LARGE_INTEGER end;
+			end.QuadPart = (LONGLONG)finalSize;
+			SetFilePointerEx((HANDLE)fileHandle, end, NULL, FILE_BEGIN);
+			SetEndOfFile((HANDLE)fileHandle);
+		}
+		CloseHandle((HANDLE)fileHandle);
+		fileHandle = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (fileHandle>=0) {
+		if (writable && finalSize>=0 && ftruncate(fileHandle, (off_t)finalSize)!=0)
+			perror("could not cut the file down");
+		::close(fileHandle);
+		fileHandle = -1;
+	}
+#endif
+	fileSize = 0;
+	headSize = 0;
+	writable = false;
+	sequential = false;
+}
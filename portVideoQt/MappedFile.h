@@ -0,0 +1,91 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <stddef.h>
+
+#define MAPPED_WINDOW_SIZE (64*1024*1024)	// bytes mapped at a time by default
+
+// a file mapped into memory a window at a time, either read only or
+// read/write at a size that can be changed: only its head (the first bytes,
+// mapped while the file is open) and one window over the rest are mapped at
+// once, so the address space taken does not grow with the file; the window
+// slides to wherever view() is asked for
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	// opens the file, mapping the first headSize bytes of it
+	bool openRead(const char *path, size_t headSize = 0);
+	// creates (or truncates) the file at the given size, mapping its head
+	bool create(const char *path, long long size, size_t headSize = 0);
+	// changes the size of the file, which may move the head
+	bool resize(long long size);
+	// unmaps the file, first cutting a writable one down to the given size
+	void close(long long finalSize = -1);
+	// hints that the windows are read front to back
+	void adviseSequential();
+	// the bytes mapped at a time (rounded up to the mapping granularity)
+	void setWindowSize(size_t size);
+
+	// the length bytes at offset, mapping a window over them first unless
+	// the current one holds them; valid until the window moves, NULL if
+	// they lie past the end of the file or cannot be mapped
+	unsigned char* view(long long offset, size_t length);
+
+	bool isOpen() const;
+	bool isWritable() const { return writable; }
+	unsigned char* head() const { return headMapping; }
+	long long size() const { return fileSize; }
+
+private:
+	bool mapHead();
+	void unmapWindow();
+	void unmapHead();
+	unsigned char* mapRange(long long offset, size_t length, void **handle);
+	void unmapRange(unsigned char *data, size_t length, void *handle);
+
+	unsigned char *headMapping;
+	size_t headSize;
+	size_t headLength;
+	unsigned char *window;
+	long long windowOffset;
+	size_t windowLength;
+	size_t windowSize;
+	size_t granularity;
+	long long fileSize;
+	bool writable;
+	bool sequential;
+#ifdef WIN32
+	void *fileHandle;
+#else
+	int fileHandle;
+#endif
+	// the mapping objects of the views (only used on Windows)
+	void *headHandle;
+	void *windowHandle;
+
+	MappedFile(const MappedFile &);
+	MappedFile& operator=(const MappedFile &);
+};
+
+#endif
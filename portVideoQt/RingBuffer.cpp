@@ -18,59 +18,144 @@
 
 #include "RingBuffer.h"
 
-RingBuffer::RingBuffer(int size) {
-	readIndex  = 0;
-	writeIndex = 0;
-	bufferSize = size;
+#include <chrono>
+#include <thread>
+
+RingBuffer::RingBuffer(int depth, Mode mode) {
+	slotCount = (depth<2)?2:depth;
+	ringMode  = mode;
+	
+	// slot i is free for the write at position i
+	slots = new Slot[slotCount];
+	for (int i=0;i<slotCount;i++)
+		slots[i].sequence.store(i, std::memory_order_relaxed);
 	
-	buffer[0] = new unsigned char[bufferSize];
-	buffer[1] = new unsigned char[bufferSize];
-	buffer[2] = new unsigned char[bufferSize];
+	writePos     = 0;
+	readPos      = 0;
+	dropCount    = 0;
+	readWaiters  = 0;
+	writeWaiters = 0;
 }
 
 
 RingBuffer::~RingBuffer() {
+	delete [] slots;
+}
 
-	delete [] buffer[0];
-	delete [] buffer[1];
-	delete [] buffer[2];
-
+// stores the frame unless the slot at the write position is still taken
+bool RingBuffer::push(const FrameHandle &frame) {
+	unsigned long long pos = writePos.load(std::memory_order_relaxed);
+	Slot &slot = slots[ pos % slotCount ];
+	if( slot.sequence.load(std::memory_order_acquire) != pos )
+		return false;
+	
+	slot.frame = frame;
+	slot.sequence.store(pos + 1, std::memory_order_release);
+	writePos.store(pos + 1, std::memory_order_relaxed);
+	return true;
 }
 
-int RingBuffer::size() {
-	return bufferSize;
+// claims the oldest frame; the writer may race the reader for it
+// when dropping, hence the compare and swap
+bool RingBuffer::pop(FrameHandle &frame) {
+	unsigned long long pos = readPos.load(std::memory_order_relaxed);
+	for(;;) {
+		Slot &slot = slots[ pos % slotCount ];
+		unsigned long long seq = slot.sequence.load(std::memory_order_acquire);
+		if( seq != pos + 1 ) {
+			if( seq <= pos )
+				return false;	// empty
+			pos = readPos.load(std::memory_order_relaxed);
+			continue;			// lost the race, try the next one
+		}
+		if( readPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed) ) {
+			frame = slot.frame;
+			slot.frame.release();
+			slot.sequence.store(pos + slotCount, std::memory_order_release);
+			return true;
+		}
+	}
 }
 
-int RingBuffer::nextIndex( int index ) {
-	if( index >= 2 )
-		return 0;
-	else
-		return index + 1;
+void RingBuffer::wake(std::atomic<int> &waiters, std::condition_variable &cond) {
+	// pairs with the fence in the waiting thread, so either it sees
+	// our change or we see it waiting
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if( waiters.load(std::memory_order_relaxed) > 0 ) {
+		{ std::lock_guard<std::mutex> lock(waitMutex); }
+		cond.notify_all();
+	}
 }
 
-unsigned char* RingBuffer::getNextBufferToWrite() {
-	int nextWriteIndex = nextIndex( writeIndex );
-	if( nextWriteIndex == readIndex ){
-		return NULL;
-	}else{
-		return buffer[ nextWriteIndex ];
+bool RingBuffer::write(const FrameHandle &frame) {
+	bool written = push(frame);
+	if( !written && ringMode==LATEST_FRAME ) {
+		FrameHandle oldest;
+		if( pop(oldest) ) dropCount++;
+		// the reader may still be finishing the slot we need
+		while( !(written = push(frame)) )
+			std::this_thread::yield();
 	}
+	
+	if( written ) wake(readWaiters, readable);
+	return written;
 }
 
-void RingBuffer::writeFinished() {
-	writeIndex = nextIndex( writeIndex );
+bool RingBuffer::read(FrameHandle &frame) {
+	if( !pop(frame) ) return false;
+	wake(writeWaiters, writable);
+	return true;
 }
 
+bool RingBuffer::readLatest(FrameHandle &frame) {
+	if( !pop(frame) ) return false;
+	while( pop(frame) ) dropCount++;
+	wake(writeWaiters, writable);
+	return true;
+}
 
-unsigned char* RingBuffer::getNextBufferToRead() {
-	if( readIndex == writeIndex ){
-		return NULL;
-	}else{
-		int nextReadIndex = nextIndex( readIndex );
-		return buffer[ nextReadIndex ];
+bool RingBuffer::waitWrite(const FrameHandle &frame, int timeout) {
+	if( write(frame) ) return true;
+	
+	std::chrono::steady_clock::time_point deadline =
+		std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+	bool written;
+	{
+		std::unique_lock<std::mutex> lock(waitMutex);
+		writeWaiters++;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		while( !(written = push(frame)) ) {
+			if( writable.wait_until(lock, deadline) == std::cv_status::timeout ) {
+				written = push(frame);
+				break;
+			}
+		}
+		writeWaiters--;
 	}
+	
+	if( written ) wake(readWaiters, readable);
+	return written;
 }
 
-void RingBuffer::readFinished() {
-	readIndex = nextIndex( readIndex );
+bool RingBuffer::waitRead(FrameHandle &frame, int timeout) {
+	if( read(frame) ) return true;
+	
+	std::chrono::steady_clock::time_point deadline =
+		std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+	bool got;
+	{
+		std::unique_lock<std::mutex> lock(waitMutex);
+		readWaiters++;
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		while( !(got = pop(frame)) ) {
+			if( readable.wait_until(lock, deadline) == std::cv_status::timeout ) {
+				got = pop(frame);
+				break;
+			}
+		}
+		readWaiters--;
+	}
+	
+	if( got ) wake(writeWaiters, writable);
+	return got;
 }
@@ -26,26 +26,70 @@
 #include <stdlib.h>
 #endif
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "FramePool.h"
+
+#define RING_DEPTH 3
+
+// a lock-free single producer, single consumer queue of frames (by handle);
+// each slot carries a sequence number telling whose turn it is, so a slot
+// is only ever touched by the side that has claimed it
 class RingBuffer
 {
 public:
-	RingBuffer(int size);
+	enum Mode {
+		LATEST_FRAME,	// a full ring drops its oldest frame (control loop)
+		LOSSLESS		// a full ring refuses new frames (recording)
+	};
+
+	RingBuffer(int depth = RING_DEPTH, Mode mode = LATEST_FRAME);
 	~RingBuffer();
 	
-	int size();
+	int depth() const { return slotCount; }
+	Mode mode() const { return ringMode; }
+	long dropped() const { return dropCount; }
+	
+	// non-blocking; false if the frame was refused (lossless and full)
+	bool write(const FrameHandle &frame);
+	// non-blocking; false if the ring was empty
+	bool read(FrameHandle &frame);
+	// non-blocking; skips to the most recent frame, dropping the others
+	bool readLatest(FrameHandle &frame);
 	
-	unsigned char* getNextBufferToWrite();
-	void writeFinished();
-	unsigned char* getNextBufferToRead();
-	void readFinished();
+	// block for up to timeout ms until a frame (or a free slot) is available
+	bool waitWrite(const FrameHandle &frame, int timeout);
+	bool waitRead(FrameHandle &frame, int timeout);
 
 private:
-	int nextIndex( int index );
-	int bufferSize;
+	struct Slot {
+		std::atomic<unsigned long long> sequence;
+		FrameHandle frame;
+	};
+	
+	bool push(const FrameHandle &frame);
+	bool pop(FrameHandle &frame);
+	void wake(std::atomic<int> &waiters, std::condition_variable &cond);
+	
+	Slot *slots;
+	int slotCount;
+	Mode ringMode;
+	
+	std::atomic<unsigned long long> writePos;	// only the writer moves this
+	std::atomic<unsigned long long> readPos;	// claimed by compare and swap
+	std::atomic<long> dropCount;
+	
+	// only used to sleep on; the ring itself never takes this lock
+	std::mutex waitMutex;
+	std::condition_variable readable;
+	std::condition_variable writable;
+	std::atomic<int> readWaiters;
+	std::atomic<int> writeWaiters;
 	
-	unsigned char* buffer[3];
-	volatile char readIndex;
-	volatile char writeIndex;
+	RingBuffer(const RingBuffer &);
+	RingBuffer& operator=(const RingBuffer &);
 };
 
 #endif
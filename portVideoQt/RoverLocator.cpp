@@ -0,0 +1,406 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "RoverLocator.h"
+#include "ColourConverter.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+RoverLocator::RoverLocator(PoseFeed *feed) {
+	this->feed = feed;
+	motionFeed = NULL;
+	frameCount = 0;
+	fullScans = 0;
+
+	roiX = roiY = roiWidth = roiHeight = 0;
+	scale = LOCATOR_SCALE;
+	scaledWidth = scaledHeight = 0;
+
+	// red at the front, blue at the rear
+	frontColour[0] = 255; frontColour[1] = 0; frontColour[2] = 0;
+	rearColour[0]  = 0;   rearColour[1]  = 0; rearColour[2]  = 255;
+	tolerance  = LOCATOR_TOLERANCE;
+	minArea    = LOCATOR_MIN_AREA;
+	markerSpacing = LOCATOR_MARKER_SPACING;
+	spacingTolerance = LOCATOR_SPACING_TOLERANCE;
+	markRovers = true;
+	trackRovers = true;
+	trackRadius = LOCATOR_TRACK_RADIUS;
+
+	classes    = NULL;
+	labels     = NULL;
+	parent     = NULL;
+	labelClass = NULL;
+	area = sumX = sumY = NULL;
+	labelCount = 0;
+	frontCount = rearCount = 0;
+
+	motion = NULL;
+	trackCount = 0;
+
+	last.number = -1;
+	last.n = 0;
+}
+
+RoverLocator::~RoverLocator() {
+	freeBuffers();
+}
+
+void RoverLocator::freeBuffers() {
+	delete [] classes;    classes    = NULL;
+	delete [] labels;     labels     = NULL;
+	delete [] parent;     parent     = NULL;
+	delete [] labelClass; labelClass = NULL;
+	delete [] area;       area       = NULL;
+	delete [] sumX;       sumX       = NULL;
+	delete [] sumY;       sumY       = NULL;
+}
+
+bool RoverLocator::init(int w, int h, int sb, int db) {
+	FrameProcessor::init(w, h, sb, db);
+
+	// the markers are told apart by colour
+	if (sb!=3 || (db!=3 && db!=1)) {
+		printf("rover locator needs colour frames\n");
+		return false;
+	}
+
+	// clip the region to the frame
+	if (roiWidth<=0 || roiHeight<=0) {
+		roiX = roiY = 0;
+		roiWidth  = w;
+		roiHeight = h;
+	}
+	if (roiX<0) roiX = 0;
+	if (roiY<0) roiY = 0;
+	if (roiX+roiWidth>w)  roiWidth  = w-roiX;
+	if (roiY+roiHeight>h) roiHeight = h-roiY;
+	if (scale<1) scale = 1;
+
+	scaledWidth  = roiWidth/scale;
+	scaledHeight = roiHeight/scale;
+	if (scaledWidth<=0 || scaledHeight<=0) return false;
+
+	// everything a frame needs is allocated once, here
+	int pixels = scaledWidth*scaledHeight;
+	freeBuffers();
+	classes    = new unsigned char[pixels];
+	labels     = new int[pixels];
+	parent     = new int[pixels+1];
+	labelClass = new unsigned char[pixels+1];
+	area       = new int[pixels+1];
+	sumX       = new int[pixels+1];
+	sumY       = new int[pixels+1];
+
+	// start with a full scan
+	trackCount = 0;
+	return true;
+}
+
+void RoverLocator::setRegion(int x, int y, int w, int h) {
+	roiX = x;
+	roiY = y;
+	roiWidth  = w;
+	roiHeight = h;
+}
+
+void RoverLocator::setScale(int s) {
+	scale = s;
+}
+
+void RoverLocator::setMarkers(const unsigned char front[3], const unsigned char rear[3], int tolerance) {
+	memcpy(frontColour, front, 3);
+	memcpy(rearColour, rear, 3);
+	this->tolerance = tolerance;
+}
+
+void RoverLocator::setFlag(int flag, bool value) {
+	if (flag==MARK_ROVERS) markRovers = value;
+	else if (flag==TRACK_ROVERS) trackRovers = value;
+}
+
+void RoverLocator::toggleFlag(int flag) {
+	if (flag==MARK_ROVERS) markRovers = !markRovers;
+	else if (flag==TRACK_ROVERS) trackRovers = !trackRovers;
+}
+
+void RoverLocator::printOptions() {
+	printf("locator:  %dx%d+%d+%d at 1/%d scale", roiWidth, roiHeight, roiX, roiY, scale);
+	if (trackRovers) printf(", tracking within %d pixels", trackRadius);
+	printf("\n");
+}
+
+int RoverLocator::getLastPoses(PoseEstimate *poses, int max) {
+	std::lock_guard<std::mutex> lock(lastMutex);
+	int n = (last.n<max)?last.n:max;
+	memcpy(poses, last.estimates, n*sizeof(PoseEstimate));
+	return n;
+}
+
+void RoverLocator::process(unsigned char *src, unsigned char *dest) {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	double dt = std::chrono::duration<double>(now-trackTime).count();
+	if (motionFeed!=NULL) {
+		const PoseFrame *m = motionFeed->read();
+		if (m!=NULL) motion = m;
+	}
+
+	PoseFrame *frame = feed->getWriteFrame();
+	frame->number = frameCount++;
+
+	// follow the rovers already found, or look everywhere if one got away
+	if (!trackRovers || trackCount==0 || !track(src, frame, dt)) {
+		frame->n = locate(src, roiX, roiY, roiWidth, roiHeight, frame->estimates, MAX_POSE_ESTIMATES);
+		fullScans++;
+	}
+	trackCount = frame->n;
+	memcpy(tracks, frame->estimates, frame->n*sizeof(PoseEstimate));
+	trackTime = now;
+
+	{
+		std::lock_guard<std::mutex> lock(lastMutex);
+		last.number = frame->number;
+		last.n = frame->n;
+		memcpy(last.estimates, frame->estimates, frame->n*sizeof(PoseEstimate));
+	}
+
+	// pass the frame on, marking the rovers before the feed takes the frame
+	if (destBytes==srcBytes) memcpy(dest, src, srcSize);
+	else ColourConverter::convert(src, ColourConverter::RGB24, dest, ColourConverter::GRAY8, width, height);
+	if (markRovers) {
+		for (int i=0;i<frame->n;i++)
+			markRover(dest, frame->estimates[i]);
+	}
+	feed->publish();
+}
+
+int RoverLocator::locate(const unsigned char *src, int x, int y, int w, int h, PoseEstimate *poses, int max) {
+	// the rovers within the given window of the frame
+	int sw = w/scale, sh = h/scale;
+	if (sw<=0 || sh<=0) return 0;
+	classify(src, x, y, sw, sh);
+	label(x, y, sw, sh);
+	return pairMarkers(poses, max);
+}
+
+void RoverLocator::classify(const unsigned char *src, int x0, int y0, int sw, int sh) {
+	// one pixel from the middle of each scale x scale block
+	int rowSize = width*srcBytes;
+	const unsigned char *row = src + (y0+scale/2)*rowSize + (x0+scale/2)*srcBytes;
+	unsigned char *c = classes;
+	for (int y=0;y<sh;y++) {
+		const unsigned char *p = row;
+		for (int x=0;x<sw;x++) {
+			int df = abs(p[0]-frontColour[0]) + abs(p[1]-frontColour[1]) + abs(p[2]-frontColour[2]);
+			int dr = abs(p[0]-rearColour[0]) + abs(p[1]-rearColour[1]) + abs(p[2]-rearColour[2]);
+			if (df<=tolerance && df<=dr) *c = FRONT;
+			else if (dr<=tolerance) *c = REAR;
+			else *c = NONE;
+			c++;
+			p += scale*srcBytes;
+		}
+		row += scale*rowSize;
+	}
+}
+
+int RoverLocator::findRoot(int l) {
+	// path halving keeps the trees flat
+	while (parent[l]!=l) {
+		parent[l] = parent[parent[l]];
+		l = parent[l];
+	}
+	return l;
+}
+
+void RoverLocator::label(int x0, int y0, int sw, int sh) {
+	// first pass: provisional labels, joining those of the same class
+	// that meet above and to the left of a pixel
+	labelCount = 0;
+	for (int y=0;y<sh;y++) {
+		for (int x=0;x<sw;x++) {
+			int i = y*sw+x;
+			unsigned char c = classes[i];
+			if (c==NONE) { labels[i] = 0; continue; }
+
+			int left = (x>0 && classes[i-1]==c)?labels[i-1]:0;
+			int up   = (y>0 && classes[i-sw]==c)?labels[i-sw]:0;
+			if (left==0 && up==0) {
+				labels[i] = ++labelCount;
+				parent[labelCount] = labelCount;
+				labelClass[labelCount] = c;
+			} else if (left==0 || up==0) {
+				labels[i] = left+up;
+			} else {
+				int a = findRoot(left), b = findRoot(up);
+				if (a<b) parent[b] = a;
+				else if (b<a) parent[a] = b;
+				labels[i] = left;
+			}
+		}
+	}
+
+	// second pass: the area and centroid of each component
+	for (int l=1;l<=labelCount;l++) area[l] = sumX[l] = sumY[l] = 0;
+	for (int y=0;y<sh;y++) {
+		const int *row = labels + y*sw;
+		for (int x=0;x<sw;x++) {
+			if (row[x]==0) continue;
+			int l = findRoot(row[x]);
+			area[l]++;
+			sumX[l] += x;
+			sumY[l] += y;
+		}
+	}
+
+	// every big enough component is a marker, centred in frame pixels
+	frontCount = rearCount = 0;
+	for (int l=1;l<=labelCount;l++) {
+		if (parent[l]!=l || area[l]<minArea) continue;
+
+		Marker m;
+		m.x = x0 + ((float)sumX[l]/area[l] + 0.5f)*scale;
+		m.y = y0 + ((float)sumY[l]/area[l] + 0.5f)*scale;
+		if (labelClass[l]==FRONT && frontCount<LOCATOR_MAX_MARKERS) front[frontCount++] = m;
+		else if (labelClass[l]==REAR && rearCount<LOCATOR_MAX_MARKERS) rear[rearCount++] = m;
+	}
+}
+
+int RoverLocator::pairMarkers(PoseEstimate *poses, int max) {
+	// pair the front and rear markers left that are nearest to the marker
+	// spacing apart, until none are (the closest pair may well be the
+	// front of one rover and the rear of the rover ahead of it)
+	bool frontUsed[LOCATOR_MAX_MARKERS], rearUsed[LOCATOR_MAX_MARKERS];
+	memset(frontUsed, 0, sizeof(frontUsed));
+	memset(rearUsed, 0, sizeof(rearUsed));
+
+	int n = 0;
+	while (n<max) {
+		int bestFront = -1, bestRear = -1;
+		float bestError = (float)spacingTolerance;
+		for (int i=0;i<frontCount;i++) {
+			if (frontUsed[i]) continue;
+			for (int j=0;j<rearCount;j++) {
+				if (rearUsed[j]) continue;
+				float dx = front[i].x-rear[j].x, dy = front[i].y-rear[j].y;
+				float error = fabs(sqrtf(dx*dx+dy*dy)-markerSpacing);
+				if (error<=bestError) {
+					bestError = error;
+					bestFront = i;
+					bestRear  = j;
+				}
+			}
+		}
+		if (bestFront<0) break;
+		frontUsed[bestFront] = rearUsed[bestRear] = true;
+
+		// the rover sits between its markers, facing the front one
+		// (counterclockwise from +x, with the frame y pointing down)
+		const Marker &f = front[bestFront], &r = rear[bestRear];
+		PoseEstimate &pose = poses[n++];
+		pose.x = 0.5f*(f.x+r.x);
+		pose.y = 0.5f*(f.y+r.y);
+		pose.heading = (float)(atan2(r.y-f.y, f.x-r.x)*180.0/M_PI);
+		if (pose.heading<0) pose.heading += 360.0f;
+		pose.transVel = 0;
+		pose.rotVel = 0;
+	}
+	return n;
+}
+
+bool RoverLocator::track(const unsigned char *src, PoseFrame *frame, double dt) {
+	// search a window around where each rover should be by now,
+	// giving up (for a full scan) as soon as one is not there
+	PoseEstimate found[MAX_POSE_ESTIMATES];
+	frame->n = 0;
+	for (int t=0;t<trackCount;t++) {
+		PoseEstimate expected = predict(tracks[t], dt);
+
+		int x0 = (int)expected.x-trackRadius, y0 = (int)expected.y-trackRadius;
+		int x1 = (int)expected.x+trackRadius, y1 = (int)expected.y+trackRadius;
+		if (x0<roiX) x0 = roiX;
+		if (y0<roiY) y0 = roiY;
+		if (x1>roiX+roiWidth)  x1 = roiX+roiWidth;
+		if (y1>roiY+roiHeight) y1 = roiY+roiHeight;
+		if (x1<=x0 || y1<=y0) return false;
+
+		int n = locate(src, x0, y0, x1-x0, y1-y0, found, MAX_POSE_ESTIMATES);
+		int best = -1;
+		float bestSqr = (float)trackRadius*trackRadius*2;
+		for (int i=0;i<n;i++) {
+			float dx = found[i].x-expected.x, dy = found[i].y-expected.y;
+			if (dx*dx+dy*dy<bestSqr) {
+				bestSqr = dx*dx+dy*dy;
+				best = i;
+			}
+		}
+		if (best<0) return false;
+
+		// two tracks on one rover leave another rover untracked
+		for (int i=0;i<frame->n;i++) {
+			float dx = frame->estimates[i].x-found[best].x, dy = frame->estimates[i].y-found[best].y;
+			if (dx*dx+dy*dy<0.25f*markerSpacing*markerSpacing) return false;
+		}
+		frame->estimates[frame->n++] = found[best];
+	}
+	return true;
+}
+
+PoseEstimate RoverLocator::predict(const PoseEstimate &pose, double dt) {
+	// drive the rover on at the velocities commanded to the
+	// closest expected pose, or leave it be if there is none
+	float transVel = 0, rotVel = 0;
+	if (motion!=NULL) {
+		float bestSqr = (float)trackRadius*trackRadius;
+		for (int i=0;i<motion->n;i++) {
+			const PoseEstimate &m = motion->estimates[i];
+			float dx = m.x-pose.x, dy = m.y-pose.y;
+			if (dx*dx+dy*dy<bestSqr) {
+				bestSqr = dx*dx+dy*dy;
+				transVel = m.transVel;
+				rotVel = m.rotVel;
+			}
+		}
+	}
+
+	PoseEstimate expected = pose;
+	double heading = (pose.heading + 0.5*rotVel*dt)*M_PI/180.0;
+	expected.x += (float)(transVel*dt*cos(heading));
+	expected.y -= (float)(transVel*dt*sin(heading));
+	expected.heading = (float)fmod(pose.heading + rotVel*dt + 360.0, 360.0);
+	expected.transVel = transVel;
+	expected.rotVel = rotVel;
+	return expected;
+}
+
+void RoverLocator::markRover(unsigned char *dest, const PoseEstimate &pose) {
+	// a white cross on the centre of the rover
+	int cx = (int)pose.x, cy = (int)pose.y;
+	for (int d=-5;d<=5;d++) {
+		int x = cx+d, y = cy+d;
+		if (x>=0 && x<width && cy>=0 && cy<height)
+			memset(dest + (cy*width+x)*destBytes, 255, destBytes);
+		if (y>=0 && y<height && cx>=0 && cx<width)
+			memset(dest + (y*width+cx)*destBytes, 255, destBytes);
+	}
+}
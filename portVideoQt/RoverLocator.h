@@ -0,0 +1,126 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef ROVERLOCATOR_H
+#define ROVERLOCATOR_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#include "FrameProcessor.h"
+#include "../ross/PoseFeed.h"
+
+#define LOCATOR_SCALE 4			// classify one pixel in every 4x4
+#define LOCATOR_TOLERANCE 90		// summed channel distance to a marker colour
+#define LOCATOR_MIN_AREA 2		// marker pixels (at the locator scale)
+#define LOCATOR_MARKER_SPACING 24	// frame pixels between the markers of a rover
+#define LOCATOR_SPACING_TOLERANCE 10	// frame pixels either way
+#define LOCATOR_MAX_MARKERS 64		// of each colour per frame
+#define LOCATOR_TRACK_RADIUS 48		// frame pixels searched around a prediction
+
+// finds the rovers in a colour frame by the two markers on top of each,
+// front and rear, labelling the connected marker pixels of a downscaled
+// region of the frame; the pose of every rover (in frame pixels) goes to
+// a PoseFeed each frame, and the frame is passed on with the rovers marked;
+// once found, each rover is tracked by searching only a window around where
+// its last pose and commanded velocities (from a motion feed) put it, and the
+// whole region is scanned again only when a rover is lost
+class RoverLocator: public FrameProcessor
+{
+public:
+	enum Flag { MARK_ROVERS, TRACK_ROVERS };
+
+	RoverLocator(PoseFeed *feed);
+	~RoverLocator();
+
+	bool init(int w, int h, int sb, int db);
+	void process(unsigned char *src, unsigned char *dest);
+
+	// set before the pipeline starts; a region of 0x0 is the whole frame
+	void setRegion(int x, int y, int w, int h);
+	void setScale(int s);
+	void setMarkers(const unsigned char front[3], const unsigned char rear[3], int tolerance);
+	void setMinArea(int area) { minArea = area; }
+	void setMarkerSpacing(int spacing, int tolerance) { markerSpacing = spacing; spacingTolerance = tolerance; }
+	// the expected poses and velocities (in frame pixels) of the rovers
+	void setMotionFeed(PoseFeed *feed) { motionFeed = feed; }
+	void setTrackRadius(int radius) { trackRadius = radius; }
+
+	void setFlag(int flag, bool value);
+	void toggleFlag(int flag);
+	void printOptions();
+
+	// the rovers of the last frame, for any thread but the feed's reader
+	int getLastPoses(PoseEstimate *poses, int max);
+	long getFullScans() { return fullScans; }
+
+private:
+	enum MarkerClass { NONE, FRONT, REAR };
+
+	struct Marker {
+		float x, y;
+	};
+
+	int locate(const unsigned char *src, int x, int y, int w, int h, PoseEstimate *poses, int max);
+	void classify(const unsigned char *src, int x, int y, int sw, int sh);
+	void label(int x, int y, int sw, int sh);
+	int findRoot(int l);
+	int pairMarkers(PoseEstimate *poses, int max);
+	bool track(const unsigned char *src, PoseFrame *frame, double dt);
+	PoseEstimate predict(const PoseEstimate &pose, double dt);
+	void markRover(unsigned char *dest, const PoseEstimate &pose);
+	void freeBuffers();
+
+	PoseFeed *feed;
+	PoseFeed *motionFeed;
+	long frameCount;
+	std::atomic<long> fullScans;
+
+	int roiX, roiY, roiWidth, roiHeight;
+	int scale;
+	int scaledWidth, scaledHeight;
+	unsigned char frontColour[3], rearColour[3];
+	int tolerance;
+	int minArea;
+	int markerSpacing;
+	int spacingTolerance;
+	bool markRovers;
+	bool trackRovers;
+	int trackRadius;
+
+	unsigned char *classes;		// MarkerClass of each scaled pixel
+	int *labels;				// provisional label of each scaled pixel
+	int *parent;				// union-find forest of the labels
+	unsigned char *labelClass;	// MarkerClass of each label
+	int *area, *sumX, *sumY;	// of each root label
+	int labelCount;
+
+	Marker front[LOCATOR_MAX_MARKERS], rear[LOCATOR_MAX_MARKERS];
+	int frontCount, rearCount;
+
+	const PoseFrame *motion;	// the newest from the motion feed
+	PoseEstimate tracks[MAX_POSE_ESTIMATES];
+	int trackCount;
+	std::chrono::steady_clock::time_point trackTime;
+
+	std::mutex lastMutex;
+	PoseFrame last;
+};
+
+#endif
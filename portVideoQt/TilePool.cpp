@@ -0,0 +1,85 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "TilePool.h"
+
+TilePool::TilePool(int threads) {
+	if (threads<=0) threads = (int)std::thread::hardware_concurrency() - 1;
+	stopping = false;
+	for (int i=0;i<threads;i++)
+		workers.push_back(std::thread(&TilePool::run, this));
+}
+
+TilePool::~TilePool() {
+	{
+		std::lock_guard<std::mutex> lock(tileMutex);
+		stopping = true;
+	}
+	tileReady.notify_all();
+	for (unsigned int i=0;i<workers.size();i++)
+		workers[i].join();
+}
+
+void TilePool::process(FrameProcessor *fp, unsigned char *src, unsigned char *dest, int height) {
+	int tileCount = threadCount() + 1;
+	if (tileCount>height) tileCount = height;
+	if (tileCount<=1 || !fp->isTileable()) {
+		fp->process(src, dest);
+		return;
+	}
+	
+	Job job;
+	job.remaining = tileCount;
+	
+	// queue all but the first tile, which this thread does itself
+	{
+		std::lock_guard<std::mutex> lock(tileMutex);
+		for (int i=1;i<tileCount;i++) {
+			Tile tile = { fp, src, dest, height*i/tileCount, height*(i+1)/tileCount, &job };
+			tiles.push_back(tile);
+		}
+	}
+	tileReady.notify_all();
+	
+	Tile first = { fp, src, dest, 0, height/tileCount, &job };
+	fp->processTile(first.src, first.dest, first.firstRow, first.lastRow);
+	finish(first);
+	
+	std::unique_lock<std::mutex> lock(job.mutex);
+	while (job.remaining>0) job.done.wait(lock);
+}
+
+void TilePool::finish(Tile &tile) {
+	std::lock_guard<std::mutex> lock(tile.job->mutex);
+	if (--tile.job->remaining==0) tile.job->done.notify_all();
+}
+
+void TilePool::run() {
+	for (;;) {
+		Tile tile;
+		{
+			std::unique_lock<std::mutex> lock(tileMutex);
+			while (!stopping && tiles.empty()) tileReady.wait(lock);
+			if (stopping) return;
+			tile = tiles.front();
+			tiles.pop_front();
+		}
+		tile.fp->processTile(tile.src, tile.dest, tile.firstRow, tile.lastRow);
+		finish(tile);
+	}
+}
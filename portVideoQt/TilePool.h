@@ -0,0 +1,74 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef TILEPOOL_H
+#define TILEPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FrameProcessor.h"
+
+// a set of worker threads that process a frame as tiles of rows; several
+// threads may hand it frames at once, and each helps with its own tiles
+class TilePool
+{
+public:
+	// 0 threads means one less than the number of cores
+	TilePool(int threads = 0);
+	~TilePool();
+	
+	int threadCount() { return (int)workers.size(); }
+	
+	// runs fp over the rows of src into dest as tiles, returning once
+	// every tile is done; fp must be tileable
+	void process(FrameProcessor *fp, unsigned char *src, unsigned char *dest, int height);
+
+private:
+	struct Job {
+		std::mutex mutex;
+		std::condition_variable done;
+		int remaining;
+	};
+	
+	struct Tile {
+		FrameProcessor *fp;
+		unsigned char *src;
+		unsigned char *dest;
+		int firstRow;
+		int lastRow;
+		Job *job;
+	};
+	
+	void run();
+	void finish(Tile &tile);
+	
+	std::vector<std::thread> workers;
+	std::mutex tileMutex;
+	std::condition_variable tileReady;
+	std::deque<Tile> tiles;
+	bool stopping;
+	
+	TilePool(const TilePool &);
+	TilePool& operator=(const TilePool &);
+};
+
+#endif
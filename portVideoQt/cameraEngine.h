@@ -19,6 +19,10 @@
 #ifndef CAMERAENGINE_H
 #define CAMERAENGINE_H
 
+#include <string.h>
+#include <chrono>
+#include "ColourConverter.h"
+
 #define SAT(c) \
         if (c & (~255)) { if (c < 0) c = 0; else c = 255; }
 
@@ -31,11 +35,25 @@ public:
 	virtual bool initCamera(int width, int height, bool colour) = 0;
 	virtual bool startCamera() = 0;
 	virtual unsigned char* getFrame() = 0;
+	// fills dest (width*height*bytes, RGB top-down) with the next frame;
+	// engines able to write straight into dest should override this
+	virtual bool getFrame(unsigned char *dest) {
+		unsigned char *frame = getFrame();
+		if (frame==NULL) return false;
+		memcpy(dest,frame,width*height*bytes);
+		return true;
+	}
 	virtual bool stopCamera() = 0;
 	virtual bool resetCamera() = 0;
 	virtual bool closeCamera() = 0;	
 	virtual bool stillRunning() = 0;
 	virtual void showSettingsDialog() = 0;
+	// the camera time of the last frame in microseconds; engines
+	// without a clock of their own stamp it when it is asked for
+	virtual long long getTimestamp() {
+		return std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
 		
 	int getFps() { return fps; }
 	int getWidth() { return width; }
@@ -58,79 +76,13 @@ protected:
 	int fps;
 	bool colour;
 	
-	void uyvy2gray(int width, int heigth, unsigned char *src, unsigned char *dest) {
-				for(int y=0;y<height;y++) {
-					for(int x=0;x<width/2;++x) {
-						src++;
-						*dest++ = *src++;
-						src++;
-						*dest++ = *src++;
-					}
-				}
+	void uyvy2gray(int width, int height, unsigned char *src, unsigned char *dest) {
+		ColourConverter::convert(src, ColourConverter::UYVY, dest, ColourConverter::GRAY8, width, height);
 	}
 	
 	void uyvy2rgb(int width, int height, unsigned char *src, unsigned char *dest) {
-	
-			/*int R,G,B;
-			int Y[2];
-			int U,V;
-
-			for(int y=0;y<height;y++) {
-				for(int x=0;x<width/2;x++) {
-					U    = *src++ -128;
-					Y[0] = *src++;
-					V    = *src++ -128;
-					Y[1] = *src++;
-										
-					// conversion
-					for (int i=0;i<2;i++) {	
-						R = (int)(Y[i] + 1.370705f * V);					//R
-						G = (int)(Y[i] - 0.698001f * V - 0.337633f * U);	//G
-						B = (int)(Y[i] + 1.732446f * U);					//B
-						
-						SAT(R);
-						SAT(G);
-						SAT(B);
-	
-						*dest++ = R;
-						*dest++ = G;
-						*dest++ = B;
-					}
-				}
-			}*/			
-
-			int R,G,B;
-			int Y[2];
-			int cG,cR,cB;
-
-			for(int y=0;y<height;y++) {
-				for(int x=0;x<width/2;x++) {
-					cB   = ((*src - 128) * 454) >> 8;
-					cG   = (*src++ - 128) * 88;
-					Y[0] = *src++;  
-					cR   = ((*src - 128) * 359) >> 8;
-					cG   = (cG + (*src++ - 128) * 183) >> 8;
-					Y[1] = *src++;
-					
-					// conversion
-					for (int i=0;i<2;i++) {	
-
-						R = Y[i] + cR;
-						G = Y[i] + cG;
-						B = Y[i] + cB;
-						
-						SAT(R);
-						SAT(G);
-						SAT(B);
-	
-						*dest++ = R;
-						*dest++ = G;
-						*dest++ = B;
-					}
-				}
-			}		
-	
-	};
+		ColourConverter::convert(src, ColourConverter::UYVY, dest, ColourConverter::RGB24, width, height);
+	}
 };
 
 #endif
@@ -17,11 +17,36 @@
 */
 
 #include "cameraTool.h"
+
+#include <stdlib.h>
+
+cameraEngine* cameraTool::nextCamera = NULL;
+
+void cameraTool::useCamera(cameraEngine *camera) {
+	nextCamera = camera;
+}
 	
 cameraEngine* cameraTool::findCamera() {
 
 	cameraEngine* camera = NULL;
 
+	if (nextCamera!=NULL) {
+		camera = nextCamera;
+		nextCamera = NULL;
+		if (camera->findCamera()) return camera;
+		delete camera;
+		return NULL;
+	}
+
+	const char *replay = getenv("PORTVIDEO_REPLAY");
+	if (replay!=NULL) {
+		const char *fps = getenv("PORTVIDEO_FPS");
+		camera = new fileCamera(replay, (fps!=NULL)?atoi(fps):30);
+		if (camera->findCamera()) return camera;
+		delete camera;
+		return NULL;
+	}
+
 	#ifdef WIN32
 	camera = new dslibCamera();
 	#endif
@@ -39,7 +64,7 @@ cameraEngine* cameraTool::findCamera() {
 	}
 	#endif
 	
-	if( !camera->findCamera() ) { 
+	if( camera!=NULL && !camera->findCamera() ) { 
 		delete camera;
 		camera = NULL;
 	} 
@@ -31,6 +31,8 @@
 #include "../linux/v4linuxCamera.h"
 #endif
 
+#include "fileCamera.h"
+
 #ifdef __APPLE__
 #include <stdio.h>
 #include <stdlib.h>
@@ -39,11 +41,19 @@
 #endif
 
 
+// finds the camera to use: one handed over beforehand (such as a simCamera),
+// else a recording named by PORTVIDEO_REPLAY (at PORTVIDEO_FPS, default 30),
+// else the camera of the platform
 class cameraTool
 {
 public:
 	
 	static cameraEngine* findCamera();
+	// the next findCamera returns (and the caller then owns) this camera
+	static void useCamera(cameraEngine *camera);
+
+private:
+	static cameraEngine *nextCamera;
 };
 
 #endif
@@ -28,6 +28,7 @@ dslibCamera::dslibCamera()
 
 	//buffer = NULL;
 	pbuffer = NULL;
+	g_Timestamp = 0;
 
 	//cameraName = new char[255];
 }
@@ -79,62 +80,30 @@ bool dslibCamera::startCamera()
 }
 
 unsigned char* dslibCamera::getFrame()
+{
+		if (getFrame(pbuffer)) return pbuffer;
+		return NULL;
+}
+
+// converts the next sample straight into dest: DirectShow delivers BGR
+// rows bottom-up, so the rows are flipped (and swapped to RGB) in one pass
+bool dslibCamera::getFrame(unsigned char *dest)
 {
 		
 		DWORD wait_result = dsvl_vs->WaitForNextSample(/*INFINITE*/1000/fps);
 		if(wait_result == WAIT_OBJECT_0)
 		{
 
-			unsigned char r,g,b;
-			int dwidth = 2*width;
-
 			dsvl_vs->CheckoutMemoryBuffer(&g_mbHandle, &buffer);
 			g_Timestamp = dsvl_vs->GetCurrentTimestamp();
-			switch (colour) {
-				case false: {
-					unsigned char *src = (unsigned char*)buffer;
-					unsigned char *dest = pbuffer;
-					dest+=width*height-width;
-
-					for(int y=0;y<height;y++) {
-						for(int x=0;x<width;x++) {
-							//quicker
-							/**dest++ = *src++;
-							src++;
-							src++;*/
-
-							//apparently incorrect
-							/*r = *src++;
-							g = *src++;
-							b = *src++;
-							*dest++ = (r+b+g)/3;*/
-
-							//better
-							/*r = *src++;
-							g = *src++;
-							b = *src++;
-							*dest++ = (unsigned char)(0.30 * r + 0.59 * g + 0.11 * b);*/
-
-							//fastest and best
-							r = *src++;
-							g = *src++;
-							b = *src++;
-							*dest++ = hibyte(r * 77 + g * 151 + b * 28);
-						}
-						dest-=dwidth;
-					}
-					break;
-				}
-				case true: {
-					memcpy(pbuffer,buffer,width*height*bytes);
-					break;
-				}
-			}
+			ColourConverter::convert((unsigned char*)buffer, ColourConverter::BGR24,
+				dest, colour ? ColourConverter::RGB24 : ColourConverter::GRAY8,
+				width, height, true);
 			dsvl_vs->CheckinMemoryBuffer(g_mbHandle);
-			return pbuffer;
+			return true;
 		}
 
-		return NULL;
+		return false;
 }
 
 bool dslibCamera::stopCamera()
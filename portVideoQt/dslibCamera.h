@@ -36,12 +36,15 @@ public:
 	bool initCamera(int width, int height, bool colour);
 	bool startCamera();
 	unsigned char* getFrame();
+	bool getFrame(unsigned char *dest);
 	bool stopCamera();
 	bool stillRunning();
 	bool resetCamera();
 	bool closeCamera();
 	
 	void showSettingsDialog();
+	// DirectShow stamps its samples in units of 100ns
+	long long getTimestamp() { return g_Timestamp/10; }
 
 private:
 
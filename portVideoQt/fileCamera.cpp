@@ -0,0 +1,235 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "fileCamera.h"
+
+#include <stdlib.h>
+#include <thread>
+
+fileCamera::fileCamera(const char *path, int fps, bool loop, long firstFrame) {
+	this->path = new char[strlen(path)+1];
+	strcpy(this->path, path);
+	this->fps = fps;
+	this->loop = loop;
+	this->firstFrame = firstFrame;
+
+	cameraName = (char*)"Replay Camera";
+	buffer = NULL;
+	frames = NULL;
+	frameSize = 0;
+	frameCount = 0;
+	frameIndex = 0;
+	lastIndex = -1;
+	recording = NULL;
+}
+
+fileCamera::~fileCamera() {
+	closeCamera();
+	delete [] path;
+}
+
+bool fileCamera::isPattern() {
+	return strchr(path, '%')!=NULL;
+}
+
+bool fileCamera::parseSize(int *w, int *h) {
+	// the size follows the last underscore of the name
+	const char *size = strrchr(path, '_');
+	if (size==NULL) return false;
+	return sscanf(size, "_%dx%d.raw", w, h)==2 && *w>0 && *h>0;
+}
+
+bool fileCamera::findCamera() {
+	if (!isPattern() && FrameRecording::isRecording(path)) return true;
+
+	int w, h;
+	if (!parseSize(&w, &h)) return false;
+
+	char fileName[1024];
+	if (isPattern()) sprintf(fileName, path, firstFrame);
+	else strcpy(fileName, path);
+	FILE *file = fopen(fileName, "rb");
+	if (file==NULL) return false;
+	fclose(file);
+	return true;
+}
+
+bool fileCamera::initCamera(int width, int height, bool colour) {
+	closeCamera();
+	this->colour = colour;
+	bytes = (colour?3:1);
+	if (!isPattern() && FrameRecording::isRecording(path)) {
+		if (!openRecording()) return false;
+		buffer = new unsigned char[frameSize];
+		return true;
+	}
+
+	// the recording decides the size, the caller the bytes per pixel
+	if (!parseSize(&this->width, &this->height)) return false;
+	frameSize = this->width*this->height*bytes;
+
+	if (isPattern()) {
+		if (!readSeries()) return false;
+	} else {
+		if (!mapFile()) return false;
+	}
+
+	buffer = new unsigned char[frameSize];
+	return true;
+}
+
+bool fileCamera::mapFile() {
+	if (!file.openRead(path)) return false;
+	if (file.size()%frameSize!=0) {
+		file.close();
+		return false;
+	}
+	// the frames are read once, front to back, a window of them at a time
+	file.setWindowSize((size_t)RECORDING_WINDOW_FRAMES*frameSize);
+	file.adviseSequential();
+	frameCount = (int)(file.size()/frameSize);
+	return true;
+}
+
+bool fileCamera::openRecording() {
+	recording = new FrameRecording();
+	if (!recording->open(path) || recording->getFrameCount()==0) {
+		delete recording;
+		recording = NULL;
+		return false;
+	}
+	width = recording->getWidth();
+	height = recording->getHeight();
+	frameSize = width*height*bytes;
+	frameCount = (int)recording->getFrameCount();
+	return true;
+}
+
+bool fileCamera::readSeries() {
+	// count the files of the series, then read them all in
+	char fileName[1024];
+	int count = 0;
+	for (;;count++) {
+		sprintf(fileName, path, firstFrame+count);
+		FILE *file = fopen(fileName, "rb");
+		if (file==NULL) break;
+		fclose(file);
+	}
+	if (count==0) return false;
+
+	frames = new unsigned char[(size_t)count*frameSize];
+	for (int i=0;i<count;i++) {
+		sprintf(fileName, path, firstFrame+i);
+		FILE *file = fopen(fileName, "rb");
+		size_t read = (file!=NULL)?fread(frames+(size_t)i*frameSize, 1, frameSize, file):0;
+		if (file!=NULL) fclose(file);
+		if (read!=(size_t)frameSize) {
+			delete [] frames;
+			frames = NULL;
+			return false;
+		}
+	}
+	frameCount = count;
+	return true;
+}
+
+void fileCamera::unmapFile() {
+	if (recording!=NULL) {
+		delete recording;
+		recording = NULL;
+	} else if (file.isOpen()) file.close();
+	else delete [] frames;
+	frames = NULL;
+	frameCount = 0;
+}
+
+bool fileCamera::startCamera() {
+	if (frames==NULL && recording==NULL && !file.isOpen()) return false;
+	frameIndex = 0;
+	lastIndex = -1;
+	nextFrame = std::chrono::steady_clock::now();
+	return true;
+}
+
+unsigned char* fileCamera::getFrame() {
+	if (getFrame(buffer)) return buffer;
+	return NULL;
+}
+
+bool fileCamera::getFrame(unsigned char *dest) {
+	if (!stillRunning()) return false;
+
+	// keep to the frame rate, without catching up on late frames
+	if (fps>0) {
+		std::this_thread::sleep_until(nextFrame);
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		nextFrame += std::chrono::microseconds(1000000/fps);
+		if (nextFrame<now) nextFrame = now;
+	}
+
+	if (recording!=NULL) {
+		const unsigned char *frame = recording->frame(frameIndex);
+		if (frame==NULL) return false;
+		if (recording->getBytes()==bytes) memcpy(dest, frame, frameSize);
+		else ColourConverter::convert(frame, (recording->getBytes()==3)?ColourConverter::RGB24:ColourConverter::GRAY8,
+			dest, colour?ColourConverter::RGB24:ColourConverter::GRAY8, width, height);
+	} else {
+		const unsigned char *frame = (frames!=NULL)?frames+(size_t)frameIndex*frameSize
+			:file.view((long long)frameIndex*frameSize, frameSize);
+		if (frame==NULL) return false;
+		memcpy(dest, frame, frameSize);
+	}
+	lastIndex = frameIndex;
+	frameIndex++;
+	if (loop && frameIndex==frameCount) frameIndex = 0;
+	return true;
+}
+
+long long fileCamera::getTimestamp() {
+	if (recording==NULL || lastIndex<0 || recording->timestamp(lastIndex)<0)
+		return cameraEngine::getTimestamp();
+	return recording->timestamp(lastIndex);
+}
+
+bool fileCamera::seekFrame(long number) {
+	long index;
+	if (recording!=NULL) index = recording->findFrame(number);
+	else index = (number>=0 && number<frameCount)?number:-1;
+	if (index<0) return false;
+	frameIndex = (int)index;
+	return true;
+}
+
+bool fileCamera::stopCamera() {
+	return true;
+}
+
+bool fileCamera::stillRunning() {
+	return (frames!=NULL || recording!=NULL || file.isOpen()) && frameIndex<frameCount;
+}
+
+bool fileCamera::resetCamera() {
+	return (stopCamera() && startCamera());
+}
+
+bool fileCamera::closeCamera() {
+	unmapFile();
+	delete [] buffer;
+	buffer = NULL;
+	return true;
+}
@@ -0,0 +1,84 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef FILECAMERA_H
+#define FILECAMERA_H
+
+#include <stdio.h>
+#include <chrono>
+#include "cameraEngine.h"
+#include "MappedFile.h"
+#include "FrameRecording.h"
+
+// replays raw frames as written by portVideoQt::saveBuffer, named
+// name_WxH.raw: either one file holding any number of frames back to
+// back (mapped a window of frames at a time), or a numbered series given as
+// a pattern such as "frame%ld_640x480.raw"; frames hold the number of
+// bytes per pixel the camera is initialised with, and are handed out at
+// the given rate (or as fast as they are asked for at 0 fps);
+// also replays a recording written by FrameRecorder (of any name),
+// converted to the bytes per pixel asked for, with its timestamps
+class fileCamera : public cameraEngine
+{
+public:
+	fileCamera(const char *path, int fps = 30, bool loop = true, long firstFrame = 0);
+	~fileCamera();
+
+	bool findCamera();
+	bool initCamera(int width, int height, bool colour);
+	bool startCamera();
+	unsigned char* getFrame();
+	bool getFrame(unsigned char *dest);
+	bool stopCamera();
+	bool stillRunning();
+	bool resetCamera();
+	bool closeCamera();
+
+	void showSettingsDialog() {};
+
+	int getFrameCount() { return frameCount; }
+	// the camera time of the last frame, as recorded
+	long long getTimestamp();
+	// continues from the frame of the given camera number
+	// (or position, for raw frames), or the first one after it
+	bool seekFrame(long number);
+
+private:
+	bool isPattern();
+	bool parseSize(int *w, int *h);
+	bool mapFile();
+	bool openRecording();
+	bool readSeries();
+	void unmapFile();
+
+	char *path;
+	bool loop;
+	long firstFrame;
+
+	unsigned char *frames;		// a series read in, back to back
+	int frameSize;
+	int frameCount;
+	int frameIndex;
+	int lastIndex;
+	MappedFile file;
+	FrameRecording *recording;
+
+	std::chrono::steady_clock::time_point nextFrame;
+};
+
+#endif
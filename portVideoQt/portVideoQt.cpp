@@ -21,7 +21,7 @@
 void portVideoQt::saveBuffer(unsigned char* buffer,int size) {
 	char fileName[32];
 	sprintf(fileName,"frame%ld_%dx%d.raw",framenumber_, width_, height_);
-	FILE*  imagefile=fopen(fileName, "w");
+	FILE*  imagefile=fopen(fileName, "wb");
 	fwrite((const char *)buffer, 1,  size, imagefile);
 	fclose(imagefile);
 }
@@ -41,6 +41,9 @@ void portVideoQt::run() {
 	allocateBuffers();
 	initFrameProcessors();
 
+	const char *record = getenv("PORTVIDEO_RECORD");
+	if (record!=NULL) startRecording(record);
+
 	bool success = camera_->startCamera();
 
 	if( success ){
@@ -67,6 +70,10 @@ void portVideoQt::run() {
 		
 		mainLoop();
 
+		// the camera thread may still hold a pooled frame
+		cameraThread->wait();
+		delete cameraThread;
+
 		camera_->stopCamera();
 
 	}else{
@@ -83,7 +90,7 @@ void portVideoQt::run() {
 // does what its name suggests
 void portVideoQt::mainLoop()
 {
-	unsigned char *cameraReadBuffer = NULL;
+	FrameHandle nextFrame;
 
 	while(running_) {
 		
@@ -95,25 +102,26 @@ void portVideoQt::mainLoop()
 			continue;
 		}
 
-		// loop until we get access to a frame
-		cameraReadBuffer = ringBuffer->getNextBufferToRead();
-		while (cameraReadBuffer==NULL) {
-			msleep(30);
-			cameraReadBuffer = ringBuffer->getNextBufferToRead();
+		// sleep until the camera thread delivers a frame
+		while (!ringBuffer->waitRead(nextFrame, 100)) {
 			if(!running_) goto emergencyexit; // escape on quit
 		}
 		
-		// try again if we can get a more recent fram
-		do {
-			memcpy(sourceBuffer_,cameraReadBuffer,ringBuffer->size());
-			ringBuffer->readFinished();
-			
-			cameraReadBuffer = ringBuffer->getNextBufferToRead();
-		} while( cameraReadBuffer != NULL );
+		// skip to the most recent frame, handing the older ones back
+		sourceFrame_ = nextFrame;
+		if (ringBuffer->readLatest(nextFrame))
+			sourceFrame_ = nextFrame;
+		nextFrame.release();
 		
-		// do the actual image processing job
-		for (frame = processorList.begin(); frame!=processorList.end(); frame++)
-			(*frame)->process(sourceBuffer_,destBuffer_);
+		// hand the frame to the processing pipeline, and pick up the
+		// newest frame to come out of it (an earlier one, as it runs behind)
+		if (pipeline_->stageCount()>0) {
+			pipeline_->push(sourceFrame_);
+			if (pipeline_->readLatest(nextFrame)) {
+				destFrame_ = nextFrame;
+				nextFrame.release();
+			}
+		}
 		
 		// update display
 		switch( displayMode_ ) {
@@ -121,15 +129,15 @@ void portVideoQt::mainLoop()
 				break;
 			case SOURCE_DISPLAY: {
             if(cw)
-               cw->updateImage(sourceImage_);
+               cw->updateImage(sourceFrame_, width_, height_, bytesPerSourcePixel_);
 				//SDL_BlitSurface(sourceImage_, NULL, window_, NULL);
 				//SDL_Flip(window_);
 				//SDL_UpdateRect( window_, 0, 0, width_, height_ );
 				break;
 			}			
 			case DEST_DISPLAY: {
-            if(cw)
-               cw->updateImage(destImage_);
+            if(cw && !destFrame_.isNull())
+               cw->updateImage(destFrame_, width_, height_, pipeline_->outputBytes());
 				//SDL_BlitSurface(destImage_, NULL, window_, NULL);
 				//SDL_Flip(window_);
 				//SDL_UpdateRect( window_, 0, 0, width_, height_ );
@@ -141,7 +149,8 @@ void portVideoQt::mainLoop()
 	}
 	emergencyexit: 
 	
-	// do the actual image processing job
+	// let the pipeline finish the frames it is working on
+	pipeline_->stop();
 	for (frame = processorList.begin(); frame!=processorList.end(); frame++)
 		(*frame)->finish();
 
@@ -216,7 +225,7 @@ void portVideoQt::process_events()
 					displayMode_ = NO_DISPLAY;
 					// turn the display black
 					for (int i=0;i<width_*height_*bytesPerDestPixel_;i++)
-						destBuffer_[i]=0;
+						destFrame_.data()[i]=0;
 					SDL_BlitSurface(destImage_, NULL, window_, NULL);
 					SDL_UpdateRect( window_, 0, 0, width_, height_ );
 				} else if( event.key.keysym.sym == SDLK_s ){
@@ -261,7 +270,7 @@ void portVideoQt::process_events()
 						SDL_WM_SetCaption(caption, NULL);
 						// turn the display black
 						for (int i=0;i<width_*height_*bytesPerDestPixel_;i++)
-							destBuffer_[i]=0;
+							destFrame_.data()[i]=0;
 						SDL_BlitSurface(destImage_, NULL, window_, NULL);
 						SDL_UpdateRect( window_, 0, 0, width_, height_ );
 					}
@@ -270,7 +279,7 @@ void portVideoQt::process_events()
 					sprintf(fileName,"frame%li.bmp",framenumber_);
 					SDL_SaveBMP(sourceImage_, fileName);
 				} else if( event.key.keysym.sym == SDLK_r ){
-					saveBuffer(sourceBuffer_, width_ * height_ * bytesPerSourcePixel_);
+					saveBuffer(sourceFrame_.data(), sourceFrame_.size());
 				} else if( event.key.keysym.sym == SDLK_ESCAPE ){
 					running_=false;
 				} else {
@@ -320,34 +329,44 @@ void portVideoQt::allocateBuffers()
 {
 	bytesPerSourcePixel_ = sourceDepth_/8;	
 	bytesPerDestPixel_ = destDepth_/8;
-	sourceBuffer_ = new unsigned char[width_*height_*bytesPerSourcePixel_];
-	destBuffer_ = new unsigned char[width_*height_*bytesPerDestPixel_];
 	cameraBuffer_ = NULL;
-		
-	//sourceImage_ = SDL_CreateRGBSurfaceFrom(sourceBuffer_, width_, height_, sourceDepth_, width_*bytesPerSourcePixel_, 0 , 0, 0, 0);
-	//if (sourceDepth_==8)
-	//	SDL_SetPalette(sourceImage_, SDL_LOGPAL|SDL_PHYSPAL, palette_, 0, 256 );
-   sourceImage_ = new QImage(sourceBuffer_, width_, height_, QImage::Format_RGB888);
-
-	//destImage_ = SDL_CreateRGBSurfaceFrom(destBuffer_, width_, height_, destDepth_, width_*bytesPerDestPixel_, 0 , 0, 0, 0);
-	//if (destDepth_==8)
-	//	SDL_SetPalette(destImage_, SDL_LOGPAL|SDL_PHYSPAL, palette_, 0, 256 );
-		
-   destImage_ = new QImage(sourceBuffer_, width_, height_, QImage::Format_RGB888);
-	//SDL_DisplayFormat(sourceImage_);
-	//SDL_DisplayFormat(destImage_);
 	
-	ringBuffer = new RingBuffer(width_*height_*bytesPerSourcePixel_);
+	// enough frames for the ring, the main loop, the widget and the first
+	// pipeline stage to hold some
+	sourcePool_ = new FramePool(width_*height_*bytesPerSourcePixel_, POOL_FRAMES);
+	pipeline_   = new FramePipeline();
+	
+	ringBuffer = new RingBuffer(RING_DEPTH, RingBuffer::LATEST_FRAME);
+	recorder_   = new FrameRecorder(width_, height_, bytesPerSourcePixel_);
 }
 
 void portVideoQt::freeBuffers()
 {
-	delete sourceImage_;
-	delete destImage_;
-	delete [] sourceBuffer_;
-	delete [] destBuffer_;
-	
+	// hand every frame back before the pools go away
+	if (cw) cw->clearImage();
+	sourceFrame_.release();
+	destFrame_.release();
+	delete pipeline_;
 	delete ringBuffer;
+	
+	// the camera thread has stopped, so the recording is complete
+	stopRecording();
+	delete recorder_;
+	recorder_ = NULL;
+	
+	delete sourcePool_;
+}
+
+bool portVideoQt::startRecording(const char *fileName) {
+	if (recorder_==NULL) return false;
+	return recorder_->start(fileName);
+}
+
+bool portVideoQt::stopRecording() {
+	if (recorder_==NULL || !recorder_->isRecording()) return false;
+	bool finished = recorder_->stop();
+	printf("recorded %ld frames, dropped %ld\n", recorder_->getRecorded(), recorder_->getDropped());
+	return finished;
 }
 
 void portVideoQt::addFrameProcessor(FrameProcessor *fp) {
@@ -368,13 +387,15 @@ void portVideoQt::setDisplayMode(DisplayMode mode) {
 }
 
 void portVideoQt::initFrameProcessors() {
-	for (frame = processorList.begin(); frame!=processorList.end(); ) {
-		bool success = (*frame)->init(width_ , height_, bytesPerSourcePixel_, bytesPerDestPixel_);
-		if(!success) {	
-			processorList.erase( frame );
-			//printf("removed frame processor\n");
-		} else frame++;
-	}
+	// chain the processors, each reading the output of the one before
+	for (frame = processorList.begin(); frame!=processorList.end(); frame++)
+		pipeline_->addStage(*frame, bytesPerDestPixel_);
+	pipeline_->start(width_, height_, bytesPerSourcePixel_);
+	
+	// forget the processors that failed to initialise
+	processorList.clear();
+	for (int i=0;i<pipeline_->stageCount();i++)
+		processorList.push_back(pipeline_->getStage(i));
 }
 
 portVideoQt::portVideoQt(char* name, bool srcColour, bool destColour, CameraWidget* cameraWidget)
@@ -389,6 +410,7 @@ portVideoQt::portVideoQt(char* name, bool srcColour, bool destColour, CameraWidg
 	pause_ = false;
 	
 	framenumber_=0;
+	recorder_ = NULL;
 	
 	appName = name;
 	sourceDepth_ = (srcColour?24:8);
@@ -415,6 +437,7 @@ portVideoQt::portVideoQt()
 	pause_ = false;
 	
 	framenumber_=0;
+	recorder_ = NULL;
 	
 	appName = "Video";
 	sourceDepth_ = 8;
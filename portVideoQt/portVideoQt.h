@@ -38,10 +38,14 @@
 
 #define WIDTH 640
 #define HEIGHT 480
+#define POOL_FRAMES 12
 
 #include "cameraTool.h"
+#include "FramePool.h"
 #include "RingBuffer.h"
 #include "FrameProcessor.h"
+#include "FramePipeline.h"
+#include "FrameRecorder.h"
 #include "cameraWidget.h"
 
 class CameraThread;
@@ -69,6 +73,11 @@ public:
 	
 	enum DisplayMode { NO_DISPLAY, SOURCE_DISPLAY, DEST_DISPLAY };
 	void setDisplayMode(DisplayMode mode);
+	
+	// records every camera frame (see FrameRecorder) once the camera runs
+	bool startRecording(const char *fileName);
+	bool stopRecording();
+	bool isRecording() { return recorder_!=NULL && recorder_->isRecording(); }
 
 	QSize getSize() { while(!running_); return QSize(width_, height_);};
 	int   getFps()  { while(!running_); return fps_;};
@@ -92,11 +101,14 @@ protected:
 	
 	void saveBuffer(unsigned char* buffer, int size);
 	
-	QImage *sourceImage_;
-	QImage *destImage_;
+	// the camera writes into sourcePool_, each processor into a pool of its
+	// pipeline stage; frames are passed on (and displayed) by handle
+	FramePool *sourcePool_;
+	FramePipeline *pipeline_;
+	FrameRecorder *recorder_;
 
-	unsigned char* sourceBuffer_;
-	unsigned char* destBuffer_;
+	FrameHandle sourceFrame_;
+	FrameHandle destFrame_;
 
 private:
    CameraWidget* cw;
@@ -134,21 +146,24 @@ public:
 protected:
    void run()
    {
-		unsigned char *cameraBuffer = NULL;
-		unsigned char *cameraWriteBuffer = NULL;
-		
 		while(engine->running_) {
 			if(!engine->pause_) {
-				cameraBuffer = engine->camera_->getFrame();
-				if (cameraBuffer!=NULL) {
+				// every buffer is still held downstream
+				FrameHandle cameraFrame = engine->sourcePool_->acquire();
+				if (cameraFrame.isNull()) {
+					msleep(5);
+					continue;
+				}
 				
-					cameraWriteBuffer = engine->ringBuffer->getNextBufferToWrite();
-					if (cameraWriteBuffer!=NULL) {
-						memcpy(cameraWriteBuffer,cameraBuffer,engine->ringBuffer->size());
+				// getFrame blocks until the camera delivers, and a full
+				// ring drops its oldest frame, so there is no need to sleep
+				if (engine->camera_->getFrame(cameraFrame.data())) {
+					cameraFrame.setNumber(engine->framenumber_);
+					// only copies the frame, the disk is written elsewhere
+					if (engine->recorder_->isRecording())
+						engine->recorder_->record(cameraFrame.data(), engine->framenumber_, engine->camera_->getTimestamp());
+					if (engine->ringBuffer->write(cameraFrame))
 						engine->framenumber_++;
-						engine->ringBuffer->writeFinished();
-					}
-					msleep(20);
 				} /*else {
 					if (!engine->camera_->stillRunning()) {
 						printf("camera disconnected\n");
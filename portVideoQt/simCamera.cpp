@@ -0,0 +1,149 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "simCamera.h"
+#include "../FormationControl/helpers.h"
+#include "../ross/Simulator.h"
+
+#include <math.h>
+#include <thread>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+static const unsigned char FRONT_MARKER[3] = {250, 10, 10};
+static const unsigned char REAR_MARKER[3]  = {10, 10, 250};
+
+simCamera::simCamera(SimulationLoop *loop, int fps) {
+	this->loop = loop;
+	env = NULL;
+	init(fps);
+}
+
+simCamera::simCamera(const Environment *env, int fps) {
+	loop = NULL;
+	this->env = env;
+	init(fps);
+}
+
+void simCamera::init(int fps) {
+	this->fps = fps;
+	cameraName = (char*)"Simulated Camera";
+	buffer = NULL;
+	rgb = NULL;
+	noise = 0;
+	seed = 1;
+}
+
+simCamera::~simCamera() {
+	closeCamera();
+}
+
+bool simCamera::initCamera(int width, int height, bool colour) {
+	this->width = width;
+	this->height = height;
+	this->colour = colour;
+	bytes = (colour?3:1);
+
+	closeCamera();
+	buffer = new unsigned char[width*height*bytes];
+	if (!colour) rgb = new unsigned char[width*height*3];
+	return true;
+}
+
+void simCamera::setNoise(int amplitude, unsigned int seed) {
+	noise = amplitude;
+	this->seed = seed;
+}
+
+bool simCamera::startCamera() {
+	nextFrame = std::chrono::steady_clock::now();
+	return true;
+}
+
+unsigned char* simCamera::getFrame() {
+	if (getFrame(buffer)) return buffer;
+	return NULL;
+}
+
+bool simCamera::getFrame(unsigned char *dest) {
+	// keep to the frame rate, without catching up on late frames
+	if (fps>0) {
+		std::this_thread::sleep_until(nextFrame);
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		nextFrame += std::chrono::microseconds(1000000/fps);
+		if (nextFrame<now) nextFrame = now;
+	}
+
+	if (loop!=NULL) {
+		if (!loop->interpolate(poses)) poses.setSize(0);
+	} else poses = env->getPoses();
+
+	if (colour) render(dest);
+	else {
+		render(rgb);
+		ColourConverter::convert(rgb, ColourConverter::RGB24, dest, ColourConverter::GRAY8, width, height);
+	}
+	return true;
+}
+
+void simCamera::render(unsigned char *dest) {
+	int size = width*height*3;
+	if (noise>0) {
+		// a small linear congruential generator keeps runs repeatable
+		for (int i=0;i<size;i++) {
+			seed = seed*1103515245u + 12345u;
+			int c = SIM_BACKGROUND + (int)((seed>>16)%(2*noise+1)) - noise;
+			SAT(c);
+			dest[i] = (unsigned char)c;
+		}
+	} else memset(dest, SIM_BACKGROUND, size);
+
+	// each rover where the environment puts it (as in Environment::addCell)
+	for (int i=0;i<poses.getSize();i++) {
+		int xi, yi;
+		f2i(poses.x[i], poses.y[i], &xi, &yi, windowSize[0], windowSize[1]);
+		double heading = poses.heading[i]*M_PI/180.0;
+		float dx = (float)(SIM_MARKER_OFFSET*cos(heading));
+		float dy = (float)(-SIM_MARKER_OFFSET*sin(heading));
+		drawMarker(dest, xi+dx, yi+dy, FRONT_MARKER);
+		drawMarker(dest, xi-dx, yi-dy, REAR_MARKER);
+	}
+}
+
+void simCamera::drawMarker(unsigned char *dest, float x, float y, const unsigned char colour[3]) {
+	int cx = (int)floor(x+0.5f), cy = (int)floor(y+0.5f);
+	for (int j=-SIM_MARKER_RADIUS;j<=SIM_MARKER_RADIUS;j++) {
+		int py = cy+j;
+		if (py<0 || py>=height) continue;
+		for (int i=-SIM_MARKER_RADIUS;i<=SIM_MARKER_RADIUS;i++) {
+			int px = cx+i;
+			if (px<0 || px>=width || i*i+j*j>SIM_MARKER_RADIUS*SIM_MARKER_RADIUS) continue;
+			memcpy(dest+(py*width+px)*3, colour, 3);
+		}
+	}
+}
+
+bool simCamera::closeCamera() {
+	delete [] buffer;
+	buffer = NULL;
+	delete [] rgb;
+	rgb = NULL;
+	return true;
+}
@@ -0,0 +1,75 @@
+/*  portVideo, a cross platform camera framework
+    Copyright (C) 2005 Martin Kaltenbrunner <mkalten@iua.upf.es>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef SIMCAMERA_H
+#define SIMCAMERA_H
+
+#include <chrono>
+#include "cameraEngine.h"
+#include "RoverLocator.h"
+#include "../ross/SimulationLoop.h"
+
+#define SIM_BACKGROUND 80			// grey level of the floor
+#define SIM_MARKER_OFFSET (LOCATOR_MARKER_SPACING/2)
+#define SIM_MARKER_RADIUS 5
+
+// renders the poses of the cells of a simulation as a camera would see the
+// rovers, a red marker at the front of each and a blue one at the rear (as
+// the RoverLocator expects), so that the vision path runs without a camera;
+// the poses come from the snapshots of a running simulation loop (from any
+// thread) or straight from an environment that is not stepped meanwhile
+// (as of the end of its last step)
+class simCamera : public cameraEngine
+{
+public:
+	simCamera(SimulationLoop *loop, int fps = 30);
+	simCamera(const Environment *env, int fps = 0);
+	~simCamera();
+
+	bool findCamera() { return true; }
+	bool initCamera(int width, int height, bool colour);
+	bool startCamera();
+	unsigned char* getFrame();
+	bool getFrame(unsigned char *dest);
+	bool stopCamera() { return true; }
+	bool stillRunning() { return true; }
+	bool resetCamera() { return (stopCamera() && startCamera()); }
+	bool closeCamera();
+
+	void showSettingsDialog() {};
+
+	// adds +-amplitude of (repeatable) noise to every channel of every pixel
+	void setNoise(int amplitude, unsigned int seed = 1);
+
+private:
+	void init(int fps);
+	void render(unsigned char *dest);
+	void drawMarker(unsigned char *dest, float x, float y, const unsigned char colour[3]);
+
+	SimulationLoop *loop;
+	const Environment *env;
+	PoseStore poses;
+
+	unsigned char *rgb;		// the frame before it is made grey
+	int noise;
+	unsigned int seed;
+
+	std::chrono::steady_clock::time_point nextFrame;
+};
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * Checks every kernel ColourConverter dispatches to against its scalar counterpart: each
+ * conversion, at each instruction set up to the one the processor supports, over widths
+ * that leave every possible tail, on rows that start off alignment and are fenced with
+ * guard bytes. Returns 0 if every check passed.
+ */
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "../ColourConverter.h"
+
+/*widths 1 to MAX_WIDTH cover every tail of a 32-pixel AVX2 block, twice over*/
+#define MAX_WIDTH 97
+#define MAX_HEIGHT 3
+/*bytes past each end of a destination that no kernel may touch*/
+#define GUARD_BYTES 64
+#define GUARD 0xA5
+
+static int failures = 0;
+
+static void check(bool passed, const char * what)
+{
+	printf("%s: %s\n", passed ? "ok" : "FAILED", what);
+	if (!passed)
+		failures++;
+}
+
+/*the same bytes every run, so a failure can be reproduced*/
+static void fill(std::vector<unsigned char> & bytes, unsigned int seed)
+{
+	for (size_t i = 0; i < bytes.size(); i++) {
+		seed = seed * 1103515245u + 12345u;
+		bytes[i] = (unsigned char)(seed >> 16);
+	}
+}
+
+static bool guarded(const std::vector<unsigned char> & dest, size_t size)
+{
+	for (size_t i = 0; i < GUARD_BYTES; i++)
+		if (dest[i] != GUARD || dest[GUARD_BYTES + size + i] != GUARD)
+			return false;
+	return true;
+}
+
+/*
+ * Converts each frame at the given instruction set and at the scalar one, from a source
+ * that starts offset bytes past alignment, and compares the two (and their guards).
+ */
+static bool matchesScalar(ColourConverter::Format srcFormat, ColourConverter::Format destFormat,
+                          ColourConverter::Isa isa, int offset)
+{
+	bool yuv = srcFormat == ColourConverter::UYVY || srcFormat == ColourConverter::YUYV;
+	for (int width = 1; width <= MAX_WIDTH; width++) {
+		if (yuv && (width & 1))
+			continue;
+		for (int height = 1; height <= MAX_HEIGHT; height++) {
+			for (int flip = 0; flip < 2; flip++) {
+				size_t srcSize = ColourConverter::frameSize(srcFormat, width, height);
+				size_t destSize = ColourConverter::frameSize(destFormat, width, height);
+				std::vector<unsigned char> src(srcSize + offset);
+				fill(src, width * 131 + height * 7 + flip);
+				std::vector<unsigned char> expected(destSize + 2 * GUARD_BYTES, GUARD);
+				std::vector<unsigned char> actual(destSize + 2 * GUARD_BYTES + offset, GUARD);
+				unsigned char * out = &actual[offset];
+
+				if (!ColourConverter::convert(&src[offset], srcFormat, &expected[GUARD_BYTES], destFormat,
+				                              width, height, flip != 0, ColourConverter::ISA_SCALAR) ||
+				    !ColourConverter::convert(&src[offset], srcFormat, out + GUARD_BYTES, destFormat,
+				                              width, height, flip != 0, isa)) {
+					printf("  %s to %s (%s) failed at %dx%d\n", ColourConverter::formatName(srcFormat),
+					       ColourConverter::formatName(destFormat), ColourConverter::isaName(isa), width, height);
+					return false;
+				}
+				std::vector<unsigned char> shifted(out, out + destSize + 2 * GUARD_BYTES);
+				if (!guarded(shifted, destSize) ||
+				    memcmp(&expected[GUARD_BYTES], &shifted[GUARD_BYTES], destSize) != 0) {
+					printf("  %s to %s (%s) differs at %dx%d%s, offset %d\n",
+					       ColourConverter::formatName(srcFormat), ColourConverter::formatName(destFormat),
+					       ColourConverter::isaName(isa), width, height, flip ? " flipped" : "", offset);
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+static void testKernels()
+{
+	ColourConverter::Isa best = ColourConverter::supportedIsa();
+	printf("supported: %s\n", ColourConverter::isaName(best));
+	for (int isa = ColourConverter::ISA_SCALAR; isa <= best; isa++) {
+		for (int s = 0; s < ColourConverter::FORMAT_COUNT; s++) {
+			for (int d = 0; d < ColourConverter::FORMAT_COUNT; d++) {
+				ColourConverter::Format srcFormat = (ColourConverter::Format)s;
+				ColourConverter::Format destFormat = (ColourConverter::Format)d;
+				if (!ColourConverter::canConvert(srcFormat, destFormat))
+					continue;
+				bool passed = true;
+				for (int offset = 0; offset < 4 && passed; offset++)
+					passed = matchesScalar(srcFormat, destFormat, (ColourConverter::Isa)isa, offset);
+				char what[96];
+				snprintf(what, sizeof(what), "%s to %s (%s) matches scalar",
+				         ColourConverter::formatName(srcFormat), ColourConverter::formatName(destFormat),
+				         ColourConverter::isaName((ColourConverter::Isa)isa));
+				check(passed, what);
+			}
+		}
+	}
+}
+
+/*
+ * Frames the converter cannot take are refused without touching the destination, and
+ * a set above the processor's falls back to the best it has.
+ */
+static void testRefusals()
+{
+	unsigned char src[64] = {0};
+	unsigned char dest[64];
+	memset(dest, GUARD, sizeof(dest));
+	bool untouched = !ColourConverter::convert(src, ColourConverter::UYVY, dest, ColourConverter::RGB24, 3, 1) &&
+	                 !ColourConverter::convert(src, ColourConverter::YUYV, dest, ColourConverter::GRAY8, 5, 2) &&
+	                 !ColourConverter::convert(src, ColourConverter::RGB24, dest, ColourConverter::UYVY, 4, 1) &&
+	                 !ColourConverter::convert(src, ColourConverter::RGB24, dest, ColourConverter::GRAY8, 0, 1) &&
+	                 !ColourConverter::convert(NULL, ColourConverter::RGB24, dest, ColourConverter::GRAY8, 4, 1);
+	for (size_t i = 0; i < sizeof(dest); i++)
+		if (dest[i] != GUARD)
+			untouched = false;
+	check(untouched, "odd YUV widths and unsupported conversions are refused");
+
+	std::vector<unsigned char> rgb(MAX_WIDTH * 3), best(MAX_WIDTH), above(MAX_WIDTH);
+	fill(rgb, 1);
+	ColourConverter::convert(&rgb[0], ColourConverter::RGB24, &best[0], ColourConverter::GRAY8,
+	                         MAX_WIDTH, 1, false);
+	ColourConverter::convert(&rgb[0], ColourConverter::RGB24, &above[0], ColourConverter::GRAY8,
+	                         MAX_WIDTH, 1, false, ColourConverter::ISA_AVX2);
+	check(best == above, "a set above the processor's falls back to the best it has");
+}
+
+int main()
+{
+	testKernels();
+	testRefusals();
+	printf("%d failed\n", failures);
+	return failures ? 1 : 0;
+}
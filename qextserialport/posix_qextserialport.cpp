@@ -0,0 +1,708 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include "posix_qextserialport.h"
+
+
+/*!
+\fn Posix_QextSerialPort::Posix_QextSerialPort()
+Default constructor.  Note that the name of the device used by a Posix_QextSerialPort constructed
+with this constructor will be determined by #defined constants, or lack thereof - the default
+behavior is the same as _TTY_LINUX_.  See QextSerialPort::QextSerialPort() for the constants.
+
+This constructor associates the object with the first port on the system, e.g. /dev/ttyS0 for
+Linux platforms.  See the other constructor if you need a port other than the first.
+*/
+Posix_QextSerialPort::Posix_QextSerialPort():
+	QextSerialBase(),
+	listener(this)
+{
+    init();
+}
+
+/*!
+\fn Posix_QextSerialPort::Posix_QextSerialPort(const Posix_QextSerialPort&)
+Copy constructor.  The copy has the name and settings of s, but is not open.
+*/
+Posix_QextSerialPort::Posix_QextSerialPort(const Posix_QextSerialPort& s):
+	QextSerialBase(s.port),
+	listener(this)
+{
+    init();
+    _queryMode = s._queryMode;
+    lastErr = s.lastErr;
+    Settings = s.Settings;
+}
+
+/*!
+\fn Posix_QextSerialPort::Posix_QextSerialPort(const QString & name)
+Constructs a serial port attached to the port specified by name.
+name is the name of the device, e.g. "/dev/ttyS0" or "/dev/ttyUSB0".
+*/
+Posix_QextSerialPort::Posix_QextSerialPort(const QString & name, QextSerialBase::QueryMode mode):
+	QextSerialBase(name),
+	listener(this)
+{
+    setQueryMode(mode);
+    init();
+}
+
+/*!
+\fn Posix_QextSerialPort::Posix_QextSerialPort(const PortSettings& settings)
+Constructs a port with default name and specified settings.
+*/
+Posix_QextSerialPort::Posix_QextSerialPort(const PortSettings& settings, QextSerialBase::QueryMode mode):
+	QextSerialBase(),
+	listener(this)
+{
+    init();
+    setBaudRate(settings.BaudRate);
+    setDataBits(settings.DataBits);
+    setStopBits(settings.StopBits);
+    setParity(settings.Parity);
+    setFlowControl(settings.FlowControl);
+    setTimeout(settings.Timeout_Millisec);
+    setQueryMode(mode);
+}
+
+/*!
+\fn Posix_QextSerialPort::Posix_QextSerialPort(const QString & name, const PortSettings& settings)
+Constructs a port with specified name and settings.
+*/
+Posix_QextSerialPort::Posix_QextSerialPort(const QString & name, const PortSettings& settings, QextSerialBase::QueryMode mode):
+	QextSerialBase(name),
+	listener(this)
+{
+    init();
+    setBaudRate(settings.BaudRate);
+    setDataBits(settings.DataBits);
+    setStopBits(settings.StopBits);
+    setParity(settings.Parity);
+    setFlowControl(settings.FlowControl);
+    setTimeout(settings.Timeout_Millisec);
+    setQueryMode(mode);
+}
+
+void Posix_QextSerialPort::init()
+{
+	channel = 0;
+	memset(&Posix_CommConfig, 0, sizeof(Posix_CommConfig));
+}
+
+/*!
+\fn Posix_QextSerialPort::~Posix_QextSerialPort()
+Standard destructor.
+*/
+Posix_QextSerialPort::~Posix_QextSerialPort()
+{
+    if (isOpen()) {
+        close();
+    }
+}
+
+/*!
+\fn Posix_QextSerialPort& Posix_QextSerialPort::operator=(const Posix_QextSerialPort& s)
+Overrides the = operator.  This port is closed and takes the name and settings of s.
+*/
+Posix_QextSerialPort& Posix_QextSerialPort::operator=(const Posix_QextSerialPort& s)
+{
+    if (this != &s) {
+        close();
+        _queryMode = s._queryMode;
+        lastErr = s.lastErr;
+        port = s.port;
+        Settings = s.Settings;
+    }
+    return *this;
+}
+
+/*!
+\fn bool Posix_QextSerialPort::open(OpenMode mode)
+Opens the serial port associated to this class, non-blocking and without becoming its
+controlling terminal, and configures it to the current settings, as stored in the Settings
+structure (raw 8-bit input and output otherwise).  This function has no effect if the port
+associated with the class is already open.
+*/
+bool Posix_QextSerialPort::open(OpenMode mode)
+{
+    LOCK_MUTEX();
+    if (mode == QIODevice::NotOpen) {
+        UNLOCK_MUTEX();
+        return isOpen();
+    }
+    if (isOpen()) {
+        UNLOCK_MUTEX();
+        return false;
+    }
+
+    /*open the port*/
+    int fd = ::open(port.toLocal8Bit().constData(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) {
+        translateError(errno);
+        UNLOCK_MUTEX();
+        return false;
+    }
+    if (tcgetattr(fd, &Posix_CommConfig) < 0) {
+        translateError(errno);
+        ::close(fd);
+        UNLOCK_MUTEX();
+        return false;
+    }
+
+    /*set up parameters*/
+    /*the input is flushed once here, not by every setting applied below*/
+    tcflush(fd, TCIOFLUSH);
+    cfmakeraw(&Posix_CommConfig);
+    Posix_CommConfig.c_cflag |= CREAD | CLOCAL;
+    Posix_CommConfig.c_cc[VMIN] = 0;
+    Posix_CommConfig.c_cc[VTIME] = 0;
+
+    channel = new Posix_QextSerialChannel(fd, &listener);
+    setBaudRate(Settings.BaudRate);
+    setDataBits(Settings.DataBits);
+    setStopBits(Settings.StopBits);
+    setParity(Settings.Parity);
+    setFlowControl(Settings.FlowControl);
+    setTimeout(Settings.Timeout_Millisec);
+    applyConfig();
+
+    if (!channel->open()) {
+        qWarning("Posix_QextSerialPort: could not watch %s", port.toLocal8Bit().constData());
+        delete channel;
+        channel = 0;
+        UNLOCK_MUTEX();
+        return false;
+    }
+    lastErr = E_NO_ERROR;
+    QIODevice::open(mode);
+    UNLOCK_MUTEX();
+    return isOpen();
+}
+
+/*!
+\fn void Posix_QextSerialPort::close()
+Closes a serial port.  This function has no effect if the serial port associated with the class
+is not currently open.  Bytes queued but not yet taken by the device are dropped; call flush()
+first to keep them.
+*/
+void Posix_QextSerialPort::close()
+{
+    LOCK_MUTEX();
+    if (isOpen()) {
+        delete channel;
+        channel = 0;
+        QIODevice::close();
+    }
+    UNLOCK_MUTEX();
+}
+
+/*!
+\fn void Posix_QextSerialPort::flush()
+Waits until the bytes queued by write() have been taken by the device.  This function has no
+effect if the serial port associated with the class is not currently open.
+*/
+void Posix_QextSerialPort::flush()
+{
+    LOCK_MUTEX();
+    if (isOpen()) {
+        channel->waitForWritten(-1);
+        tcdrain(channel->fd());
+    }
+    UNLOCK_MUTEX();
+}
+
+/*!
+\fn qint64 Posix_QextSerialPort::size() const
+This function will return the number of bytes received but not yet read.  It is included
+primarily to provide a complete QIODevice interface.
+*/
+qint64 Posix_QextSerialPort::size() const
+{
+    if (!channel)
+        return 0;
+    return (qint64)channel->bytesAvailable();
+}
+
+/*!
+\fn qint64 Posix_QextSerialPort::bytesAvailable()
+Returns the number of bytes received but not yet read.  This function will return 0 if the port
+is not currently open.
+*/
+qint64 Posix_QextSerialPort::bytesAvailable()
+{
+    LOCK_MUTEX();
+    qint64 available = 0;
+    if (isOpen()) {
+        available = (qint64)channel->bytesAvailable() + QIODevice::bytesAvailable();
+    }
+    UNLOCK_MUTEX();
+    return available;
+}
+
+/*!
+\fn qint64 Posix_QextSerialPort::bytesToWrite() const
+Returns the number of bytes written but not yet taken by the device.
+*/
+qint64 Posix_QextSerialPort::bytesToWrite() const
+{
+    if (!channel)
+        return 0;
+    return (qint64)channel->bytesToWrite();
+}
+
+/*!
+\fn void Posix_QextSerialPort::translateError(ulong error)
+Translates a system-specific error code (an errno) to a QextSerialPort error code.  Used internally.
+*/
+void Posix_QextSerialPort::translateError(ulong error)
+{
+    switch (error) {
+        case EBADF:
+        case ENOTTY:
+            lastErr = E_INVALID_FD;
+            break;
+        case EINTR:
+            lastErr = E_CAUGHT_NON_BLOCKED_SIGNAL;
+            break;
+        case ENOMEM:
+            lastErr = E_NO_MEMORY;
+            break;
+        case ENOENT:
+        case ENODEV:
+        case ENXIO:
+            lastErr = E_INVALID_DEVICE;
+            break;
+        case EIO:
+            lastErr = E_IO_ERROR;
+            break;
+        default:
+            lastErr = E_IO_ERROR;
+            break;
+    }
+}
+
+/*!
+\fn qint64 Posix_QextSerialPort::readData(char *data, qint64 maxSize)
+Reads a block of data from the serial port.  This function will read at most maxSize bytes from
+the serial port and place them in the buffer pointed to by data.  Return value is the number of
+bytes actually read, or -1 on error.  In polling mode, with nothing received yet, it waits up to
+the timeout for the first byte.
+
+\warning before calling this function ensure that serial port associated with this class
+is currently open (use isOpen() function to check if port is open).
+*/
+qint64 Posix_QextSerialPort::readData(char *data, qint64 maxSize)
+{
+    LOCK_MUTEX();
+    if (queryMode() == QextSerialBase::Polling && Settings.Timeout_Millisec > 0)
+        channel->waitForReadable((int)Settings.Timeout_Millisec);
+    qint64 retVal = (qint64)channel->read(data, (long long)maxSize);
+    if (retVal == 0 && channel->error()) {
+        lastErr = E_READ_FAILED;
+        retVal = -1;
+    }
+    UNLOCK_MUTEX();
+    return retVal;
+}
+
+/*!
+\fn qint64 Posix_QextSerialPort::writeData(const char *data, qint64 maxSize)
+Writes a block of data to the serial port.  This function will write maxSize bytes from the
+buffer pointed to by data to the serial port, queueing what the device does not take at once.
+Return value is the number of bytes written (all of them), or -1 on error.
+
+\warning before calling this function ensure that serial port associated with this class
+is currently open (use isOpen() function to check if port is open).
+*/
+qint64 Posix_QextSerialPort::writeData(const char *data, qint64 maxSize)
+{
+    LOCK_MUTEX();
+    qint64 retVal = (qint64)channel->write(data, (long long)maxSize);
+    if (retVal < 0)
+        lastErr = E_WRITE_FAILED;
+    UNLOCK_MUTEX();
+    return retVal;
+}
+
+/*!
+\fn void Posix_QextSerialPort::ungetChar(char c)
+This function is included to implement the full QIODevice interface, and currently has no
+purpose within this class.  This function is meaningless on an unbuffered device and currently
+only prints a warning message to that effect.
+*/
+void Posix_QextSerialPort::ungetChar(char)
+{
+    /*meaningless on unbuffered sequential device - return error and print a warning*/
+    TTY_WARNING("Posix_QextSerialPort: ungetChar() called on an unbuffered sequential device - operation is meaningless");
+}
+
+/*!
+\fn void Posix_QextSerialPort::setFlowControl(FlowType flow)
+Sets the flow control used by the port.  Possible values of flow are:
+\verbatim
+    FLOW_OFF            No flow control
+    FLOW_HARDWARE       Hardware (RTS/CTS) flow control
+    FLOW_XONXOFF        Software (XON/XOFF) flow control
+\endverbatim
+*/
+void Posix_QextSerialPort::setFlowControl(FlowType flow)
+{
+    LOCK_MUTEX();
+    Settings.FlowControl = flow;
+    if (channel) {
+        switch (flow) {
+
+            /*no flow control*/
+            case FLOW_OFF:
+                Posix_CommConfig.c_cflag &= ~CRTSCTS;
+                Posix_CommConfig.c_iflag &= ~(IXON | IXOFF | IXANY);
+                break;
+
+            /*software (XON/XOFF) flow control*/
+            case FLOW_XONXOFF:
+                Posix_CommConfig.c_cflag &= ~CRTSCTS;
+                Posix_CommConfig.c_iflag |= IXON | IXOFF;
+                Posix_CommConfig.c_iflag &= ~IXANY;
+                break;
+
+            case FLOW_HARDWARE:
+                Posix_CommConfig.c_cflag |= CRTSCTS;
+                Posix_CommConfig.c_iflag &= ~(IXON | IXOFF | IXANY);
+                break;
+        }
+        applyConfig();
+    }
+    UNLOCK_MUTEX();
+}
+
+/*!
+\fn void Posix_QextSerialPort::setParity(ParityType parity)
+Sets the parity associated with the serial port.  The possible values of parity are:
+\verbatim
+    PAR_SPACE       Space Parity
+    PAR_MARK        Mark Parity
+    PAR_NONE        No Parity
+    PAR_EVEN        Even Parity
+    PAR_ODD         Odd Parity
+\endverbatim
+
+\note
+Mark and space parity need CMSPAR (Linux); elsewhere no parity is used instead.
+*/
+void Posix_QextSerialPort::setParity(ParityType parity)
+{
+    LOCK_MUTEX();
+    Settings.Parity = parity;
+    if (channel) {
+        Posix_CommConfig.c_cflag &= ~(PARENB | PARODD);
+#ifdef CMSPAR
+        Posix_CommConfig.c_cflag &= ~CMSPAR;
+#endif
+        Posix_CommConfig.c_iflag &= ~INPCK;
+        switch (parity) {
+
+            /*no parity*/
+            case PAR_NONE:
+                break;
+
+            /*even parity*/
+            case PAR_EVEN:
+                Posix_CommConfig.c_cflag |= PARENB;
+                Posix_CommConfig.c_iflag |= INPCK;
+                break;
+
+            /*odd parity*/
+            case PAR_ODD:
+                Posix_CommConfig.c_cflag |= PARENB | PARODD;
+                Posix_CommConfig.c_iflag |= INPCK;
+                break;
+
+            /*mark and space parity - stick parity, where supported*/
+            case PAR_MARK:
+            case PAR_SPACE:
+#ifdef CMSPAR
+                Posix_CommConfig.c_cflag |= PARENB | CMSPAR | ((parity == PAR_MARK) ? PARODD : 0);
+                Posix_CommConfig.c_iflag |= INPCK;
+#else
+                TTY_PORTABILITY_WARNING("Posix_QextSerialPort Portability Warning: Mark and space parity are not supported by this system.");
+#endif
+                break;
+        }
+        applyConfig();
+    }
+    UNLOCK_MUTEX();
+}
+
+/*!
+\fn void Posix_QextSerialPort::setDataBits(DataBitsType dataBits)
+Sets the number of data bits used by the serial port.  Possible values of dataBits are:
+\verbatim
+    DATA_5      5 data bits
+    DATA_6      6 data bits
+    DATA_7      7 data bits
+    DATA_8      8 data bits
+\endverbatim
+*/
+void Posix_QextSerialPort::setDataBits(DataBitsType dataBits)
+{
+    LOCK_MUTEX();
+    Settings.DataBits = dataBits;
+    if (channel) {
+        Posix_CommConfig.c_cflag &= ~CSIZE;
+        switch (dataBits) {
+            case DATA_5:
+                Posix_CommConfig.c_cflag |= CS5;
+                break;
+            case DATA_6:
+                Posix_CommConfig.c_cflag |= CS6;
+                break;
+            case DATA_7:
+                Posix_CommConfig.c_cflag |= CS7;
+                break;
+            case DATA_8:
+                Posix_CommConfig.c_cflag |= CS8;
+                break;
+        }
+        applyConfig();
+    }
+    UNLOCK_MUTEX();
+}
+
+/*!
+\fn void Posix_QextSerialPort::setStopBits(StopBitsType stopBits)
+Sets the number of stop bits used by the serial port.  Possible values of stopBits are:
+\verbatim
+    STOP_1      1 stop bit
+    STOP_1_5    1.5 stop bits (WINDOWS ONLY)
+    STOP_2      2 stop bits
+\endverbatim
+*/
+void Posix_QextSerialPort::setStopBits(StopBitsType stopBits)
+{
+    LOCK_MUTEX();
+    if (stopBits == STOP_1_5) {
+        TTY_PORTABILITY_WARNING("Posix_QextSerialPort: 1.5 stop bit operation is not supported by POSIX.  Switching to 1 stop bit.");
+        stopBits = STOP_1;
+    }
+    Settings.StopBits = stopBits;
+    if (channel) {
+        if (stopBits == STOP_2)
+            Posix_CommConfig.c_cflag |= CSTOPB;
+        else
+            Posix_CommConfig.c_cflag &= ~CSTOPB;
+        applyConfig();
+    }
+    UNLOCK_MUTEX();
+}
+
+/*!
+\fn void Posix_QextSerialPort::setBaudRate(BaudRateType baudRate)
+Sets the baud rate of the serial port.  The rates only Windows supports are replaced by the
+nearest slower POSIX rate:
+\verbatim
+
+  baudRate             POSIX
+  --------            ------
+   BAUD14400            9600
+   BAUD56000           38400
+   BAUD128000         115200
+   BAUD256000         115200
+\endverbatim
+*/
+void Posix_QextSerialPort::setBaudRate(BaudRateType baudRate)
+{
+    LOCK_MUTEX();
+    speed_t speed = B115200;
+    switch (baudRate) {
+        case BAUD50:      speed = B50;     break;
+        case BAUD75:      speed = B75;     break;
+        case BAUD110:     speed = B110;    break;
+        case BAUD134:     speed = B134;    break;
+        case BAUD150:     speed = B150;    break;
+        case BAUD200:     speed = B200;    break;
+        case BAUD300:     speed = B300;    break;
+        case BAUD600:     speed = B600;    break;
+        case BAUD1200:    speed = B1200;   break;
+        case BAUD1800:    speed = B1800;   break;
+        case BAUD2400:    speed = B2400;   break;
+        case BAUD4800:    speed = B4800;   break;
+        case BAUD9600:    speed = B9600;   break;
+        case BAUD19200:   speed = B19200;  break;
+        case BAUD38400:   speed = B38400;  break;
+        case BAUD57600:   speed = B57600;  break;
+        case BAUD115200:  speed = B115200; break;
+
+        /*76800 baud*/
+        case BAUD76800:
+#ifdef B76800
+            speed = B76800;
+#else
+            TTY_PORTABILITY_WARNING("Posix_QextSerialPort: 76800 baud operation is not supported by this system.  Switching to 57600 baud.");
+            baudRate = BAUD57600;
+            speed = B57600;
+#endif
+            break;
+
+        /*WINDOWS ONLY*/
+        case BAUD14400:
+            TTY_PORTABILITY_WARNING("Posix_QextSerialPort Portability Warning: POSIX does not support 14400 baud operation.  Switching to 9600 baud.");
+            baudRate = BAUD9600;
+            speed = B9600;
+            break;
+        case BAUD56000:
+            TTY_PORTABILITY_WARNING("Posix_QextSerialPort Portability Warning: POSIX does not support 56000 baud operation.  Switching to 38400 baud.");
+            baudRate = BAUD38400;
+            speed = B38400;
+            break;
+        case BAUD128000:
+        case BAUD256000:
+            TTY_PORTABILITY_WARNING("Posix_QextSerialPort Portability Warning: POSIX does not support this baud rate.  Switching to 115200 baud.");
+            baudRate = BAUD115200;
+            speed = B115200;
+            break;
+    }
+    Settings.BaudRate = baudRate;
+    if (channel) {
+        cfsetispeed(&Posix_CommConfig, speed);
+        cfsetospeed(&Posix_CommConfig, speed);
+        applyConfig();
+    }
+    UNLOCK_MUTEX();
+}
+
+/*!
+\fn void Posix_QextSerialPort::setDtr(bool set)
+Sets DTR line to the requested state (high by default).  This function will have no effect if
+the port associated with the class is not currently open.
+*/
+void Posix_QextSerialPort::setDtr(bool set)
+{
+    LOCK_MUTEX();
+    if (isOpen()) {
+        int bits = TIOCM_DTR;
+        ioctl(channel->fd(), set ? TIOCMBIS : TIOCMBIC, &bits);
+    }
+    UNLOCK_MUTEX();
+}
+
+/*!
+\fn void Posix_QextSerialPort::setRts(bool set)
+Sets RTS line to the requested state (high by default).  This function will have no effect if
+the port associated with the class is not currently open.
+*/
+void Posix_QextSerialPort::setRts(bool set)
+{
+    LOCK_MUTEX();
+    if (isOpen()) {
+        int bits = TIOCM_RTS;
+        ioctl(channel->fd(), set ? TIOCMBIS : TIOCMBIC, &bits);
+    }
+    UNLOCK_MUTEX();
+}
+
+/*!
+\fn ulong Posix_QextSerialPort::lineStatus(void)
+returns the line status as stored by the port function.  This function will retrieve the states
+of the following lines: DCD, CTS, DSR, RI, DTR, RTS, Secondary TXD, and Secondary RXD.  The value
+returned is an unsigned long with specific bits indicating which lines are high (see
+Win_QextSerialPort::lineStatus() for the masks).  This function will return 0 if the port
+associated with the class is not currently open, or is not a serial line (such as a pty).
+*/
+ulong Posix_QextSerialPort::lineStatus(void)
+{
+    unsigned long Status = 0;
+    int Temp = 0;
+    LOCK_MUTEX();
+    if (isOpen() && ioctl(channel->fd(), TIOCMGET, &Temp) == 0) {
+        if (Temp & TIOCM_CTS) Status |= LS_CTS;
+        if (Temp & TIOCM_DSR) Status |= LS_DSR;
+        if (Temp & TIOCM_RI)  Status |= LS_RI;
+        if (Temp & TIOCM_CD)  Status |= LS_DCD;
+        if (Temp & TIOCM_DTR) Status |= LS_DTR;
+        if (Temp & TIOCM_RTS) Status |= LS_RTS;
+#ifdef TIOCM_ST
+        if (Temp & TIOCM_ST)  Status |= LS_ST;
+        if (Temp & TIOCM_SR)  Status |= LS_SR;
+#endif
+    }
+    UNLOCK_MUTEX();
+    return Status;
+}
+
+/*!
+\fn bool Posix_QextSerialPort::waitForReadyRead(int msecs)
+Waits up to msecs milliseconds (forever if negative) for bytes to read.  Returns true if there
+are bytes to read.
+*/
+bool Posix_QextSerialPort::waitForReadyRead(int msecs)
+{
+    if (!channel)
+        return false;
+    return channel->waitForReadable(msecs);
+}
+
+/*!
+\fn bool Posix_QextSerialPort::waitForBytesWritten(int msecs)
+Waits up to msecs milliseconds (forever if negative) for the bytes written to be taken by the
+device.  Returns true if they all were.
+*/
+bool Posix_QextSerialPort::waitForBytesWritten(int msecs)
+{
+    if (!channel)
+        return false;
+    return channel->waitForWritten(msecs);
+}
+
+/*!
+\fn void Posix_QextSerialPort::setTimeout(long millisec);
+Sets the read timeout for the port to millisec milliseconds: in polling mode a read waits up to
+millisec for the first byte.  Setting 0 or -1 indicates that reads return immediately.
+
+\note this function does nothing in event driven mode.
+*/
+void Posix_QextSerialPort::setTimeout(long millisec)
+{
+    LOCK_MUTEX();
+    Settings.Timeout_Millisec = millisec;
+    UNLOCK_MUTEX();
+}
+
+void Posix_QextSerialPort::applyConfig()
+{
+    if (channel && tcsetattr(channel->fd(), TCSANOW, &Posix_CommConfig) < 0)
+        translateError(errno);
+}
+
+/*!
+\fn void Posix_QextSerialPort::Listener::channelReadable()
+Called on the reactor thread when bytes arrive.
+*/
+void Posix_QextSerialPort::Listener::channelReadable()
+{
+	if (qesp->queryMode() == QextSerialBase::EventDriven)
+		emit qesp->readyRead();
+}
+
+/*!
+\fn void Posix_QextSerialPort::Listener::channelWritten(long long bytes)
+Called on the reactor thread when a queued write has drained.
+*/
+void Posix_QextSerialPort::Listener::channelWritten(long long bytes)
+{
+	if (qesp->queryMode() == QextSerialBase::EventDriven)
+		emit qesp->bytesWritten((qint64)bytes);
+}
+
+/*!
+\fn void Posix_QextSerialPort::Listener::channelError(int error)
+Called on the reactor thread when the device fails or hangs up (such as a USB adapter being
+unplugged), which is reported as DSR dropping.  The error itself is reported by the next read
+or write.
+*/
+void Posix_QextSerialPort::Listener::channelError(int)
+{
+	if (qesp->queryMode() == QextSerialBase::EventDriven)
+		emit qesp->dsrChanged(false);
+}
@@ -0,0 +1,101 @@
+#ifndef _POSIX_QEXTSERIALPORT_H_
+#define _POSIX_QEXTSERIALPORT_H_
+
+#include <termios.h>
+#include "qextserialbase.h"
+#include "posix_qextserialreactor.h"
+
+
+/*!
+\author Ross Mead
+
+A cross-platform serial port class.
+This class encapsulates the POSIX portion of QextSerialPort.  The user will be notified of errors
+and possible portability conflicts at run-time by default - this behavior can be turned off by
+defining _TTY_NOWARN_ (to turn off all warnings) or _TTY_NOWARN_PORT_ (to turn off portability
+warnings) in the project.  Note that defining _TTY_NOWARN_ also defines _TTY_NOWARN_PORT_.
+
+The port is opened non-blocking and handed to the Posix_QextSerialReactor, one thread that serves
+every open port, so reads and writes never wait on the device: read() takes what the reactor has
+received, and write() queues what the device does not take at once.  In event driven mode the
+reactor thread emits readyRead() as bytes arrive and bytesWritten() as a queued write drains.
+In polling mode read() waits up to the timeout for the first byte, as a tty with VTIME would.
+
+\note
+The copy constructor and assign operator copy the name and settings only; the copy is closed.
+*/
+class Posix_QextSerialPort: public QextSerialBase
+{
+	Q_OBJECT
+
+	private:
+		/*!
+		 * This method is a part of constructor.
+		 */
+		void init();
+
+		/*!
+		 * Apply Posix_CommConfig to the open port.
+		 */
+		void applyConfig();
+
+		/*!
+		 * Emits the signals of the port for the events of its channel, on the reactor thread.
+		 * A member rather than a base, so that the port being destroyed does not race the
+		 * reactor until its channel is closed.
+		 */
+		class Listener: public Posix_QextSerialListener
+		{
+			Posix_QextSerialPort * qesp;
+
+			public:
+				Listener(Posix_QextSerialPort * qesp) { this->qesp = qesp; }
+				virtual void channelReadable();
+				virtual void channelWritten(long long bytes);
+				virtual void channelError(int error);
+		};
+		friend class Listener;
+		Listener listener;
+
+	protected:
+		struct termios Posix_CommConfig;
+		Posix_QextSerialChannel * channel;
+
+	    virtual qint64 readData(char *data, qint64 maxSize);
+	    virtual qint64 writeData(const char *data, qint64 maxSize);
+
+	public:
+	    Posix_QextSerialPort();
+	    Posix_QextSerialPort(const Posix_QextSerialPort& s);
+	    Posix_QextSerialPort(const QString & name, QextSerialBase::QueryMode mode = QextSerialBase::Polling);
+	    Posix_QextSerialPort(const PortSettings& settings, QextSerialBase::QueryMode mode = QextSerialBase::Polling);
+	    Posix_QextSerialPort(const QString & name, const PortSettings& settings, QextSerialBase::QueryMode mode = QextSerialBase::Polling);
+	    Posix_QextSerialPort& operator=(const Posix_QextSerialPort& s);
+	    virtual ~Posix_QextSerialPort();
+	    virtual bool open(OpenMode mode);
+	    virtual void close();
+	    virtual void flush();
+	    virtual qint64 size() const;
+	    virtual void ungetChar(char c);
+	    virtual void setFlowControl(FlowType);
+	    virtual void setParity(ParityType);
+	    virtual void setDataBits(DataBitsType);
+	    virtual void setStopBits(StopBitsType);
+	    virtual void setBaudRate(BaudRateType);
+	    virtual void setDtr(bool set=true);
+	    virtual void setRts(bool set=true);
+	    virtual ulong lineStatus(void);
+	    virtual qint64 bytesAvailable();
+	    virtual void translateError(ulong);
+	    virtual void setTimeout(long);
+
+	    /*!
+	     * Return number of bytes written but not yet taken by the device.
+	     */
+		virtual qint64 bytesToWrite() const;
+
+		virtual bool waitForReadyRead(int msecs);
+		virtual bool waitForBytesWritten(int msecs);
+};
+
+#endif
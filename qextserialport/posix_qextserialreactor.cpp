@@ -0,0 +1,546 @@
+#include "posix_qextserialreactor.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#ifdef __linux__
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+/*events taken from the kernel at a time*/
+#define REACTOR_MAX_EVENTS 32
+
+
+/*!
+\fn Posix_QextSerialChannel::Posix_QextSerialChannel(int fd, Posix_QextSerialListener * listener)
+Constructs a channel for the descriptor of an open port, which the channel closes when it is
+closed itself. The listener (if any) is told of its events once the channel is opened.
+*/
+Posix_QextSerialChannel::Posix_QextSerialChannel(int fd, Posix_QextSerialListener * listener)
+{
+	_fd = fd;
+	this->listener = listener;
+	reactor = 0;
+	token = 0;
+	rxHead = 0;
+	txHead = 0;
+	writeArmed = false;
+	lastError = 0;
+}
+
+/*!
+\fn Posix_QextSerialChannel::~Posix_QextSerialChannel()
+Standard destructor.
+*/
+Posix_QextSerialChannel::~Posix_QextSerialChannel()
+{
+	close();
+}
+
+/*!
+\fn bool Posix_QextSerialChannel::open()
+Hands the channel to the reactor. Returns false if the reactor could not watch the descriptor.
+*/
+bool Posix_QextSerialChannel::open()
+{
+	if (_fd < 0 || reactor)
+		return false;
+	if (!Posix_QextSerialReactor::instance()->add(this))
+		return false;
+	reactor = Posix_QextSerialReactor::instance();
+	return true;
+}
+
+/*!
+\fn void Posix_QextSerialChannel::close()
+Takes the channel from the reactor (waiting out an event being delivered), closes the descriptor
+and drops the bytes still buffered either way.
+*/
+void Posix_QextSerialChannel::close()
+{
+	if (reactor) {
+		reactor->remove(this);
+		reactor = 0;
+	}
+	std::lock_guard<std::mutex> guard(lock);
+	if (_fd >= 0) {
+		::close(_fd);
+		_fd = -1;
+	}
+	rx.clear();
+	rxHead = 0;
+	tx.clear();
+	txHead = 0;
+	writeArmed = false;
+	changed.notify_all();
+}
+
+/*!
+\fn long long Posix_QextSerialChannel::read(char * data, long long maxSize)
+Takes up to maxSize received bytes without waiting. Returns the number of bytes read.
+*/
+long long Posix_QextSerialChannel::read(char * data, long long maxSize)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	long long available = (long long)(rx.size() - rxHead);
+	long long n = (maxSize < available) ? maxSize : available;
+	if (n <= 0)
+		return 0;
+	memcpy(data, &rx[rxHead], (size_t)n);
+	rxHead += (size_t)n;
+	if (rxHead == rx.size()) {
+		rx.clear();
+		rxHead = 0;
+	}
+	else if (rxHead >= REACTOR_READ_CHUNK && rxHead * 2 >= rx.size()) {
+		rx.erase(rx.begin(), rx.begin() + rxHead);
+		rxHead = 0;
+	}
+	return n;
+}
+
+/*!
+\fn long long Posix_QextSerialChannel::write(const char * data, long long size)
+Writes as much of data as the port takes now and queues the rest for the reactor, without
+waiting. Returns size, or -1 if the port has failed.
+*/
+long long Posix_QextSerialChannel::write(const char * data, long long size)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	if (_fd < 0 || lastError)
+		return -1;
+
+	long long taken = 0;
+	if (txHead == tx.size()) {
+		/*nothing queued, so the bytes can go straight out*/
+		while (taken < size) {
+			ssize_t n = ::write(_fd, data + taken, (size_t)(size - taken));
+			if (n > 0)
+				taken += n;
+			else if (n < 0 && errno == EINTR)
+				continue;
+			else if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+				lastError = errno;
+				return -1;
+			}
+			else
+				break;
+		}
+	}
+	if (taken < size) {
+		tx.insert(tx.end(), data + taken, data + size);
+		if (!writeArmed && reactor) {
+			writeArmed = true;
+			reactor->armWrite(this, true);
+		}
+	}
+	return size;
+}
+
+/*!
+\fn long long Posix_QextSerialChannel::bytesAvailable() const
+Returns the number of bytes received but not yet read.
+*/
+long long Posix_QextSerialChannel::bytesAvailable() const
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return (long long)(rx.size() - rxHead);
+}
+
+/*!
+\fn long long Posix_QextSerialChannel::bytesToWrite() const
+Returns the number of bytes written but not yet taken by the port.
+*/
+long long Posix_QextSerialChannel::bytesToWrite() const
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return (long long)(tx.size() - txHead);
+}
+
+/*!
+\fn int Posix_QextSerialChannel::error() const
+Returns the errno of the failure that stopped the channel, or 0.
+*/
+int Posix_QextSerialChannel::error() const
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return lastError;
+}
+
+bool Posix_QextSerialChannel::readable() const
+{
+	return rxHead < rx.size();
+}
+
+bool Posix_QextSerialChannel::written() const
+{
+	return txHead == tx.size();
+}
+
+bool Posix_QextSerialChannel::waitForReadable(int msecs)
+{
+	return waitFor(&Posix_QextSerialChannel::readable, msecs);
+}
+
+bool Posix_QextSerialChannel::waitForWritten(int msecs)
+{
+	return waitFor(&Posix_QextSerialChannel::written, msecs);
+}
+
+bool Posix_QextSerialChannel::waitFor(bool (Posix_QextSerialChannel::*ready)() const, int msecs)
+{
+	std::unique_lock<std::mutex> guard(lock);
+	/*a failed or closed channel will not become ready*/
+	while (!(this->*ready)() && _fd >= 0 && !lastError) {
+		if (msecs < 0)
+			changed.wait(guard);
+		else if (changed.wait_for(guard, std::chrono::milliseconds(msecs)) == std::cv_status::timeout)
+			break;
+	}
+	return (this->*ready)();
+}
+
+/*!
+\fn void Posix_QextSerialChannel::onReadable()
+Reads everything the port has received. Called by the reactor.
+*/
+void Posix_QextSerialChannel::onReadable()
+{
+	char chunk[REACTOR_READ_CHUNK];
+	bool received = false;
+	int failure = 0;
+	for (;;) {
+		ssize_t n = ::read(_fd, chunk, sizeof(chunk));
+		if (n > 0) {
+			std::lock_guard<std::mutex> guard(lock);
+			rx.insert(rx.end(), chunk, chunk + n);
+			received = true;
+			if (n < (ssize_t)sizeof(chunk))
+				break;
+		}
+		else if (n < 0 && errno == EINTR)
+			continue;
+		else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			break;
+		else {
+			/*end of file: the other end hung up*/
+			failure = (n == 0) ? EIO : errno;
+			break;
+		}
+	}
+	if (received)
+		changed.notify_all();
+	if (failure)
+		onError(failure);
+	else if (received && listener)
+		listener->channelReadable();
+}
+
+/*!
+\fn void Posix_QextSerialChannel::onWritable()
+Writes as much of the queue as the port takes. Called by the reactor.
+*/
+void Posix_QextSerialChannel::onWritable()
+{
+	long long drained = 0;
+	int failure = 0;
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		while (txHead < tx.size()) {
+			ssize_t n = ::write(_fd, &tx[txHead], tx.size() - txHead);
+			if (n > 0)
+				txHead += n;
+			else if (n < 0 && errno == EINTR)
+				continue;
+			else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+				break;
+			else {
+				failure = errno;
+				break;
+			}
+		}
+		if (txHead == tx.size()) {
+			drained = (long long)tx.size();
+			tx.clear();
+			txHead = 0;
+			writeArmed = false;
+			reactor->armWrite(this, false);
+		}
+	}
+	changed.notify_all();
+	if (failure)
+		onError(failure);
+	else if (drained && listener)
+		listener->channelWritten(drained);
+}
+
+/*!
+\fn void Posix_QextSerialChannel::onError(int error)
+Stops the channel after the port failed (or hung up). Called by the reactor.
+*/
+void Posix_QextSerialChannel::onError(int error)
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (lastError)
+			return;
+		lastError = error;
+	}
+	changed.notify_all();
+	if (listener)
+		listener->channelError(error);
+}
+
+
+/*!
+\fn Posix_QextSerialReactor * Posix_QextSerialReactor::instance()
+Returns the reactor shared by all ports.
+*/
+Posix_QextSerialReactor * Posix_QextSerialReactor::instance()
+{
+	static Posix_QextSerialReactor reactor;
+	return &reactor;
+}
+
+Posix_QextSerialReactor::Posix_QextSerialReactor()
+{
+	stopping = false;
+	nextToken = 1;
+	wakeFds[0] = wakeFds[1] = -1;
+	if (pipe(wakeFds) == 0) {
+		fcntl(wakeFds[0], F_SETFL, fcntl(wakeFds[0], F_GETFL) | O_NONBLOCK);
+		fcntl(wakeFds[1], F_SETFL, fcntl(wakeFds[1], F_GETFL) | O_NONBLOCK);
+	}
+#ifdef __linux__
+	epollFd = epoll_create1(EPOLL_CLOEXEC);
+	if (epollFd >= 0 && wakeFds[0] >= 0) {
+		struct epoll_event event;
+		event.events = EPOLLIN;
+		event.data.u64 = 0;
+		epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFds[0], &event);
+	}
+#endif
+}
+
+/*!
+\fn Posix_QextSerialReactor::~Posix_QextSerialReactor()
+Stops the reactor thread. Every port should be closed by now.
+*/
+Posix_QextSerialReactor::~Posix_QextSerialReactor()
+{
+	{
+		std::lock_guard<std::mutex> guard(channelMutex);
+		stopping = true;
+	}
+	wake();
+	if (thread.joinable())
+		thread.join();
+#ifdef __linux__
+	if (epollFd >= 0)
+		::close(epollFd);
+#endif
+	if (wakeFds[0] >= 0) {
+		::close(wakeFds[0]);
+		::close(wakeFds[1]);
+	}
+}
+
+/*!
+\fn bool Posix_QextSerialReactor::add(Posix_QextSerialChannel * channel)
+Starts watching the descriptor of a channel (made non-blocking), starting the reactor thread
+with the first channel. The events of the descriptor carry a token new to the channel rather
+than its address, so an event taken before a channel is removed is never delivered to another
+channel later made at the same address. Returns false if the descriptor could not be watched.
+*/
+bool Posix_QextSerialReactor::add(Posix_QextSerialChannel * channel)
+{
+	if (wakeFds[0] < 0)
+		return false;
+	int flags = fcntl(channel->fd(), F_GETFL);
+	if (flags < 0 || fcntl(channel->fd(), F_SETFL, flags | O_NONBLOCK) < 0)
+		return false;
+
+	std::lock_guard<std::mutex> guard(channelMutex);
+	channel->token = nextToken++;
+#ifdef __linux__
+	struct epoll_event event;
+	event.events = EPOLLIN;
+	event.data.u64 = channel->token;
+	if (epollFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, channel->fd(), &event) < 0)
+		return false;
+#endif
+	channels.push_back(channel);
+	if (!thread.joinable())
+		thread = std::thread(&Posix_QextSerialReactor::run, this);
+	wake();
+	return true;
+}
+
+/*!
+\fn void Posix_QextSerialReactor::remove(Posix_QextSerialChannel * channel)
+Stops watching a channel. Once this returns, no event is delivered to it any more (unless it is
+removed by its own listener, on the reactor thread, in which case none is after that event).
+*/
+void Posix_QextSerialReactor::remove(Posix_QextSerialChannel * channel)
+{
+	{
+		std::lock_guard<std::mutex> guard(channelMutex);
+		for (size_t i = 0; i < channels.size(); i++)
+			if (channels[i] == channel) {
+				channels.erase(channels.begin() + i);
+				break;
+			}
+#ifdef __linux__
+		epoll_ctl(epollFd, EPOLL_CTL_DEL, channel->fd(), 0);
+#endif
+	}
+	wake();
+	std::lock_guard<std::recursive_mutex> dispatching(dispatchMutex);
+}
+
+/*!
+\fn void Posix_QextSerialReactor::armWrite(Posix_QextSerialChannel * channel, bool arm)
+Starts (or stops) waiting for the port of a channel to take more bytes. Called with the lock of
+the channel held, so its descriptor is still open.
+*/
+void Posix_QextSerialReactor::armWrite(Posix_QextSerialChannel * channel, bool arm)
+{
+#ifdef __linux__
+	struct epoll_event event;
+	event.events = (uint32_t)EPOLLIN | (arm ? (uint32_t)EPOLLOUT : 0u);
+	event.data.u64 = channel->token;
+	epoll_ctl(epollFd, EPOLL_CTL_MOD, channel->fd(), &event);
+#else
+	/*the descriptors are gathered again for the next poll*/
+	(void)channel;
+	if (arm)
+		wake();
+#endif
+}
+
+/*!
+\fn int Posix_QextSerialReactor::channelCount()
+Returns the number of channels watched.
+*/
+int Posix_QextSerialReactor::channelCount()
+{
+	std::lock_guard<std::mutex> guard(channelMutex);
+	return (int)channels.size();
+}
+
+void Posix_QextSerialReactor::wake()
+{
+	char c = 0;
+	if (wakeFds[1] >= 0 && ::write(wakeFds[1], &c, 1) < 0) {
+		/*a full pipe wakes the reactor anyway*/
+	}
+}
+
+void Posix_QextSerialReactor::run()
+{
+	for (;;) {
+		unsigned long long ready[REACTOR_MAX_EVENTS];
+		bool readable[REACTOR_MAX_EVENTS], writable[REACTOR_MAX_EVENTS], failed[REACTOR_MAX_EVENTS];
+		int count = 0;
+		bool woken = false;
+
+#ifdef __linux__
+		struct epoll_event events[REACTOR_MAX_EVENTS];
+		int n = epoll_wait(epollFd, events, REACTOR_MAX_EVENTS, -1);
+		for (int i = 0; i < n; i++) {
+			if (events[i].data.u64 == 0) {
+				woken = true;
+				continue;
+			}
+			ready[count] = events[i].data.u64;
+			readable[count] = (events[i].events & EPOLLIN) != 0;
+			writable[count] = (events[i].events & EPOLLOUT) != 0;
+			failed[count] = (events[i].events & (EPOLLERR | EPOLLHUP)) != 0;
+			count++;
+		}
+#else
+		std::vector<struct pollfd> fds;
+		std::vector<unsigned long long> watched;
+		{
+			std::lock_guard<std::mutex> guard(channelMutex);
+			if (stopping)
+				return;
+			struct pollfd wakeFd = { wakeFds[0], POLLIN, 0 };
+			fds.push_back(wakeFd);
+			for (size_t i = 0; i < channels.size(); i++) {
+				if (channels[i]->error())
+					continue;
+				struct pollfd fd = { channels[i]->fd(), (short)(POLLIN | (channels[i]->writeArmed ? POLLOUT : 0)), 0 };
+				fds.push_back(fd);
+				watched.push_back(channels[i]->token);
+			}
+		}
+		int n = poll(&fds[0], fds.size(), -1);
+		if (n > 0) {
+			woken = (fds[0].revents & POLLIN) != 0;
+			for (size_t i = 1; i < fds.size() && count < REACTOR_MAX_EVENTS; i++) {
+				if (!fds[i].revents)
+					continue;
+				ready[count] = watched[i - 1];
+				readable[count] = (fds[i].revents & POLLIN) != 0;
+				writable[count] = (fds[i].revents & POLLOUT) != 0;
+				failed[count] = (fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+				count++;
+			}
+		}
+#endif
+		if (n < 0 && errno != EINTR)
+			return;
+		if (woken) {
+			char drain[64];
+			while (::read(wakeFds[0], drain, sizeof(drain)) > 0);
+			std::lock_guard<std::mutex> guard(channelMutex);
+			if (stopping)
+				return;
+		}
+
+		std::lock_guard<std::recursive_mutex> dispatching(dispatchMutex);
+		for (int i = 0; i < count; i++)
+			dispatch(ready[i], readable[i], writable[i], failed[i]);
+	}
+}
+
+Posix_QextSerialChannel * Posix_QextSerialReactor::find(unsigned long long token)
+{
+	std::lock_guard<std::mutex> guard(channelMutex);
+	for (size_t i = 0; i < channels.size(); i++)
+		if (channels[i]->token == token)
+			return channels[i];
+	return 0;
+}
+
+void Posix_QextSerialReactor::dispatch(unsigned long long token, bool readable, bool writable, bool failed)
+{
+	/*the channel may have been removed since the events were taken, or by its own listener;
+	  one removed is not destroyed before the delivery in progress ends*/
+	Posix_QextSerialChannel * channel = find(token);
+	if (!channel || channel->error())
+		return;
+
+	/*read what is left before a hangup is reported*/
+	if (readable || failed)
+		channel->onReadable();
+	if (failed && find(token))
+		channel->onError(EIO);
+	if (!find(token))
+		return;
+
+	if (channel->error()) {
+#ifdef __linux__
+		/*a failed port stays ready, so stop watching it*/
+		epoll_ctl(epollFd, EPOLL_CTL_DEL, channel->fd(), 0);
+#endif
+		return;
+	}
+	if (writable)
+		channel->onWritable();
+}
@@ -0,0 +1,131 @@
+#ifndef _POSIX_QEXTSERIALREACTOR_H_
+#define _POSIX_QEXTSERIALREACTOR_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*size of the chunks read from a port at a time*/
+#define REACTOR_READ_CHUNK 4096
+
+/*!
+ * Receives the events of a channel, on the reactor thread.
+ */
+class Posix_QextSerialListener
+{
+	public:
+		virtual ~Posix_QextSerialListener() {}
+		virtual void channelReadable() = 0;
+		virtual void channelWritten(long long bytes) = 0;
+		virtual void channelError(int error) = 0;
+};
+
+class Posix_QextSerialReactor;
+
+/*!
+ * \author Ross Mead
+ *
+ * The non-blocking file descriptor of an open port, with the bytes received but not yet read and
+ * the bytes written but not yet taken by the port. Reads and writes never block the caller: the
+ * reactor fills the receive buffer and drains the transmit buffer as the port becomes ready.
+ * Closing the channel removes it from the reactor before the descriptor is closed, so no event
+ * is delivered to its listener afterwards.
+ */
+class Posix_QextSerialChannel
+{
+	friend class Posix_QextSerialReactor;
+
+	public:
+		Posix_QextSerialChannel(int fd, Posix_QextSerialListener * listener = 0);
+		~Posix_QextSerialChannel();
+
+		int fd() const { return _fd; }
+		bool open();
+		void close();
+
+		long long read(char * data, long long maxSize);
+		long long write(const char * data, long long size);
+		long long bytesAvailable() const;
+		long long bytesToWrite() const;
+		int error() const;
+
+		/*!
+		 * Wait up to msecs milliseconds (forever if negative) for bytes to read,
+		 * or for the bytes written to be taken by the port.
+		 */
+		bool waitForReadable(int msecs);
+		bool waitForWritten(int msecs);
+
+	private:
+		void onReadable();
+		void onWritable();
+		void onError(int error);
+		bool waitFor(bool (Posix_QextSerialChannel::*ready)() const, int msecs);
+		bool readable() const;
+		bool written() const;
+
+		int _fd;
+		Posix_QextSerialListener * listener;
+		Posix_QextSerialReactor * reactor;
+		unsigned long long token;	///< names the channel to the reactor, never reused.
+
+		mutable std::mutex lock;
+		std::condition_variable changed;
+		std::vector<char> rx;	///< received, from rxHead on.
+		size_t rxHead;
+		std::vector<char> tx;	///< to write, from txHead on.
+		size_t txHead;
+		std::atomic<bool> writeArmed;	///< the reactor waits for the port to take more.
+		int lastError;
+
+		Posix_QextSerialChannel(const Posix_QextSerialChannel &);
+		Posix_QextSerialChannel& operator=(const Posix_QextSerialChannel &);
+};
+
+/*!
+ * \author Ross Mead
+ *
+ * One thread that waits on every open port at once (with epoll on Linux, poll elsewhere) and
+ * moves the bytes between the ports and their channels, rather than a thread per port.
+ * It is started by the first channel opened.
+ */
+class Posix_QextSerialReactor
+{
+	public:
+		static Posix_QextSerialReactor * instance();
+		~Posix_QextSerialReactor();
+
+		bool add(Posix_QextSerialChannel * channel);
+		void remove(Posix_QextSerialChannel * channel);
+		void armWrite(Posix_QextSerialChannel * channel, bool arm);
+
+		int channelCount();
+
+	private:
+		Posix_QextSerialReactor();
+		void run();
+		void wake();
+		Posix_QextSerialChannel * find(unsigned long long token);
+		void dispatch(unsigned long long token, bool readable, bool writable, bool failed);
+
+		std::thread thread;
+		bool stopping;
+		int wakeFds[2];
+#ifdef __linux__
+		int epollFd;
+#endif
+
+		std::mutex channelMutex;
+		std::vector<Posix_QextSerialChannel*> channels;
+		/*the token of the next channel added (0 is the wake pipe)*/
+		unsigned long long nextToken;
+		/*held while events are delivered, so remove() waits out the one in progress*/
+		std::recursive_mutex dispatchMutex;
+
+		Posix_QextSerialReactor(const Posix_QextSerialReactor &);
+		Posix_QextSerialReactor& operator=(const Posix_QextSerialReactor &);
+};
+
+#endif
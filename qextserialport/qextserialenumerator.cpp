@@ -6,8 +6,14 @@
  
 #include "qextserialenumerator.h"
 
-#include <objbase.h>
-#include <initguid.h>
+#ifdef _TTY_WIN_
+	#include <objbase.h>
+	#include <initguid.h>
+#endif /*_TTY_WIN_*/
+#ifdef _TTY_POSIX_
+	#include <QtCore/QDir>
+	#include <QtCore/QStringList>
+#endif /*_TTY_POSIX_*/
 
 
 #ifdef _TTY_WIN_
@@ -149,7 +155,16 @@ QList<QextPortInfo> QextSerialEnumerator::getPorts()
 			setupAPIScan(ports);
 	#endif /*_TTY_WIN_*/
 	#ifdef _TTY_POSIX_
-		qCritical("Enumeration for POSIX systems is not implemented yet.");
+		//USB serial adapters, as the radios of the rovers are attached
+		QStringList names = QDir("/dev").entryList(QStringList("ttyUSB*"), QDir::System, QDir::Name);
+		for (int i = 0; i < names.size(); i++) {
+			QextPortInfo info;
+			info.portName = names.at(i);
+			info.physName = "/dev/" + names.at(i);
+			info.friendName = names.at(i);
+			info.enumName = "/dev";
+			ports.append(info);
+		}
 	#endif /*_TTY_POSIX_*/
 	
 	return ports;
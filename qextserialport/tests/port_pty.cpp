@@ -0,0 +1,88 @@
+/*
+ * Exercises Posix_QextSerialPort against an openpty() pair: the slave is opened by name as the
+ * station opens a rover's port, and the master plays the rover. Returns 0 if every check passed.
+ */
+#include <fcntl.h>
+#include <pty.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <thread>
+#include "../qextserialport.h"
+
+static int failures = 0;
+
+static void check(bool passed, const char * what)
+{
+	printf("%s: %s\n", passed ? "ok" : "FAILED", what);
+	if (!passed)
+		failures++;
+}
+
+/*reads what the rover was sent, waiting up to a second for it*/
+static std::string roverRead(int rover)
+{
+	std::string got;
+	char data[64];
+	for (int wait = 0; wait < 100 && got.empty(); wait++) {
+		ssize_t n = ::read(rover, data, sizeof(data));
+		if (n > 0)
+			got.append(data, (size_t)n);
+		else
+			usleep(10000);
+	}
+	return got;
+}
+
+int main()
+{
+	int rover, station;
+	char name[64];
+	if (openpty(&rover, &station, name, 0, 0) != 0) {
+		perror("openpty");
+		return 1;
+	}
+	fcntl(rover, F_SETFL, fcntl(rover, F_GETFL) | O_NONBLOCK);
+	PortSettings settings = { BAUD57600, DATA_8, PAR_NONE, STOP_1, FLOW_OFF, 200 };
+
+	QextSerialPort port(QString(name), settings, QextSerialPort::EventDriven);
+	check(port.open(QIODevice::ReadWrite), "an event driven port opens");
+	port.setParity(PAR_EVEN);
+	port.setParity(PAR_NONE);
+	port.setBaudRate(BAUD115200);
+	check(port.lastError() == E_NO_ERROR, "the line settings are taken");
+
+	port.write("H\r", 2);
+	check(roverRead(rover) == "H\r", "the rover is sent the command");
+	check(::write(rover, "OK\r", 3) == 3 && port.waitForReadyRead(1000), "the reply arrives");
+	char data[64];
+	check(port.read(data, sizeof(data)) == 3 && memcmp(data, "OK\r", 3) == 0, "the reply is read whole");
+	port.close();
+
+	/*a polling port waits for bytes up to its timeout*/
+	QextSerialPort polling(QString(name), settings, QextSerialPort::Polling);
+	check(polling.open(QIODevice::ReadWrite), "a polling port opens");
+	std::thread late([&]() {
+		usleep(50000);
+		if (::write(rover, "L", 1) != 1)
+			perror("write");
+	});
+	long long n = polling.read(data, sizeof(data));
+	late.join();
+	check(n == 1, "a polling read waits for a late byte");
+	check(polling.read(data, sizeof(data)) == 0, "a polling read times out");
+	polling.close();
+
+	/*the rover hanging up fails the port*/
+	QextSerialPort again(QString(name), settings, QextSerialPort::EventDriven);
+	again.open(QIODevice::ReadWrite);
+	::close(rover);
+	usleep(50000);
+	check(again.write("x", 1) < 0, "a write after a hangup fails");
+	again.close();
+	::close(station);
+
+	printf("%d failed\n", failures);
+	return failures ? 1 : 0;
+}
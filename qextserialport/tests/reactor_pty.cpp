@@ -0,0 +1,187 @@
+/*
+ * Exercises Posix_QextSerialReactor against openpty() pairs: each master is a channel, as the
+ * station opens a port, and each slave plays a fake rover at the far end of the link.
+ * Returns 0 if every check passed.
+ */
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pty.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include "../posix_qextserialreactor.h"
+
+/*fake rovers on the line*/
+#define N_ROVERS 16
+/*bytes queued by one write, past what a pty takes at once*/
+#define QUEUED_BYTES 200000
+
+class Listener : public Posix_QextSerialListener
+{
+	public:
+		Listener() : reads(0), written(0), error(0) {}
+		void channelReadable() { reads++; }
+		void channelWritten(long long bytes) { written += bytes; }
+		void channelError(int error) { this->error = error; }
+
+		std::atomic<int> reads;
+		std::atomic<long long> written;
+		std::atomic<int> error;
+};
+
+static int failures = 0;
+
+static void check(bool passed, const char * what)
+{
+	printf("%s: %s\n", passed ? "ok" : "FAILED", what);
+	if (!passed)
+		failures++;
+}
+
+static bool openPair(int * master, int * slave)
+{
+	if (openpty(master, slave, 0, 0, 0) != 0)
+		return false;
+	struct termios raw;
+	tcgetattr(*slave, &raw);
+	cfmakeraw(&raw);
+	tcsetattr(*slave, TCSANOW, &raw);
+	fcntl(*slave, F_SETFL, fcntl(*slave, F_GETFL) | O_NONBLOCK);
+	return true;
+}
+
+/*reads from a channel until it holds size bytes, or a wait times out*/
+static std::string readAll(Posix_QextSerialChannel * channel, size_t size)
+{
+	std::string got;
+	char data[REACTOR_READ_CHUNK];
+	while (got.size() < size && channel->waitForReadable(3000))
+		got.append(data, (size_t)channel->read(data, sizeof(data)));
+	return got;
+}
+
+/*
+ * Every rover echoes what it is sent, upper case, as the rovers acknowledge a command; one
+ * write queues more than the pty takes, so the reactor drains the rest.
+ */
+static void testEcho()
+{
+	int masters[N_ROVERS], slaves[N_ROVERS];
+	Posix_QextSerialChannel * channels[N_ROVERS];
+	Listener listeners[N_ROVERS];
+	for (int i = 0; i < N_ROVERS; i++) {
+		if (!openPair(&masters[i], &slaves[i])) {
+			check(false, "openpty");
+			return;
+		}
+		channels[i] = new Posix_QextSerialChannel(masters[i], &listeners[i]);
+		channels[i]->open();
+	}
+	check(Posix_QextSerialReactor::instance()->channelCount() == N_ROVERS, "one reactor watches every port");
+
+	std::atomic<bool> stopping(false);
+	std::thread rovers([&]() {
+		char data[512];
+		while (!stopping) {
+			for (int i = 0; i < N_ROVERS; i++) {
+				ssize_t n = ::read(slaves[i], data, sizeof(data));
+				for (ssize_t k = 0; k < n; k++)
+					data[k] = (char)toupper(data[k]);
+				for (ssize_t sent = 0; sent < n;) {
+					ssize_t w = ::write(slaves[i], data + sent, (size_t)(n - sent));
+					if (w > 0)
+						sent += w;
+					else
+						usleep(100);
+				}
+			}
+			usleep(200);
+		}
+	});
+
+	std::string queued(QUEUED_BYTES, 'q');
+	char command[32];
+	for (int i = 0; i < N_ROVERS; i++) {
+		int length = sprintf(command, "D,%d,%d\r", i, i * 10);
+		channels[i]->write(command, length);
+	}
+	channels[0]->write(queued.data(), (long long)queued.size());
+	check(channels[0]->bytesToWrite() > 0, "a long write is queued, not blocked on");
+	check(channels[0]->waitForWritten(5000), "the reactor drains the queue");
+
+	bool echoed = true;
+	for (int i = 0; i < N_ROVERS; i++) {
+		int length = sprintf(command, "D,%d,%d\r", i, i * 10);
+		for (int k = 0; k < length; k++)
+			command[k] = (char)toupper(command[k]);
+		size_t size = (size_t)length + ((i == 0) ? queued.size() : 0);
+		std::string got = readAll(channels[i], size);
+		if (got.size() != size || got.compare(0, (size_t)length, command) != 0)
+			echoed = false;
+	}
+	check(echoed, "every rover's reply reaches its own channel");
+	check(listeners[0].reads > 0 && listeners[0].written > 0, "the listener hears of reads and writes");
+
+	stopping = true;
+	rovers.join();
+
+	/*a rover hanging up fails its channel only*/
+	::close(slaves[3]);
+	for (int wait = 0; wait < 100 && !listeners[3].error; wait++)
+		usleep(10000);
+	check(listeners[3].error != 0, "a hangup is reported");
+	check(channels[3]->write("x", 1) < 0, "a write after a hangup fails");
+	check(channels[4]->write("x", 1) == 1, "the other ports carry on");
+
+	for (int i = 0; i < N_ROVERS; i++) {
+		delete channels[i];
+		if (i != 3)
+			::close(slaves[i]);
+	}
+	check(Posix_QextSerialReactor::instance()->channelCount() == 0, "closing a channel stops watching it");
+}
+
+/*
+ * Channels are closed and made again (often at the same address) while their rovers keep
+ * talking, so events taken for a closed channel must never reach the one made after it.
+ */
+static void testReopen()
+{
+	int master, slave;
+	bool stray = false;
+	for (int round = 0; round < 200; round++) {
+		if (!openPair(&master, &slave)) {
+			check(false, "openpty");
+			return;
+		}
+		Listener listener;
+		Posix_QextSerialChannel * channel = new Posix_QextSerialChannel(master, &listener);
+		channel->open();
+		if (::write(slave, "A,1\r", 4) != 4)
+			stray = true;
+		if (round % 2)
+			channel->waitForReadable(100);
+		delete channel;
+		::close(slave);
+		/*nothing is delivered once the channel is closed*/
+		int reads = listener.reads;
+		usleep(1000);
+		if (listener.reads != reads || listener.error)
+			stray = true;
+	}
+	check(!stray, "no event reaches a channel after it is closed");
+	check(Posix_QextSerialReactor::instance()->channelCount() == 0, "every channel was removed");
+}
+
+int main()
+{
+	testEcho();
+	testReopen();
+	printf("%d failed\n", failures);
+	return failures ? 1 : 0;
+}
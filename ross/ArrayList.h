@@ -0,0 +1,825 @@
+//
+// Filename:        "ArrayList.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// This library of classes describes and implements a templated
+// list of items stored contiguously, with a small inline buffer.
+//
+
+
+
+//
+// <ArrayList>
+// Last modified:   17Oct2026
+//
+// This class describes a templated list of items that is a drop-in
+// replacement for LinkedList<T>.  Items are stored in one contiguous
+// block (inline for up to N items, on the heap beyond that), so indexed
+// access is O(1).  The circular "head" of LinkedList<T> is kept as an
+// offset into the block, so ++/-- still rotate the list in O(1) without
+// moving any items; indexed and iterator access are relative to the head.
+//
+
+// preprocessor directives
+#ifndef ARRAY_LIST_H
+#define ARRAY_LIST_H
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+// global constants
+static const int DEFAULT_ARRAY_LIST_INLINE_SIZE = 4;
+
+template <class T, int N = DEFAULT_ARRAY_LIST_INLINE_SIZE>
+class ArrayList
+{
+
+    public:
+
+        //
+        // <ConstIterator>
+        // Last modified:   17Oct2026
+        //
+        // This class iterates over the items of a list (starting at the
+        // head) without rotating the list.
+        //
+        class ConstIterator
+        {
+            public:
+                ConstIterator(const ArrayList<T, N> *l, int p)
+                    : list(l), pos(p) {};
+                const T& operator  *() const { return (*list)[pos]; };
+                const T* operator ->() const { return &(*list)[pos]; };
+                ConstIterator& operator ++() { ++pos; return *this; };
+                bool operator ==(const ConstIterator &it) const
+                {
+                    return (list == it.list) && (pos == it.pos);
+                };
+                bool operator !=(const ConstIterator &it) const
+                {
+                    return !(*this == it);
+                };
+
+            protected:
+                const ArrayList<T, N> *list;
+                int                    pos;
+        };  // ConstIterator
+
+        // <constructors>
+        ArrayList();
+        ArrayList(const ArrayList<T, N> &list);
+        ArrayList(ArrayList<T, N> &&list);
+
+        // <destructors>
+        ~ArrayList();
+
+        // <public mutator functions>
+        bool insert(T item, const int pos = 0);
+        bool insertHead(T item);
+        bool insertTail(T item);
+        bool remove(const int pos = 0);
+        bool removeHead();
+        bool removeHead(T &item);
+        bool removeTail();
+        bool removeTail(T &item);
+        void clear();
+        bool reserve(const int n);
+
+        // <public accessor functions>
+        bool getHead(T &item)     const;
+        bool getHeadNext(T &item) const;
+        bool getHeadPrev(T &item) const;
+        bool getTail(T &item)     const;
+        int  getSize()            const;
+        int  getCapacity()        const;
+        bool isEmpty()            const;
+
+        // <public iterator functions>
+        ConstIterator begin() const;
+        ConstIterator end()   const;
+
+        // <overloaded operators>
+        ArrayList<T, N>& operator =(const ArrayList<T, N> &list);
+        ArrayList<T, N>& operator =(ArrayList<T, N> &&list);
+        ArrayList<T, N>& operator ++();
+        ArrayList<T, N>& operator --();
+        T&               operator [](const int pos) const;
+
+    protected:
+
+        // <protected data members>
+        typename aligned_storage<sizeof(T),
+                                 alignment_of<T>::value>::type inlineItems[N];
+        T   *items;
+        int  size, capacity, head;
+
+        // <protected utility functions>
+        bool isInline() const;
+        int  getIndex(const int pos) const;
+        bool grow(const int n);
+        void stealFrom(ArrayList<T, N> &list);
+};  // ArrayList<T, N>
+
+
+
+//
+// <ArrayList>
+// Last modified: 17Oct2026
+//
+// This class implements a templated list of contiguous items.
+//
+
+
+
+// <constructors>
+
+//
+// ArrayList()
+// Last modified: 17Oct2026
+//
+// Default constructor that points the list at its inline
+// buffer and sets the size and head to 0.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+template <class T, int N>
+ArrayList<T, N>::ArrayList()
+    : items(reinterpret_cast<T *>(inlineItems)),
+      size(0), capacity(N), head(0)
+{
+}   // ArrayList()
+
+
+
+//
+// ArrayList(list)
+// Last modified: 17Oct2026
+//
+// Copy constructor that copies the contents
+// of the parameterized list into this list.
+//
+// Returns:     <none>
+// Parameters:
+//      list    in/out      the list being copied
+//
+template <class T, int N>
+ArrayList<T, N>::ArrayList(const ArrayList<T, N> &list)
+    : items(reinterpret_cast<T *>(inlineItems)),
+      size(0), capacity(N), head(0)
+{
+    *this = list;   // copy contents of the parameterized list into this list
+}   // ArrayList(const ArrayList<T, N> &)
+
+
+
+//
+// ArrayList(list)
+// Last modified: 17Oct2026
+//
+// Move constructor that takes over the contents of the parameterized
+// list, leaving it empty; heap storage is taken without copying.
+//
+// Returns:     <none>
+// Parameters:
+//      list    in/out      the list being moved
+//
+template <class T, int N>
+ArrayList<T, N>::ArrayList(ArrayList<T, N> &&list)
+    : items(reinterpret_cast<T *>(inlineItems)),
+      size(0), capacity(N), head(0)
+{
+    stealFrom(list);
+}   // ArrayList(ArrayList<T, N> &&)
+
+
+
+// <destructors>
+
+//
+// ~ArrayList()
+// Last modified: 17Oct2026
+//
+// Destructor that clears this list and releases its heap storage.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+template <class T, int N>
+ArrayList<T, N>::~ArrayList()
+{
+    clear();
+    if (!isInline()) ::operator delete(items);
+}   // ~ArrayList()
+
+
+
+// <public mutator functions>
+
+//
+// bool insert(item, pos)
+// Last modified: 17Oct2026
+//
+// Attempts to insert an item at the parameterized position
+// in the list, inserting at the head by default, returning
+// true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    in      the item being inserted
+//      pos     in      the position to insert at (default head)
+//
+template <class T, int N>
+bool ArrayList<T, N>::insert(T item, const int pos)
+{
+    if ((pos < 0) || (pos > getSize())) return false;
+    if ((size == capacity) && (!grow(2 * capacity))) return false;
+
+    // insert physically after the block end, or before the head if the
+    // position wraps around the end of the block (shifting the head)
+    int at = head + pos;
+    if (at > size)
+    {
+        at -= size;
+        ++head;
+    }
+    for (int i = size; i > at; --i)
+    {
+        new (&items[i]) T(std::move(items[i - 1]));
+        items[i - 1].~T();
+    }
+    new (&items[at]) T(std::move(item));
+    ++size;
+    return true;
+}   // insert(T, const int)
+
+
+
+//
+// bool insertHead(item)
+// Last modified: 17Oct2026
+//
+// Attempts to insert an item at the head of the list,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    in      the item being inserted
+//
+template <class T, int N>
+bool ArrayList<T, N>::insertHead(T item)
+{
+    return insert(std::move(item), 0);
+}   // insertHead(T)
+
+
+
+//
+// bool insertTail(item)
+// Last modified: 17Oct2026
+//
+// Attempts to insert an item at the tail (head-previous)
+// of the list, returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    in      the item being inserted
+//
+template <class T, int N>
+bool ArrayList<T, N>::insertTail(T item)
+{
+    return insert(std::move(item), getSize());
+}   // insertTail(T)
+
+
+
+//
+// bool remove(pos)
+// Last modified: 17Oct2026
+//
+// Attempts to remove the item at the parameterized position
+// from the list, removing the head by default, returning
+// true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      pos     in      the position to remove (default head)
+//
+template <class T, int N>
+bool ArrayList<T, N>::remove(const int pos)
+{
+    if ((pos < 0) || (pos > getSize()) || (isEmpty())) return false;
+    int at = getIndex(pos);
+    items[at].~T();
+    for (int i = at; i < size - 1; ++i)
+    {
+        new (&items[i]) T(std::move(items[i + 1]));
+        items[i + 1].~T();
+    }
+    --size;
+    if (at < head) --head;
+    if (head >= size) head = 0;
+    return true;
+}   // remove(const int)
+
+
+
+//
+// bool removeHead()
+// Last modified: 17Oct2026
+//
+// Attempts to remove the head item from the list,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:  <none>
+//
+template <class T, int N>
+bool ArrayList<T, N>::removeHead()
+{
+    return remove(0);
+}   // removeHead()
+
+
+
+//
+// bool removeHead(item)
+// Last modified: 17Oct2026
+//
+// Attempts to remove the head item from the list,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    out     set to the value of the head item
+//
+template <class T, int N>
+bool ArrayList<T, N>::removeHead(T &item)
+{
+    return getHead(item) && removeHead();
+}   // removeHead(T &)
+
+
+
+//
+// bool removeTail()
+// Last modified: 17Oct2026
+//
+// Attempts to remove the tail (head-previous) item from the list,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:  <none>
+//
+template <class T, int N>
+bool ArrayList<T, N>::removeTail()
+{
+    return remove(getSize() - 1);
+}   // removeTail()
+
+
+
+//
+// bool removeTail(item)
+// Last modified: 17Oct2026
+//
+// Attempts to remove the tail (head-previous) item from the list,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    out     set to the value of the tail item
+//
+template <class T, int N>
+bool ArrayList<T, N>::removeTail(T &item)
+{
+    return getTail(item) && removeTail();
+}   // removeTail(T &)
+
+
+
+//
+// void clear()
+// Last modified: 17Oct2026
+//
+// Clears the list, keeping its storage for reuse.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+template <class T, int N>
+void ArrayList<T, N>::clear()
+{
+    for (int i = 0; i < size; ++i) items[i].~T();
+    size = head = 0;
+}   // clear()
+
+
+
+//
+// bool reserve(n)
+// Last modified: 17Oct2026
+//
+// Attempts to make room for at least the parameterized number of items,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      n       in      the number of items to make room for
+//
+template <class T, int N>
+bool ArrayList<T, N>::reserve(const int n)
+{
+    return (n <= capacity) || grow(n);
+}   // reserve(const int)
+
+
+
+// <public accessor functions>
+
+//
+// bool getHead(item) const
+// Last modified: 17Oct2026
+//
+// Attempts to retrieve the value of the head item
+// in the list, assigning it to the given parameter,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    out     set to the value of the head item
+//
+template <class T, int N>
+bool ArrayList<T, N>::getHead(T &item) const
+{
+    if (isEmpty()) return false;
+    item = items[head];         // assign value to the given parameter
+    return true;
+}   // getHead(T &) const
+
+
+
+//
+// bool getHeadNext(item) const
+// Last modified: 17Oct2026
+//
+// Attempts to retrieve the value of the head-next item
+// in the list, assigning it to the given parameter,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    out     set to the value of the head-next item
+//
+template <class T, int N>
+bool ArrayList<T, N>::getHeadNext(T &item) const
+{
+    if (isEmpty()) return false;
+    item = items[getIndex(1 % size)];
+    return true;
+}   // getHeadNext(T &) const
+
+
+
+//
+// bool getHeadPrev(item) const
+// Last modified: 17Oct2026
+//
+// Attempts to retrieve the value of the head-previous item
+// in the list, assigning it to the given parameter,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    out     set to the value of the head-previous item
+//
+template <class T, int N>
+bool ArrayList<T, N>::getHeadPrev(T &item) const
+{
+    if (isEmpty()) return false;
+    item = items[getIndex(size - 1)];
+    return true;
+}   // getHeadPrev(T &) const
+
+
+
+//
+// bool getTail(item) const
+// Last modified: 17Oct2026
+//
+// Attempts to retrieve the value of the tail (head-previous)
+// item in the list, assigning it to the given parameter,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    out     set to the value of the head-previous item
+//
+template <class T, int N>
+bool ArrayList<T, N>::getTail(T &item) const
+{
+    return getHeadPrev(item);
+}   // getTail(T &) const
+
+
+
+//
+// int getSize() const
+// Last modified: 17Oct2026
+//
+// Returns the number of items in the list.
+//
+// Returns:     the number of items in the list
+// Parameters:  <none>
+//
+template <class T, int N>
+int ArrayList<T, N>::getSize() const
+{
+    return size;
+}   // getSize() const
+
+
+
+//
+// int getCapacity() const
+// Last modified: 17Oct2026
+//
+// Returns the number of items the list can hold without growing.
+//
+// Returns:     the number of items the list can hold without growing
+// Parameters:  <none>
+//
+template <class T, int N>
+int ArrayList<T, N>::getCapacity() const
+{
+    return capacity;
+}   // getCapacity() const
+
+
+
+//
+// bool isEmpty() const
+// Last modified: 17Oct2026
+//
+// Returns true if the list is empty, false otherwise.
+//
+// Returns:     true if the list is empty, false otherwise
+// Parameters:  <none>
+//
+template <class T, int N>
+bool ArrayList<T, N>::isEmpty() const
+{
+    return getSize() == 0;
+}   // isEmpty() const
+
+
+
+// <public iterator functions>
+
+//
+// ConstIterator begin() const
+// Last modified: 17Oct2026
+//
+// Returns an iterator to the head of the list.
+//
+// Returns:     an iterator to the head of the list
+// Parameters:  <none>
+//
+template <class T, int N>
+typename ArrayList<T, N>::ConstIterator ArrayList<T, N>::begin() const
+{
+    return ConstIterator(this, 0);
+}   // begin() const
+
+
+
+//
+// ConstIterator end() const
+// Last modified: 17Oct2026
+//
+// Returns an iterator past the tail of the list.
+//
+// Returns:     an iterator past the tail of the list
+// Parameters:  <none>
+//
+template <class T, int N>
+typename ArrayList<T, N>::ConstIterator ArrayList<T, N>::end() const
+{
+    return ConstIterator(this, getSize());
+}   // end() const
+
+
+
+// <overloaded operators>
+
+//
+// ArrayList<T, N>& =(list)
+// Last modified: 17Oct2026
+//
+// Copies the contents of the parameterized list into this list.
+//
+// Returns:     this list
+// Parameters:
+//      list    in/out  the list being copied
+//
+template <class T, int N>
+ArrayList<T, N>& ArrayList<T, N>::operator =(const ArrayList<T, N> &list)
+{
+    if (this == &list) return *this;
+    clear();    // clears this list
+
+    // copies the contents of the parameterized list to this list
+    if (!reserve(list.getSize())) return *this;
+    for (int i = 0; i < list.getSize(); ++i) new (&items[i]) T(list[i]);
+    size = list.getSize();
+    return *this;
+}   // =(const ArrayList<T, N> &)
+
+
+
+//
+// ArrayList<T, N>& =(list)
+// Last modified: 17Oct2026
+//
+// Moves the contents of the parameterized list into this list.
+//
+// Returns:     this list
+// Parameters:
+//      list    in/out  the list being moved
+//
+template <class T, int N>
+ArrayList<T, N>& ArrayList<T, N>::operator =(ArrayList<T, N> &&list)
+{
+    if (this == &list) return *this;
+    clear();
+    stealFrom(list);
+    return *this;
+}   // =(ArrayList<T, N> &&)
+
+
+
+//
+// ArrayList<T, N>& ++()
+// Last modified: 17Oct2026
+//
+// Moves the head to head-next.
+//
+// Returns:     this list
+// Parameters:  <none>
+//
+template <class T, int N>
+ArrayList<T, N>& ArrayList<T, N>::operator ++()
+{
+    if ((!isEmpty()) && (++head == size)) head = 0;
+    return *this;
+}   // ++()
+
+
+
+//
+// ArrayList<T, N>& --()
+// Last modified: 17Oct2026
+//
+// Moves the head to head-previous.
+//
+// Returns:     this list
+// Parameters:  <none>
+//
+template <class T, int N>
+ArrayList<T, N>& ArrayList<T, N>::operator --()
+{
+    if ((!isEmpty()) && (--head < 0)) head = size - 1;
+    return *this;
+}   // --()
+
+
+
+//
+// T& [] (pos) const
+// Last modified: 17Oct2026
+//
+// Provides array-like access of list items in constant time.
+//
+// Returns:     the list item at the parameterized position
+// Parameters:
+//      pos     in      the position of the desired item
+//
+template <class T, int N>
+T& ArrayList<T, N>::operator [](const int pos) const
+{
+    assert((pos >= 0) && (pos <= getSize()));
+    return items[getIndex(pos)];
+}   // [](const int) const
+
+
+
+// <protected utility functions>
+
+//
+// bool isInline() const
+// Last modified: 17Oct2026
+//
+// Returns true if the items are stored in the inline buffer.
+//
+// Returns:     true if the items are stored in the inline buffer
+// Parameters:  <none>
+//
+template <class T, int N>
+bool ArrayList<T, N>::isInline() const
+{
+    return items == reinterpret_cast<const T *>(inlineItems);
+}   // isInline() const
+
+
+
+//
+// int getIndex(pos) const
+// Last modified: 17Oct2026
+//
+// Returns the index in the block of the item at the parameterized
+// position relative to the head (the size wraps around to the head,
+// matching LinkedList<T>).
+//
+// Returns:     the index of the item in the block
+// Parameters:
+//      pos     in      the position of the desired item
+//
+template <class T, int N>
+int ArrayList<T, N>::getIndex(const int pos) const
+{
+    int i = head + ((pos == size) ? 0 : pos);
+    return (i >= size) ? i - size : i;
+}   // getIndex(const int) const
+
+
+
+//
+// bool grow(n)
+// Last modified: 17Oct2026
+//
+// Attempts to move the items into a heap block of the parameterized
+// capacity, returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      n       in      the new capacity of the list
+//
+template <class T, int N>
+bool ArrayList<T, N>::grow(const int n)
+{
+    if (n <= capacity) return true;
+    T *block = static_cast<T *>(::operator new(n * sizeof(T), nothrow));
+    if (block == NULL) return false;
+    for (int i = 0; i < size; ++i)
+    {
+        new (&block[i]) T(std::move(items[i]));
+        items[i].~T();
+    }
+    if (!isInline()) ::operator delete(items);
+    items    = block;
+    capacity = n;
+    return true;
+}   // grow(const int)
+
+
+
+//
+// void stealFrom(list)
+// Last modified: 17Oct2026
+//
+// Takes over the items of the parameterized list (which must be
+// empty-handed afterwards), assuming this list is empty.
+//
+// Returns:     <none>
+// Parameters:
+//      list    in/out  the list being moved from
+//
+template <class T, int N>
+void ArrayList<T, N>::stealFrom(ArrayList<T, N> &list)
+{
+    if (list.isInline())
+    {
+        for (int i = 0; i < list.size; ++i)
+            new (&items[i]) T(std::move(list.items[i]));
+        size = list.size;
+        head = list.head;
+        list.clear();
+    }
+    else
+    {
+        if (!isInline()) ::operator delete(items);
+        items         = list.items;
+        size          = list.size;
+        capacity      = list.capacity;
+        head          = list.head;
+        list.items    = reinterpret_cast<T *>(list.inlineItems);
+        list.size     = list.head = 0;
+        list.capacity = N;
+    }
+}   // stealFrom(ArrayList<T, N> &)
+#endif
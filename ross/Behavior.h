@@ -11,7 +11,7 @@
 #ifndef BEHAVIOR_H
 #define BEHAVIOR_H
 #include <iostream>
-#include "../GL/glut.h"
+#include "GLTypes.h"
 using namespace std;
 
 // enumerated status of a behavior
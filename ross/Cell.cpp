@@ -2,12 +2,13 @@
 // Filename:        "Cell.cpp"
 //
 // Programmer:      Ross Mead
-// Last modified:   14May2007
+// Last modified:   17Oct2026
 //
 // Description:     This class implements a robot cell.
 //
 
 // preprocessor directives
+#include <algorithm>
 #include "Cell.h"
 #include "Environment.h"
 
@@ -52,8 +53,8 @@ Cell::Cell(const GLfloat dx,    const GLfloat dy, const GLfloat dz,
 //
 Cell::Cell(const Cell &c): State(c), Neighborhood(c), Robot(c)
 {
-    leftNbr  = c.leftNbr;
-    rightNbr = c.rightNbr;
+    leftNbrID  = c.leftNbrID;
+    rightNbrID = c.rightNbrID;
 }   // Cell(const Cell &)
 
 
@@ -203,49 +204,56 @@ void Cell::draw()
 
 
 //
-// void step()
-// Last modified: 27Aug2006
+// void compute()
+// Last modified: 17Oct2026
 //
 // Processes packets received and updates the state of the cell,
-// which is then broadcast within the neighborhood of the cell.
+// which is then broadcast within the neighborhood of the cell;
+// the cell only reads (never moves) robot positions here.
 //
 // Returns:     <none>
 // Parameters:  <none>
 //
-void Cell::step()
+void Cell::compute()
 {
     if (processPackets())
     {
         updateState();
         sendStateToNbrs();
     }
-    Robot::step();
-}   // step()
+}   // compute()
 
 
 
 //
 // void updateState()
-// Last modified: 27Aug2006
+// Last modified: 17Oct2026
 //
 // Updates the state of the cell based upon the
-// current states of the neighbors of the cell.
+// current states of the neighbors of the cell
+// (relating to the neighbors a batch at a time).
 //
 // Returns:     <none>
 // Parameters:  <none>
 //
 void Cell::updateState()
 {
-    Neighbor currNbr;
-    for (GLint i = 0; i < getNNbrs(); ++i)
+    GLint ids[NBR_BATCH_SIZE];
+    Vec2f actual[NBR_BATCH_SIZE];
+    for (GLint i = 0; i < getNNbrs(); i += NBR_BATCH_SIZE)
     {
-        if (!getHead(currNbr)) break;
+        const GLint n = min(NBR_BATCH_SIZE, getNNbrs() - i);
+        for (GLint j = 0; j < n; ++j) ids[j] = getNbr(i + j)->ID;
+        getRelationshipsTo(ids, actual, n);
+        for (GLint j = 0; j < n; ++j) getNbr(i + j)->relActual = actual[j];
+    }
 
-        // change formation if a neighbor has changed formation
-        if (getNbr(0)->formation.getFormationID() > formation.getFormationID())
-            changeFormation(getNbr(0)->formation, *getNbr(0));
-        getNbr(0)->relActual = getRelationship(currNbr.ID);
-        ++(*this);
+    // change formation if a neighbor has changed formation
+    for (GLint i = 0; i < getNNbrs(); ++i)
+    {
+        Neighbor *currNbr = getNbr(i);
+        if (currNbr->formation.getFormationID() > formation.getFormationID())
+            changeFormation(currNbr->formation, *currNbr);
     }
     rels = getRelationships();
 	if(rels.getSize())
@@ -284,9 +292,11 @@ void Cell::updateState()
 
 //
 // bool changeFormation()
-// Last modified: 27Aug2006
+// Last modified: 17Oct2026
 //
-// Attempts to change the formation of the cell,
+// Attempts to change the formation of the cell (looking up the
+// gradient and desired relationships of the cell if the formation
+// has been compiled, deriving them from the neighbor otherwise),
 // returning true if successful, false otherwise.
 //
 // Returns:     true if successful, false otherwise
@@ -297,10 +307,19 @@ void Cell::updateState()
 bool Cell::changeFormation(const Formation &f, Neighbor n)
 {
     formation = f;
+    Vec2f leftRel, rightRel;
+    if (formation.getTableEntry(ID, gradient, leftRel, rightRel))
+    {
+        transError = Vec2f();
+        rotError   = 0.0f;
+        setNbrDesired(leftNbrID,  leftRel);
+        setNbrDesired(rightNbrID, rightRel);
+        return true;
+    }
     if (formation.getSeedID() == ID)
     {
         gradient   = formation.getSeedGradient();
-        transError = Vector();
+        transError = Vec2f();
         rotError   = 0.0f;
     }
     else
@@ -309,12 +328,12 @@ bool Cell::changeFormation(const Formation &f, Neighbor n)
         if (nbrRel == NULL) return false;
         nbrRel->relDesired.rotateRelative(n.formation.getHeading());
         gradient             = n.gradient + nbrRel->relDesired;
-        transError           = Vector();
+        transError           = Vec2f();
         rotError             = 0.0f;
     }
-    LinkedList<Vector> r = formation.getRelationships(gradient);
-    if (leftNbr  != NULL) leftNbr->relDesired  = r[LEFT_NBR_INDEX];
-    if (rightNbr != NULL) rightNbr->relDesired = r[RIGHT_NBR_INDEX];
+    ArrayList<Vec2f> r = formation.getRelationships(gradient);
+    setNbrDesired(leftNbrID,  r[LEFT_NBR_INDEX]);
+    setNbrDesired(rightNbrID, r[RIGHT_NBR_INDEX]);
     return true;
 }   // changeFormation(const Formation &, Neighbor)
 
@@ -322,10 +341,11 @@ bool Cell::changeFormation(const Formation &f, Neighbor n)
 
 //
 // bool sendStateToNbrs()
-// Last modified: 27Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to broadcast the state of the cell
-// to the neighborhood of the cell, returning
+// to the neighborhood of the cell (each neighbor
+// even if another could not be sent to), returning
 // true if successful, false otherwise.
 //
 // Returns:     true if successful, false otherwise
@@ -333,17 +353,17 @@ bool Cell::changeFormation(const Formation &f, Neighbor n)
 //
 bool Cell::sendStateToNbrs()
 {
-    Neighbor curr;
+    bool success = true;
     for (GLint i = 0; i < getNNbrs(); ++i)
-        if (!sendState(getNbr(i)->ID)) return false;
-    return true;
+        success = sendState(getNbr(i)->ID) && success;
+    return success;
 }   // sendStateToNbrs()
 
 
 
 //
 // bool sendState(toID)
-// Last modified: 27Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to send the state of the cell
 // to the neighbor with the parameterized ID,
@@ -355,16 +375,17 @@ bool Cell::sendStateToNbrs()
 //
 bool Cell::sendState(const GLint toID)
 {
-    return sendMsg(new State(*this), toID, STATE);
+    return sendMsg(*this, toID, STATE);
 }   // sendState(const GLint)
 
 
 
 //
 // bool processPackets()
-// Last modified: 27Aug2006
+// Last modified: 17Oct2026
 //
-// Attempts to process all packets received by the cell,
+// Attempts to process all packets received by the cell (draining
+// the queue even past a packet that could not be processed),
 // returning true if successful, false otherwise.
 //
 // Returns:     true if successful, false otherwise
@@ -372,17 +393,17 @@ bool Cell::sendState(const GLint toID)
 //
 bool Cell::processPackets()
 {
+    bool   success = true;
     Packet p;
-    while (msgQueue.dequeue(p))
-        if (!processPacket(p)) return false;
-    return true;
+    while (msgQueue.dequeue(p)) success = processPacket(p) && success;
+    return success;
 }   // processPackets()
 
 
 
 //
 // bool processPacket(p)
-// Last modified: 22Dec2006
+// Last modified: 17Oct2026
 //
 // Attempts to process the parameterized packet,
 // returning true if successful, false otherwise.
@@ -395,15 +416,14 @@ bool Cell::processPacket(Packet &p)
 {
     bool success = false;
     if ((p.fromOperator()) && (p.type == CHANGE_FORMATION))
-        success  = changeFormation(*((Formation *)p.msg));
+        success  = (p.getFormation() == NULL) ?
+            false : changeFormation(*p.getFormation());
     else if ((isNbr(p.fromID)) || (p.fromBroadcast()))
         switch(p.type)
         {
             case STATE:
-                success = (p.msg == NULL) ?
-                    false : updateNbr(p.fromID, *((State *)p.msg));
-                delete (State *)p.msg;
-                p.msg   = NULL;
+                success = (p.getState() == NULL) ?
+                    false : updateNbr(p.fromID, *p.getState());
                 break;
             default: break;
         }
@@ -485,6 +505,31 @@ Cell& Cell::operator =(const Robot &r)
 bool Cell::init(const GLfloat dx,    const GLfloat dy, const GLfloat dz,
                 const GLfloat theta, const Color   colorIndex)
 {
-    leftNbr = rightNbr = NULL;
+    leftNbrID = rightNbrID = ID_NO_NBR;
     return true;
 }   // init(const GLfloat..<4>, const Color)
+
+
+
+// <protected utility functions>
+
+//
+// bool setNbrDesired(id, rel)
+// Last modified: 17Oct2026
+//
+// Attempts to set the desired relationship of the neighbor
+// with the parameterized ID (looked up by ID, since the neighbors
+// may move in memory), returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      id      in      the ID of the neighbor
+//      rel     in      the desired relationship to the neighbor
+//
+bool Cell::setNbrDesired(const GLint id, const Vec2f &rel)
+{
+    Neighbor *nbr = nbrWithID(id);
+    if (nbr == NULL) return false;
+    nbr->relDesired = rel;
+    return true;
+}   // setNbrDesired(const GLint, const Vec2f &)
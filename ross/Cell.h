@@ -2,7 +2,7 @@
 // Filename:        "Cell.h"
 //
 // Programmer:      Ross Mead
-// Last modified:   27Aug2006
+// Last modified:   17Oct2026
 //
 // Description:     This class describes a robot cell.
 //
@@ -21,6 +21,7 @@ enum MessageType {HEARTBEAT, STATE, CHANGE_FORMATION};
 static const Color DEFAULT_CELL_COLOR = DEFAULT_ROBOT_COLOR;
 static const GLint LEFT_NBR_INDEX     = 0;
 static const GLint RIGHT_NBR_INDEX    = 1;
+static const GLint NBR_BATCH_SIZE     = 16;  // neighbors related at once
 
 class Cell: protected State, public Neighborhood, public Robot
 {
@@ -51,7 +52,7 @@ class Cell: protected State, public Neighborhood, public Robot
 
         // <virtual public utility functions>
         virtual void draw();
-        virtual void step();
+        virtual void compute();
         virtual void updateState();
 
         // <virtual public neighborhood functions>
@@ -70,7 +71,7 @@ class Cell: protected State, public Neighborhood, public Robot
     protected:
 
         // <protected data members>
-        Neighbor *leftNbr, *rightNbr;
+        GLint leftNbrID, rightNbrID;    // ID_NO_NBR if there is none
 
         // <virtual protected utility functions>
         virtual bool init(const GLfloat dx         = 0.0f,
@@ -78,5 +79,8 @@ class Cell: protected State, public Neighborhood, public Robot
                           const GLfloat dz         = 0.0f,
                           const GLfloat theta      = 0.0f,
                           const Color   colorIndex = DEFAULT_CELL_COLOR);
+
+        // <protected utility functions>
+        bool setNbrDesired(const GLint id, const Vec2f &rel);
 };  // Cell
 #endif
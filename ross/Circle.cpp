@@ -248,7 +248,7 @@ GLfloat Circle::getArea() const
 
 //
 // void draw()
-// Last modified: 27Aug2006
+// Last modified: 17Oct2026
 //
 // Renders the circle with current vector position and radius.
 //
@@ -257,6 +257,7 @@ GLfloat Circle::getArea() const
 //
 void Circle::draw()
 {
+#ifndef ROSS_HEADLESS
     if ((color[0] == COLOR[INVISIBLE][0]) &&
         (color[1] == COLOR[INVISIBLE][1]) &&
         (color[2] == COLOR[INVISIBLE][2])) return;
@@ -289,6 +290,7 @@ void Circle::draw()
 	    }
         glEnd();
     glPopMatrix();
+#endif
 }   // draw()
 
 
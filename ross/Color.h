@@ -10,7 +10,7 @@
 // preprocessor directives
 #ifndef COLOR_H
 #define COLOR_H
-#include "../GL/glut.h"
+#include "GLTypes.h"
 using namespace std;
 
 // predefined colors
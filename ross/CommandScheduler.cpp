@@ -0,0 +1,1030 @@
+//
+// Filename:        "CommandScheduler.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements a scheduler that collects the drive
+//                  commands posted for the robots during a tick, suppresses
+//                  those that have not changed, and hands the rest (encoded
+//                  once each) to a sender thread that writes all of the
+//                  commands routed to a port in one write per tick (robots
+//                  sharing a port in multiplexed frames), along with the
+//                  queries that poll the robots for their odometry.
+//
+
+// preprocessor directives
+#include "CommandScheduler.h"
+#include "TelemetryParser.h"
+#ifndef ROSS_HEADLESS
+#include <QtCore/QObject>
+#include "../formationcontrol/types.h"
+#endif
+
+
+
+// <file functions>
+
+//
+// GLint encodeInt(buf, value)
+// Last modified: 17Oct2026
+//
+// Writes the parameterized value in decimal (without a terminator).
+//
+// Returns:     the number of characters written
+// Parameters:
+//      buf     out     the characters (at least 11)
+//      value   in      the value being written
+//
+static GLint encodeInt(char *buf, const GLint value)
+{
+    char         digits[10];
+    GLint        nDigits = 0, n = 0;
+    unsigned int u       = (value < 0) ? 0u - (unsigned int)value
+                                       : (unsigned int)value;
+    if (value < 0) buf[n++] = '-';
+    do
+    {
+        digits[nDigits++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u > 0);
+    while (nDigits > 0) buf[n++] = digits[--nDigits];
+    return n;
+}   // encodeInt(char *, const GLint)
+
+
+
+//
+// GLint encodeDrive(buf, left, right)
+// Last modified: 17Oct2026
+//
+// Writes the parameterized wheel speeds as a drive command ("D,l,r\r").
+//
+// Returns:     the number of characters written
+// Parameters:
+//      buf     out     the characters (at least MAX_COMMAND_BYTES)
+//      left    in      the speed of the left wheel (in steps per second)
+//      right   in      the speed of the right wheel (in steps per second)
+//
+static GLint encodeDrive(char *buf, const GLint left, const GLint right)
+{
+    GLint n = 0;
+    buf[n++] = 'D';
+    buf[n++] = ',';
+    n       += encodeInt(buf + n, left);
+    buf[n++] = ',';
+    n       += encodeInt(buf + n, right);
+    buf[n++] = '\r';
+    return n;
+}   // encodeDrive(char *, const GLint, const GLint)
+
+
+
+//
+// void encodeMux(buf, left, right)
+// Last modified: 17Oct2026
+//
+// Writes the parameterized wheel speeds as the entry of a multiplexed
+// frame (less the address), as 16-bit little-endian integers.
+//
+// Returns:     <none>
+// Parameters:
+//      buf     out     the bytes (at least MUX_ENTRY_BYTES - 1)
+//      left    in      the speed of the left wheel (in steps per second)
+//      right   in      the speed of the right wheel (in steps per second)
+//
+static void encodeMux(char *buf, const GLint left, const GLint right)
+{
+    const GLint l = (left  < -32768) ? -32768 : (left  > 32767) ? 32767 : left;
+    const GLint r = (right < -32768) ? -32768 : (right > 32767) ? 32767 : right;
+    buf[0] = (char)(l & 0xFF);
+    buf[1] = (char)((l >> 8) & 0xFF);
+    buf[2] = (char)(r & 0xFF);
+    buf[3] = (char)((r >> 8) & 0xFF);
+}   // encodeMux(char *, const GLint, const GLint)
+
+
+
+#ifndef ROSS_HEADLESS
+// <constructors>
+
+//
+// TerminalSink(w)
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this sink
+// to the parameterized writer.
+//
+// Returns:     <none>
+// Parameters:
+//      w       in      the object (of the terminals' thread) that writes
+//                      to the ports, through its writeTerminal() slot
+//
+TerminalSink::TerminalSink(QObject *w): writer(w)
+{
+}   // TerminalSink(QObject *)
+
+
+
+// <virtual public accessor functions>
+
+//
+// GLint getNPorts() const
+// Last modified: 17Oct2026
+//
+// Returns the number of terminals (one port each).
+//
+// Returns:     the number of terminals
+// Parameters:  <none>
+//
+GLint TerminalSink::getNPorts() const
+{
+    return terminalList.count();
+}   // getNPorts() const
+
+
+
+//
+// long long getNQueued(port) const
+// Last modified: 17Oct2026
+//
+// Returns the number of bytes written to the serial port of the
+// parameterized terminal that it has yet to send (those handed over to
+// be written, and those the port had left queued after its last write).
+//
+// Returns:     the bytes still queued (0 if not open)
+// Parameters:
+//      port    in      the index of the terminal
+//
+long long TerminalSink::getNQueued(const GLint port) const
+{
+    const Terminal &terminal = terminalList.at(port);
+    if ((!terminal.isOpen) || (terminal.pSerPort == NULL)) return 0;
+    lock_guard<mutex> lock(queueMutex);
+    map<const QObject *, PortQueue>::const_iterator q =
+        queues.find(terminal.pSerPort);
+    return (q == queues.end()) ? 0 : q->second.nHanded + q->second.nQueued;
+}   // getNQueued(const GLint) const
+
+
+
+// <public mutator functions>
+
+//
+// const vector<char>& take(port)
+// Last modified: 17Oct2026
+//
+// Takes the bytes handed over to be written to the parameterized port
+// since the last take (swapping buffers, so that neither is reallocated
+// once it has grown to fit a tick); only the writer's thread may call it,
+// and the bytes returned are valid until its next call for the port.
+//
+// Returns:     the bytes to write to the port
+// Parameters:
+//      port    in      the serial port being written to
+//
+const vector<char>& TerminalSink::take(const QObject *port)
+{
+    lock_guard<mutex> lock(queueMutex);
+    PortQueue &q = queues[port];
+    q.writing.swap(q.pending);
+    q.pending.clear();
+    q.posted = false;
+    return q.writing;
+}   // take(const QObject *)
+
+
+
+//
+// void written(port, n, queued)
+// Last modified: 17Oct2026
+//
+// Records that the parameterized bytes handed over have been written
+// to the parameterized port (or dropped, if it has since closed),
+// leaving the parameterized bytes queued by the port.
+//
+// Returns:     <none>
+// Parameters:
+//      port    in      the serial port written to
+//      n       in      the number of bytes handed over
+//      queued  in      the bytes the port has yet to send
+//
+void TerminalSink::written(const QObject   *port,
+                           const GLint      n,
+                           const long long  queued)
+{
+    lock_guard<mutex> lock(queueMutex);
+    PortQueue &q = queues[port];
+    q.nHanded   -= n;
+    q.nQueued    = queued;
+}   // written(const QObject *, const GLint, const long long)
+
+
+
+// <virtual public utility functions>
+
+//
+// bool send(port, data, n)
+// Last modified: 17Oct2026
+//
+// Attempts to hand the parameterized bytes over to be written to the
+// serial port of the parameterized terminal (if open) on the thread the
+// port belongs to (the port is not safe to write from the sender thread),
+// appending them to the buffer of the port and queueing a call to the
+// writer unless one is already waiting,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      port    in      the index of the terminal
+//      data    in      the bytes being written
+//      n       in      the number of bytes
+//
+bool TerminalSink::send(const GLint port, const char *data, const GLint n)
+{
+    const Terminal &terminal = terminalList.at(port);
+    if ((!terminal.isOpen) || (terminal.pSerPort == NULL) ||
+        (writer == NULL)) return false;
+
+    QObject *serPort = terminal.pSerPort;
+    {
+        lock_guard<mutex> lock(queueMutex);
+        PortQueue &q = queues[serPort];
+        if (q.pending.capacity() == 0)
+        {
+            q.pending.reserve(DEFAULT_LINK_CAPACITY);
+            q.writing.reserve(DEFAULT_LINK_CAPACITY);
+        }
+        q.pending.insert(q.pending.end(), data, data + n);
+        q.nHanded += n;
+        if (q.posted) return true;
+        q.posted   = true;
+    }
+    if (QMetaObject::invokeMethod(writer, "writeTerminal",
+                                  Qt::QueuedConnection,
+                                  Q_ARG(QObject *, serPort)))
+        return true;
+
+    // drop the bytes waiting for the call that could not be queued
+    lock_guard<mutex> lock(queueMutex);
+    PortQueue &q = queues[serPort];
+    q.nHanded -= (long long)q.pending.size();
+    q.pending.clear();
+    q.posted   = false;
+    return false;
+}   // send(const GLint, const char *, const GLint)
+#endif
+
+
+
+// <constructors>
+
+//
+// CommandScheduler(s, refresh)
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this (stopped) scheduler
+// to the parameterized values.
+//
+// Returns:     <none>
+// Parameters:
+//      s           in      the ports the commands are written to
+//      refresh     in      the ticks between resends of a command
+//
+CommandScheduler::CommandScheduler(CommandSink *s, const GLint refresh)
+    : sink(s), refreshTicks(DEFAULT_COMMAND_REFRESH),
+      linkCapacity(DEFAULT_LINK_CAPACITY), pollTicks(DEFAULT_POLL_TICKS),
+      tick(0), metrics(NULL), nDirty(0), running(false),
+      nPosted(0), nSuppressed(0), nSent(0), nDropped(0), nWrites(0),
+      nBytes(0), nPolls(0)
+{
+    setRefresh(refresh);
+}   // CommandScheduler(CommandSink *, const GLint)
+
+
+
+// <destructors>
+
+//
+// ~CommandScheduler()
+// Last modified: 17Oct2026
+//
+// Destructor that stops this scheduler (after writing what is left).
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+CommandScheduler::~CommandScheduler()
+{
+    stop();
+}   // ~CommandScheduler()
+
+
+
+// <public mutator functions>
+
+//
+// bool setSink(s)
+// Last modified: 17Oct2026
+//
+// Attempts to set the ports that this (stopped) scheduler writes to
+// (none if NULL), returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      s       in      the ports the commands are written to
+//
+bool CommandScheduler::setSink(CommandSink *s)
+{
+    if (isRunning()) return false;
+    sink = s;
+    return true;
+}   // setSink(CommandSink *)
+
+
+
+//
+// bool setRefresh(refresh)
+// Last modified: 17Oct2026
+//
+// Attempts to set the number of ticks after which a command that keeps
+// being posted unchanged is sent again (never if 0), in case the robot
+// missed it, returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      refresh     in      the ticks between resends of a command
+//
+bool CommandScheduler::setRefresh(const GLint refresh)
+{
+    if (refresh < 0) return false;
+    refreshTicks = refresh;
+    return true;
+}   // setRefresh(const GLint)
+
+
+
+//
+// bool setRoute(ID, port, address)
+// Last modified: 17Oct2026
+//
+// Attempts to route the commands of the parameterized robot to the
+// parameterized port and address (see RoutingTable::setRoute),
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      ID          in      the ID of the robot
+//      port        in      the index of the port
+//      address     in      the address on the port (default direct)
+//
+bool CommandScheduler::setRoute(const GLint ID,
+                                const GLint port,
+                                const GLint address)
+{
+    return routes.setRoute(ID, port, address);
+}   // setRoute(const GLint, const GLint, const GLint)
+
+
+
+//
+// bool setLinkCapacity(bytes)
+// Last modified: 17Oct2026
+//
+// Attempts to set the number of bytes a port carries per tick (1152 at
+// 115200 baud and 10 ticks per second), beyond which a write counts as
+// an overrun, returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      bytes   in      the bytes per tick per port
+//
+bool CommandScheduler::setLinkCapacity(const GLint bytes)
+{
+    if (bytes <= 0) return false;
+    linkCapacity = bytes;
+    return true;
+}   // setLinkCapacity(const GLint)
+
+
+
+//
+// bool setPollInterval(ticks)
+// Last modified: 17Oct2026
+//
+// Attempts to set the number of ticks between the queries ("Q\r") that
+// ask each robot driven so far for its wheel positions (never if 0), the
+// robots spread over the ticks between, returning true if successful,
+// false otherwise.  The queries are written with the commands, so they
+// count against the capacity of the link.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      ticks   in      the ticks between polls of a robot
+//
+bool CommandScheduler::setPollInterval(const GLint ticks)
+{
+    if (ticks < 0) return false;
+    lock_guard<mutex> lock(slotMutex);
+    pollTicks = ticks;
+    return true;
+}   // setPollInterval(const GLint)
+
+
+
+//
+// bool setMetrics(m)
+// Last modified: 17Oct2026
+//
+// Attempts to set the registry that this (stopped) scheduler reports the
+// health of each port to (none if NULL), which times each written command
+// until the robot acknowledges it, returning true if successful,
+// false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      m       in      the registry of the health of the links
+//
+bool CommandScheduler::setMetrics(LinkMetrics *m)
+{
+    if (isRunning()) return false;
+    metrics = m;
+    return true;
+}   // setMetrics(LinkMetrics *)
+
+
+
+//
+// bool post(ID, left, right)
+// Last modified: 17Oct2026
+//
+// Attempts to set the wheel speeds that the parameterized robot is driven
+// at by the end of this tick (replacing any posted earlier in the tick),
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      ID      in      the ID of the robot
+//      left    in      the speed of the left wheel (in steps per second)
+//      right   in      the speed of the right wheel (in steps per second)
+//
+bool CommandScheduler::post(const GLint ID, const GLint left, const GLint right)
+{
+    lock_guard<mutex> lock(slotMutex);
+    if (!grow(ID)) return false;
+    slots[ID].left   = left;
+    slots[ID].right  = right;
+    slots[ID].posted = true;
+    nPosted.fetch_add(1, memory_order_relaxed);
+    return true;
+}   // post(const GLint, const GLint, const GLint)
+
+
+
+//
+// void flush()
+// Last modified: 17Oct2026
+//
+// Ends the tick, encoding each posted command that differs from the one
+// last sent to its robot (or is due to be resent) and handing it to the
+// sender (or writing it here if stopped), along with the robots due to
+// be polled.  A command still waiting for the sender from an earlier
+// tick is replaced rather than queued.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void CommandScheduler::flush()
+{
+    {
+        lock_guard<mutex> lock(slotMutex);
+        ++tick;
+        for (GLint i = 0; i < (GLint)slots.size(); ++i)
+        {
+            CommandSlot &s = slots[i];
+            ++s.age;
+            if ((pollTicks > 0) && ((tick + i) % pollTicks == 0) && (!s.poll))
+            {
+                s.poll = true;
+                if (!s.dirty) ++nDirty;
+            }
+            if (!s.posted) continue;
+            s.posted = false;
+            if ((!s.sent) || (s.left != s.sentLeft) || (s.right != s.sentRight))
+            {
+                s.sentLeft  = s.left;
+                s.sentRight = s.right;
+                s.sent      = true;
+                s.resend    = false;
+                s.nBytes    = encodeDrive(s.data, s.left, s.right);
+                encodeMux(s.muxData, s.left, s.right);
+            }
+            else if ((refreshTicks == 0) || (s.age < refreshTicks))
+            {
+                nSuppressed.fetch_add(1, memory_order_relaxed);
+                continue;
+            }
+            else s.resend = true;
+            s.age = 0;
+            if (!s.dirty)
+            {
+                s.dirty = true;
+                if (!s.poll) ++nDirty;
+            }
+        }
+        if (nDirty == 0) return;
+    }
+    if (isRunning()) ready.notify_one();
+    else             send();
+}   // flush()
+
+
+
+//
+// bool start()
+// Last modified: 17Oct2026
+//
+// Attempts to start writing the commands on the thread of this scheduler,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:  <none>
+//
+bool CommandScheduler::start()
+{
+    if ((isRunning()) || (sink == NULL)) return false;
+    running = true;
+    sender  = thread(&CommandScheduler::run, this);
+    return true;
+}   // start()
+
+
+
+//
+// void stop()
+// Last modified: 17Oct2026
+//
+// Stops writing the commands on the thread of this scheduler,
+// writing any that are still waiting first.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void CommandScheduler::stop()
+{
+    {
+        lock_guard<mutex> lock(slotMutex);
+        running = false;
+    }
+    ready.notify_all();
+    if (sender.joinable()) sender.join();
+    send();
+}   // stop()
+
+
+
+// <public accessor functions>
+
+//
+// bool isRunning() const
+// Last modified: 17Oct2026
+//
+// Returns true if this scheduler writes on its own thread, false otherwise.
+//
+// Returns:     true if this scheduler is running, false otherwise
+// Parameters:  <none>
+//
+bool CommandScheduler::isRunning() const
+{
+    return running;
+}   // isRunning() const
+
+
+
+//
+// GLint getRefresh() const
+// Last modified: 17Oct2026
+//
+// Returns the number of ticks between resends of an unchanged command.
+//
+// Returns:     the ticks between resends of a command (never if 0)
+// Parameters:  <none>
+//
+GLint CommandScheduler::getRefresh() const
+{
+    return refreshTicks;
+}   // getRefresh() const
+
+
+
+//
+// Route getRoute(ID) const
+// Last modified: 17Oct2026
+//
+// Returns the port and address that the commands of the parameterized
+// robot are written to.
+//
+// Returns:     the route of the robot
+// Parameters:
+//      ID      in      the ID of the robot
+//
+Route CommandScheduler::getRoute(const GLint ID) const
+{
+    return routes.getRoute(ID);
+}   // getRoute(const GLint) const
+
+
+
+//
+// GLint getLinkCapacity() const
+// Last modified: 17Oct2026
+//
+// Returns the number of bytes a port carries per tick.
+//
+// Returns:     the bytes per tick per port
+// Parameters:  <none>
+//
+GLint CommandScheduler::getLinkCapacity() const
+{
+    return linkCapacity;
+}   // getLinkCapacity() const
+
+
+
+//
+// GLint getPollInterval() const
+// Last modified: 17Oct2026
+//
+// Returns the number of ticks between polls of a robot.
+//
+// Returns:     the ticks between polls of a robot (never if 0)
+// Parameters:  <none>
+//
+GLint CommandScheduler::getPollInterval() const
+{
+    lock_guard<mutex> lock(slotMutex);
+    return pollTicks;
+}   // getPollInterval() const
+
+
+
+//
+// LinkMetrics* getMetrics() const
+// Last modified: 17Oct2026
+//
+// Returns the registry that the health of each port is reported to.
+//
+// Returns:     the registry of the health of the links (NULL if none)
+// Parameters:  <none>
+//
+LinkMetrics* CommandScheduler::getMetrics() const
+{
+    return metrics;
+}   // getMetrics() const
+
+
+
+//
+// long getNPosted() const
+// Last modified: 17Oct2026
+//
+// Returns the number of commands posted so far.
+//
+// Returns:     the number of commands posted so far
+// Parameters:  <none>
+//
+long CommandScheduler::getNPosted() const
+{
+    return nPosted.load(memory_order_relaxed);
+}   // getNPosted() const
+
+
+
+//
+// long getNSuppressed() const
+// Last modified: 17Oct2026
+//
+// Returns the number of ticks that a robot was not sent its command
+// because it had not changed.
+//
+// Returns:     the number of suppressed commands so far
+// Parameters:  <none>
+//
+long CommandScheduler::getNSuppressed() const
+{
+    return nSuppressed.load(memory_order_relaxed);
+}   // getNSuppressed() const
+
+
+
+//
+// long getNSent() const
+// Last modified: 17Oct2026
+//
+// Returns the number of commands handed to a port so far.
+//
+// Returns:     the number of commands sent so far
+// Parameters:  <none>
+//
+long CommandScheduler::getNSent() const
+{
+    return nSent.load(memory_order_relaxed);
+}   // getNSent() const
+
+
+
+//
+// long getNDropped() const
+// Last modified: 17Oct2026
+//
+// Returns the number of commands dropped so far for want of a port.
+//
+// Returns:     the number of commands dropped so far
+// Parameters:  <none>
+//
+long CommandScheduler::getNDropped() const
+{
+    return nDropped.load(memory_order_relaxed);
+}   // getNDropped() const
+
+
+
+//
+// long getNWrites() const
+// Last modified: 17Oct2026
+//
+// Returns the number of successful writes to a port so far.
+//
+// Returns:     the number of writes so far
+// Parameters:  <none>
+//
+long CommandScheduler::getNWrites() const
+{
+    return nWrites.load(memory_order_relaxed);
+}   // getNWrites() const
+
+
+
+//
+// long getNBytes() const
+// Last modified: 17Oct2026
+//
+// Returns the number of bytes successfully written so far.
+//
+// Returns:     the number of bytes written so far
+// Parameters:  <none>
+//
+long CommandScheduler::getNBytes() const
+{
+    return nBytes.load(memory_order_relaxed);
+}   // getNBytes() const
+
+
+
+//
+// long getNPolls() const
+// Last modified: 17Oct2026
+//
+// Returns the number of queries handed to a port so far.
+//
+// Returns:     the number of polls so far
+// Parameters:  <none>
+//
+long CommandScheduler::getNPolls() const
+{
+    return nPolls.load(memory_order_relaxed);
+}   // getNPolls() const
+
+
+
+//
+// RoutingTable& getRoutingTable()
+// Last modified: 17Oct2026
+//
+// Returns the table that routes the commands of each robot to a port.
+//
+// Returns:     the routing table
+// Parameters:  <none>
+//
+RoutingTable& CommandScheduler::getRoutingTable()
+{
+    return routes;
+}   // getRoutingTable()
+
+
+
+//
+// mutex& getSendMutex()
+// Last modified: 17Oct2026
+//
+// Returns the mutex held while the ports are written to, which is to be
+// held while the ports themselves change (such as a terminal closing).
+//
+// Returns:     the mutex held while writing
+// Parameters:  <none>
+//
+mutex& CommandScheduler::getSendMutex()
+{
+    return sendMutex;
+}   // getSendMutex()
+
+
+
+// <protected utility functions>
+
+//
+// void run()
+// Last modified: 17Oct2026
+//
+// Writes the commands handed over at the end of each tick
+// until this scheduler is stopped.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void CommandScheduler::run()
+{
+    unique_lock<mutex> lock(slotMutex);
+    while (running)
+    {
+        ready.wait(lock, [this] { return (nDirty > 0) || (!running); });
+        if (nDirty == 0) continue;
+        lock.unlock();
+        send();
+        lock.lock();
+    }
+}   // run()
+
+
+
+//
+// void send()
+// Last modified: 17Oct2026
+//
+// Takes the commands and polls waiting for the sender, appending each to
+// the batch of its port (dropping those without one), and those of robots
+// sharing a port to multiplexed frames at the end of it, then writes each
+// batch
+// at once (timing the write and, if written, each command in it until
+// acknowledged).  The batches keep their storage from tick to tick.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void CommandScheduler::send()
+{
+    lock_guard<mutex> sendLock(sendMutex);
+    GLint nPorts = (sink == NULL) ? 0 : sink->getNPorts();
+    if ((GLint)batches.size() < nPorts)
+    {
+        batches.resize(nPorts);
+        muxes.resize(nPorts);
+        polls.resize(nPorts);
+        batchIDs.resize(nPorts);
+    }
+    {
+        lock_guard<mutex> lock(slotMutex);
+        if (nDirty == 0) return;
+        for (GLint i = 0; i < (GLint)slots.size(); ++i)
+        {
+            CommandSlot &s = slots[i];
+            if ((!s.dirty) && (!s.poll)) continue;
+            const bool command = s.dirty, poll = s.poll;
+            s.dirty = s.poll = false;
+            Route r = routes.getRoute(i);
+            if ((r.port < 0) || (r.port >= nPorts))
+            {
+                if (!command) continue;
+                nDropped.fetch_add(1, memory_order_relaxed);
+                if (metrics != NULL) metrics->commandDropped(r.port);
+                continue;
+            }
+            if (command)
+            {
+                if (r.address == ROUTE_DIRECT)
+                    batches[r.port].insert(batches[r.port].end(),
+                                           s.data, s.data + s.nBytes);
+                else
+                {
+                    muxes[r.port].push_back((char)r.address);
+                    muxes[r.port].insert(muxes[r.port].end(), s.muxData,
+                                         s.muxData + MUX_ENTRY_BYTES - 1);
+                }
+                batchIDs[r.port].push_back(i);
+                nSent.fetch_add(1, memory_order_relaxed);
+                if (metrics != NULL) metrics->commandSent(r.port, s.resend);
+            }
+            if (poll)
+            {
+                if (r.address == ROUTE_DIRECT)
+                    batches[r.port].insert(batches[r.port].end(), POLL_QUERY,
+                                           POLL_QUERY + POLL_QUERY_BYTES);
+                else polls[r.port].push_back((char)r.address);
+                nPolls.fetch_add(1, memory_order_relaxed);
+                if (metrics != NULL) metrics->pollSent(r.port);
+            }
+        }
+        nDirty = 0;
+    }
+    for (GLint i = 0; i < nPorts; ++i)
+    {
+        packMux(i, muxes[i], 'D', MUX_ENTRY_BYTES);
+        packMux(i, polls[i], 'Q', 1);
+        GLint n = (GLint)batches[i].size();
+        if (n == 0) continue;
+        const long long queued  = (metrics != NULL) ? sink->getNQueued(i) : 0;
+        const long long start   = (metrics != NULL) ? LinkMetrics::now()  : 0;
+        const bool      success = sink->send(i, &batches[i][0], n);
+        if (success)
+        {
+            nWrites.fetch_add(1, memory_order_relaxed);
+            nBytes.fetch_add(n, memory_order_relaxed);
+        }
+        if (metrics != NULL)
+        {
+            metrics->batchWritten(i, n, LinkMetrics::now() - start, success,
+                                  n > linkCapacity, queued);
+            for (GLint j = 0; (success) && (j < (GLint)batchIDs[i].size()); ++j)
+                metrics->awaitAck(i, batchIDs[i][j], start);
+        }
+        batches[i].clear();
+        batchIDs[i].clear();
+    }
+}   // send()
+
+
+
+//
+// void packMux(port, entries, type, entryBytes)
+// Last modified: 17Oct2026
+//
+// Appends the parameterized entries for the robots sharing the
+// parameterized port to its batch, as frames of up to MAX_MUX_PAYLOAD
+// bytes of whole entries framed like a binary reply: TELEMETRY_SOF,
+// ROUTE_MULTIPLEX, the type, the length of the payload, the entries
+// (each starting with an address), and the CRC-16/CCITT (low byte first).
+//
+// Returns:     <none>
+// Parameters:
+//      port        in      the index of the port
+//      entries     in/out  the entries (cleared once appended)
+//      type        in      the type of the frame ('D' drive, 'Q' query)
+//      entryBytes  in      the bytes per entry
+//
+void CommandScheduler::packMux(const GLint     port,
+                               vector<char> &entries,
+                               const char    type,
+                               const GLint   entryBytes)
+{
+    vector<char> &batch     = batches[port];
+    const GLint   nBytes    = (GLint)entries.size();
+    const GLint   maxLength = MAX_MUX_PAYLOAD / entryBytes * entryBytes;
+    for (GLint begin = 0; begin < nBytes; begin += maxLength)
+    {
+        GLint length = nBytes - begin;
+        if (length > maxLength) length = maxLength;
+        const GLint start = (GLint)batch.size();
+        batch.push_back((char)TELEMETRY_SOF);
+        batch.push_back((char)ROUTE_MULTIPLEX);
+        batch.push_back(type);
+        batch.push_back((char)length);
+        batch.insert(batch.end(), entries.begin() + begin,
+                     entries.begin() + begin + length);
+        unsigned short crc = TelemetryParser::crc16(
+            (const unsigned char *)&batch[start + 1], length + 3);
+        batch.push_back((char)(crc & 0xFF));
+        batch.push_back((char)(crc >> 8));
+    }
+    entries.clear();
+}   // packMux(const GLint, vector<char> &, const char, const GLint)
+
+
+
+//
+// bool grow(ID)
+// Last modified: 17Oct2026
+//
+// Attempts to make room for the commands of the parameterized robot,
+// with the slot mutex held, returning true if successful,
+// false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      ID      in      the ID of the robot
+//
+bool CommandScheduler::grow(const GLint ID)
+{
+    if (ID < 0) return false;
+    GLint n = (GLint)slots.size();
+    if (ID < n) return true;
+    slots.resize(ID + 1);
+    for (GLint i = n; i <= ID; ++i)
+    {
+        CommandSlot &s = slots[i];
+        s.left     = s.right     = 0;
+        s.sentLeft = s.sentRight = 0;
+        s.posted   = s.sent      = s.dirty = s.resend = s.poll = false;
+        s.age      = s.nBytes    = 0;
+    }
+    return true;
+}   // grow(const GLint)
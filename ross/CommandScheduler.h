@@ -0,0 +1,228 @@
+//
+// Filename:        "CommandScheduler.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes a scheduler that collects the drive
+//                  commands posted for the robots during a tick, suppresses
+//                  those that have not changed, and hands the rest (encoded
+//                  once each) to a sender thread that writes all of the
+//                  commands routed to a port in one write per tick (robots
+//                  sharing a port in multiplexed frames), along with the
+//                  queries that poll the robots for their odometry.
+//
+
+// preprocessor directives
+#ifndef COMMAND_SCHEDULER_H
+#define COMMAND_SCHEDULER_H
+#include <atomic>
+#include <cstddef>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "GLTypes.h"
+#include "LinkMetrics.h"
+#include "RoutingTable.h"
+using namespace std;
+
+// global constants
+static const GLint MAX_COMMAND_BYTES       = 32;  // bytes per encoded command
+static const GLint DEFAULT_COMMAND_REFRESH = 10;  // ticks between resends
+static const GLint MUX_ENTRY_BYTES         = 5;   // address and wheel speeds
+static const GLint MAX_MUX_PAYLOAD         = 255; // payload bytes per frame
+static const GLint DEFAULT_LINK_CAPACITY   = 1152; // bytes per tick per port
+static const GLint DEFAULT_POLL_TICKS      = 0;   // ticks between polls
+static const char  POLL_QUERY[]            = "Q\r"; // asks for wheel steps
+static const GLint POLL_QUERY_BYTES        = 2;
+
+//
+// CommandSink
+//
+// Describes the ports that the commands are written to.
+//
+class CommandSink
+{
+    public:
+
+        // <destructors>
+        virtual ~CommandSink() { }
+
+        // <virtual public accessor functions>
+        virtual GLint     getNPorts()             const = 0;
+        virtual long long getNQueued(const GLint) const { return 0; }
+
+        // <virtual public utility functions>
+        virtual bool send(const GLint port, const char *data, const GLint n) = 0;
+};  // CommandSink
+
+#ifndef ROSS_HEADLESS
+class QObject;
+
+//
+// TerminalSink
+//
+// Describes the serial ports of the open terminals as command ports,
+// which belong to the thread of the terminals (not the sender thread),
+// so the writes are appended to a buffer kept for each port (reused
+// from tick to tick) and made there by the writer's
+// writeTerminal(QObject *) slot, which takes the buffer through take()
+// and reports back through written(). At most one call to the slot is
+// queued per port at a time (the writes made while it waits are
+// appended to the same buffer), so a tick costs no allocation beyond
+// that queued call.
+//
+class TerminalSink: public CommandSink
+{
+    public:
+
+        // <constructors>
+        TerminalSink(QObject *w = NULL);
+
+        // <virtual public accessor functions>
+        virtual GLint     getNPorts()                  const;
+        virtual long long getNQueued(const GLint port) const;
+
+        // <public mutator functions>
+        const vector<char>& take(const QObject *port);
+        void                written(const QObject   *port,
+                                    const GLint      n,
+                                    const long long  queued);
+
+        // <virtual public utility functions>
+        virtual bool send(const GLint port, const char *data, const GLint n);
+
+    protected:
+
+        //
+        // PortQueue
+        //
+        // Describes the bytes written to a port that it has yet to send.
+        //
+        struct PortQueue
+        {
+            long long    nHanded;   // handed over but not yet written
+            long long    nQueued;   // left queued by the port's last write
+            vector<char> pending;   // handed over since the last take()
+            vector<char> writing;   // taken by the writer (its thread only)
+            bool         posted;    // true if a call to the writer is queued
+        };  // PortQueue
+
+        // <protected data members>
+        QObject                            *writer;
+        mutable mutex                       queueMutex;  // guards the queues
+        map<const QObject *, PortQueue>     queues;      // indexed by port
+
+    private:
+
+        // <private constructors>
+        TerminalSink(const TerminalSink &);
+        TerminalSink& operator =(const TerminalSink &);
+};  // TerminalSink
+#endif
+
+//
+// CommandSlot
+//
+// Describes the drive commands of a robot.
+//
+struct CommandSlot
+{
+    GLint left, right;          // the wheel speeds posted this tick
+    bool  posted;               // true if posted this tick
+    GLint sentLeft, sentRight;  // the wheel speeds last handed to the sender
+    bool  sent;                 // true if ever handed to the sender
+    GLint age;                  // the ticks since last handed to the sender
+    bool  dirty;                // true if waiting for the sender
+    bool  resend;               // true if unchanged since last handed over
+    bool  poll;                 // true if due to be polled (by the sender)
+    GLint nBytes;               // the length of the encoded command
+    char  data[MAX_COMMAND_BYTES];          // the command alone on a port
+    char  muxData[MUX_ENTRY_BYTES - 1];     // the command on a shared port
+};  // CommandSlot
+
+class CommandScheduler
+{
+
+    public:
+
+        // <constructors>
+        CommandScheduler(CommandSink *s       = NULL,
+                         const GLint  refresh = DEFAULT_COMMAND_REFRESH);
+
+        // <destructors>
+        ~CommandScheduler();
+
+        // <public mutator functions>
+        bool setSink(CommandSink *s = NULL);
+        bool setRefresh(const GLint refresh = DEFAULT_COMMAND_REFRESH);
+        bool setRoute(const GLint ID,
+                      const GLint port,
+                      const GLint address = ROUTE_DIRECT);
+        bool setLinkCapacity(const GLint bytes = DEFAULT_LINK_CAPACITY);
+        bool setPollInterval(const GLint ticks = DEFAULT_POLL_TICKS);
+        bool setMetrics(LinkMetrics *m = NULL);
+        bool post(const GLint ID, const GLint left, const GLint right);
+        void flush();
+        bool start();
+        void stop();
+
+        // <public accessor functions>
+        bool          isRunning()                  const;
+        GLint         getRefresh()                 const;
+        Route         getRoute(const GLint ID)     const;
+        GLint         getLinkCapacity()            const;
+        GLint         getPollInterval()            const;
+        LinkMetrics*  getMetrics()                 const;
+        long          getNPosted()                 const;
+        long          getNSuppressed()             const;
+        long          getNSent()                   const;
+        long          getNDropped()                const;
+        long          getNWrites()                 const;
+        long          getNBytes()                  const;
+        long          getNPolls()                  const;
+        RoutingTable& getRoutingTable();
+        mutex&        getSendMutex();
+
+    protected:
+
+        // <protected data members>
+        CommandSink            *sink;
+        GLint                   refreshTicks;
+        GLint                   linkCapacity;
+        GLint                   pollTicks;
+        long                    tick;        // the ticks flushed so far
+        LinkMetrics            *metrics;
+        RoutingTable            routes;
+        vector<CommandSlot>     slots;       // indexed by robot ID
+        vector< vector<char> >  batches;     // indexed by port
+        vector< vector<char> >  muxes;       // indexed by port
+        vector< vector<char> >  polls;       // indexed by port (addresses)
+        vector< vector<GLint> > batchIDs;    // indexed by port
+        GLint                   nDirty;      // slots waiting for the sender
+        thread                  sender;
+        atomic<bool>            running;
+        mutable mutex           slotMutex;   // guards the slots
+        mutex                   sendMutex;   // guards the batches and ports
+        condition_variable      ready;
+        atomic<long>            nPosted, nSuppressed, nSent, nDropped;
+        atomic<long>            nWrites, nBytes, nPolls;
+
+        // <protected utility functions>
+        void  run();
+        void  send();
+        void  packMux(const GLint     port,
+                      vector<char> &entries,
+                      const char    type,
+                      const GLint   entryBytes);
+        bool  grow(const GLint ID);
+
+    private:
+
+        // <private constructors>
+        CommandScheduler(const CommandScheduler &);
+        CommandScheduler& operator =(const CommandScheduler &);
+};  // CommandScheduler
+#endif
@@ -10,8 +10,8 @@
 // preprocessor directives
 #include "Environment.h"
 #include <time.h>
-#include "../formationcontrol/helpers.h"
-#include "simulator.h"
+#include "../FormationControl/helpers.h"
+#include "Simulator.h"
 
 
 // <constructors>
@@ -52,7 +52,9 @@ Environment::Environment(const GLint     n,
 //      e       in/out      the environment being copied
 //
 Environment::Environment(const Environment &e)
-    : cells(e.cells), msgQueue(e.msgQueue)
+    : cells(e.cells), grid(e.grid), msgQueue(e.msgQueue), poseFeed(NULL),
+      motionFeed(NULL), scheduler(NULL), odometryFeed(NULL),
+      nDroppedPackets(e.nDroppedPackets.load())
 {
 }   // Environment(const Environment &)
 
@@ -150,7 +152,7 @@ bool Environment::addCell(int xi, int yi, float heading, Cell *c)
         delete c;
         return false;
     }
-    return true;
+    return grid.insert(c->x, c->y);
 }
 
 
@@ -158,10 +160,11 @@ bool Environment::addCell(int xi, int yi, float heading, Cell *c)
 
 //
 // bool addCell(c)
-// Last modified: 27Aug2006
+// Last modified: 17Oct2026
 //
-// Attempts to add a cell to the environment,
-// returning true if successful, false otherwise.
+// Attempts to add a cell to the environment at a random position
+// clear of every other cell (widening the area searched whenever it
+// gets too crowded), returning true if successful, false otherwise.
 //
 // Returns:     true if successful, false otherwise
 // Parameters:
@@ -172,16 +175,18 @@ bool Environment::addCell(Cell *c)
     if ((c == NULL) && ((c = new Cell()) == NULL)) return false;
 
     // assign random x-/y-position, making sure that no cells are overlapping
-    bool done = true;
+    GLfloat span   = 1.0f;
+    GLint   nTries = 0;
     do
     {
-        c->x = frand(-1.0f, 1.0f);
-        c->y = frand(-1.0f, 1.0f);
-        done = true;
-        for (int i = 0; i < cells.getSize(); ++i)
-            if (c->getDistanceTo(*cells[i]) <= c->collisionRadius())
-                done = false;
-    }   while (!done);
+        if (++nTries > MAX_PLACEMENT_TRIES)
+        {
+            span  *= FACTOR_PLACEMENT_GROWTH;
+            nTries = 1;
+        }
+        c->x = frand(-span, span);
+        c->y = frand(-span, span);
+    }   while (grid.collides(c->x, c->y, c->collisionRadius()));
     c->setHeading(frand(-180.0f, 180.0f));  // assign random heading
     c->setEnvironment(this);
 
@@ -191,7 +196,7 @@ bool Environment::addCell(Cell *c)
         delete c;
         return false;
     }
-    return true;
+    return grid.insert(c->x, c->y);
 }   // addCell(Cell *)
 
 
@@ -218,7 +223,7 @@ bool Environment::removeCell()
 
 //
 // bool removeCell(c)
-// Last modified: 27Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to remove a cell from the environment,
 // storing the address of the removed cell and
@@ -230,16 +235,120 @@ bool Environment::removeCell()
 //
 bool Environment::removeCell(Cell* &c)
 {
-    return cells.removeTail(c);
+    if (!cells.removeTail(c)) return false;
+    grid.removeTail();
+    return true;
 }   // removeCell(Cell* &)
 
 
 
+//
+// bool setNThreads(n)
+// Last modified: 17Oct2026
+//
+// Attempts to set the number of threads used to step the cells
+// (one per core if n is 0), returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      n       in      the number of threads (default one per core)
+//
+bool Environment::setNThreads(const GLint n)
+{
+    return workers.setNThreads(n);
+}   // setNThreads(const GLint)
+
+
+
+//
+// bool setPoseFeed(feed)
+// Last modified: 17Oct2026
+//
+// Attempts to set the feed of camera poses that corrects the position
+// and heading of the cells at the start of every step (none if NULL),
+// returning true if successful, false otherwise.  Only this environment
+// may read from the feed.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      feed    in      the feed of camera poses (default none)
+//
+bool Environment::setPoseFeed(PoseFeed *feed)
+{
+    poseFeed = feed;
+    return true;
+}   // setPoseFeed(PoseFeed *)
+
+
+
+//
+// bool setMotionFeed(feed)
+// Last modified: 17Oct2026
+//
+// Attempts to set the feed that the pose and commanded velocity of each
+// cell (in camera pixels) go to at the end of every step, for the camera
+// to predict where to look for the robots (none if NULL), returning true
+// if successful, false otherwise.  Only this environment may publish to
+// the feed.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      feed    in      the feed of expected poses (default none)
+//
+bool Environment::setMotionFeed(PoseFeed *feed)
+{
+    motionFeed = feed;
+    return true;
+}   // setMotionFeed(PoseFeed *)
+
+
+
+//
+// bool setCommandScheduler(s)
+// Last modified: 17Oct2026
+//
+// Attempts to set the scheduler that the cells post their drive commands
+// to while moving (none if NULL), which is flushed at the end of every
+// step, returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      s       in      the scheduler of drive commands (default none)
+//
+bool Environment::setCommandScheduler(CommandScheduler *s)
+{
+    scheduler = s;
+    return true;
+}   // setCommandScheduler(CommandScheduler *)
+
+
+
+//
+// bool setOdometryFeed(feed)
+// Last modified: 17Oct2026
+//
+// Attempts to set the feed of the wheel odometry that the robots report
+// (none if NULL), which moves each cell by how its wheels actually turned
+// whenever its robot has reported since the last step,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      feed    in      the feed of wheel odometry (default none)
+//
+bool Environment::setOdometryFeed(OdometryFeed *feed)
+{
+    odometryFeed = feed;
+    return true;
+}   // setOdometryFeed(OdometryFeed *)
+
+
+
 // <public accessor functions>
 
 //
 // Cell* getCell() const
-// Last modified: 27Aug2006
+// Last modified: 17Oct2026
 //
 // Returns the cell at the parameterized position.
 //
@@ -248,17 +357,14 @@ bool Environment::removeCell(Cell* &c)
 //
 Cell* Environment::getCell(GLint pos) const
 {
-    Cell *head = NULL;
-    if ((pos < 0) || (pos > getNCells()) || (!cells.getHead(head)))
-        return NULL;
-    pos -= head->getID();
-    return cells[(pos < 0) ? getNCells() + pos : pos];
+    pos = getCellIndex(pos);
+    return (pos < 0) ? NULL : cells[pos];
 }   // getCell(GLint) const
 
 
 
 //
-// LinkedList<Cell *> getCells() const
+// ArrayList<Cell *> getCells() const
 // Last modified: 27Aug2006
 //
 // Returns all of the cells in the environment.
@@ -266,7 +372,7 @@ Cell* Environment::getCell(GLint pos) const
 // Returns:     all of the cells in the environment
 // Parameters:  <none>
 //
-LinkedList<Cell *> Environment::getCells()
+ArrayList<Cell *> Environment::getCells()
 {
     return cells;
 }   // getCells()
@@ -289,52 +395,178 @@ GLint Environment::getNCells() const
 
 
 
+//
+// GLint getNThreads() const
+// Last modified: 17Oct2026
+//
+// Returns the number of threads used to step the cells.
+//
+// Returns:     the number of threads used to step the cells
+// Parameters:  <none>
+//
+GLint Environment::getNThreads() const
+{
+    return workers.getNThreads();
+}   // getNThreads() const
+
+
+
+//
+// const PoseStore& getPoses() const
+// Last modified: 17Oct2026
+//
+// Returns the poses of the cells (by position in the cell list)
+// as of the end of the last step.
+//
+// Returns:     the poses of the cells
+// Parameters:  <none>
+//
+const PoseStore& Environment::getPoses() const
+{
+    return poses;
+}   // getPoses() const
+
+
+
+//
+// PoseFeed* getPoseFeed() const
+// Last modified: 17Oct2026
+//
+// Returns the feed of camera poses that corrects the cells (if any).
+//
+// Returns:     the feed of camera poses, NULL if none
+// Parameters:  <none>
+//
+PoseFeed* Environment::getPoseFeed() const
+{
+    return poseFeed;
+}   // getPoseFeed() const
+
+
+
+//
+// PoseFeed* getMotionFeed() const
+// Last modified: 17Oct2026
+//
+// Returns the feed that the expected poses of the cells go to (if any).
+//
+// Returns:     the feed of expected poses, NULL if none
+// Parameters:  <none>
+//
+PoseFeed* Environment::getMotionFeed() const
+{
+    return motionFeed;
+}   // getMotionFeed() const
+
+
+
+//
+// CommandScheduler* getCommandScheduler() const
+// Last modified: 17Oct2026
+//
+// Returns the scheduler that the cells post their drive commands to (if any).
+//
+// Returns:     the scheduler of drive commands, NULL if none
+// Parameters:  <none>
+//
+CommandScheduler* Environment::getCommandScheduler() const
+{
+    return scheduler;
+}   // getCommandScheduler() const
+
+
+
+//
+// OdometryFeed* getOdometryFeed() const
+// Last modified: 17Oct2026
+//
+// Returns the feed of the wheel odometry that the robots report (if any).
+//
+// Returns:     the feed of wheel odometry, NULL if none
+// Parameters:  <none>
+//
+OdometryFeed* Environment::getOdometryFeed() const
+{
+    return odometryFeed;
+}   // getOdometryFeed() const
+
+
+
+//
+// long getNDroppedPackets() const
+// Last modified: 17Oct2026
+//
+// Returns the number of packets dropped so far because a queue between
+// the cells was full (read only between steps).
+//
+// Returns:     the number of packets dropped
+// Parameters:  <none>
+//
+long Environment::getNDroppedPackets() const
+{
+    long n = nDroppedPackets.load(memory_order_relaxed);
+    for (GLint i = 0; i < getNCells(); ++i) n += cells[i]->getNDroppedPackets();
+    return n;
+}   // getNDroppedPackets() const
+
+
+
 // <virtual public utility functions>
 
 //
 // void draw()
-// Last modified: 27Aug2006
+// Last modified: 17Oct2026
 //
-// Renders the environment.
+// Renders the environment, batching the cells (as of the end
+// of the last step) into a constant number of draw calls.
 //
 // Returns:     <none>
 // Parameters:  <none>
 //
 void Environment::draw()
 {
-    Cell *currCell = NULL;
-    for (GLint i = 0; i < getNCells(); ++i)
-        if (cells.getHead(currCell))
-        {
-            currCell->draw();
-            ++cells;
-        }
+    if (poses.getSize() != getNCells()) loadPoses();
+    renderer.build(poses, cells);
+    renderer.draw();
 }   // draw()
 
 
 
 //
-// void step()
-// Last modified: 27Aug2006
+// bool step()
+// Last modified: 17Oct2026
 //
-// Executes the next step in each cell in the environment
-// and forwards all sent packets to their destinations.
+// Executes the next step in each cell in the environment in two phases,
+// returning true if successful, false otherwise.  Any camera poses that
+// have arrived since the last step replace the dead-reckoned poses of
+// the cells they match before anything else.  First, every cell
+// decides what to do from the positions of the last step and the packets
+// it was sent during the last step (split across the worker threads,
+// since no cell moves or delivers packets yet).  Then, all sent packets
+// are forwarded in cell order and every cell moves, so the result is
+// the same no matter how many threads are used.  Finally, the drive
+// commands posted while moving go out through the command scheduler
+// (if any), and the new poses (and the velocities that led to them)
+// go to the motion feed (if any).
 //
-// Returns:     <none>
+// Returns:     true if successful, false otherwise
 // Parameters:  <none>
 //
 bool Environment::step()
 {
-    Cell *currCell = NULL;
-    for (GLint i = 0; i < getNCells(); ++i)
+    applyPoseFeed();
+    loadPoses();
+    workers.parallelFor(getNCells(), [this](const int begin, const int end)
     {
-        if (!cells.getHead(currCell)) return false;
-        currCell->step();
-        ++cells;
-    }
+        for (GLint i = begin; i < end; ++i) cells[i]->compute();
+    });
 
     // forwards all messages sent via robot cell communication
-    return forwardPackets();
+    bool success = forwardPackets();
+    movePoses();
+    if (scheduler != NULL) scheduler->flush();
+    publishMotion();
+    return success;
 }   // step()
 
 
@@ -358,56 +590,116 @@ void Environment::clear()
 // <public utility functions>
 
 //
-// Vector getRelationship(toID, fromID)
-// Last modified: 27Aug2006
+// void draw(p)
+// Last modified: 17Oct2026
+//
+// Renders the environment with the cells at the parameterized poses
+// (such as those interpolated between two ticks), or at their current
+// poses if the number of poses does not match the number of cells.
+//
+// Returns:     <none>
+// Parameters:
+//      p       in      the poses of the cells
+//
+void Environment::draw(const PoseStore &p)
+{
+    if (renderer.build(p, cells)) renderer.draw();
+    else                          draw();
+}   // draw(const PoseStore &)
+
+
+
+//
+// Vec2f getRelationship(toID, fromID)
+// Last modified: 17Oct2026
 //
 // Returns the relationship between the two cells
-// with the parameterized ID's.
+// with the parameterized ID's (as of the start of this step).
 //
 // Returns:     the relationship between two cells
 // Parameters:
 //      toID    in      the ID of the cell being related to
 //      fromID  in      the ID of the cell being related from
 //
-Vector Environment::getRelationship(const GLint toID, const GLint fromID)
+Vec2f Environment::getRelationship(const GLint toID, const GLint fromID)
 {
-    Cell  *toCell = getCell(toID), *fromCell = getCell(fromID);
-    if ((toCell == NULL) || (fromCell == NULL)) return Vector();
-    Vector temp   = *toCell - *fromCell;
-    temp.rotateRelative(-fromCell->getHeading());
-    return temp;
+    return poses.getRelationship(getCellIndex(toID), getCellIndex(fromID));
 }   // getRelationship(const GLint, const GLint)
 
 
 
 //
-// bool sendMsg(msg, toID, fromID, type)
-// Last modified: 07Sep2006
+// void getRelationshipsTo(fromID, toIDs, rels, n)
+// Last modified: 17Oct2026
+//
+// Stores the relationships from the cell with the parameterized ID to
+// each of the cells with the parameterized ID's (as of the start of this
+// step), turning them all into the frame of the cell at once.
+//
+// Returns:     <none>
+// Parameters:
+//      fromID  in      the ID of the cell being related from
+//      toIDs   in      the ID's of the cells being related to
+//      rels    out     the relationships between the cells
+//      n       in      the number of cells being related to
+//
+void Environment::getRelationshipsTo(const GLint fromID,
+                                     const GLint toIDs[],
+                                     Vec2f       rels[],
+                                     const GLint n)
+{
+    const GLint from = getCellIndex(fromID);
+    if ((from < 0) || (from >= poses.getSize()))
+    {
+        for (GLint i = 0; i < n; ++i) rels[i] = Vec2f();
+        return;
+    }
+    for (GLint i = 0; i < n; ++i)
+    {
+        const GLint to = getCellIndex(toIDs[i]);
+        rels[i] = ((to < 0) || (to >= poses.getSize())) ? Vec2f() :
+            Vec2f(poses.x[to] - poses.x[from], poses.y[to] - poses.y[from]);
+    }
+    rotateAll(rels, rels, n, -poses.heading[from]);
+}   // getRelationshipsTo(const GLint, const GLint [], Vec2f [], const GLint)
+
+
+
+//
+// bool sendMsg(f, toID, fromID, type)
+// Last modified: 17Oct2026
 //
-// Attempts to send a packet to its destination
-// based upon the given parameters, returning
-// true if successful, false otherwise.
+// Attempts to send a packet carrying the parameterized formation
+// to its destination based upon the given parameters (compiling
+// a formation change for every cell so that the cells can look up
+// their places in it), returning true if successful, false otherwise.
 //
 // Returns:     true if successful, false otherwise
 // Parameters:
-//      msg     in/out  the message being sent
+//      f       in      the formation being sent
 //      toID    in      the ID of the cell receiving the packet
 //      fromID  in      the ID of the cell sending the packet
 //      type    in      the type of message being sent
 //
-bool Environment::sendMsg(const Message &msg,
-                          const GLint    toID,
-                          const GLint    fromID,
-                          const GLint    type)
+bool Environment::sendMsg(const Formation &f,
+                          const GLint      toID,
+                          const GLint      fromID,
+                          const GLint      type)
 {
-    return sendPacket(Packet(msg, toID, fromID, type));
-}   // sendMsg(const Message &, const GLint, const GLint, const GLint)
+    if ((type == CHANGE_FORMATION) && (!f.isCompiled()))
+    {
+        Formation compiled(f);
+        compiled.compile(getNCells());
+        return sendPacket(Packet(compiled, toID, fromID, type));
+    }
+    return sendPacket(Packet(f, toID, fromID, type));
+}   // sendMsg(const Formation &, const GLint, const GLint, const GLint)
 
 
 
 //
 // bool sendPacket(p)
-// Last modified: 07Sep2006
+// Last modified: 17Oct2026
 //
 // Attempts to send a packet to its destination,
 // returning true if successful, false otherwise.
@@ -423,20 +715,19 @@ bool Environment::sendPacket(const Packet &p)
     //if (msgQueue.enqueue(p)) return true;
 
     // continuous message passing
-    if (forwardPacket(p)) return true;
-
-    delete p.msg;
-    return false;
+    return forwardPacket(p);
 }   // sendPacket(const Packet &)
 
 
 
 //
 // bool forwardPacket(p)
-// Last modified: 07Sep2006
+// Last modified: 17Oct2026
 //
-// Attempts to forward a packet to its destination,
-// returning true if successful, false otherwise.
+// Attempts to forward a packet to its destination, returning true
+// if successful, false otherwise (if it has no destination).  A packet
+// its destination has no room for is counted as dropped instead, so
+// a burst of traffic costs packets rather than the tick.
 //
 // Returns:     true if successful, false otherwise
 // Parameters:
@@ -445,18 +736,20 @@ bool Environment::sendPacket(const Packet &p)
 bool Environment::forwardPacket(const Packet &p)
 {
     Cell *c = getCell(p.toID);
-    if ((c != NULL) && (c->msgQueue.enqueue(p))) return true;
-    delete p.msg;
-    return false;
+    if (c == NULL) return false;
+    if (!c->msgQueue.enqueue(p))
+        nDroppedPackets.fetch_add(1, memory_order_relaxed);
+    return true;
 }   // forwardPacket(const Packet &)
 
 
 
 //
 // bool forwardPackets()
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
-// Attempts to forward all packets to their destinations,
+// Attempts to forward all packets (those queued in the environment,
+// then those sent by each cell, in cell order) to their destinations,
 // returning true if successful, false otherwise.
 //
 // Returns:     true if successful, false otherwise
@@ -464,19 +757,96 @@ bool Environment::forwardPacket(const Packet &p)
 //
 bool Environment::forwardPackets()
 {
+    bool   success = true;
     Packet p;
-    while (msgQueue.dequeue(p))
-        if (!forwardPacket(p)) return false;
-    return true;
+    while (msgQueue.dequeue(p)) success = forwardPacket(p) && success;
+    for (GLint i = 0; i < getNCells(); ++i)
+        while (cells[i]->sendQueue.dequeue(p))
+            success = forwardPacket(p) && success;
+    return success;
 }   // forwardPackets()
 
 
 
+// <public spatial query functions>
+
+//
+// ArrayList<GLint> getNearestCells(id, k)
+// Last modified: 17Oct2026
+//
+// Returns the ID's of (up to) the parameterized number of cells nearest
+// to the cell with the parameterized ID (as of the end of the last step).
+//
+// Returns:     the ID's of the nearest cells (nearest first)
+// Parameters:
+//      id      in      the ID of the cell
+//      k       in      the number of cells to find
+//
+ArrayList<GLint> Environment::getNearestCells(const GLint id, const GLint k)
+{
+    ArrayList<GLint> nearest;
+    const GLint      i = getCellIndex(id);
+    if ((i < 0) || (i >= grid.getSize())) return nearest;
+    grid.getNearest(cells[i]->x, cells[i]->y, k, nearest, i);
+    for (GLint j = 0; j < nearest.getSize(); ++j)
+        nearest[j] = cells[nearest[j]]->getID();
+    return nearest;
+}   // getNearestCells(const GLint, const GLint)
+
+
+
+//
+// ArrayList<GLint> getCellsWithin(id, r)
+// Last modified: 17Oct2026
+//
+// Returns the ID's of the cells within the parameterized radius of the
+// cell with the parameterized ID (as of the end of the last step).
+//
+// Returns:     the ID's of the cells within the radius (in no order)
+// Parameters:
+//      id      in      the ID of the cell
+//      r       in      the radius being searched
+//
+ArrayList<GLint> Environment::getCellsWithin(const GLint id, const GLfloat r)
+{
+    ArrayList<GLint> within;
+    const GLint      i = getCellIndex(id);
+    if ((i < 0) || (i >= grid.getSize())) return within;
+    grid.getWithin(cells[i]->x, cells[i]->y, r, within, i);
+    for (GLint j = 0; j < within.getSize(); ++j)
+        within[j] = cells[within[j]]->getID();
+    return within;
+}   // getCellsWithin(const GLint, const GLfloat)
+
+
+
+//
+// bool isColliding(id)
+// Last modified: 17Oct2026
+//
+// Returns true if any other cell is within the collision radius of the
+// cell with the parameterized ID (as of the end of the last step),
+// false otherwise.
+//
+// Returns:     true if the cell is colliding, false otherwise
+// Parameters:
+//      id      in      the ID of the cell
+//
+bool Environment::isColliding(const GLint id)
+{
+    const GLint i = getCellIndex(id);
+    if ((i < 0) || (i >= grid.getSize())) return false;
+    return grid.collides(cells[i]->x, cells[i]->y,
+                         cells[i]->collisionRadius(), i);
+}   // isColliding(const GLint)
+
+
+
 // <public utility cell functions>
 
 //
 // bool showLine(show)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to display the line of the heading vector of each cell,
 // returning true if successful, false otherwise.
@@ -487,22 +857,15 @@ bool Environment::forwardPackets()
 //
 bool Environment::showLine(const bool show)
 {
-    Cell *currCell;
-    for (GLint i = 0; i < getNCells(); ++i)
-        if (cells.getHead(currCell))
-        {
-            currCell->heading.showLine = show;
-            ++cells;
-        }
-        else return false;
+    for (GLint i = 0; i < getNCells(); ++i) cells[i]->heading.showLine = show;
     return true;
-}   // showPos(const bool)
+}   // showLine(const bool)
 
 
 
 //
 // bool showHead(show)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to display the head of the heading vector of each cell,
 // returning true if successful, false otherwise.
@@ -513,22 +876,15 @@ bool Environment::showLine(const bool show)
 //
 bool Environment::showHead(const bool show)
 {
-    Cell *currCell;
-    for (GLint i = 0; i < getNCells(); ++i)
-        if (cells.getHead(currCell))
-        {
-            currCell->heading.showHead = show;
-            ++cells;
-        }
-        else return false;
+    for (GLint i = 0; i < getNCells(); ++i) cells[i]->heading.showHead = show;
     return true;
-}   // showHeading(const bool)
+}   // showHead(const bool)
 
 
 
 //
 // bool showPos(show)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to display the position vector of each cell,
 // returning true if successful, false otherwise.
@@ -539,14 +895,7 @@ bool Environment::showHead(const bool show)
 //
 bool Environment::showPos(const bool show)
 {
-    Cell *currCell;
-    for (GLint i = 0; i < getNCells(); ++i)
-        if (cells.getHead(currCell))
-        {
-            currCell->showPos          = show;
-            ++cells;
-        }
-        else return false;
+    for (GLint i = 0; i < getNCells(); ++i) cells[i]->showPos = show;
     return true;
 }   // showPos(const bool)
 
@@ -554,7 +903,7 @@ bool Environment::showPos(const bool show)
 
 //
 // bool showHeading(show)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to display the heading vector of each cell,
 // returning true if successful, false otherwise.
@@ -565,14 +914,7 @@ bool Environment::showPos(const bool show)
 //
 bool Environment::showHeading(const bool show)
 {
-    Cell *currCell;
-    for (GLint i = 0; i < getNCells(); ++i)
-        if (cells.getHead(currCell))
-        {
-            currCell->showHeading      = show;
-            ++cells;
-        }
-        else return false;
+    for (GLint i = 0; i < getNCells(); ++i) cells[i]->showHeading = show;
     return true;
 }   // showHeading(const bool)
 
@@ -621,14 +963,13 @@ bool Environment::initRobots(const Formation f)
 	setColor(BLACK);
 
     return (getNCells() == N_CELLS) &&
-           sendMsg(new Formation(f), f.getSeedID(),
-                   ID_OPERATOR,      CHANGE_FORMATION);
+           sendMsg(f, f.getSeedID(), ID_OPERATOR, CHANGE_FORMATION);
 }
 
 
 //
 // bool initCells(n, f)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Initializes each cell to the parameterized values,
 // returning true if successful, false otherwise.
@@ -647,47 +988,313 @@ bool Environment::initCells(const GLint n, const Formation f)
     if (!initNbrs()) return false;
 
     // organizes the cells into an initial formation (default line)
-    Cell *c  = NULL;
     for (GLint i = 0; i < getNCells(); ++i)
     {
-        if (!cells.getHead(c)) return false;
+        Cell *c = cells[i];
         c->x = f.getRadius() *
                ((GLfloat)i - (GLfloat)(getNCells() - 1) / 2.0f);
         c->y = 0.0f;
         c->setColor(DEFAULT_ROBOT_COLOR);
         c->setHeading(f.getHeading());
-        ++cells;
     }
     return (getNCells() == n) &&
-           sendMsg(new Formation(f), f.getSeedID(),
-                   ID_OPERATOR,      CHANGE_FORMATION);
+           sendMsg(f, f.getSeedID(), ID_OPERATOR, CHANGE_FORMATION);
 }   // initCells(const GLint, const Formation f)
 
 
 
 //
 // bool initNbrs(nNbrs)
-// Last modified: 03Sep2006
+// Last modified: 17Oct2026
 //
-// Initializes the neighborhood of each cell,
-// returning true if successful, false otherwise.
+// Initializes the neighborhood of each cell (a chain of cells by ID,
+// or the parameterized number of cells nearest to each cell) and sizes
+// its packet queues to match, returning true if successful, false otherwise.
 //
 // Returns:     true if successful, false otherwise
 // Parameters:
 //      nNbrs       in      the initial number of neighbors
+//                          (default 0 for a chain)
 //
 bool Environment::initNbrs(const GLint nNbrs)
 {
-    Cell *c = NULL;
+    ArrayList<GLint> nearest;
+    if (nNbrs > 0) syncGrid();
     for (GLint i = 0; i < getNCells(); ++i)
     {
-        if (!cells.getHead(c))                            return false;
+        Cell *c = cells[i];
         c->clearNbrs();
-        if ((i > 0)               && (!c->addNbr(i - 1))) return false;
-        else c->leftNbr  = c->nbrWithID(i - 1);
-        if ((i < getNCells() - 1) && (!c->addNbr(i + 1))) return false;
-        else c->rightNbr = c->nbrWithID(i + 1);
-        ++cells;
+        if (nNbrs > 0)
+        {
+            nearest = getNearestCells(c->getID(), nNbrs);
+            for (GLint j = 0; j < nearest.getSize(); ++j)
+                if (!c->addNbr(nearest[j]))               return false;
+        }
+        else
+        {
+            if ((i > 0)               && (!c->addNbr(i - 1))) return false;
+            if ((i < getNCells() - 1) && (!c->addNbr(i + 1))) return false;
+        }
+
+        c->leftNbrID  = c->isNbr(i - 1) ? i - 1 : ID_NO_NBR;
+        c->rightNbrID = c->isNbr(i + 1) ? i + 1 : ID_NO_NBR;
     }
+
+    // each cell sends its state to every neighbor once per step, so size
+    // its inbox for every cell it neighbors (nearest neighborhoods are not
+    // symmetric) and its outbox for its own neighbors, plus headroom
+    vector<GLint> nIn(getNCells(), 0);
+    for (GLint i = 0; i < getNCells(); ++i)
+        for (GLint j = 0; j < cells[i]->getNNbrs(); ++j)
+        {
+            const GLint k = getCellIndex(cells[i]->getNbr(j)->ID);
+            if (k >= 0) ++nIn[k];
+        }
+    for (GLint i = 0; i < getNCells(); ++i)
+        if (!cells[i]->setQueueSizes(nIn[i] + PACKET_QUEUE_HEADROOM,
+                                     cells[i]->getNNbrs() + PACKET_QUEUE_HEADROOM))
+            return false;
     return true;
 }   // initNbrs(const GLint)
+
+
+
+// <protected utility functions>
+
+//
+// bool applyPoseFeed()
+// Last modified: 17Oct2026
+//
+// Moves the cells to the newest camera poses (if any arrived since the
+// last step), matching the closest remaining pair of cell and pose
+// each time until no pair is within the match radius, returning true
+// if any cell was moved, false otherwise.  Cells the camera did not
+// see keep their dead-reckoned poses.
+//
+// Returns:     true if any cell was moved, false otherwise
+// Parameters:  <none>
+//
+bool Environment::applyPoseFeed()
+{
+    if (poseFeed == NULL) return false;
+    const PoseFrame *frame = poseFeed->read();
+    if ((frame == NULL) || (frame->n <= 0) || (getNCells() == 0)) return false;
+
+    // convert the camera poses into environment coordinates
+    const GLint nPoses = frame->n;
+    GLfloat     px[MAX_POSE_ESTIMATES], py[MAX_POSE_ESTIMATES];
+    bool        poseUsed[MAX_POSE_ESTIMATES];
+    for (GLint j = 0; j < nPoses; ++j)
+    {
+        i2f(&px[j], &py[j],
+            (int)frame->estimates[j].x, (int)frame->estimates[j].y,
+            windowSize[0], windowSize[1]);
+        poseUsed[j] = false;
+    }
+
+    // match the closest cell and pose until none are close enough
+    vector<bool> cellUsed(getNCells(), false);
+    bool         moved   = false;
+    const GLfloat maxSqr = MAX_POSE_CORRECTION * MAX_POSE_CORRECTION;
+    while (true)
+    {
+        GLint   bestCell = -1, bestPose = -1;
+        GLfloat bestSqr  = maxSqr;
+        for (GLint i = 0; i < getNCells(); ++i)
+        {
+            if (cellUsed[i]) continue;
+            for (GLint j = 0; j < nPoses; ++j)
+            {
+                if (poseUsed[j]) continue;
+                GLfloat dx = px[j] - cells[i]->x, dy = py[j] - cells[i]->y;
+                if (dx * dx + dy * dy < bestSqr)
+                {
+                    bestSqr  = dx * dx + dy * dy;
+                    bestCell = i;
+                    bestPose = j;
+                }
+            }
+        }
+        if (bestCell < 0) break;
+        cells[bestCell]->x = px[bestPose];
+        cells[bestCell]->y = py[bestPose];
+        cells[bestCell]->setHeading(frame->estimates[bestPose].heading);
+        cellUsed[bestCell] = poseUsed[bestPose] = true;
+        moved = true;
+    }
+    if (moved) syncGrid();
+    return moved;
+}   // applyPoseFeed()
+
+
+
+//
+// bool publishMotion()
+// Last modified: 17Oct2026
+//
+// Publishes the pose of each cell in camera pixels (as in addCell) along
+// with the velocities it was last driven at, per second (the inverse of
+// Robot::updateLinearSpeed), to the motion feed (if any), returning true
+// if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:  <none>
+//
+bool Environment::publishMotion()
+{
+    if (motionFeed == NULL) return false;
+    PoseFrame *frame = motionFeed->getWriteFrame();
+    frame->number    = motionFeed->getNPublished();
+    frame->n         = (getNCells() < MAX_POSE_ESTIMATES) ? getNCells()
+                                                         : MAX_POSE_ESTIMATES;
+
+    // a distance of one unit spans half of the window height
+    const GLfloat pixelsPerUnit = 0.5f * windowSize[1];
+    for (GLint i = 0; i < frame->n; ++i)
+    {
+        PoseEstimate &e = frame->estimates[i];
+        int           xi, yi;
+        f2i(poses.x[i], poses.y[i], &xi, &yi, windowSize[0], windowSize[1]);
+        e.x        = (GLfloat)xi;
+        e.y        = (GLfloat)yi;
+        e.heading  = poses.heading[i];
+        e.transVel = (GLfloat)(poses.transVel[i] * pixelsPerUnit / STI_SEC);
+        e.rotVel   = (GLfloat)(poses.rotVel[i] / STI_SEC);
+    }
+    motionFeed->publish();
+    return true;
+}   // publishMotion()
+
+
+
+//
+// GLint getCellIndex(id) const
+// Last modified: 17Oct2026
+//
+// Returns the index (in the cell list) of the cell
+// with the parameterized ID, -1 if there is none.
+//
+// Returns:     the index of the cell with the parameterized ID
+// Parameters:
+//      id      in      the ID of the cell
+//
+GLint Environment::getCellIndex(GLint id) const
+{
+    Cell *head = NULL;
+    if ((id < 0) || (id >= getNCells()) || (!cells.getHead(head))) return -1;
+    id -= head->getID();
+    return (id < 0) ? getNCells() + id : id;
+}   // getCellIndex(GLint) const
+
+
+
+//
+// void loadPoses()
+// Last modified: 17Oct2026
+//
+// Copies the pose of each cell into the pose store,
+// picking up any cell moved or added since the last step.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void Environment::loadPoses()
+{
+    poses.setSize(getNCells());
+    for (GLint i = 0; i < getNCells(); ++i)
+        poses.setPose(i, cells[i]->x, cells[i]->y, cells[i]->getHeading());
+}   // loadPoses()
+
+
+
+//
+// void movePoses()
+// Last modified: 17Oct2026
+//
+// Moves every cell by its active behavior (or by how the wheels of its
+// robot actually turned, if reported since the last step), integrating
+// all of the poses in the pose store at once before handing each cell its
+// new pose (and bringing the spatial grid up to date).
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void Environment::movePoses()
+{
+    for (GLint i = 0; i < getNCells(); ++i)
+    {
+        Cell   *c  = cells[i];
+        GLfloat tv = 0.0f, rv = 0.0f;
+        if (c->behavior.isActive())
+        {
+            tv = c->getTransVel();
+            rv = c->getAngVel();
+            readOdometry(i, tv, rv);
+        }
+        poses.setVelocity(i, tv, rv);
+    }
+    poses.integrate();
+    for (GLint i = 0; i < getNCells(); ++i)
+        cells[i]->moveTo(poses.x[i], poses.y[i], poses.heading[i]);
+    syncGrid();
+}   // movePoses()
+
+
+
+//
+// bool readOdometry(i, tv, rv)
+// Last modified: 17Oct2026
+//
+// Attempts to replace the parameterized velocities of the cell at the
+// parameterized position with the wheel speeds its robot last reported
+// (the inverse of Robot::updateLinearSpeed and Robot::updateAngularSpeed),
+// returning true if it has reported since the last step, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      i       in      the position of the cell
+//      tv      out     the translation per step
+//      rv      out     the rotation (in degrees) per step
+//
+bool Environment::readOdometry(const GLint i, GLfloat &tv, GLfloat &rv)
+{
+    WheelOdometry o;
+    if ((odometryFeed == NULL) || (!odometryFeed->read(cells[i]->getID(), o)))
+        return false;
+
+    // a distance of one unit spans half of the window height
+    const GLfloat pixelsPerUnit = 0.5f * windowSize[1];
+    GLfloat       linearSps     = 0.5f * (o.rightSpeed + o.leftSpeed);
+    GLfloat       angularSps    = 0.5f * (o.rightSpeed - o.leftSpeed) /
+                                  ANGULAR_SPEED_GAIN;
+    tv = (GLfloat)(SPS_TO_MPS(linearSps) * gCameraScalePPM * STI_SEC /
+                   pixelsPerUnit);
+    rv = (GLfloat)(SPS_TO_DPS(angularSps) * STI_SEC);
+    return true;
+}   // readOdometry(const GLint, GLfloat &, GLfloat &)
+
+
+
+//
+// void syncGrid()
+// Last modified: 17Oct2026
+//
+// Brings the spatial grid up to date with the position of each cell,
+// only rehashing the cells that have changed grid cells
+// (or rebuilding it if cells have been added or removed).
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void Environment::syncGrid()
+{
+    if (grid.getSize() != getNCells())
+    {
+        grid.clear();
+        for (GLint i = 0; i < getNCells(); ++i)
+            grid.insert(cells[i]->x, cells[i]->y);
+    }
+    else
+        for (GLint i = 0; i < getNCells(); ++i)
+            grid.update(i, cells[i]->x, cells[i]->y);
+}   // syncGrid()
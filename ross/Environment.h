@@ -11,10 +11,20 @@
 #ifndef ENVIRONMENT_H
 #define ENVIRONMENT_H
 #include "Cell.h"
+#include "CommandScheduler.h"
+#include "OdometryFeed.h"
+#include "PoseFeed.h"
+#include "PoseStore.h"
+#include "SpatialGrid.h"
+#include "SwarmRenderer.h"
+#include "WorkerPool.h"
 using namespace std;
 
 // global constants
-static const Color DEFAULT_ENV_COLOR = BLACK;
+static const Color   DEFAULT_ENV_COLOR       = BLACK;
+static const GLint   MAX_PLACEMENT_TRIES     = 10;
+static const GLfloat FACTOR_PLACEMENT_GROWTH = 1.5f;
+static const GLfloat MAX_POSE_CORRECTION     = 0.2f;  // pose match radius
 
 class Environment
 {
@@ -24,7 +34,8 @@ class Environment
         GLfloat color[3];
 
         // <constructors>
-		Environment() {};
+		Environment() : poseFeed(NULL), motionFeed(NULL), scheduler(NULL),
+                        odometryFeed(NULL), nDroppedPackets(0) {};
         //Environment(const GLint     n          = 0,
         //            const Formation f          = Formation(),
         //            const Color     colorIndex = DEFAULT_ENV_COLOR);
@@ -45,11 +56,23 @@ class Environment
 		bool addCell(int xi, int yi, float heading, Cell *c = NULL);
         bool removeCell();
         bool removeCell(Cell* &c);
+        bool setNThreads(const GLint n = 0);
+        bool setPoseFeed(PoseFeed *feed = NULL);
+        bool setMotionFeed(PoseFeed *feed = NULL);
+        bool setCommandScheduler(CommandScheduler *s = NULL);
+        bool setOdometryFeed(OdometryFeed *feed = NULL);
 
         // <public accessor functions>
-        Cell*              getCell(GLint pos) const;
-        LinkedList<Cell *> getCells();
-        GLint              getNCells() const;
+        Cell*             getCell(GLint pos) const;
+        ArrayList<Cell *> getCells();
+        GLint             getNCells() const;
+        GLint             getNThreads() const;
+        const PoseStore&  getPoses()    const;
+        PoseFeed*         getPoseFeed() const;
+        PoseFeed*         getMotionFeed() const;
+        CommandScheduler* getCommandScheduler() const;
+        OdometryFeed*     getOdometryFeed() const;
+        long              getNDroppedPackets() const;
 
         // <virtual public utility functions>
         virtual void draw();
@@ -57,17 +80,27 @@ class Environment
         virtual void clear();
 
         // <public utility functions>
-        Vector  getRelationship(const GLint toID, const GLint fromID);
+        void    draw(const PoseStore &p);
+        Vec2f   getRelationship(const GLint toID, const GLint fromID);
+        void    getRelationshipsTo(const GLint fromID,
+                                   const GLint toIDs[],
+                                   Vec2f       rels[],
+                                   const GLint n);
         GLfloat getDistanceTo(const GLint id)   const;
         GLfloat getAngleTo(const GLint id)      const;
-        bool    sendMsg(const Message &msg    = NULL,
-                        const GLint    toID   = ID_BROADCAST,
-                        const GLint    fromID = ID_OPERATOR,
-                        const GLint    type   = HEARTBEAT);
+        bool    sendMsg(const Formation &f,
+                        const GLint      toID   = ID_BROADCAST,
+                        const GLint      fromID = ID_OPERATOR,
+                        const GLint      type   = CHANGE_FORMATION);
         bool    sendPacket(const Packet &p = Packet());
         bool    forwardPacket(const Packet &p);
         bool    forwardPackets();
 
+        // <public spatial query functions>
+        ArrayList<GLint> getNearestCells(const GLint id, const GLint k);
+        ArrayList<GLint> getCellsWithin(const GLint id, const GLfloat r);
+        bool             isColliding(const GLint id);
+
         // <public utility cell functions>
         bool    showLine(const bool show);
         bool    showHead(const bool show);
@@ -81,8 +114,17 @@ class Environment
     protected:
 
         // <protected data members>
-        LinkedList<Cell *> cells;
-        Queue<Packet>      msgQueue;
+        ArrayList<Cell *> cells;
+        PoseStore         poses;
+        SpatialGrid       grid;
+        SwarmRenderer     renderer;
+        MpscQueue<Packet> msgQueue;
+        WorkerPool        workers;
+        PoseFeed         *poseFeed;   // the camera poses (if any)
+        PoseFeed         *motionFeed; // the expected poses (if any)
+        CommandScheduler *scheduler;  // the drive commands (if any)
+        OdometryFeed     *odometryFeed; // the wheel odometry (if any)
+        atomic<long>      nDroppedPackets; // packets an inbox had no room for
 
         // <virtual protected utility functions>
         virtual bool init(const GLint     n          = 0,
@@ -91,5 +133,14 @@ class Environment
         virtual bool initCells(const GLint     n = 0,
                                const Formation f = Formation());
         virtual bool initNbrs(const GLint nNbrs = 0);
+
+        // <protected utility functions>
+        GLint getCellIndex(GLint id) const;
+        bool  applyPoseFeed();
+        bool  publishMotion();
+        void  loadPoses();
+        void  movePoses();
+        bool  readOdometry(const GLint i, GLfloat &tv, GLfloat &rv);
+        void  syncGrid();
 };  // Environment
 #endif
@@ -2,14 +2,152 @@
 // Filename:        "Formation.cpp"
 //
 // Programmer:      Ross Mead
-// Last modified:   04Sep2006
+// Last modified:   17Oct2026
 //
 // Description:     This class implements a formation.
 //
 
 // preprocessor directives
+#include <cfloat>
+#include <cstring>
 #include "Formation.h"
 
+// Describes a formation function whose intersection
+// with a circle can be calculated in closed form.
+struct FunctionDescription
+{
+    Function      f;
+    FunctionShape shape;
+    GLfloat       slope;
+};  // FunctionDescription
+
+// Describes a relationship already calculated for a formation
+// (keyed by everything the calculation depends upon).
+struct RelationshipMemo
+{
+    GLint    formationID;
+    Function f;
+    GLfloat  r, theta;
+    Vec2f    c, rel;
+};  // RelationshipMemo
+
+// global variables (one memo per thread, so the workers stepping the
+// cells in parallel never wait on each other for it; thread_local needs
+// the VS2015 toolset the solution targets, see README)
+static thread_local RelationshipMemo relMemo[RELATIONSHIP_MEMO_SIZE];
+
+
+
+//
+// ArrayList<FunctionDescription>& functionDescriptions()
+// Last modified: 17Oct2026
+//
+// Returns the list of formation functions that have closed-form
+// intersections (built on first use, so it can be filled in
+// while other globals are still being initialized).
+//
+// Returns:     the list of described formation functions
+// Parameters:  <none>
+//
+static ArrayList<FunctionDescription>& functionDescriptions()
+{
+    static ArrayList<FunctionDescription> descriptions;
+    return descriptions;
+}   // functionDescriptions()
+
+
+
+//
+// GLint memoSlot(m)
+// Last modified: 17Oct2026
+//
+// Returns the slot in the relationship memo of the parameterized key.
+//
+// Returns:     the slot of the key
+// Parameters:
+//      m       in      the key (the relationship itself is ignored)
+//
+static GLint memoSlot(const RelationshipMemo &m)
+{
+    GLfloat      values[5] = {m.r, m.theta, m.c.x, m.c.y, 0.0f};
+    unsigned int bits[5]   = {0, 0, 0, 0, 0}, hash = 2166136261u;
+    memcpy(bits, values, sizeof(values));
+    bits[4] = (unsigned int)m.formationID ^
+              (unsigned int)reinterpret_cast<size_t>(m.f);
+    for (GLint i = 0; i < 5; ++i) hash = (hash ^ bits[i]) * 16777619u;
+    return (GLint)(hash % RELATIONSHIP_MEMO_SIZE);
+}   // memoSlot(const RelationshipMemo &)
+
+
+
+//
+// bool sameKey(m1, m2)
+// Last modified: 17Oct2026
+//
+// Returns true if the parameterized memo entries have the same key,
+// false otherwise.
+//
+// Returns:     true if the keys are the same, false otherwise
+// Parameters:
+//      m1      in      the first memo entry
+//      m2      in      the second memo entry
+//
+static bool sameKey(const RelationshipMemo &m1, const RelationshipMemo &m2)
+{
+    return (m1.f           == m2.f)           &&
+           (m1.formationID == m2.formationID) &&
+           (m1.r           == m2.r)           &&
+           (m1.theta       == m2.theta)       &&
+           (m1.c           == m2.c);
+}   // sameKey(const RelationshipMemo &, const RelationshipMemo &)
+
+
+
+//
+// void nearestLineRoot(slope, r, c, xMin, xMax, target, best, found)
+// Last modified: 17Oct2026
+//
+// Solves for the intersections of the line y = slope * x (restricted
+// to [xMin, xMax]) and a circle centered at the parameterized vector
+// position c with the appropriate radius, keeping the one closest to
+// the parameterized target x-coordinate.
+//
+// Returns:     <none>
+// Parameters:
+//      slope   in      the slope of the line
+//      r       in      the radius of the intersecting circle
+//      c       in      the position to be centered at
+//      xMin    in      the least x-coordinate of the line
+//      xMax    in      the greatest x-coordinate of the line
+//      target  in      the x-coordinate the intersection should be near
+//      best    in/out  the closest x-coordinate found so far
+//      found   in/out  whether any intersection has been found so far
+//
+static void nearestLineRoot(const GLdouble slope,  const GLdouble r,
+                            const Vec2f    c,      const GLdouble xMin,
+                            const GLdouble xMax,   const GLdouble target,
+                            GLdouble      &best,   bool          &found)
+{
+
+    // (x - c.x)^2 + (slope * x - c.y)^2 = r^2 as a * x^2 + b * x + k = 0
+    GLdouble a    = 1.0 + slope * slope,
+             b    = -2.0 * (c.x + slope * c.y),
+             k    = (GLdouble)c.x * c.x + (GLdouble)c.y * c.y - r * r,
+             disc = b * b - 4.0 * a * k;
+    if (disc < 0.0) return;
+
+    // use the numerically stable form of the quadratic formula
+    GLdouble q        = -0.5 * (b + ((b < 0.0) ? -sqrt(disc) : sqrt(disc)));
+    GLdouble roots[2] = {q / a, (q != 0.0) ? k / q : q / a};
+    for (GLint i = 0; i < 2; ++i)
+        if ((roots[i] >= xMin) && (roots[i] <= xMax) &&
+            ((!found) || (abs(roots[i] - target) < abs(best - target))))
+        {
+            best  = roots[i];
+            found = true;
+        }
+}   // nearestLineRoot(const GLdouble..<2>, const Vec2f, ...)
+
 
 
 // <constructors>
@@ -32,7 +170,7 @@
 //
 Formation::Formation(const Function f,
                      const GLfloat  r,
-                     const Vector   sGrad,
+                     const Vec2f    sGrad,
                      const GLint    sID,
                      const GLint    fID,
                      const GLfloat  theta)
@@ -43,7 +181,7 @@ Formation::Formation(const Function f,
     setSeedID(sID);
     setFormationID(fID);
     setHeading(theta);
-}   // Formation(const..{Function, GLfloat, Vector, GLint, GLint, GLfloat})
+}   // Formation(const..{Function, GLfloat, Vec2f, GLint, GLint, GLfloat})
 
 
 
@@ -63,12 +201,12 @@ Formation::Formation(const Function f,
 //      fID         in      the initial ID of the formation
 //      theta       in      the initial heading of the formation
 //
-Formation::Formation(LinkedList<Function> f,
-                     const GLfloat        r,
-                     const Vector         sGrad,
-                     const GLint          sID,
-                     const GLint          fID,
-                     const GLfloat        theta)
+Formation::Formation(ArrayList<Function> f,
+                     const GLfloat       r,
+                     const Vec2f         sGrad,
+                     const GLint         sID,
+                     const GLint         fID,
+                     const GLfloat       theta)
 {
     setFunctions(f);
     setRadius(r);
@@ -76,7 +214,7 @@ Formation::Formation(LinkedList<Function> f,
     setSeedID(sID);
     setFormationID(fID);
     setHeading(theta);
-}   // Formation(const..{LL<Function>, GLfloat, Vector, GLint..<2>, GLfloat})
+}   // Formation(const..{LL<Function>, GLfloat, Vec2f, GLint..<2>, GLfloat})
 
 
 
@@ -102,7 +240,7 @@ Formation::Formation(const Formation &f)
 
 //
 // bool setFunction(f)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to set the function to the parameterized function,
 // returning true if successful, false otherwise.
@@ -114,6 +252,7 @@ Formation::Formation(const Formation &f)
 bool Formation::setFunction(const Function f)
 {
     clear();
+    table.reset();
     return addFunction(f);
 }   // setFunction(const Function)
 
@@ -121,7 +260,7 @@ bool Formation::setFunction(const Function f)
 
 //
 // bool setFunctions(f)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to set the set of functions
 // to the parameterized set of functions,
@@ -131,17 +270,18 @@ bool Formation::setFunction(const Function f)
 // Parameters:
 //      f       in/out  the set of functions to be set to
 //
-bool Formation::setFunctions(const LinkedList<Function> &f)
+bool Formation::setFunctions(const ArrayList<Function> &f)
 {
     clear();
+    table.reset();
     return addFunctions(f);
-}   // setFunctions(const LinkedList<Function> &)
+}   // setFunctions(const ArrayList<Function> &)
 
 
 
 //
 // bool addFunction(f)
-// Last modified: 02Sep2006
+// Last modified: 17Oct2026
 //
 // Attempts to add the parameterized function to the formation,
 // returning true if successful, false otherwise.
@@ -152,7 +292,9 @@ bool Formation::setFunctions(const LinkedList<Function> &f)
 //
 bool Formation::addFunction(const Function f)
 {
-    return (f != NULL) && insertTail(f);
+    if (f == NULL) return false;
+    table.reset();
+    return insertTail(f);
 }   // addFunction(const Function)
 
 
@@ -168,18 +310,18 @@ bool Formation::addFunction(const Function f)
 // Parameters:
 //      f       in/out  the set of functions being added
 //
-bool Formation::addFunctions(const LinkedList<Function> &f)
+bool Formation::addFunctions(const ArrayList<Function> &f)
 {
     for (GLint i = 0; i < f.getSize(); ++i)
         if (!addFunction(f[i])) return false;
     return true;
-}   // addFunctions(const LinkedList<Function> &)
+}   // addFunctions(const ArrayList<Function> &)
 
 
 
 //
 // bool removeFunction(pos)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to remove the function at the
 // parameterized position from the formation,
@@ -191,6 +333,7 @@ bool Formation::addFunctions(const LinkedList<Function> &f)
 //
 bool Formation::removeFunction(const GLint pos)
 {
+    table.reset();
     return remove(pos);
 }   // removeFunction(const GLint)
 
@@ -198,7 +341,7 @@ bool Formation::removeFunction(const GLint pos)
 
 //
 // bool removeFunctions()
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to remove all of the functions from the formation,
 // returning true if successful, false otherwise.
@@ -210,6 +353,7 @@ bool Formation::removeFunction(const GLint pos)
 bool Formation::removeFunctions()
 {
     clear();
+    table.reset();
     return true;
 }   // removeFunctions()
 
@@ -217,7 +361,7 @@ bool Formation::removeFunctions()
 
 //
 // bool setRadius(r)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to set the radius to the parameterized radius,
 // returning true if successful, false otherwise.
@@ -230,6 +374,7 @@ bool Formation::setRadius(const GLfloat r)
 {
     if (r <= 0.0f) return false;
     radius = r;
+    table.reset();
     return true;
 }   // setRadius(const GLfloat)
 
@@ -237,7 +382,7 @@ bool Formation::setRadius(const GLfloat r)
 
 //
 // bool setSeedGradient(sGrad)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to set the seed gradient
 // to the parameterized seed gradient,
@@ -247,17 +392,18 @@ bool Formation::setRadius(const GLfloat r)
 // Parameters:
 //      sGrad   in/out  the seed gradient to be set to
 //
-bool Formation::setSeedGradient(const Vector sGrad)
+bool Formation::setSeedGradient(const Vec2f sGrad)
 {
     seedGradient = sGrad;
+    table.reset();
     return true;
-}   // setSeedGradient(const Vector)
+}   // setSeedGradient(const Vec2f)
 
 
 
 //
 // bool setSeedID(sID)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to set the seed ID to the parameterized seed ID,
 // returning true if successful, false otherwise.
@@ -271,6 +417,7 @@ bool Formation::setSeedID(const GLint sID)
     if ((sID < 0) && (sID != ID_OPERATOR) && (sID != ID_BROADCAST))
         return false;
     seedID = sID;
+    table.reset();
     return true;
 }   // setSeedID(const GLint)
 
@@ -297,7 +444,7 @@ bool Formation::setFormationID(const GLint fID)
 
 //
 // bool setHeading(theta)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Attempts to set the heading to the parameterized heading,
 // returning true if successful, false otherwise.
@@ -309,6 +456,7 @@ bool Formation::setFormationID(const GLint fID)
 bool Formation::setHeading(const GLfloat theta)
 {
     heading = scaleDegrees(theta);
+    table.reset();
     return true;
 }   // setHeading(const GLint)
 
@@ -318,7 +466,7 @@ bool Formation::setHeading(const GLfloat theta)
 
 //
 // Function getFunction() const
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Returns the function at the parameterized position in this formation.
 //
@@ -329,13 +477,13 @@ bool Formation::setHeading(const GLfloat theta)
 Function Formation::getFunction(const int pos) const
 {
     if ((pos < 0) || (pos > this->getSize())) return NULL;
-    return LinkedList<Function>(*this)[pos];
+    return (*this)[pos];
 }   // getFunction(const int) const
 
 
 
 //
-// LinkedList<Function> getFunctions() const
+// ArrayList<Function> getFunctions() const
 // Last modified: 28Aug2006
 //
 // Returns the set of functions of this formation.
@@ -343,7 +491,7 @@ Function Formation::getFunction(const int pos) const
 // Returns:     the set of functions of this formation
 // Parameters:  <none>
 //
-LinkedList<Function> Formation::getFunctions() const
+ArrayList<Function> Formation::getFunctions() const
 {
     return *this;
 }   // getFunctions() const
@@ -367,7 +515,7 @@ GLfloat Formation::getRadius() const
 
 
 //
-// Vector getSeedGradient() const
+// Vec2f getSeedGradient() const
 // Last modified: 28Aug2006
 //
 // Returns the seed gradient of this formation.
@@ -375,7 +523,7 @@ GLfloat Formation::getRadius() const
 // Returns:     the seed gradient of this formation
 // Parameters:  <none>
 //
-Vector Formation::getSeedGradient() const
+Vec2f Formation::getSeedGradient() const
 {
     return seedGradient;
 }   // getSeedGradient() const
@@ -433,8 +581,8 @@ GLfloat Formation::getHeading() const
 // <public utility functions>
 
 //
-// LinkedList<Vector> getRelationships(c)
-// Last modified: 28Aug2006
+// ArrayList<Vec2f> getRelationships(c)
+// Last modified: 17Oct2026
 //
 // Calculates the intersections of the set of functions of this formation
 // and a circle centered at the parameterized vector position c with
@@ -444,32 +592,29 @@ GLfloat Formation::getHeading() const
 // Parameters:
 //      c       in      the position to be centered at
 //
-LinkedList<Vector> Formation::getRelationships(const Vector c)
+ArrayList<Vec2f> Formation::getRelationships(const Vec2f c)
 {
-    if (isEmpty()) return LinkedList<Vector>();
-    LinkedList<Vector> rels;
-    Function           curr = NULL;
+    if (isEmpty()) return ArrayList<Vec2f>();
+    ArrayList<Vec2f> rels;
+    rels.reserve(2 * getSize());
     for (GLint i = 0; i < getSize(); ++i)
     {
-        if (!getHead(curr)) break;
-        rels.insertTail(getRelationship(curr, -radius, c, heading));
-        rels.insertTail(getRelationship(curr,  radius, c, heading));
-        ++(*this);
+        rels.insertTail(getRelationship((*this)[i], -radius, c, heading));
+        rels.insertTail(getRelationship((*this)[i],  radius, c, heading));
     }
     return rels;
-}   // getRelationships(const Vector)
+}   // getRelationships(const Vec2f)
 
 //
-// Vector getRelationship(f, r, c, theta)
-// Last modified: 28Aug2006
-//
-// Uses the secant method to calculate the intersection of the function
-// and a circle centered at the parameterized vector position c with
-// the appropriate radius, returning a vector from c to this intersection.
-//
-// The secant method is defined by the following recurrence relation:
+// Vec2f getRelationship(f, r, c, theta)
+// Last modified: 17Oct2026
 //
-//      x_(n + 1) = x_n - f(x_n) * (x_n - x_(n - 1)) / (f(x_n) - f(x_(n - 1))).
+// Calculates the intersection of the function and a circle centered at
+// the parameterized vector position c with the appropriate radius,
+// returning a vector from c to this intersection.  The intersection is
+// solved in closed form for described functions and searched for
+// otherwise, and recent results are remembered (by each thread) since
+// every cell of a formation asks for the same few relationships.
 //
 // Returns:     vector from the parameterized vector position c
 //              to the intersection of the function and appropriate circle
@@ -479,33 +624,30 @@ LinkedList<Vector> Formation::getRelationships(const Vector c)
 //      c           in      the position to be centered at
 //      theta       in      the rotation of the relationship (default 0)
 //
-Vector Formation::getRelationship(const Function f,
-                                  const GLfloat  r,
-                                  const Vector   c,
-                                  const GLfloat  theta)
+Vec2f Formation::getRelationship(const Function f,
+                                 const GLfloat  r,
+                                 const Vec2f    c,
+                                 const GLfloat  theta)
 {
-    if (f == NULL) return Vector();
-    GLfloat xn        = c.x + r + X_ROOT_THRESHOLD,
-            xn_1      = c.x + r - X_ROOT_THRESHOLD,
-            intersect = 0.0f, error = 0.0f;
-    for (int i = 0; i < X_N_ITERATIONS; ++i)
-    {
-        intersect     = fIntersect(f, r, c, xn);
-        error         = intersect * (xn - xn_1) /
-                       (intersect - fIntersect(f, r, c, xn_1));
-        if (abs(error) <= X_ROOT_THRESHOLD) break;
-        xn_1          = xn;
-        xn           -= error;
-    }
-    Vector rel        = Vector(xn, f(xn)) - c;
-    rel.rotateRelative(-theta);
-    return rel;
-}   // getRelationship(const..{Function, GLfloat, Vector, GLfloat})
+    if (f == NULL) return Vec2f();
+    RelationshipMemo key;
+    key.formationID = formationID;
+    key.f           = f;
+    key.r           = r;
+    key.theta       = theta;
+    key.c           = c;
+    GLint slot      = memoSlot(key);
+    if (sameKey(relMemo[slot], key)) return relMemo[slot].rel;
+    GLfloat x     = intersect(f, r, c);
+    key.rel       = (Vec2f(x, f(x)) - c).rotated(-theta);
+    relMemo[slot] = key;
+    return key.rel;
+}   // getRelationship(const..{Function, GLfloat, Vec2f, GLfloat})
 
 
 
 //
-// Vector getRelationship(pos, r, c, theta)
+// Vec2f getRelationship(pos, r, c, theta)
 // Last modified: 28Aug2006
 //
 // Calculates the intersection of the function at the parameterized position
@@ -520,13 +662,147 @@ Vector Formation::getRelationship(const Function f,
 //      c       in      the position to be centered at
 //      theta   in      the rotation of the relationship (default 0)
 //
-Vector Formation::getRelationship(const GLint   pos,
-                                  const GLfloat r,
-                                  const Vector  c,
-                                  const GLfloat theta)
+Vec2f Formation::getRelationship(const GLint   pos,
+                                 const GLfloat r,
+                                 const Vec2f   c,
+                                 const GLfloat theta)
 {
     return getRelationship(getFunction(pos), r, c, theta);
-}   // getRelationship(const GLint, const GLfloat, const Vector, const GLfloat)
+}   // getRelationship(const GLint, const GLfloat, const Vec2f, const GLfloat)
+
+
+
+//
+// bool compile(nCells)
+// Last modified: 17Oct2026
+//
+// Attempts to precompute the gradient and desired neighbor relationships
+// of every cell (with IDs 0 to nCells - 1) in this formation by following
+// the chain of neighbors outward from the seed once, so that each cell
+// can look up its entry instead of deriving it from its neighbor,
+// returning true if successful, false otherwise.  The table is shared
+// by every copy of this formation until the formation is changed.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      nCells  in      the number of cells in the formation
+//
+bool Formation::compile(const GLint nCells)
+{
+    table.reset();
+    if ((isEmpty()) || (seedID < 0) || (seedID >= nCells)) return false;
+    shared_ptr<FormationTable> t(new FormationTable(nCells));
+    Function f = (*this)[0];
+    Vec2f    grad, leftRel, rightRel, prevLeftRel, prevRightRel;
+
+    // from the seed to the rightmost cell
+    grad = seedGradient;
+    for (GLint id = seedID; id < nCells; ++id)
+    {
+        if (id > seedID) grad = grad + prevRightRel.rotated(heading);
+        leftRel  = getRelationship(f, -radius, grad, heading);
+        rightRel = getRelationship(f,  radius, grad, heading);
+        if (!t->setEntry(id, grad, leftRel, rightRel)) return false;
+        if (id == seedID) prevLeftRel = leftRel;
+        prevRightRel = rightRel;
+    }
+
+    // from the seed to the leftmost cell
+    grad = seedGradient;
+    for (GLint id = seedID - 1; id >= 0; --id)
+    {
+        grad     = grad + prevLeftRel.rotated(heading);
+        leftRel  = getRelationship(f, -radius, grad, heading);
+        rightRel = getRelationship(f,  radius, grad, heading);
+        if (!t->setEntry(id, grad, leftRel, rightRel)) return false;
+        prevLeftRel = leftRel;
+    }
+    table = t;
+    return true;
+}   // compile(const GLint)
+
+
+
+//
+// bool isCompiled() const
+// Last modified: 17Oct2026
+//
+// Returns true if this formation has a precompiled table,
+// false otherwise.
+//
+// Returns:     true if this formation is compiled, false otherwise
+// Parameters:  <none>
+//
+bool Formation::isCompiled() const
+{
+    return table.get() != NULL;
+}   // isCompiled() const
+
+
+
+//
+// bool getTableEntry(id, grad, leftRel, rightRel) const
+// Last modified: 17Oct2026
+//
+// Attempts to look up the precompiled gradient and desired neighbor
+// relationships of the cell with the parameterized ID,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      id          in      the ID of the cell
+//      grad        out     the gradient of the cell
+//      leftRel     out     the desired relationship to the left neighbor
+//      rightRel    out     the desired relationship to the right neighbor
+//
+bool Formation::getTableEntry(const GLint id,
+                              Vec2f      &grad,
+                              Vec2f      &leftRel,
+                              Vec2f      &rightRel) const
+{
+    return (table.get() != NULL) &&
+           table->getEntry(id, grad, leftRel, rightRel);
+}   // getTableEntry(const GLint, Vec2f &, Vec2f &, Vec2f &) const
+
+
+
+// <public static functions>
+
+//
+// bool describeFunction(f, shape, slope)
+// Last modified: 17Oct2026
+//
+// Attempts to describe the parameterized formation function as one
+// whose intersections can be calculated in closed form, returning
+// true if successful, false otherwise.  Functions should be described
+// before any formation using them is stepped.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      f       in      the formation function being described
+//      shape   in      the shape of the function
+//      slope   in      the slope of the function (y = slope * x or
+//                      y = slope * |x|, default 1)
+//
+bool Formation::describeFunction(const Function      f,
+                                 const FunctionShape shape,
+                                 const GLfloat       slope)
+{
+    if (f == NULL) return false;
+    ArrayList<FunctionDescription> &descriptions = functionDescriptions();
+    for (GLint i = 0; i < descriptions.getSize(); ++i)
+        if (descriptions[i].f == f)
+        {
+            descriptions[i].shape = shape;
+            descriptions[i].slope = slope;
+            return true;
+        }
+    FunctionDescription d;
+    d.f     = f;
+    d.shape = shape;
+    d.slope = slope;
+    return descriptions.insertTail(d);
+}   // describeFunction(const Function, const FunctionShape, const GLfloat)
 
 
 
@@ -534,7 +810,7 @@ Vector Formation::getRelationship(const GLint   pos,
 
 //
 // Formation& =(f)
-// Last modified: 28Aug2006
+// Last modified: 17Oct2026
 //
 // Copies the contents of the parameterized formation into this formation.
 //
@@ -550,6 +826,7 @@ Formation& Formation::operator =(const Formation &f)
     setSeedID(f.seedID);
     setFormationID(f.formationID);
     setHeading(f.heading);
+    table = f.table;
     return *this;
 }   // =(const Formation &)
 
@@ -570,7 +847,179 @@ Formation& Formation::operator =(const Formation &f)
 //      f       in/out      the formation being copied
 //
 GLfloat Formation::fIntersect(const Function f, const GLfloat r,
-                              const Vector   c, const GLfloat x)
+                              const Vec2f    c, const GLfloat x)
 {
     return pow(x - c.x, 2.0f) + pow(f(x) - c.y, 2.0f) - pow(r, 2.0f);
-}   // fIntersect(const Function, const GLfloat, const Vector, const GLfloat)
+}   // fIntersect(const Function, const GLfloat, const Vec2f, const GLfloat)
+
+
+
+//
+// GLfloat intersect(f, r, c)
+// Last modified: 17Oct2026
+//
+// Returns the x-coordinate of the intersection of the parameterized
+// function and a circle centered at the parameterized vector position c
+// with the appropriate radius (the intersection nearest x = c.x + r).
+//
+// Returns:     the x-coordinate of the intersection
+// Parameters:
+//      f       in      the intersecting function
+//      r       in      the radius of the intersecting circle
+//      c       in      the position to be centered at
+//
+GLfloat Formation::intersect(const Function f, const GLfloat r, const Vec2f c)
+{
+    GLfloat x = c.x + r;
+    if ((intersectClosedForm(f, r, c, x)) || (intersectBracketed(f, r, c, x)))
+        return x;
+    return intersectSecant(f, r, c);
+}   // intersect(const Function, const GLfloat, const Vec2f)
+
+
+
+//
+// bool intersectClosedForm(f, r, c, x)
+// Last modified: 17Oct2026
+//
+// Attempts to solve for the intersection of the parameterized function
+// and a circle centered at the parameterized vector position c with the
+// appropriate radius in closed form, returning true if successful
+// (the function is described and meets the circle), false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      f       in      the intersecting function
+//      r       in      the radius of the intersecting circle
+//      c       in      the position to be centered at
+//      x       out     the x-coordinate of the intersection
+//
+bool Formation::intersectClosedForm(const Function f,
+                                    const GLfloat  r,
+                                    const Vec2f    c,
+                                    GLfloat       &x)
+{
+    const ArrayList<FunctionDescription> &descriptions =
+        functionDescriptions();
+    for (GLint i = 0; i < descriptions.getSize(); ++i)
+    {
+        if (descriptions[i].f != f) continue;
+        GLdouble slope  = descriptions[i].slope,
+                 target = c.x + r,
+                 best   = target;
+        bool     found  = false;
+        switch (descriptions[i].shape)
+        {
+            case LINEAR_SHAPE:
+                nearestLineRoot(slope, r, c, -DBL_MAX, DBL_MAX,
+                                target, best, found);
+                break;
+            case ABS_LINEAR_SHAPE:
+                nearestLineRoot( slope, r, c, 0.0, DBL_MAX,
+                                target, best, found);
+                nearestLineRoot(-slope, r, c, -DBL_MAX, 0.0,
+                                target, best, found);
+                break;
+            default: break;
+        }
+        if (found) x = (GLfloat)best;
+        return found;
+    }
+    return false;
+}   // intersectClosedForm(const..{Function, GLfloat, Vec2f}, GLfloat &)
+
+
+
+//
+// bool intersectBracketed(f, r, c, x)
+// Last modified: 17Oct2026
+//
+// Attempts to solve for the intersection of the parameterized function
+// and a circle centered at the parameterized vector position c with the
+// appropriate radius by safeguarded Newton's method, returning true if
+// successful, false otherwise (when no sign change can be bracketed).
+// The search starts between c.x (inside the circle whenever c is on
+// the function) and c.x + r, and falls back upon bisection whenever
+// a Newton step would leave the bracket.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      f       in      the intersecting function
+//      r       in      the radius of the intersecting circle
+//      c       in      the position to be centered at
+//      x       out     the x-coordinate of the intersection
+//
+bool Formation::intersectBracketed(const Function f,
+                                   const GLfloat  r,
+                                   const Vec2f    c,
+                                   GLfloat       &x)
+{
+    GLfloat lo  = c.x,
+            hi  = c.x + r,
+            gLo = fIntersect(f, r, c, lo),
+            gHi = fIntersect(f, r, c, hi);
+    for (GLint i = 0; (i < X_N_BRACKET_STEPS) && (!(gLo * gHi <= 0.0f)); ++i)
+        gHi = fIntersect(f, r, c, hi += r);
+    if (!(gLo * gHi <= 0.0f)) return false;
+
+    GLfloat xn = hi, gn = gHi;
+    for (GLint i = 0; (i < X_N_ITERATIONS) && (gn != 0.0f); ++i)
+    {
+        GLfloat h    = X_DERIVATIVE_STEP * ((abs(xn) > 1.0f) ? abs(xn) : 1.0f);
+        GLfloat dgdx = (fIntersect(f, r, c, xn + h) -
+                        fIntersect(f, r, c, xn - h)) / (2.0f * h),
+                next = (dgdx == 0.0f) ? xn : xn - gn / dgdx;
+        if (!((next - lo) * (next - hi) < 0.0f)) next = 0.5f * (lo + hi);
+        bool done = abs(next - xn) <= X_ROOT_THRESHOLD;
+        xn        = next;
+        gn        = fIntersect(f, r, c, xn);
+        if ((gn < 0.0f) == (gLo < 0.0f))
+        {
+            lo  = xn;
+            gLo = gn;
+        }
+        else hi = xn;
+        if (done) break;
+    }
+    x = xn;
+    return true;
+}   // intersectBracketed(const..{Function, GLfloat, Vec2f}, GLfloat &)
+
+
+
+//
+// GLfloat intersectSecant(f, r, c)
+// Last modified: 17Oct2026
+//
+// Uses the secant method to calculate the intersection of the function
+// and a circle centered at the parameterized vector position c with
+// the appropriate radius, returning the x-coordinate of this intersection.
+//
+// The secant method is defined by the following recurrence relation:
+//
+//      x_(n + 1) = x_n - f(x_n) * (x_n - x_(n - 1)) / (f(x_n) - f(x_(n - 1))).
+//
+// Returns:     the x-coordinate of the intersection
+// Parameters:
+//      f       in      the intersecting function
+//      r       in      the radius of the intersecting circle
+//      c       in      the position to be centered at
+//
+GLfloat Formation::intersectSecant(const Function f,
+                                   const GLfloat  r,
+                                   const Vec2f    c)
+{
+    GLfloat xn        = c.x + r + X_ROOT_THRESHOLD,
+            xn_1      = c.x + r - X_ROOT_THRESHOLD,
+            intersect = 0.0f, error = 0.0f;
+    for (int i = 0; i < X_N_ITERATIONS; ++i)
+    {
+        intersect     = fIntersect(f, r, c, xn);
+        error         = intersect * (xn - xn_1) /
+                       (intersect - fIntersect(f, r, c, xn_1));
+        if (abs(error) <= X_ROOT_THRESHOLD) break;
+        xn_1          = xn;
+        xn           -= error;
+    }
+    return xn;
+}   // intersectSecant(const Function, const GLfloat, const Vec2f)
@@ -10,7 +10,9 @@
 // preprocessor directives
 #ifndef FORMATION_H
 #define FORMATION_H
-#include "LinkedList.h"
+#include <memory>
+#include "ArrayList.h"
+#include "FormationTable.h"
 #include "Relationship.h"
 using namespace std;
 
@@ -21,8 +23,16 @@ static const Function DEFAULT_FORMATION_FUNCTION = NULL;
 static const GLfloat  DEFAULT_FORMATION_RADIUS   = 1.0f;
 static const GLdouble X_ROOT_THRESHOLD           = 5E-7;
 static const GLint    X_N_ITERATIONS             = 100;
+static const GLint    X_N_BRACKET_STEPS          = 8;
+static const GLfloat  X_DERIVATIVE_STEP          = 1E-3f;
+static const GLint    RELATIONSHIP_MEMO_SIZE     = 256;
 
-class Formation: protected LinkedList<Function>
+// Describes the shape of a formation function whose intersection
+// with a circle can be calculated in closed form (y = slope * x,
+// y = slope * |x|), or an arbitrary function that must be searched.
+enum FunctionShape {ARBITRARY_SHAPE, LINEAR_SHAPE, ABS_LINEAR_SHAPE};
+
+class Formation: protected ArrayList<Function>
 {
 
     public:
@@ -30,50 +40,62 @@ class Formation: protected LinkedList<Function>
         // <constructors>
         Formation(Function      f     = DEFAULT_FORMATION_FUNCTION,
                   const GLfloat r     = DEFAULT_FORMATION_RADIUS,
-                  const Vector  sGrad = Vector(),
+                  const Vec2f   sGrad = Vec2f(),
                   const GLint   sID   = ID_BROADCAST,
                   const GLint   fID   = -1,
                   const GLfloat theta = 0.0f);
-        Formation(LinkedList<Function> f,
-                  const GLfloat        r     = DEFAULT_FORMATION_RADIUS,
-                  const Vector         sGrad = Vector(),
-                  const GLint          sID   = ID_BROADCAST,
-                  const GLint          fID   = -1,
-                  const GLfloat        theta = 0.0f);
+        Formation(ArrayList<Function> f,
+                  const GLfloat       r     = DEFAULT_FORMATION_RADIUS,
+                  const Vec2f         sGrad = Vec2f(),
+                  const GLint         sID   = ID_BROADCAST,
+                  const GLint         fID   = -1,
+                  const GLfloat       theta = 0.0f);
         Formation(const Formation &f);
 
         // <public mutator functions>
         bool setFunction(const Function f = DEFAULT_FORMATION_FUNCTION);
-        bool setFunctions(const LinkedList<Function> &f);
+        bool setFunctions(const ArrayList<Function> &f);
         bool addFunction(const Function f = DEFAULT_FORMATION_FUNCTION);
-        bool addFunctions(const LinkedList<Function> &f);
+        bool addFunctions(const ArrayList<Function> &f);
         bool removeFunction(const GLint pos = 0);
         bool removeFunctions();
         bool setRadius(const GLfloat r = DEFAULT_FORMATION_RADIUS);
-        bool setSeedGradient(const Vector sGrad = Vector());
+        bool setSeedGradient(const Vec2f sGrad = Vec2f());
         bool setSeedID(const GLint sID = ID_BROADCAST);
         bool setFormationID(const GLint fID = -1);
         bool setHeading(const GLfloat theta = 0.0f);
 
         // <public accessor functions>
-        Function             getFunction(const GLint pos = 0) const;
-        LinkedList<Function> getFunctions()                   const;
-        GLfloat              getRadius()                      const;
-        Vector               getSeedGradient()                const;
-        GLint                getSeedID()                      const;
-        GLint                getFormationID()                 const;
-        GLfloat              getHeading()                     const;
+        Function            getFunction(const GLint pos = 0) const;
+        ArrayList<Function> getFunctions()                   const;
+        GLfloat             getRadius()                      const;
+        Vec2f               getSeedGradient()                const;
+        GLint               getSeedID()                      const;
+        GLint               getFormationID()                 const;
+        GLfloat             getHeading()                     const;
 
         // <public utility functions>
-        LinkedList<Vector> getRelationships(const Vector c = Vector());
-        Vector getRelationship(const Function f = DEFAULT_FORMATION_FUNCTION,
-                               const GLfloat  r = DEFAULT_FORMATION_RADIUS,
-                               const Vector   c = Vector(),
-                               const GLfloat  theta = 0.0f);
-        Vector getRelationship(const GLint   pos   = 0,
-                               const GLfloat r     = DEFAULT_FORMATION_RADIUS,
-                               const Vector  c     = Vector(),
-                               const GLfloat theta = 0.0f);
+        ArrayList<Vec2f> getRelationships(const Vec2f c = Vec2f());
+        Vec2f getRelationship(const Function f = DEFAULT_FORMATION_FUNCTION,
+                              const GLfloat  r = DEFAULT_FORMATION_RADIUS,
+                              const Vec2f    c = Vec2f(),
+                              const GLfloat  theta = 0.0f);
+        Vec2f getRelationship(const GLint   pos   = 0,
+                              const GLfloat r     = DEFAULT_FORMATION_RADIUS,
+                              const Vec2f   c     = Vec2f(),
+                              const GLfloat theta = 0.0f);
+
+        bool compile(const GLint nCells);
+        bool isCompiled() const;
+        bool getTableEntry(const GLint id,
+                           Vec2f      &grad,
+                           Vec2f      &leftRel,
+                           Vec2f      &rightRel) const;
+
+        // <public static functions>
+        static bool describeFunction(const Function      f,
+                                     const FunctionShape shape,
+                                     const GLfloat       slope = 1.0f);
 
         // <virtual overloaded operators>
         virtual Formation& operator =(const Formation &f);
@@ -82,13 +104,26 @@ class Formation: protected LinkedList<Function>
 
         // <protected data members>
         GLfloat radius, heading;
-        Vector  seedGradient;
+        Vec2f   seedGradient;
         GLint   seedID, formationID;
+        shared_ptr<const FormationTable> table; // shared by every copy
 
         // <protected utility functions>
         GLfloat fIntersect(const Function f = DEFAULT_FORMATION_FUNCTION,
                            const GLfloat  r = DEFAULT_FORMATION_RADIUS,
-                           const Vector   c = Vector(),
+                           const Vec2f    c = Vec2f(),
                            const GLfloat  x = 0.0f);
+        GLfloat intersect(const Function f, const GLfloat r, const Vec2f c);
+        bool    intersectClosedForm(const Function f,
+                                    const GLfloat  r,
+                                    const Vec2f    c,
+                                    GLfloat       &x);
+        bool    intersectBracketed(const Function f,
+                                   const GLfloat  r,
+                                   const Vec2f    c,
+                                   GLfloat       &x);
+        GLfloat intersectSecant(const Function f,
+                                const GLfloat  r,
+                                const Vec2f    c);
 };  // Formation
 #endif
@@ -0,0 +1,131 @@
+//
+// Filename:        "FormationTable.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements a precompiled formation table,
+//                  which holds the gradient and desired neighbor
+//                  relationships of every cell in a formation.
+//
+
+// preprocessor directives
+#include "FormationTable.h"
+
+
+
+// <constructors>
+
+//
+// FormationTable(n)
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this table
+// to the parameterized number of (zeroed) cells.
+//
+// Returns:     <none>
+// Parameters:
+//      n       in      the number of cells
+//
+FormationTable::FormationTable(const GLint n)
+{
+    setSize(n);
+}   // FormationTable(const GLint)
+
+
+
+// <public mutator functions>
+
+//
+// bool setSize(n)
+// Last modified: 17Oct2026
+//
+// Attempts to resize this table to the parameterized number of cells,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      n       in      the number of cells
+//
+bool FormationTable::setSize(const GLint n)
+{
+    if (n < 0) return false;
+    gradients.resize(n);
+    leftRels.resize(n);
+    rightRels.resize(n);
+    return true;
+}   // setSize(const GLint)
+
+
+
+//
+// bool setEntry(id, grad, leftRel, rightRel)
+// Last modified: 17Oct2026
+//
+// Attempts to set the entry of the cell with the parameterized ID,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      id          in      the ID of the cell
+//      grad        in      the gradient of the cell
+//      leftRel     in      the desired relationship to the left neighbor
+//      rightRel    in      the desired relationship to the right neighbor
+//
+bool FormationTable::setEntry(const GLint id,
+                              const Vec2f grad,
+                              const Vec2f leftRel,
+                              const Vec2f rightRel)
+{
+    if ((id < 0) || (id >= getSize())) return false;
+    gradients[id] = grad;
+    leftRels[id]  = leftRel;
+    rightRels[id] = rightRel;
+    return true;
+}   // setEntry(const GLint, const Vec2f, const Vec2f, const Vec2f)
+
+
+
+// <public accessor functions>
+
+//
+// GLint getSize() const
+// Last modified: 17Oct2026
+//
+// Returns the number of cells in this table.
+//
+// Returns:     the number of cells in this table
+// Parameters:  <none>
+//
+GLint FormationTable::getSize() const
+{
+    return (GLint)gradients.size();
+}   // getSize() const
+
+
+
+//
+// bool getEntry(id, grad, leftRel, rightRel) const
+// Last modified: 17Oct2026
+//
+// Attempts to get the entry of the cell with the parameterized ID,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      id          in      the ID of the cell
+//      grad        out     the gradient of the cell
+//      leftRel     out     the desired relationship to the left neighbor
+//      rightRel    out     the desired relationship to the right neighbor
+//
+bool FormationTable::getEntry(const GLint id,
+                              Vec2f      &grad,
+                              Vec2f      &leftRel,
+                              Vec2f      &rightRel) const
+{
+    if ((id < 0) || (id >= getSize())) return false;
+    grad     = gradients[id];
+    leftRel  = leftRels[id];
+    rightRel = rightRels[id];
+    return true;
+}   // getEntry(const GLint, Vec2f &, Vec2f &, Vec2f &) const
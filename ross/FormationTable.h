@@ -0,0 +1,48 @@
+//
+// Filename:        "FormationTable.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes a precompiled formation table,
+//                  which holds the gradient and desired neighbor
+//                  relationships of every cell in a formation.
+//
+
+// preprocessor directives
+#ifndef FORMATION_TABLE_H
+#define FORMATION_TABLE_H
+#include <vector>
+#include "Vec.h"
+using namespace std;
+
+class FormationTable
+{
+
+    public:
+
+        // <constructors>
+        FormationTable(const GLint n = 0);
+
+        // <public mutator functions>
+        bool setSize(const GLint n);
+        bool setEntry(const GLint id,
+                      const Vec2f grad,
+                      const Vec2f leftRel,
+                      const Vec2f rightRel);
+
+        // <public accessor functions>
+        GLint getSize() const;
+        bool  getEntry(const GLint id,
+                       Vec2f      &grad,
+                       Vec2f      &leftRel,
+                       Vec2f      &rightRel) const;
+
+    protected:
+
+        // <protected data members>
+        vector<Vec2f> gradients;    // gradients of the cells (by ID)
+        vector<Vec2f> leftRels;     // desired relationships to left nbrs
+        vector<Vec2f> rightRels;    // desired relationships to right nbrs
+};  // FormationTable
+#endif
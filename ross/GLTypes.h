@@ -0,0 +1,30 @@
+//
+// Filename:        "GLTypes.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This file provides the OpenGL types used throughout
+//                  the simulator, without OpenGL itself when building
+//                  headless (ROSS_HEADLESS defined).
+//
+
+// preprocessor directives
+#ifndef GL_TYPES_H
+#define GL_TYPES_H
+#ifndef ROSS_HEADLESS
+#include "../GL/glut.h"
+#else
+
+// OpenGL types
+typedef float  GLfloat;
+typedef int    GLint;
+typedef double GLdouble;
+typedef int    GLsizei;
+
+// GLUT color components
+#define GLUT_RED        0
+#define GLUT_GREEN      1
+#define GLUT_BLUE       2
+#endif
+#endif
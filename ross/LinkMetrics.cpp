@@ -0,0 +1,665 @@
+//
+// Filename:        "LinkMetrics.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements a lock-free registry of the health
+//                  of the links that reach the robots (the traffic each way,
+//                  the time spent writing, the bytes still queued, what was
+//                  dropped or resent, and a histogram of the time from
+//                  writing each drive command to its acknowledgement),
+//                  which the threads on a link update without waiting on
+//                  each other and which is periodically dumped as CSV.
+//
+
+// preprocessor directives
+#include <chrono>
+#include <climits>
+#include "LinkMetrics.h"
+
+
+
+// <file functions>
+
+//
+// void raiseMax(m, value)
+// Last modified: 17Oct2026
+//
+// Raises the parameterized maximum to the parameterized value (if larger).
+//
+// Returns:     <none>
+// Parameters:
+//      m       in/out  the maximum
+//      value   in      the value being compared
+//
+static void raiseMax(atomic<long long> &m, const long long value)
+{
+    long long current = m.load(memory_order_relaxed);
+    while ((value > current) &&
+           (!m.compare_exchange_weak(current, value, memory_order_relaxed)));
+}   // raiseMax(atomic<long long> &, const long long)
+
+
+
+//
+// long long percentile(counts, n, q, maxValue)
+// Last modified: 17Oct2026
+//
+// Returns the limit of the bucket of the parameterized histogram holding
+// the parameterized fraction of its values (at most the largest value).
+//
+// Returns:     the estimated percentile (0 if no values)
+// Parameters:
+//      counts      in      the values per bucket
+//      n           in      the number of values
+//      q           in      the fraction of the values (0 to 1)
+//      maxValue    in      the largest value
+//
+static long long percentile(const long long *counts,
+                            const long long  n,
+                            const GLdouble   q,
+                            const long long  maxValue)
+{
+    if (n <= 0) return 0;
+    const long long target = (long long)(q * (GLdouble)n + 0.999999);
+    long long       total  = 0;
+    for (GLint i = 0; i < N_LATENCY_BUCKETS; ++i)
+    {
+        total += counts[i];
+        if (total < target) continue;
+        const long long limit = LinkMetrics::getBucketLimit(i);
+        return (limit < maxValue) ? limit : maxValue;
+    }
+    return maxValue;
+}   // percentile(const long long *, const long long, ...)
+
+
+
+// <constructors>
+
+//
+// LinkMetrics(ports, robots)
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this registry to no traffic
+// (the counters zeroed) on the parameterized number of ports, timing the
+// acknowledgements of the parameterized number of robots (by ID).
+//
+// Returns:     <none>
+// Parameters:
+//      ports       in      the number of ports measured
+//      robots      in      the number of robots timed
+//
+LinkMetrics::LinkMetrics(const GLint ports, const GLint robots)
+    : nLinks((ports > 0) ? ports : 0), nRobots((robots > 0) ? robots : 0),
+      links(new LinkCounters[nLinks]()), pending(new PendingAcks[nRobots]()),
+      nUnrouted(0), startTime(now()), lastDump(startTime),
+      lastLinks(new LinkSnapshot[nLinks]()), wroteHeader(false)
+{
+}   // LinkMetrics(const GLint, const GLint)
+
+
+
+// <destructors>
+
+//
+// ~LinkMetrics()
+// Last modified: 17Oct2026
+//
+// Destructor that clears this registry.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+LinkMetrics::~LinkMetrics()
+{
+    delete [] links;
+    delete [] pending;
+    delete [] lastLinks;
+}   // ~LinkMetrics()
+
+
+
+// <public mutator functions>
+
+//
+// bool commandSent(port, retransmit)
+// Last modified: 17Oct2026
+//
+// Attempts to count a command handed to the parameterized port,
+// returning true if successful, false otherwise (counting the command
+// as unrouted if the port is past the links of this registry).
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      port        in      the index of the port
+//      retransmit  in      true if the command is an unchanged resend
+//
+bool LinkMetrics::commandSent(const GLint port, const bool retransmit)
+{
+    if ((port < 0) || (port >= nLinks))
+    {
+        nUnrouted.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    LinkCounters &c = links[port];
+    c.nCommands.fetch_add(1, memory_order_relaxed);
+    if (retransmit) c.nRetransmits.fetch_add(1, memory_order_relaxed);
+    return true;
+}   // commandSent(const GLint, const bool)
+
+
+
+//
+// bool commandDropped(port)
+// Last modified: 17Oct2026
+//
+// Attempts to count a command dropped for want of the parameterized port
+// (or of any, if it is not a port), returning true if successful,
+// false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      port    in      the index of the port
+//
+bool LinkMetrics::commandDropped(const GLint port)
+{
+    if ((port < 0) || (port >= nLinks))
+        nUnrouted.fetch_add(1, memory_order_relaxed);
+    else links[port].nDropped.fetch_add(1, memory_order_relaxed);
+    return true;
+}   // commandDropped(const GLint)
+
+
+
+//
+// bool pollSent(port)
+// Last modified: 17Oct2026
+//
+// Attempts to count a query for odometry handed to the parameterized
+// port, returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      port    in      the index of the port
+//
+bool LinkMetrics::pollSent(const GLint port)
+{
+    if ((port < 0) || (port >= nLinks)) return false;
+    links[port].nPolls.fetch_add(1, memory_order_relaxed);
+    return true;
+}   // pollSent(const GLint)
+
+
+
+//
+// bool batchWritten(port, nBytes, usec, success, overrun, queued)
+// Last modified: 17Oct2026
+//
+// Attempts to count a write of the batch of a tick to the parameterized
+// port, returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      port        in      the index of the port
+//      nBytes      in      the bytes of the batch
+//      usec        in      the time the write took (in microseconds)
+//      success     in      true if the write succeeded
+//      overrun     in      true if the batch is over the capacity of the link
+//      queued      in      the bytes still queued on the port before it
+//
+bool LinkMetrics::batchWritten(const GLint     port,
+                               const GLint     nBytes,
+                               const long long usec,
+                               const bool      success,
+                               const bool      overrun,
+                               const long long queued)
+{
+    if ((port < 0) || (port >= nLinks)) return false;
+    LinkCounters &c = links[port];
+    if (success)
+    {
+        c.nWrites.fetch_add(1, memory_order_relaxed);
+        c.nBytesOut.fetch_add(nBytes, memory_order_relaxed);
+    }
+    else c.nFailed.fetch_add(1, memory_order_relaxed);
+    if (overrun) c.nOverruns.fetch_add(1, memory_order_relaxed);
+    c.writeTime.fetch_add(usec, memory_order_relaxed);
+    raiseMax(c.maxWriteTime, usec);
+    c.queued.store(queued, memory_order_relaxed);
+    raiseMax(c.maxQueued, queued);
+    return true;
+}   // batchWritten(const GLint, const GLint, const long long, ...)
+
+
+
+//
+// bool awaitAck(port, ID, sentAt)
+// Last modified: 17Oct2026
+//
+// Attempts to start timing a command written to the parameterized robot
+// until it is acknowledged, returning true if successful, false otherwise
+// (counting the command as untimed if the robot is past the robots of
+// this registry, or if MAX_PENDING_ACKS commands still await
+// acknowledgement once those over ACK_TIMEOUT_USEC old are counted
+// as lost).  Only one thread may write the commands.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      port    in      the index of the port
+//      ID      in      the ID of the robot
+//      sentAt  in      the time the command was written (in microseconds)
+//
+bool LinkMetrics::awaitAck(const GLint     port,
+                           const GLint     ID,
+                           const long long sentAt)
+{
+    if ((port < 0) || (port >= nLinks)) return false;
+    if ((ID   < 0) || (ID   >= nRobots))
+    {
+        links[port].nUntimed.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    PendingAcks       &p = pending[ID];
+    const unsigned int t = p.tail.load(memory_order_relaxed);
+
+    // a robot that stopped answering fills its queue, so its oldest
+    // commands are expired here rather than waiting on a reply
+    if (t - p.head.load(memory_order_acquire) >= (unsigned int)MAX_PENDING_ACKS)
+        expire(p, sentAt);
+    if (t - p.head.load(memory_order_acquire) >= (unsigned int)MAX_PENDING_ACKS)
+    {
+        links[port].nUntimed.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    p.sentAt[t % MAX_PENDING_ACKS].store(sentAt, memory_order_release);
+    p.port[t % MAX_PENDING_ACKS].store(port, memory_order_release);
+    p.tail.store(t + 1, memory_order_release);
+    return true;
+}   // awaitAck(const GLint, const GLint, const long long)
+
+
+
+//
+// bool ackReceived(port, ID, timestamp)
+// Last modified: 17Oct2026
+//
+// Attempts to match an acknowledgement from the parameterized robot to
+// the oldest command awaiting one, counting its round trip, returning true
+// if successful, false otherwise.  Commands that have awaited one for
+// over ACK_TIMEOUT_USEC are counted as lost first.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      port        in      the index of the port it arrived on
+//      ID          in      the ID of the robot
+//      timestamp   in      the time it arrived (in microseconds)
+//
+bool LinkMetrics::ackReceived(const GLint     port,
+                              const GLint     ID,
+                              const long long timestamp)
+{
+    if ((port < 0) || (port >= nLinks)) return false;
+    if ((ID < 0) || (ID >= nRobots))
+    {
+        links[port].nUnmatched.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    PendingAcks &p = pending[ID];
+    expire(p, timestamp);
+
+    // the oldest command is claimed by moving head past it, which fails
+    // (and is retried) if another thread took it (or its slot was reused)
+    unsigned int h = p.head.load(memory_order_acquire);
+    long long    sentAt;
+    GLint        sentPort;
+    for (;;)
+    {
+        if (h == p.tail.load(memory_order_acquire))
+        {
+            links[port].nUnmatched.fetch_add(1, memory_order_relaxed);
+            return false;
+        }
+        sentAt   = p.sentAt[h % MAX_PENDING_ACKS].load(memory_order_acquire);
+        sentPort = p.port[h % MAX_PENDING_ACKS].load(memory_order_acquire);
+        if (p.head.compare_exchange_weak(h, h + 1, memory_order_acq_rel,
+                                         memory_order_acquire)) break;
+    }
+
+    // the round trip counts against the link the command went out on
+    long long     usec = timestamp - sentAt;
+    LinkCounters &c    = links[sentPort];
+    if (usec < 0) usec = 0;
+    GLint bucket = 0;
+    while ((bucket < N_LATENCY_BUCKETS - 1) && (usec >= getBucketLimit(bucket)))
+        ++bucket;
+    c.nAcks.fetch_add(1, memory_order_relaxed);
+    c.latencyTime.fetch_add(usec, memory_order_relaxed);
+    c.latency[bucket].fetch_add(1, memory_order_relaxed);
+    raiseMax(c.maxLatency, usec);
+    return true;
+}   // ackReceived(const GLint, const GLint, const long long)
+
+
+
+//
+// bool received(port, nBytes, nFrames, nCorrupt)
+// Last modified: 17Oct2026
+//
+// Attempts to count the parameterized bytes read from the parameterized
+// port and the replies parsed from them, returning true if successful,
+// false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      port        in      the index of the port
+//      nBytes      in      the bytes read
+//      nFrames     in      the replies parsed
+//      nCorrupt    in      the malformed replies discarded
+//
+bool LinkMetrics::received(const GLint port,
+                           const GLint nBytes,
+                           const GLint nFrames,
+                           const GLint nCorrupt)
+{
+    if ((port < 0) || (port >= nLinks)) return false;
+    LinkCounters &c = links[port];
+    c.nBytesIn.fetch_add(nBytes, memory_order_relaxed);
+    if (nFrames  > 0) c.nFrames.fetch_add(nFrames, memory_order_relaxed);
+    if (nCorrupt > 0) c.nCorrupt.fetch_add(nCorrupt, memory_order_relaxed);
+    return true;
+}   // received(const GLint, const GLint, const GLint, const GLint)
+
+
+
+//
+// bool frameDiscarded(port)
+// Last modified: 17Oct2026
+//
+// Attempts to count a reply from the parameterized port that was
+// discarded (from an unknown robot, or of an unknown type),
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      port    in      the index of the port
+//
+bool LinkMetrics::frameDiscarded(const GLint port)
+{
+    if ((port < 0) || (port >= nLinks)) return false;
+    links[port].nDiscarded.fetch_add(1, memory_order_relaxed);
+    return true;
+}   // frameDiscarded(const GLint)
+
+
+
+//
+// bool dump(file, timestamp)
+// Last modified: 17Oct2026
+//
+// Attempts to write a CSV row for each link used so far with its health
+// since the last dump (the header before the first), as counts, rates,
+// means, maxima, and round trip percentiles (estimated as the limits of
+// their buckets), returning true if successful, false otherwise.
+// Commands that have awaited acknowledgement for over ACK_TIMEOUT_USEC
+// are counted as lost first, so a robot that stopped answering shows.
+// Only one thread may dump.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      file        in/out  the file being written to
+//      timestamp   in      the time of the dump (in microseconds)
+//
+bool LinkMetrics::dump(FILE *file, const long long timestamp)
+{
+    if (file == NULL) return false;
+    for (GLint i = 0; i < nRobots; ++i) expire(pending[i], timestamp);
+    bool success = true;
+    if (!wroteHeader)
+    {
+        success = fprintf(file, "time_s,port,commands,retransmits,dropped,"
+                          "polls,writes,failed,overruns,out_bytes_per_s,"
+                          "in_bytes_per_s,queued,max_queued,mean_write_us,"
+                          "max_write_us,frames,corrupt,discarded,acks,"
+                          "lost_acks,untimed,unmatched,mean_rtt_us,p50_rtt_us,"
+                          "p90_rtt_us,p99_rtt_us,max_rtt_us\n") > 0;
+        wroteHeader = success;
+    }
+    const GLdouble dt = (timestamp > lastDump)
+                      ? (GLdouble)(timestamp - lastDump) * 1.0e-6 : 1.0e-6;
+    for (GLint i = 0; (success) && (i < nLinks); ++i)
+    {
+        LinkSnapshot s, &l = lastLinks[i];
+        collect(i, s, true);
+        if (s.nCommands + s.nDropped + s.nPolls + s.nFailed + s.nBytesIn == 0)
+            continue;
+
+        long long latency[N_LATENCY_BUCKETS];
+        for (GLint b = 0; b < N_LATENCY_BUCKETS; ++b)
+            latency[b] = s.latency[b] - l.latency[b];
+        const long long nWrites = (s.nWrites - l.nWrites) +
+                                  (s.nFailed - l.nFailed);
+        const long long nAcks   = s.nAcks - l.nAcks;
+        success = fprintf(file,
+            "%.3f,%d,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%.1f,%.1f,%lld,"
+            "%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,%lld,"
+            "%lld,%lld,%lld\n",
+            (GLdouble)(timestamp - startTime) * 1.0e-6, i,
+            s.nCommands - l.nCommands, s.nRetransmits - l.nRetransmits,
+            s.nDropped - l.nDropped, s.nPolls - l.nPolls,
+            s.nWrites - l.nWrites,
+            s.nFailed - l.nFailed, s.nOverruns - l.nOverruns,
+            (GLdouble)(s.nBytesOut - l.nBytesOut) / dt,
+            (GLdouble)(s.nBytesIn  - l.nBytesIn)  / dt,
+            s.queued, s.maxQueued,
+            (nWrites > 0) ? (s.writeTime - l.writeTime) / nWrites : 0LL,
+            s.maxWriteTime, s.nFrames - l.nFrames, s.nCorrupt - l.nCorrupt,
+            s.nDiscarded - l.nDiscarded, nAcks, s.nLostAcks - l.nLostAcks,
+            s.nUntimed - l.nUntimed, s.nUnmatched - l.nUnmatched,
+            (nAcks > 0) ? (s.latencyTime - l.latencyTime) / nAcks : 0LL,
+            percentile(latency, nAcks, 0.50, s.maxLatency),
+            percentile(latency, nAcks, 0.90, s.maxLatency),
+            percentile(latency, nAcks, 0.99, s.maxLatency),
+            s.maxLatency) > 0;
+        l = s;
+    }
+    lastDump = timestamp;
+    return success;
+}   // dump(FILE *, const long long)
+
+
+
+// <public accessor functions>
+
+//
+// bool getSnapshot(port, s)
+// Last modified: 17Oct2026
+//
+// Attempts to get the health of the parameterized link so far,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      port    in      the index of the port
+//      s       out     the health of the link
+//
+bool LinkMetrics::getSnapshot(const GLint port, LinkSnapshot &s)
+{
+    if ((port < 0) || (port >= nLinks)) return false;
+    collect(port, s, false);
+    return true;
+}   // getSnapshot(const GLint, LinkSnapshot &)
+
+
+
+//
+// long long getNUnrouted() const
+// Last modified: 17Oct2026
+//
+// Returns the number of commands so far that reached no link measured
+// (dropped for want of any port, or handed to a port past the links).
+//
+// Returns:     the number of unrouted commands so far
+// Parameters:  <none>
+//
+long long LinkMetrics::getNUnrouted() const
+{
+    return nUnrouted.load(memory_order_relaxed);
+}   // getNUnrouted() const
+
+
+
+//
+// GLint getNLinks() const
+// Last modified: 17Oct2026
+//
+// Returns the number of ports this registry measures.
+//
+// Returns:     the number of links
+// Parameters:  <none>
+//
+GLint LinkMetrics::getNLinks() const
+{
+    return nLinks;
+}   // getNLinks() const
+
+
+
+//
+// GLint getNRobots() const
+// Last modified: 17Oct2026
+//
+// Returns the number of robots (by ID) whose acknowledgements are timed.
+//
+// Returns:     the number of robots
+// Parameters:  <none>
+//
+GLint LinkMetrics::getNRobots() const
+{
+    return nRobots;
+}   // getNRobots() const
+
+
+
+// <public static functions>
+
+//
+// long long now()
+// Last modified: 17Oct2026
+//
+// Returns the time on the steady clock that the links are timed by.
+//
+// Returns:     the time (in microseconds)
+// Parameters:  <none>
+//
+long long LinkMetrics::now()
+{
+    return chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+}   // now()
+
+
+
+//
+// long long getBucketLimit(bucket)
+// Last modified: 17Oct2026
+//
+// Returns the round trip that the parameterized bucket of the histogram
+// holds up to (doubling from LATENCY_BUCKET_USEC, without limit for the
+// last bucket).
+//
+// Returns:     the limit of the bucket (in microseconds, exclusive)
+// Parameters:
+//      bucket  in      the index of the bucket
+//
+long long LinkMetrics::getBucketLimit(const GLint bucket)
+{
+    if (bucket < 0)                      return 0;
+    if (bucket >= N_LATENCY_BUCKETS - 1) return LLONG_MAX;
+    return LATENCY_BUCKET_USEC << bucket;
+}   // getBucketLimit(const GLint)
+
+
+
+// <protected utility functions>
+
+//
+// void collect(port, s, reset)
+// Last modified: 17Oct2026
+//
+// Copies the counters of the parameterized link, restarting its maxima
+// if requested.
+//
+// Returns:     <none>
+// Parameters:
+//      port    in      the index of the port
+//      s       out     the health of the link
+//      reset   in      true if the maxima restart
+//
+void LinkMetrics::collect(const GLint port, LinkSnapshot &s, const bool reset)
+{
+    LinkCounters &c = links[port];
+    s.nCommands    = c.nCommands.load(memory_order_relaxed);
+    s.nRetransmits = c.nRetransmits.load(memory_order_relaxed);
+    s.nDropped     = c.nDropped.load(memory_order_relaxed);
+    s.nPolls       = c.nPolls.load(memory_order_relaxed);
+    s.nWrites      = c.nWrites.load(memory_order_relaxed);
+    s.nFailed      = c.nFailed.load(memory_order_relaxed);
+    s.nOverruns    = c.nOverruns.load(memory_order_relaxed);
+    s.nBytesOut    = c.nBytesOut.load(memory_order_relaxed);
+    s.nBytesIn     = c.nBytesIn.load(memory_order_relaxed);
+    s.nFrames      = c.nFrames.load(memory_order_relaxed);
+    s.nCorrupt     = c.nCorrupt.load(memory_order_relaxed);
+    s.nDiscarded   = c.nDiscarded.load(memory_order_relaxed);
+    s.nAcks        = c.nAcks.load(memory_order_relaxed);
+    s.nLostAcks    = c.nLostAcks.load(memory_order_relaxed);
+    s.nUnmatched   = c.nUnmatched.load(memory_order_relaxed);
+    s.nUntimed     = c.nUntimed.load(memory_order_relaxed);
+    s.writeTime    = c.writeTime.load(memory_order_relaxed);
+    s.queued       = c.queued.load(memory_order_relaxed);
+    s.latencyTime  = c.latencyTime.load(memory_order_relaxed);
+    for (GLint i = 0; i < N_LATENCY_BUCKETS; ++i)
+        s.latency[i] = c.latency[i].load(memory_order_relaxed);
+    s.maxWriteTime = reset ? c.maxWriteTime.exchange(0, memory_order_relaxed)
+                           : c.maxWriteTime.load(memory_order_relaxed);
+    s.maxQueued    = reset ? c.maxQueued.exchange(0, memory_order_relaxed)
+                           : c.maxQueued.load(memory_order_relaxed);
+    s.maxLatency   = reset ? c.maxLatency.exchange(0, memory_order_relaxed)
+                           : c.maxLatency.load(memory_order_relaxed);
+}   // collect(const GLint, LinkSnapshot &, const bool)
+
+
+
+//
+// void expire(p, timestamp)
+// Last modified: 17Oct2026
+//
+// Counts the commands of the parameterized queue that have awaited
+// acknowledgement for over ACK_TIMEOUT_USEC at the parameterized time as
+// lost, oldest first, claiming each by moving head past it (so that the
+// threads taking commands never count one twice).
+//
+// Returns:     <none>
+// Parameters:
+//      p           in/out  the commands awaiting acknowledgement
+//      timestamp   in      the time now (in microseconds)
+//
+void LinkMetrics::expire(PendingAcks &p, const long long timestamp)
+{
+    unsigned int h = p.head.load(memory_order_acquire);
+    while (h != p.tail.load(memory_order_acquire))
+    {
+        const long long sentAt =
+            p.sentAt[h % MAX_PENDING_ACKS].load(memory_order_acquire);
+        const GLint     port   =
+            p.port[h % MAX_PENDING_ACKS].load(memory_order_acquire);
+        if (timestamp - sentAt <= ACK_TIMEOUT_USEC) return;
+        if (p.head.compare_exchange_weak(h, h + 1, memory_order_acq_rel,
+                                         memory_order_acquire))
+        {
+            links[port].nLostAcks.fetch_add(1, memory_order_relaxed);
+            ++h;
+        }
+    }
+}   // expire(PendingAcks &, const long long)
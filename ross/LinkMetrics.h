@@ -0,0 +1,165 @@
+//
+// Filename:        "LinkMetrics.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes a lock-free registry of the health
+//                  of the links that reach the robots (the traffic each way,
+//                  the time spent writing, the bytes still queued, what was
+//                  dropped or resent, and a histogram of the time from
+//                  writing each drive command to its acknowledgement),
+//                  which the threads on a link update without waiting on
+//                  each other and which is periodically dumped as CSV.
+//
+
+// preprocessor directives
+#ifndef LINK_METRICS_H
+#define LINK_METRICS_H
+#include <atomic>
+#include <cstdio>
+#include "GLTypes.h"
+using namespace std;
+
+// global constants
+static const GLint     DEFAULT_METRIC_LINKS  = 16;       // ports measured
+static const GLint     DEFAULT_METRIC_ROBOTS = 32;       // robots timed
+static const GLint     MAX_PENDING_ACKS      = 8;        // commands awaiting acks
+static const GLint     N_LATENCY_BUCKETS     = 16;       // round trip histogram
+static const long long LATENCY_BUCKET_USEC   = 250;      // first bucket limit
+static const long long ACK_TIMEOUT_USEC      = 1000000;  // acks older are lost
+
+//
+// LinkSnapshot
+//
+// Describes the health of a link so far (the maxima since the last dump).
+//
+struct LinkSnapshot
+{
+    long long nCommands;        // the commands handed to the port
+    long long nRetransmits;     // the unchanged commands resent
+    long long nDropped;         // the commands dropped (the port not open)
+    long long nPolls;           // the odometry queries handed to the port
+    long long nWrites;          // the successful writes
+    long long nFailed;          // the failed writes
+    long long nOverruns;        // the writes over the capacity of the link
+    long long nBytesOut;        // the bytes successfully written
+    long long nBytesIn;         // the bytes read
+    long long nFrames;          // the replies parsed
+    long long nCorrupt;         // the malformed replies discarded
+    long long nDiscarded;       // the replies of unknown robots or types
+    long long nAcks;            // the acknowledgements matched to a command
+    long long nLostAcks;        // the commands never acknowledged
+    long long nUntimed;         // the commands not timed (too many awaiting,
+                                // or to a robot past the registry)
+    long long nUnmatched;       // the acknowledgements of no command
+    long long writeTime;        // the time spent writing (in microseconds)
+    long long maxWriteTime;     // the longest write (in microseconds)
+    long long queued;           // the bytes still queued before the last write
+    long long maxQueued;        // the most bytes queued before a write
+    long long latencyTime;      // the sum of the round trips (in microseconds)
+    long long maxLatency;       // the longest round trip (in microseconds)
+    long long latency[N_LATENCY_BUCKETS];   // the round trips per bucket
+};  // LinkSnapshot
+
+class LinkMetrics
+{
+
+    public:
+
+        // <constructors>
+        LinkMetrics(const GLint ports  = DEFAULT_METRIC_LINKS,
+                    const GLint robots = DEFAULT_METRIC_ROBOTS);
+
+        // <destructors>
+        ~LinkMetrics();
+
+        // <public mutator functions>
+        bool commandSent(const GLint port, const bool retransmit = false);
+        bool commandDropped(const GLint port);
+        bool pollSent(const GLint port);
+        bool batchWritten(const GLint     port,
+                          const GLint     nBytes,
+                          const long long usec,
+                          const bool      success,
+                          const bool      overrun = false,
+                          const long long queued  = 0);
+        bool awaitAck(const GLint port, const GLint ID, const long long sentAt);
+        bool ackReceived(const GLint     port,
+                         const GLint     ID,
+                         const long long timestamp);
+        bool received(const GLint port,
+                      const GLint nBytes,
+                      const GLint nFrames  = 0,
+                      const GLint nCorrupt = 0);
+        bool frameDiscarded(const GLint port);
+        bool dump(FILE *file, const long long timestamp);
+
+        // <public accessor functions>
+        bool      getSnapshot(const GLint port, LinkSnapshot &s);
+        long long getNUnrouted() const;
+        GLint     getNLinks()    const;
+        GLint     getNRobots()   const;
+
+        // <public static functions>
+        static long long now();
+        static long long getBucketLimit(const GLint bucket);
+
+    protected:
+
+        //
+        // LinkCounters
+        //
+        // Describes the health of a link as it is updated.
+        //
+        struct LinkCounters
+        {
+            atomic<long long> nCommands, nRetransmits, nDropped, nPolls;
+            atomic<long long> nWrites, nFailed, nOverruns;
+            atomic<long long> nBytesOut, nBytesIn;
+            atomic<long long> nFrames, nCorrupt, nDiscarded;
+            atomic<long long> nAcks, nLostAcks, nUnmatched, nUntimed;
+            atomic<long long> writeTime, maxWriteTime;
+            atomic<long long> queued, maxQueued;
+            atomic<long long> latencyTime, maxLatency;
+            atomic<long long> latency[N_LATENCY_BUCKETS];
+        };  // LinkCounters
+
+        //
+        // PendingAcks
+        //
+        // Describes the commands written to a robot that await
+        // acknowledgement, oldest first (added by the one thread that
+        // writes the commands, and taken by whichever thread finds the
+        // oldest acknowledged or expired, claiming it by moving head).
+        //
+        struct PendingAcks
+        {
+            atomic<long long>    sentAt[MAX_PENDING_ACKS];
+            atomic<GLint>        port[MAX_PENDING_ACKS];
+            atomic<unsigned int> head;      // the oldest command (consumers)
+            atomic<unsigned int> tail;      // the next command (producer)
+        };  // PendingAcks
+
+        // <protected data members>
+        GLint             nLinks;           // the ports measured
+        GLint             nRobots;          // the robots timed
+        LinkCounters     *links;            // indexed by port
+        PendingAcks      *pending;          // indexed by robot ID
+        atomic<long long> nUnrouted;
+        long long         startTime;        // the time this registry began
+        long long         lastDump;         // owned by the thread that dumps
+        LinkSnapshot     *lastLinks;        // indexed by port
+        bool              wroteHeader;
+
+        // <protected utility functions>
+        void collect(const GLint port, LinkSnapshot &s, const bool reset);
+        void expire(PendingAcks &p, const long long timestamp);
+
+    private:
+
+        // <private constructors>
+        LinkMetrics(const LinkMetrics &);
+        LinkMetrics& operator =(const LinkMetrics &);
+};  // LinkMetrics
+#endif
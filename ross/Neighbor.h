@@ -53,11 +53,11 @@ struct Neighbor: Relationship, State
     //
     Neighbor(const GLint  id,
              const State  s       = State(),
-             const Vector desired = Vector(),
-             const Vector actual  = Vector())
+             const Vec2f  desired = Vec2f(),
+             const Vec2f  actual  = Vec2f())
         : Relationship(desired, actual, id), State(s)
     {
-    }   // Neighbor(const GLint, const State, const Vector, const Vector)
+    }   // Neighbor(const GLint, const State, const Vec2f, const Vec2f)
 
 
 
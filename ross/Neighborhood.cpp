@@ -2,7 +2,7 @@
 // Filename:        "Neighborhood.cpp"
 //
 // Programmer:      Ross Mead
-// Last modified:   10Dec2006
+// Last modified:   17Oct2026
 //
 // Description:     This class implements a robot cell neighborhood.
 //
@@ -25,7 +25,7 @@
 // Returns:     <none>
 // Parameters:  <none>
 //
-Neighborhood::Neighborhood(): LinkedList<Neighbor>()
+Neighborhood::Neighborhood(): ArrayList<Neighbor>()
 {
 }   // Neighborhood()
 
@@ -43,7 +43,7 @@ Neighborhood::Neighborhood(): LinkedList<Neighbor>()
 //      nh      in/out      the neighborhood being copied
 //
 Neighborhood::Neighborhood(const Neighborhood &nh)
-    : LinkedList<Neighbor>(nh)
+    : ArrayList<Neighbor>(nh)
 {
 }   // Neighborhood(const Neighborhood &)
 
@@ -60,10 +60,10 @@ Neighborhood::Neighborhood(const Neighborhood &nh)
 // Parameters:
 //      r       in/out      the list of relationships being copied
 //
-Neighborhood::Neighborhood(const LinkedList<Relationship> &r)
+Neighborhood::Neighborhood(const ArrayList<Relationship> &r)
 {
     for (GLint i = 0; i < r.getSize(); ++i) addNbr(r[i], State());
-}   // Neighborhood(const LinkedList<Relationship> &)
+}   // Neighborhood(const ArrayList<Relationship> &)
 
 
 
@@ -78,10 +78,10 @@ Neighborhood::Neighborhood(const LinkedList<Relationship> &r)
 // Parameters:
 //      s       in/out      the list of states being copied
 //
-Neighborhood::Neighborhood(const LinkedList<State> &s)
+Neighborhood::Neighborhood(const ArrayList<State> &s)
 {
     for (GLint i = 0; i < s.getSize(); ++i) addNbr(Relationship(), s[i]);
-}   // Neighborhood(const LinkedList<State> &)
+}   // Neighborhood(const ArrayList<State> &)
 
 
 
@@ -158,10 +158,10 @@ bool Neighborhood::addNbr(const Relationship r, const State s)
 //      actual      in  the actual relationship of the neighbor being added
 //
 bool Neighborhood::addNbr(const GLint  id,      const State  s,
-                          const Vector desired, const Vector actual)
+                          const Vec2f  desired, const Vec2f  actual)
 {
     return addNbr(Neighbor(id, s, desired, actual));
-}   // addNbr(const GLint, const State, const Vector, const Vector)
+}   // addNbr(const GLint, const State, const Vec2f, const Vec2f)
 
 
 
@@ -185,7 +185,7 @@ bool Neighborhood::removeNbr(const Neighbor n)
 
 //
 // bool removeNbr(id)
-// Last modified: 02Sep2006
+// Last modified: 17Oct2026
 //
 // Attempts to remove the neighbor with the parameterized ID,
 // returning true if successful, false otherwise.
@@ -196,13 +196,8 @@ bool Neighborhood::removeNbr(const Neighbor n)
 //
 bool Neighborhood::removeNbr(const GLint id)
 {
-    Neighbor nbr;
     for (GLint i = 0; i < getSize(); ++i)
-    {
-        if (!getHead(nbr)) return false;
-        if (nbr.ID == id)  return removeHead();
-        ++(*this);
-    }
+        if ((*this)[i].ID == id) return remove(i);
     return false;
 }   // removeNbr(const GLint)
 
@@ -211,42 +206,40 @@ bool Neighborhood::removeNbr(const GLint id)
 // <virtual public accessor functions>
 
 //
-// LinkedList<Relationship> getRelationships()
-// Last modified: 02Sep2006
+// ArrayList<Relationship> getRelationships()
+// Last modified: 17Oct2026
 //
 // Returns the list of neighbor relationships.
 //
 // Returns:     list of neighbor relationships
 // Parameters:  <none>
 //
-LinkedList<Relationship> Neighborhood::getRelationships()
+ArrayList<Relationship> Neighborhood::getRelationships()
 {
-    LinkedList<Relationship> rels;
-    Neighbor currNbr;
+    ArrayList<Relationship> rels;
+    rels.reserve(getSize());
     for (GLint i = 0; i < getSize(); ++i)
-        if ((!getHead(currNbr)) || (!rels.insertTail(currNbr))) break;
-        else ++(*this);
+        if (!rels.insertTail((*this)[i])) break;
     return rels;
 }   // getRelationships()
 
 
 
 //
-// LinkedList<State> getStates()
-// Last modified: 02Sep2006
+// ArrayList<State> getStates()
+// Last modified: 17Oct2026
 //
 // Returns the list of neighbor states.
 //
 // Returns:     list of neighbor states
 // Parameters:  <none>
 //
-LinkedList<State> Neighborhood::getStates()
+ArrayList<State> Neighborhood::getStates()
 {
-    LinkedList<State> states;
-    Neighbor currNbr;
+    ArrayList<State> states;
+    states.reserve(getSize());
     for (GLint i = 0; i < getSize(); ++i)
-        if ((!getHead(currNbr)) || (!states.insertTail(currNbr))) break;
-        else ++(*this);
+        if (!states.insertTail((*this)[i])) break;
     return states;
 }   // getStates()
 
@@ -273,7 +266,7 @@ Neighbor* Neighborhood::getNbr(const GLint pos) const
 
 
 //
-// LinkedList<Neighbor> getNbrs() const
+// ArrayList<Neighbor> getNbrs() const
 // Last modified: 02Sep2006
 //
 // Returns the list of neighbors in this neighborhood.
@@ -281,7 +274,7 @@ Neighbor* Neighborhood::getNbr(const GLint pos) const
 // Returns:     list of neighbors in this neighborhood
 // Parameters:  <none>
 //
-LinkedList<Neighbor> Neighborhood::getNbrs() const
+ArrayList<Neighbor> Neighborhood::getNbrs() const
 {
     return *this;
 }   // getNbrs() const
@@ -367,7 +360,7 @@ bool Neighborhood::isNbr(const Neighbor n)
 
 //
 // bool isNbr(id)
-// Last modified: 02Sep2006
+// Last modified: 17Oct2026
 //
 // Returns true if the neighbor with the parameterized ID
 // is in this neighborhood, false otherwise.
@@ -378,14 +371,7 @@ bool Neighborhood::isNbr(const Neighbor n)
 //
 bool Neighborhood::isNbr(const GLint id)
 {
-    Neighbor nbr;
-    for (GLint i = 0; i < getSize(); ++i)
-    {
-        getHead(nbr);
-        if (nbr.ID == id) return true;
-        else              ++(*this);
-    }
-    return false;
+    return nbrWithID(id) != NULL;
 }   // isNbr(const GLint)
 
 
@@ -427,7 +413,7 @@ Neighbor* Neighborhood::anyNbr()
 
 //
 // Neighbor* firstNbr()
-// Last modified: 03Sep2006
+// Last modified: 17Oct2026
 //
 // Returns the first neighbor in this neighborhood.
 //
@@ -436,7 +422,7 @@ Neighbor* Neighborhood::anyNbr()
 //
 Neighbor* Neighborhood::firstNbr()
 {
-    if (getHead(Neighbor())) return &(*this)[0];
+    if (getSize() > 0) return &(*this)[0];
     return NULL;
 }   // firstNbr(Neighborhood &nh)
 
@@ -444,7 +430,7 @@ Neighbor* Neighborhood::firstNbr()
 
 //
 // Neighbor* secondNbr()
-// Last modified: 03Sep2006
+// Last modified: 17Oct2026
 //
 // Returns the second neighbor in this neighborhood.
 //
@@ -453,7 +439,7 @@ Neighbor* Neighborhood::firstNbr()
 //
 Neighbor* Neighborhood::secondNbr()
 {
-    if (getHeadNext(Neighbor())) return &(*this)[1];
+    if (getSize() > 1) return &(*this)[1];
     return NULL;
 }   // secondNbr()
 
@@ -461,7 +447,7 @@ Neighbor* Neighborhood::secondNbr()
 
 //
 // Neighbor* lastNbr()
-// Last modified: 03Sep2006
+// Last modified: 17Oct2026
 //
 // Returns the last neighbor in this neighborhood.
 //
@@ -470,7 +456,7 @@ Neighbor* Neighborhood::secondNbr()
 //
 Neighbor* Neighborhood::lastNbr()
 {
-    if (getTail(Neighbor())) return &(*this)[getSize() - 1];
+    if (getSize() > 0) return &(*this)[getSize() - 1];
     return NULL;
 }   // lastNbr()
 
@@ -478,7 +464,7 @@ Neighbor* Neighborhood::lastNbr()
 
 //
 // Neighbor* closestNbr(v)
-// Last modified: 03Sep2006
+// Last modified: 17Oct2026
 //
 // Returns the closest neighbor in this neighborhood
 // as determined by the parameterized difference vector.
@@ -487,14 +473,13 @@ Neighbor* Neighborhood::lastNbr()
 // Parameters:
 //      v       in      the difference vector
 //
-Neighbor* Neighborhood::closestNbr(const Vector v)
+Neighbor* Neighborhood::closestNbr(const Vec2f v)
 {
-    Neighbor currNbr;
     GLfloat  minDist  = 0.0f, currDist = 0.0f;
     GLint    minIndex = ID_NO_NBR;
     for (GLint i = 0; i < getSize(); ++i)
     {
-        if (!getHead(currNbr)) return NULL;
+        Neighbor &currNbr = (*this)[i];
         if ((currNbr.ID != ID_NO_NBR) &&
             (((currDist = (currNbr.relActual - v).norm()) < minDist) ||
              (minIndex == ID_NO_NBR)))
@@ -502,17 +487,16 @@ Neighbor* Neighborhood::closestNbr(const Vector v)
             minDist   = currDist;
             minIndex  = i;
         }
-        ++(*this);
     }
-    return ((minIndex < 0) || (minIndex > getSize()))
+    return ((minIndex < 0) || (minIndex >= getSize()))
             ? NULL : &(*this)[minIndex];
-}   // closestNbr(const Vector)
+}   // closestNbr(const Vec2f)
 
 
 
 //
 // Neighbor* furthestNbr(v)
-// Last modified: 03Sep2006
+// Last modified: 17Oct2026
 //
 // Returns the furthest neighbor in this neighborhood
 // as determined by the parameterized difference vector.
@@ -521,14 +505,13 @@ Neighbor* Neighborhood::closestNbr(const Vector v)
 // Parameters:
 //      v       in      the difference vector
 //
-Neighbor* Neighborhood::furthestNbr(const Vector v)
+Neighbor* Neighborhood::furthestNbr(const Vec2f v)
 {
-    Neighbor currNbr;
     GLfloat  maxDist  = 0.0f, currDist = 0.0f;
     GLint    maxIndex = ID_NO_NBR;
     for (GLint i = 0; i < getSize(); ++i)
     {
-        if (!getHead(currNbr)) return NULL;
+        Neighbor &currNbr = (*this)[i];
         if ((currNbr.ID != ID_NO_NBR) &&
             (((currDist = (currNbr.relActual - v).norm()) > maxDist) ||
              (maxIndex == ID_NO_NBR)))
@@ -536,11 +519,10 @@ Neighbor* Neighborhood::furthestNbr(const Vector v)
             maxDist   = currDist;
             maxIndex  = i;
         }
-        ++(*this);
     }
-    return ((maxIndex < 0) || (maxIndex > getSize()))
+    return ((maxIndex < 0) || (maxIndex >= getSize()))
             ? NULL : &(*this)[maxIndex];
-}   // furthestNbr(const Vector)
+}   // furthestNbr(const Vec2f)
 
 
 
@@ -548,7 +530,7 @@ Neighbor* Neighborhood::furthestNbr(const Vector v)
 
 //
 // Neighbor* nbrWithID(id)
-// Last modified: 07Sep2006
+// Last modified: 17Oct2026
 //
 // Returns the neighbor (in this neighborhood) with the parameterized ID.
 //
@@ -558,13 +540,8 @@ Neighbor* Neighborhood::furthestNbr(const Vector v)
 //
 Neighbor* Neighborhood::nbrWithID(const GLint id)
 {
-    Neighbor currNbr;
     for (GLint i = 0; i < getSize(); ++i)
-    {
-        if (!getHead(currNbr)) break;
-        if (currNbr.ID == id)  return &(*this)[0];
-        ++(*this);
-    }
+        if ((*this)[i].ID == id) return &(*this)[i];
     return NULL;
 }   // nbrWithID(const GLint)
 
@@ -572,7 +549,7 @@ Neighbor* Neighborhood::nbrWithID(const GLint id)
 
 //
 // Neighbor* nbrWithGradient(grad)
-// Last modified: 07Sep2006
+// Last modified: 17Oct2026
 //
 // Returns the neighbor (in this neighborhood) with the parameterized gradient.
 //
@@ -580,23 +557,18 @@ Neighbor* Neighborhood::nbrWithID(const GLint id)
 // Parameters:
 //      gradient    in  the gradient of the neighbor to find
 //
-Neighbor* Neighborhood::nbrWithGradient(const Vector grad)
+Neighbor* Neighborhood::nbrWithGradient(const Vec2f grad)
 {
-    Neighbor currNbr;
     for (GLint i = 0; i < getSize(); ++i)
-    {
-        if (!getHead(currNbr))        break;
-        if (currNbr.gradient == grad) return &(*this)[0];
-        ++(*this);
-    }
+        if ((*this)[i].gradient == grad) return &(*this)[i];
     return NULL;
-}   // nbrWithGradient(const Vector)
+}   // nbrWithGradient(const Vec2f)
 
 
 
 //
 // Neighbor* nbrWithMinGradient(v)
-// Last modified: 03Sep2006
+// Last modified: 17Oct2026
 //
 // Returns the neighbor (in this neighborhood) with the minimum gradient
 // distance as determined by the parameterized difference vector.
@@ -605,14 +577,13 @@ Neighbor* Neighborhood::nbrWithGradient(const Vector grad)
 // Parameters:
 //      v       in      the difference vector
 //
-Neighbor* Neighborhood::nbrWithMinGradient(const Vector v)
+Neighbor* Neighborhood::nbrWithMinGradient(const Vec2f v)
 {
-    Neighbor currNbr;
     GLfloat  minGrad  = 0.0f, currGrad = 0.0f;
     GLint    minIndex = ID_NO_NBR;
     for (GLint i = 0; i < getSize(); ++i)
     {
-        if (!getHead(currNbr)) return NULL;
+        Neighbor &currNbr = (*this)[i];
         if ((currNbr.ID != ID_NO_NBR) &&
             (((currGrad = (currNbr.gradient - v).norm())
               < minGrad) || (minIndex == ID_NO_NBR)))
@@ -620,17 +591,16 @@ Neighbor* Neighborhood::nbrWithMinGradient(const Vector v)
             minGrad   = currGrad;
             minIndex  = i;
         }
-        ++(*this);
     }
-    return ((minIndex < 0) || (minIndex > getSize()))
+    return ((minIndex < 0) || (minIndex >= getSize()))
             ? NULL : &(*this)[minIndex];
-}   // nbrWithMinGradient(const Vector)
+}   // nbrWithMinGradient(const Vec2f)
 
 
 
 //
 // Neighbor* nbrWithMaxGradient(v)
-// Last modified: 03Sep2006
+// Last modified: 17Oct2026
 //
 // Returns the neighbor (in this neighborhood) with the maximum gradient
 // distance as determined by the parameterized difference vector.
@@ -639,14 +609,13 @@ Neighbor* Neighborhood::nbrWithMinGradient(const Vector v)
 // Parameters:
 //      v       in      the difference vector
 //
-Neighbor* Neighborhood::nbrWithMaxGradient(const Vector v)
+Neighbor* Neighborhood::nbrWithMaxGradient(const Vec2f v)
 {
-    Neighbor currNbr;
     GLfloat  maxGrad  = 0.0f, currGrad = 0.0f;
     GLint    maxIndex = ID_NO_NBR;
     for (GLint i = 0; i < getSize(); ++i)
     {
-        if (!getHead(currNbr)) return NULL;
+        Neighbor &currNbr = (*this)[i];
         if ((currNbr.ID != ID_NO_NBR) &&
             (((currGrad = (currNbr.gradient - v).norm())
               > maxGrad) || (maxIndex == ID_NO_NBR)))
@@ -654,11 +623,10 @@ Neighbor* Neighborhood::nbrWithMaxGradient(const Vector v)
             maxGrad   = currGrad;
             maxIndex  = i;
         }
-        ++(*this);
     }
-    return ((maxIndex < 0) || (maxIndex > getSize()))
+    return ((maxIndex < 0) || (maxIndex >= getSize()))
             ? NULL : &(*this)[maxIndex];
-}   // nbrWithMaxGradient(const Vector)
+}   // nbrWithMaxGradient(const Vec2f)
 
 
 
@@ -694,14 +662,14 @@ void Neighborhood::sortByID()
 // Parameters:
 //      v       in      the difference vector
 //
-void Neighborhood::sortByGradient(const Vector v)
+void Neighborhood::sortByGradient(const Vec2f v)
 {
     for (GLint i = 0; i < getSize() - 1; ++i)
         for (GLint j = i; j < getSize(); ++j)
             if ((getNbr(i)->gradient - v).norm() >
                 (getNbr(j)->gradient - v).norm())
                 swap(*getNbr(i), *getNbr(j));
-}   // sortByGradient(const Vector)
+}   // sortByGradient(const Vec2f)
 
 
 
@@ -716,14 +684,14 @@ void Neighborhood::sortByGradient(const Vector v)
 // Parameters:
 //      v       in      the difference vector
 //
-void Neighborhood::sortByDistance(const Vector v)
+void Neighborhood::sortByDistance(const Vec2f v)
 {
     for (GLint i = 0; i < getSize() - 1; ++i)
         for (GLint j = i; j < getSize(); ++j)
             if ((getNbr(i)->relActual - v).norm() >
                 (getNbr(j)->relActual - v).norm())
                 swap(*getNbr(i), *getNbr(j));
-}   // sortByDistance(const Vector)
+}   // sortByDistance(const Vec2f)
 
 
 
@@ -738,14 +706,14 @@ void Neighborhood::sortByDistance(const Vector v)
 // Parameters:
 //      v       in      the difference vector
 //
-void Neighborhood::sortByAngle(const Vector v)
+void Neighborhood::sortByAngle(const Vec2f v)
 {
     for (GLint i = 0; i < getSize() - 1; ++i)
         for (GLint j = i; j < getSize(); ++j)
             if ((getNbr(i)->relActual - v).angle() >
                 (getNbr(j)->relActual - v).angle())
                 swap(*getNbr(i), *getNbr(j));
-}   // sortByAngle(const Vector)
+}   // sortByAngle(const Vec2f)
 
 
 
@@ -760,11 +728,32 @@ void Neighborhood::sortByAngle(const Vector v)
 // Parameters:
 //      v       in      the difference vector
 //
-void Neighborhood::sortByAbsAngle(const Vector v)
+void Neighborhood::sortByAbsAngle(const Vec2f v)
 {
     for (GLint i = 0; i < getSize() - 1; ++i)
         for (GLint j = i; j < getSize(); ++j)
             if (abs((getNbr(i)->relActual - v).angle()) >
                 abs((getNbr(j)->relActual - v).angle()))
                 swap(*getNbr(i), *getNbr(j));
-}   // sortByAbsAngle(const Vector)
+}   // sortByAbsAngle(const Vec2f)
+
+
+
+// <overloaded operators>
+
+//
+// Neighborhood& =(nh)
+// Last modified: 17Oct2026
+//
+// Copies the contents of the parameterized neighborhood
+// into this neighborhood.
+//
+// Returns:     this neighborhood
+// Parameters:
+//      nh      in/out      the neighborhood being copied
+//
+Neighborhood& Neighborhood::operator =(const Neighborhood &nh)
+{
+    ArrayList<Neighbor>::operator =(nh);
+    return *this;
+}   // =(const Neighborhood &)
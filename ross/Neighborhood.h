@@ -2,7 +2,7 @@
 // Filename:        "Neighborhood.h"
 //
 // Programmer:      Ross Mead
-// Last modified:   07Sep2006
+// Last modified:   17Oct2026
 //
 // Description:     This class describes a robot cell neighborhood.
 //
@@ -14,7 +14,7 @@
 using namespace std;
 
 class Environment;
-class Neighborhood: public LinkedList<Neighbor>
+class Neighborhood: public ArrayList<Neighbor>
 {
 
     public:
@@ -22,8 +22,8 @@ class Neighborhood: public LinkedList<Neighbor>
         // <constructors>
         Neighborhood();
         Neighborhood(const Neighborhood &nh);
-        Neighborhood(const LinkedList<Relationship> &r);
-        Neighborhood(const LinkedList<State> &s);
+        Neighborhood(const ArrayList<Relationship> &r);
+        Neighborhood(const ArrayList<State> &s);
 
         // <destructors>
         ~Neighborhood();
@@ -34,19 +34,19 @@ class Neighborhood: public LinkedList<Neighbor>
                     const State        s = State());
         bool addNbr(const GLint  id,
                     const State  s       = State(),
-                    const Vector desired = Vector(),
-                    const Vector actual  = Vector());
+                    const Vec2f  desired = Vec2f(),
+                    const Vec2f  actual  = Vec2f());
         bool removeNbr(const Neighbor n);
         bool removeNbr(const GLint id);
 
         // <virtual public accessor functions>
-        virtual LinkedList<Relationship> getRelationships();
-        virtual LinkedList<State>        getStates();
+        virtual ArrayList<Relationship> getRelationships();
+        virtual ArrayList<State>        getStates();
 
         // <public accessor functions>
-        Neighbor*            getNbr(const GLint pos) const;
-        LinkedList<Neighbor> getNbrs()               const;
-        GLint                getNNbrs()              const;
+        Neighbor*           getNbr(const GLint pos) const;
+        ArrayList<Neighbor> getNbrs()               const;
+        GLint               getNNbrs()              const;
 
         // <public utility functions>
         bool updateNbr(Neighbor &n, const State &s);
@@ -60,20 +60,23 @@ class Neighborhood: public LinkedList<Neighbor>
         Neighbor* firstNbr();
         Neighbor* secondNbr();
         Neighbor* lastNbr();
-        Neighbor* closestNbr(const Vector c = Vector());
-        Neighbor* furthestNbr(const Vector c = Vector());
+        Neighbor* closestNbr(const Vec2f c = Vec2f());
+        Neighbor* furthestNbr(const Vec2f c = Vec2f());
 
         // <public single neighbor property member functions>
         Neighbor* nbrWithID(const GLint id);
-        Neighbor* nbrWithGradient(const Vector grad);
-        Neighbor* nbrWithMinGradient(const Vector c = Vector());
-        Neighbor* nbrWithMaxGradient(const Vector c = Vector());
+        Neighbor* nbrWithGradient(const Vec2f grad);
+        Neighbor* nbrWithMinGradient(const Vec2f c = Vec2f());
+        Neighbor* nbrWithMaxGradient(const Vec2f c = Vec2f());
 
         // <public neighbor list member functions>
         void sortByID();
-        void sortByGradient(const Vector c = Vector());
-        void sortByDistance(const Vector c = Vector());
-        void sortByAngle(const Vector c = Vector());
-        void sortByAbsAngle(const Vector c = Vector());
+        void sortByGradient(const Vec2f c = Vec2f());
+        void sortByDistance(const Vec2f c = Vec2f());
+        void sortByAngle(const Vec2f c = Vec2f());
+        void sortByAbsAngle(const Vec2f c = Vec2f());
+
+        // <overloaded operators>
+        Neighborhood& operator =(const Neighborhood &nh);
 };  // Neighborhood
 #endif
@@ -0,0 +1,235 @@
+//
+// Filename:        "OdometryFeed.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements a handoff of the wheel odometry that
+//                  the robots report, from the thread that parses their
+//                  replies to the one thread that steps the environment,
+//                  keeping only the newest timestamped sample of each robot.
+//
+
+// preprocessor directives
+#include "OdometryFeed.h"
+
+
+
+// <constructors>
+
+//
+// OdometryFeed()
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this feed to no odometry.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+OdometryFeed::OdometryFeed()
+    : routes(NULL), metrics(NULL), nFrames(0), nDropped(0)
+{
+    for (GLint i = 0; i < MAX_ODOMETRY_ROBOTS; ++i)
+    {
+        WheelOdometry &o = odometry[i];
+        o.timestamp   = 0;
+        o.left        = o.right      = 0;
+        o.leftSpeed   = o.rightSpeed = 0.0f;
+        o.hasPosition = false;
+        o.nSamples    = o.nAcks      = 0;
+        nRead[i]      = 0;
+    }
+}   // OdometryFeed()
+
+
+
+// <public mutator functions>
+
+//
+// bool setRoutingTable(t)
+// Last modified: 17Oct2026
+//
+// Attempts to set the table that tells which robot each frame came from
+// by its port and address (if NULL, the robot of the same ID as its
+// address, or as its port if unaddressed), returning true if successful,
+// false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      t       in      the routing table (default none)
+//
+bool OdometryFeed::setRoutingTable(const RoutingTable *t)
+{
+    lock_guard<mutex> lock(feedMutex);
+    routes = t;
+    return true;
+}   // setRoutingTable(const RoutingTable *)
+
+
+
+//
+// bool setMetrics(m)
+// Last modified: 17Oct2026
+//
+// Attempts to set the registry that each acknowledgement is matched to
+// the command it answers in, and each dropped frame counted in (none if
+// NULL), returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      m       in      the registry of the health of the links
+//
+bool OdometryFeed::setMetrics(LinkMetrics *m)
+{
+    lock_guard<mutex> lock(feedMutex);
+    metrics = m;
+    return true;
+}   // setMetrics(LinkMetrics *)
+
+
+
+//
+// bool read(ID, o)
+// Last modified: 17Oct2026
+//
+// Attempts to take the odometry of the parameterized robot if it has
+// reported its wheel speeds since the last read,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if there was a new sample, false otherwise
+// Parameters:
+//      ID      in      the ID of the robot
+//      o       out     the odometry of the robot
+//
+bool OdometryFeed::read(const GLint ID, WheelOdometry &o)
+{
+    if ((ID < 0) || (ID >= MAX_ODOMETRY_ROBOTS)) return false;
+    lock_guard<mutex> lock(feedMutex);
+    if (odometry[ID].nSamples == nRead[ID]) return false;
+    nRead[ID] = odometry[ID].nSamples;
+    o         = odometry[ID];
+    return true;
+}   // read(const GLint, WheelOdometry &)
+
+
+
+// <public accessor functions>
+
+//
+// bool getOdometry(ID, o) const
+// Last modified: 17Oct2026
+//
+// Attempts to get the odometry of the parameterized robot (read or not),
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      ID      in      the ID of the robot
+//      o       out     the odometry of the robot
+//
+bool OdometryFeed::getOdometry(const GLint ID, WheelOdometry &o) const
+{
+    if ((ID < 0) || (ID >= MAX_ODOMETRY_ROBOTS)) return false;
+    lock_guard<mutex> lock(feedMutex);
+    o = odometry[ID];
+    return true;
+}   // getOdometry(const GLint, WheelOdometry &) const
+
+
+
+//
+// long getNFrames() const
+// Last modified: 17Oct2026
+//
+// Returns the number of frames received so far.
+//
+// Returns:     the number of frames received so far
+// Parameters:  <none>
+//
+long OdometryFeed::getNFrames() const
+{
+    lock_guard<mutex> lock(feedMutex);
+    return nFrames;
+}   // getNFrames() const
+
+
+
+//
+// long getNDropped() const
+// Last modified: 17Oct2026
+//
+// Returns the number of frames dropped so far (from unknown robots,
+// or of unknown types).
+//
+// Returns:     the number of frames dropped so far
+// Parameters:  <none>
+//
+long OdometryFeed::getNDropped() const
+{
+    lock_guard<mutex> lock(feedMutex);
+    return nDropped;
+}   // getNDropped() const
+
+
+
+// <virtual public utility functions>
+
+//
+// void frameParsed(f)
+// Last modified: 17Oct2026
+//
+// Records the parameterized frame as the odometry of the robot it came
+// from (as routed to its port and address, or the robot of its port if
+// there is no routing table), timing acknowledgements and
+// counting dropped frames in the registry (if any).
+// Reported wheel positions are turned into wheel speeds over the time
+// since the previous positions.
+//
+// Returns:     <none>
+// Parameters:
+//      f       in      the parsed frame
+//
+void OdometryFeed::frameParsed(const TelemetryFrame &f)
+{
+    lock_guard<mutex> lock(feedMutex);
+    GLint ID = (routes == NULL) ? f.port : routes->getID(f.port, f.address);
+    ++nFrames;
+    if ((ID < 0) || (ID >= MAX_ODOMETRY_ROBOTS))
+    {
+        ++nDropped;
+        if (metrics != NULL) metrics->frameDiscarded(f.port);
+        return;
+    }
+    WheelOdometry &o = odometry[ID];
+    if (f.type == TELEMETRY_ACK)
+    {
+        ++o.nAcks;
+        if (metrics != NULL) metrics->ackReceived(f.port, ID, f.timestamp);
+    }
+    else if ((f.type == TELEMETRY_SPEED) && (f.nValues >= 2))
+    {
+        o.leftSpeed  = (GLfloat)f.values[0];
+        o.rightSpeed = (GLfloat)f.values[1];
+        o.timestamp  = f.timestamp;
+        ++o.nSamples;
+    }
+    else if ((f.type == TELEMETRY_POSITION) && (f.nValues >= 2))
+    {
+        if ((o.hasPosition) && (f.timestamp > o.timestamp))
+        {
+            GLfloat dt   = (GLfloat)(f.timestamp - o.timestamp) * 1.0e-6f;
+            o.leftSpeed  = (GLfloat)(f.values[0] - o.left)  / dt;
+            o.rightSpeed = (GLfloat)(f.values[1] - o.right) / dt;
+            ++o.nSamples;
+        }
+        o.left        = f.values[0];
+        o.right       = f.values[1];
+        o.hasPosition = true;
+        o.timestamp   = f.timestamp;
+    }
+    else
+    {
+        ++nDropped;
+        if (metrics != NULL) metrics->frameDiscarded(f.port);
+    }
+}   // frameParsed(const TelemetryFrame &)
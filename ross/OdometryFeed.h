@@ -0,0 +1,77 @@
+//
+// Filename:        "OdometryFeed.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes a handoff of the wheel odometry that
+//                  the robots report, from the thread that parses their
+//                  replies to the one thread that steps the environment,
+//                  keeping only the newest timestamped sample of each robot.
+//
+
+// preprocessor directives
+#ifndef ODOMETRY_FEED_H
+#define ODOMETRY_FEED_H
+#include <mutex>
+#include "RoutingTable.h"
+#include "TelemetryParser.h"
+using namespace std;
+
+// global constants
+static const GLint MAX_ODOMETRY_ROBOTS = 32;   // robots with odometry
+
+//
+// WheelOdometry
+//
+// Describes the wheels of a robot as last reported.
+//
+struct WheelOdometry
+{
+    long long timestamp;            // arrival (in microseconds)
+    GLint     left, right;          // wheel positions (in steps)
+    GLfloat   leftSpeed;            // wheel speeds (in steps per second)
+    GLfloat   rightSpeed;
+    bool      hasPosition;          // true if the positions were reported
+    long      nSamples;             // the number of speed samples so far
+    long      nAcks;                // the drive commands acknowledged
+};  // WheelOdometry
+
+class OdometryFeed: public TelemetryListener
+{
+
+    public:
+
+        // <constructors>
+        OdometryFeed();
+
+        // <public mutator functions>
+        bool setRoutingTable(const RoutingTable *t = NULL);
+        bool setMetrics(LinkMetrics *m = NULL);
+        bool read(const GLint ID, WheelOdometry &o);
+
+        // <public accessor functions>
+        bool getOdometry(const GLint ID, WheelOdometry &o) const;
+        long getNFrames()  const;
+        long getNDropped() const;
+
+        // <virtual public utility functions>
+        virtual void frameParsed(const TelemetryFrame &f);
+
+    protected:
+
+        // <protected data members>
+        const RoutingTable *routes;     // the robot of each port and address
+        LinkMetrics        *metrics;    // times the acknowledgements
+        WheelOdometry       odometry[MAX_ODOMETRY_ROBOTS];
+        long                nRead[MAX_ODOMETRY_ROBOTS];   // samples read
+        long                nFrames, nDropped;
+        mutable mutex       feedMutex;
+
+    private:
+
+        // <private constructors>
+        OdometryFeed(const OdometryFeed &);
+        OdometryFeed& operator =(const OdometryFeed &);
+};  // OdometryFeed
+#endif
@@ -2,7 +2,7 @@
 // Filename:        "Packet.h"
 //
 // Programmer:      Ross Mead
-// Last modified:   07Sep2006
+// Last modified:   17Oct2026
 //
 // Description:     This structure defines a message packet.
 //
@@ -10,54 +10,108 @@
 // preprocessor directives
 #ifndef PACKET_H
 #define PACKET_H
-#include "../GL/glut.h"
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "GLTypes.h"
+#include "State.h"
 using namespace std;
 
 // global constants
-static const GLint ID_OPERATOR  = -1;
-static const GLint ID_BROADCAST = -2;
+static const size_t PACKET_PAYLOAD_SIZE  =
+    (sizeof(State) > sizeof(Formation)) ? sizeof(State) : sizeof(Formation);
+static const size_t PACKET_PAYLOAD_ALIGN =
+    (alignment_of<State>::value > alignment_of<Formation>::value)
+        ? alignment_of<State>::value : alignment_of<Formation>::value;
 
-// Refer to a pointer to void as the data of a message.
-typedef void* Message;
+// Describes the kind of message carried inline by a packet.
+enum PayloadType {NO_PAYLOAD, STATE_PAYLOAD, FORMATION_PAYLOAD};
 
 struct Packet
 {
 
     // <data members>
-    Message msg;
-    GLint   toID, fromID, type;
+    GLint toID, fromID, type;
 
 
 
     // <constructors>
 
     //
-    // Packet(m, to, from, t)
-    // Last modified: 04Sep2006
+    // Packet(to, from, t)
+    // Last modified: 17Oct2026
     //
-    // Default constructor that initializes
-    // this packet to the parameterized values.
+    // Default constructor that initializes this packet
+    // to the parameterized values without a message.
     //
     // Returns:     <none>
     // Parameters:
-    //      m       in      the default message
     //      to      in      the default ID of the message recipient
     //      from    in      the default ID of the message sender
     //      t       in      the default message type
     //
-    Packet(const Message m    = NULL,
-           const GLint   to   = ID_BROADCAST,
-           const GLint   from = ID_OPERATOR,
-           const GLint   t    = 0)
-        : msg(m), toID(to), fromID(from), type(t)
+    Packet(const GLint to   = ID_BROADCAST,
+           const GLint from = ID_OPERATOR,
+           const GLint t    = 0)
+        : toID(to), fromID(from), type(t), payloadType(NO_PAYLOAD)
     {
-    }   // Packet(const Message, const GLint, const GLint, const GLint)
+    }   // Packet(const GLint, const GLint, const GLint)
+
+
+
+    //
+    // Packet(s, to, from, t)
+    // Last modified: 17Oct2026
+    //
+    // Constructor that initializes this packet to the parameterized
+    // values, copying the parameterized state into the packet.
+    //
+    // Returns:     <none>
+    // Parameters:
+    //      s       in      the state being sent
+    //      to      in      the ID of the message recipient
+    //      from    in      the ID of the message sender
+    //      t       in      the message type
+    //
+    Packet(const State &s,
+           const GLint  to   = ID_BROADCAST,
+           const GLint  from = ID_OPERATOR,
+           const GLint  t    = 0)
+        : toID(to), fromID(from), type(t), payloadType(STATE_PAYLOAD)
+    {
+        new (&payload) State(s);
+    }   // Packet(const State &, const GLint, const GLint, const GLint)
+
+
+
+    //
+    // Packet(f, to, from, t)
+    // Last modified: 17Oct2026
+    //
+    // Constructor that initializes this packet to the parameterized
+    // values, copying the parameterized formation into the packet.
+    //
+    // Returns:     <none>
+    // Parameters:
+    //      f       in      the formation being sent
+    //      to      in      the ID of the message recipient
+    //      from    in      the ID of the message sender
+    //      t       in      the message type
+    //
+    Packet(const Formation &f,
+           const GLint      to   = ID_BROADCAST,
+           const GLint      from = ID_OPERATOR,
+           const GLint      t    = 0)
+        : toID(to), fromID(from), type(t), payloadType(FORMATION_PAYLOAD)
+    {
+        new (&payload) Formation(f);
+    }   // Packet(const Formation &, const GLint, const GLint, const GLint)
 
 
 
     //
     // Packet(p)
-    // Last modified: 12Aug2006
+    // Last modified: 17Oct2026
     //
     // Copy constructor that copies the contents of
     // the parameterized packet into this packet.
@@ -67,17 +121,39 @@ struct Packet
     //      p       in/out      the packet being copied
     //
     Packet(const Packet &p)
-        : msg(p.msg), toID(p.toID), fromID(p.fromID), type(p.type)
+        : toID(p.toID), fromID(p.fromID), type(p.type),
+          payloadType(NO_PAYLOAD)
     {
+        copyPayload(p);
     }   // Packet(const Packet &)
 
 
 
+    //
+    // Packet(p)
+    // Last modified: 17Oct2026
+    //
+    // Move constructor that moves the contents of the parameterized
+    // packet into this packet, leaving it without a message.
+    //
+    // Returns:     <none>
+    // Parameters:
+    //      p       in/out      the packet being moved
+    //
+    Packet(Packet &&p)
+        : toID(p.toID), fromID(p.fromID), type(p.type),
+          payloadType(NO_PAYLOAD)
+    {
+        movePayload(p);
+    }   // Packet(Packet &&)
+
+
+
     // <destructors>
-    
+
     //
     // ~Packet()
-    // Last modified: 07Sep2006
+    // Last modified: 17Oct2026
     //
     // Destructor that clears this packet.
     //
@@ -86,10 +162,64 @@ struct Packet
     //
     ~Packet()
     {
+        clearPayload();
     }   // ~Packet()
 
 
 
+    // <accessor functions>
+
+    //
+    // State* getState()
+    // Last modified: 17Oct2026
+    //
+    // Returns the state carried by this packet, NULL if it carries none.
+    //
+    // Returns:     the state carried by this packet
+    // Parameters:  <none>
+    //
+    State* getState()
+    {
+        return (payloadType == STATE_PAYLOAD)
+            ? reinterpret_cast<State *>(&payload) : NULL;
+    }   // getState()
+
+
+
+    //
+    // Formation* getFormation()
+    // Last modified: 17Oct2026
+    //
+    // Returns the formation carried by this packet,
+    // NULL if it carries none.
+    //
+    // Returns:     the formation carried by this packet
+    // Parameters:  <none>
+    //
+    Formation* getFormation()
+    {
+        return (payloadType == FORMATION_PAYLOAD)
+            ? reinterpret_cast<Formation *>(&payload) : NULL;
+    }   // getFormation()
+
+
+
+    //
+    // PayloadType getPayloadType() const
+    // Last modified: 17Oct2026
+    //
+    // Returns the kind of message carried by this packet.
+    //
+    // Returns:     the kind of message carried by this packet
+    // Parameters:  <none>
+    //
+    PayloadType getPayloadType() const
+    {
+        return payloadType;
+    }   // getPayloadType() const
+
+
+
     // <utility functions>
 
     //
@@ -121,5 +251,135 @@ struct Packet
     {
         return fromID == ID_BROADCAST;
     }   // fromBroadcast() const
+
+
+
+    // <overloaded operators>
+
+    //
+    // Packet& =(p)
+    // Last modified: 17Oct2026
+    //
+    // Copies the contents of the parameterized packet into this packet.
+    //
+    // Returns:     this packet
+    // Parameters:
+    //      p       in/out      the packet being copied
+    //
+    Packet& operator =(const Packet &p)
+    {
+        if (this == &p) return *this;
+        toID   = p.toID;
+        fromID = p.fromID;
+        type   = p.type;
+        copyPayload(p);
+        return *this;
+    }   // =(const Packet &)
+
+
+
+    //
+    // Packet& =(p)
+    // Last modified: 17Oct2026
+    //
+    // Moves the contents of the parameterized packet into this packet,
+    // leaving it without a message.
+    //
+    // Returns:     this packet
+    // Parameters:
+    //      p       in/out      the packet being moved
+    //
+    Packet& operator =(Packet &&p)
+    {
+        if (this == &p) return *this;
+        toID   = p.toID;
+        fromID = p.fromID;
+        type   = p.type;
+        movePayload(p);
+        return *this;
+    }   // =(Packet &&)
+
+    protected:
+
+    // <protected data members>
+    PayloadType payloadType;
+    aligned_storage<PACKET_PAYLOAD_SIZE, PACKET_PAYLOAD_ALIGN>::type payload;
+
+
+
+    // <protected utility functions>
+
+    //
+    // void copyPayload(p)
+    // Last modified: 17Oct2026
+    //
+    // Replaces the message of this packet with
+    // a copy of the message of the parameterized packet.
+    //
+    // Returns:     <none>
+    // Parameters:
+    //      p       in/out      the packet whose message is copied
+    //
+    void copyPayload(const Packet &p)
+    {
+        const State     *s = reinterpret_cast<const State *>(&p.payload);
+        const Formation *f = reinterpret_cast<const Formation *>(&p.payload);
+        if ((payloadType == STATE_PAYLOAD) && (p.payloadType == STATE_PAYLOAD))
+            *getState() = *s;
+        else if ((payloadType   == FORMATION_PAYLOAD) &&
+                 (p.payloadType == FORMATION_PAYLOAD))
+            *getFormation() = *f;
+        else
+        {
+            clearPayload();
+            if      (p.payloadType == STATE_PAYLOAD)
+                new (&payload) State(*s);
+            else if (p.payloadType == FORMATION_PAYLOAD)
+                new (&payload) Formation(*f);
+            payloadType = p.payloadType;
+        }
+    }   // copyPayload(const Packet &)
+
+
+
+    //
+    // void movePayload(p)
+    // Last modified: 17Oct2026
+    //
+    // Replaces the message of this packet with the message
+    // of the parameterized packet, leaving it without a message.
+    //
+    // Returns:     <none>
+    // Parameters:
+    //      p       in/out      the packet whose message is moved
+    //
+    void movePayload(Packet &p)
+    {
+        clearPayload();
+        if      (p.payloadType == STATE_PAYLOAD)
+            new (&payload) State(std::move(*p.getState()));
+        else if (p.payloadType == FORMATION_PAYLOAD)
+            new (&payload) Formation(std::move(*p.getFormation()));
+        payloadType = p.payloadType;
+        p.clearPayload();
+    }   // movePayload(Packet &)
+
+
+
+    //
+    // void clearPayload()
+    // Last modified: 17Oct2026
+    //
+    // Destroys the message carried by this packet, if any.
+    //
+    // Returns:     <none>
+    // Parameters:  <none>
+    //
+    void clearPayload()
+    {
+        if      (payloadType == STATE_PAYLOAD)     getState()->~State();
+        else if (payloadType == FORMATION_PAYLOAD) getFormation()->~Formation();
+        payloadType = NO_PAYLOAD;
+    }   // clearPayload()
 };  // Packet
 #endif
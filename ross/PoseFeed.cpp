@@ -0,0 +1,141 @@
+//
+// Filename:        "PoseFeed.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements a lock-free handoff of the poses
+//                  of the robots seen in each camera frame, from the one
+//                  thread that locates them to the one thread that steps
+//                  the environment (which only ever sees the newest),
+//                  or of the poses the environment expects them to have.
+//
+
+// preprocessor directives
+#include "PoseFeed.h"
+
+// global constants
+static const int POSE_FEED_FRESH = 4;  // marks an unread latest frame
+static const int POSE_FEED_INDEX = 3;  // masks the index of a frame
+
+
+
+// <constructors>
+
+//
+// PoseFeed()
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this feed to three empty frames,
+// one for the producer to write, one for the consumer to read, and the
+// newest published one (which the two swap their own with).
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+PoseFeed::PoseFeed()
+    : writeIndex(0), readIndex(1), latestIndex(2), nPublished(0)
+{
+    for (GLint i = 0; i < 3; ++i)
+    {
+        frames[i].number = -1;
+        frames[i].n      = 0;
+    }
+}   // PoseFeed()
+
+
+
+// <public mutator functions>
+
+//
+// PoseFrame* getWriteFrame()
+// Last modified: 17Oct2026
+//
+// Returns the frame that the producer fills before publishing it,
+// which no other thread touches until then.
+//
+// Returns:     the frame to be published next
+// Parameters:  <none>
+//
+PoseFrame* PoseFeed::getWriteFrame()
+{
+    return &frames[writeIndex];
+}   // getWriteFrame()
+
+
+
+//
+// bool publish()
+// Last modified: 17Oct2026
+//
+// Publishes the write frame as the newest frame (replacing an unread one),
+// taking the previous newest frame to write next, returning true if the
+// replaced frame had been read, false otherwise.
+//
+// Returns:     true if the replaced frame had been read, false otherwise
+// Parameters:  <none>
+//
+bool PoseFeed::publish()
+{
+    int prev   = latestIndex.exchange(writeIndex | POSE_FEED_FRESH,
+                                      memory_order_acq_rel);
+    writeIndex = prev & POSE_FEED_INDEX;
+    nPublished.fetch_add(1, memory_order_relaxed);
+    return (prev & POSE_FEED_FRESH) == 0;
+}   // publish()
+
+
+
+//
+// const PoseFrame* read()
+// Last modified: 17Oct2026
+//
+// Takes the newest frame if it has not been read yet, which stays
+// untouched by the producer until the next read.
+//
+// Returns:     the newest frame if unread, NULL otherwise
+// Parameters:  <none>
+//
+const PoseFrame* PoseFeed::read()
+{
+    if ((latestIndex.load(memory_order_relaxed) & POSE_FEED_FRESH) == 0)
+        return NULL;
+    readIndex = latestIndex.exchange(readIndex, memory_order_acq_rel) &
+                POSE_FEED_INDEX;
+    return &frames[readIndex];
+}   // read()
+
+
+
+// <public accessor functions>
+
+//
+// bool isFresh() const
+// Last modified: 17Oct2026
+//
+// Returns true if a frame has been published since the last read,
+// false otherwise.
+//
+// Returns:     true if a frame is waiting to be read, false otherwise
+// Parameters:  <none>
+//
+bool PoseFeed::isFresh() const
+{
+    return (latestIndex.load(memory_order_acquire) & POSE_FEED_FRESH) != 0;
+}   // isFresh() const
+
+
+
+//
+// long getNPublished() const
+// Last modified: 17Oct2026
+//
+// Returns the number of frames published so far.
+//
+// Returns:     the number of frames published so far
+// Parameters:  <none>
+//
+long PoseFeed::getNPublished() const
+{
+    return nPublished.load(memory_order_relaxed);
+}   // getNPublished() const
@@ -0,0 +1,83 @@
+//
+// Filename:        "PoseFeed.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes a lock-free handoff of the poses
+//                  of the robots seen in each camera frame, from the one
+//                  thread that locates them to the one thread that steps
+//                  the environment (which only ever sees the newest),
+//                  or of the poses the environment expects them to have.
+//
+
+// preprocessor directives
+#ifndef POSE_FEED_H
+#define POSE_FEED_H
+#include <atomic>
+#include <cstddef>
+#include "GLTypes.h"
+using namespace std;
+
+// global constants
+static const GLint MAX_POSE_ESTIMATES = 32;    // robots per camera frame
+
+//
+// PoseEstimate
+//
+// Describes the pose of a robot as seen by the camera
+// (and how it is being driven, if known).
+//
+struct PoseEstimate
+{
+    GLfloat x, y;       // position (in camera pixels, y downwards)
+    GLfloat heading;    // heading (in degrees, counterclockwise from +x)
+    GLfloat transVel;   // forward speed (in camera pixels per second)
+    GLfloat rotVel;     // turning speed (in degrees per second)
+};  // PoseEstimate
+
+//
+// PoseFrame
+//
+// Describes the poses of the robots seen in a camera frame.
+//
+struct PoseFrame
+{
+    long         number;                         // the camera frame
+    GLint        n;                              // the number of estimates
+    PoseEstimate estimates[MAX_POSE_ESTIMATES];  // the estimates
+};  // PoseFrame
+
+class PoseFeed
+{
+
+    public:
+
+        // <constructors>
+        PoseFeed();
+
+        // <public mutator functions>
+        PoseFrame*       getWriteFrame();
+        bool             publish();
+        const PoseFrame* read();
+
+        // <public accessor functions>
+        bool isFresh()        const;
+        long getNPublished()  const;
+
+    protected:
+
+        // <protected data members>
+        PoseFrame    frames[3];
+        GLint        writeIndex;        // owned by the producer
+        GLint        readIndex;         // owned by the consumer
+        atomic<int>  latestIndex;       // the newest published frame
+        atomic<long> nPublished;
+
+    private:
+
+        // <private constructors>
+        PoseFeed(const PoseFeed &);
+        PoseFeed& operator =(const PoseFeed &);
+};  // PoseFeed
+#endif
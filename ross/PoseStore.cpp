@@ -0,0 +1,179 @@
+//
+// Filename:        "PoseStore.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements the poses and velocities
+//                  of a swarm of robots, stored as parallel arrays.
+//
+
+// preprocessor directives
+#include "PoseStore.h"
+
+
+
+// <constructors>
+
+//
+// PoseStore(n)
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this store
+// to the parameterized number of resting robots.
+//
+// Returns:     <none>
+// Parameters:
+//      n       in      the number of robots
+//
+PoseStore::PoseStore(const GLint n)
+{
+    setSize(n);
+}   // PoseStore(const GLint)
+
+
+
+// <public mutator functions>
+
+//
+// bool setSize(n)
+// Last modified: 17Oct2026
+//
+// Attempts to resize this store to the parameterized number of robots
+// (keeping the poses of the robots that remain),
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      n       in      the number of robots
+//
+bool PoseStore::setSize(const GLint n)
+{
+    if (n < 0) return false;
+    x.resize(n, 0.0f);
+    y.resize(n, 0.0f);
+    heading.resize(n, 0.0f);
+    transVel.resize(n, 0.0f);
+    rotVel.resize(n, 0.0f);
+    return true;
+}   // setSize(const GLint)
+
+
+
+//
+// bool setPose(i, dx, dy, theta)
+// Last modified: 17Oct2026
+//
+// Attempts to set the pose of the robot at the parameterized index,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      i       in      the index of the robot
+//      dx      in      the x-coordinate to be set to
+//      dy      in      the y-coordinate to be set to
+//      theta   in      the heading (in degrees) to be set to
+//
+bool PoseStore::setPose(const GLint   i,
+                        const GLfloat dx,
+                        const GLfloat dy,
+                        const GLfloat theta)
+{
+    if ((i < 0) || (i >= getSize())) return false;
+    x[i]       = dx;
+    y[i]       = dy;
+    heading[i] = theta;
+    return true;
+}   // setPose(const GLint, const GLfloat, const GLfloat, const GLfloat)
+
+
+
+//
+// bool setVelocity(i, tv, rv)
+// Last modified: 17Oct2026
+//
+// Attempts to set the velocities of the robot at the parameterized index,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      i       in      the index of the robot
+//      tv      in      the translational velocity to be set to
+//      rv      in      the angular velocity (in degrees per step)
+//
+bool PoseStore::setVelocity(const GLint i, const GLfloat tv, const GLfloat rv)
+{
+    if ((i < 0) || (i >= getSize())) return false;
+    transVel[i] = tv;
+    rotVel[i]   = rv;
+    return true;
+}   // setVelocity(const GLint, const GLfloat, const GLfloat)
+
+
+
+// <public accessor functions>
+
+//
+// GLint getSize() const
+// Last modified: 17Oct2026
+//
+// Returns the number of robots in this store.
+//
+// Returns:     the number of robots in this store
+// Parameters:  <none>
+//
+GLint PoseStore::getSize() const
+{
+    return (GLint)x.size();
+}   // getSize() const
+
+
+
+// <public utility functions>
+
+//
+// void integrate()
+// Last modified: 17Oct2026
+//
+// Moves every robot one step forward along its heading by its
+// translational velocity, then turns it by its angular velocity.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void PoseStore::integrate()
+{
+    const GLint n = getSize();
+    if (n == 0) return;
+    GLfloat       *px = &x[0], *py = &y[0], *ph = &heading[0];
+    const GLfloat *tv = &transVel[0], *rv = &rotVel[0];
+    for (GLint i = 0; i < n; ++i)
+    {
+        GLfloat theta = degreesToRadians(ph[i]);
+        px[i] += tv[i] * cos(theta);
+        py[i] += tv[i] * sin(theta);
+        ph[i]  = scaleDegrees(ph[i] + rv[i]);
+    }
+}   // integrate()
+
+
+
+//
+// Vec2f getRelationship(to, from) const
+// Last modified: 17Oct2026
+//
+// Returns the relationship from the robot at the parameterized
+// from index to the robot at the parameterized to index,
+// relative to the heading of the robot being related from.
+//
+// Returns:     the relationship between the two robots
+// Parameters:
+//      to      in      the index of the robot being related to
+//      from    in      the index of the robot being related from
+//
+Vec2f PoseStore::getRelationship(const GLint to, const GLint from) const
+{
+    if ((to   < 0) || (to   >= getSize()) ||
+        (from < 0) || (from >= getSize())) return Vec2f();
+    return Vec2f(x[to] - x[from], y[to] - y[from]).rotated(-heading[from]);
+}   // getRelationship(const GLint, const GLint) const
@@ -0,0 +1,47 @@
+//
+// Filename:        "PoseStore.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes the poses and velocities
+//                  of a swarm of robots, stored as parallel arrays.
+//
+
+// preprocessor directives
+#ifndef POSE_STORE_H
+#define POSE_STORE_H
+#include <vector>
+#include "Vec.h"
+using namespace std;
+
+class PoseStore
+{
+
+    public:
+
+        // <public data members>
+        vector<GLfloat> x, y;       // positions of the robots
+        vector<GLfloat> heading;    // headings (in degrees) of the robots
+        vector<GLfloat> transVel;   // translational velocities of the robots
+        vector<GLfloat> rotVel;     // angular velocities (in degrees per step)
+
+        // <constructors>
+        PoseStore(const GLint n = 0);
+
+        // <public mutator functions>
+        bool setSize(const GLint n);
+        bool setPose(const GLint   i,
+                     const GLfloat dx,
+                     const GLfloat dy,
+                     const GLfloat theta);
+        bool setVelocity(const GLint i, const GLfloat tv, const GLfloat rv);
+
+        // <public accessor functions>
+        GLint getSize() const;
+
+        // <public utility functions>
+        void  integrate();
+        Vec2f getRelationship(const GLint to, const GLint from) const;
+};  // PoseStore
+#endif
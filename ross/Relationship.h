@@ -11,19 +11,21 @@
 // preprocessor directives
 #ifndef RELATIONSHIP_H
 #define RELATIONSHIP_H
-#include "../GL/glut.h"
-#include "Packet.h"
-#include "Vector.h"
+#include "GLTypes.h"
+#include "ArrayList.h"
+#include "Vec.h"
 using namespace std;
 
 // global constants
-static const GLint ID_NO_NBR = ID_BROADCAST;
+static const GLint ID_OPERATOR  = -1;
+static const GLint ID_BROADCAST = -2;
+static const GLint ID_NO_NBR    = ID_BROADCAST;
 
 struct Relationship
 {
 
     // <data members>
-    Vector relDesired, relActual;
+    Vec2f  relDesired, relActual;
     GLint  ID;
 
 
@@ -43,19 +45,19 @@ struct Relationship
     //      actual  in      the default actual relationship
     //      id      in      the default ID
     //
-    Relationship(const Vector desired  = Vector(),
-                 const Vector actual   = Vector(),
+    Relationship(const Vec2f  desired  = Vec2f(),
+                 const Vec2f  actual   = Vec2f(),
                  const GLint  id       = ID_NO_NBR)
         : relDesired(desired), relActual(actual), ID(id)
     {
-    }   // Relationship(const Vector, const Vector, const GLint)
+    }   // Relationship(const Vec2f, const Vec2f, const GLint)
 
 
 
     // <utility functions>
 
     //
-    // Vector getError(desired, actual, id)
+    // Vec2f getError(desired, actual, id)
     // Last modified: 12Aug2006
     //
     // Returns the difference (error) between desired and actual relationships.
@@ -63,7 +65,7 @@ struct Relationship
     // Returns:     difference between desired and actual relationships
     // Parameters:  <none>
     //
-    Vector getError()
+    Vec2f getError()
     {
         return relDesired - relActual;
     }   // getError()
@@ -84,12 +86,12 @@ struct Relationship
     //      rels    in/out  the list of relationships
     //      id      in      the ID of the relationship to be found
     //
-    friend Relationship* relWithID(const LinkedList<Relationship> &rels,
-                                   const GLint                     id)
+    friend Relationship* relWithID(const ArrayList<Relationship> &rels,
+                                   const GLint                    id)
     {
         for (GLint i = 0; i < rels.getSize(); ++i)
             if (rels[i].ID == id) return &rels[i];
         return NULL;
-    }   // relWithID(const LinkedList<Relationship> &, const GLint)
+    }   // relWithID(const ArrayList<Relationship> &, const GLint)
 };  // Relationship
 #endif
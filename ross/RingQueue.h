@@ -0,0 +1,701 @@
+//
+// Filename:        "RingQueue.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// This library of classes describes and implements bounded,
+// preallocated queues of items stored in a ring buffer that
+// may be shared between threads without locking.
+//
+
+
+
+//
+// <SpscQueue>
+// Last modified:   17Oct2026
+//
+// This class describes a bounded queue of items that one thread may
+// enqueue into while one (other) thread dequeues from.  All slots
+// are allocated up front, so enqueueing and dequeueing never allocate.
+//
+// <MpscQueue>
+// Last modified:   17Oct2026
+//
+// This class describes a bounded queue of items that any number of
+// threads may enqueue into while one thread dequeues from.  Each slot
+// carries a sequence number that tells producers and the consumer
+// whether the slot is free or filled.
+//
+// Copying either queue copies its queued items, and must not be done
+// while another thread is using the queue being copied.
+//
+
+// preprocessor directives
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+#include <atomic>
+#include <cstddef>
+#include <utility>
+using namespace std;
+
+// global constants
+static const int RING_QUEUE_CACHE_LINE   = 64;
+static const int DEFAULT_RING_QUEUE_SIZE = 16;
+
+//
+// int ringQueueCapacity(n)
+// Last modified: 17Oct2026
+//
+// Returns the smallest power of two that is at least the
+// parameterized size (and at least 2).
+//
+// Returns:     the capacity of a ring of the parameterized size
+// Parameters:
+//      n       in      the requested size of the ring
+//
+inline int ringQueueCapacity(const int n)
+{
+    int capacity = 2;
+    while (capacity < n) capacity <<= 1;
+    return capacity;
+}   // ringQueueCapacity(const int)
+
+template <class T>
+class SpscQueue
+{
+
+    public:
+
+        // <constructors>
+        SpscQueue(const int n = DEFAULT_RING_QUEUE_SIZE);
+        SpscQueue(const SpscQueue<T> &q);
+
+        // <destructors>
+        ~SpscQueue();
+
+        // <public mutator functions>
+        bool enqueue(const T &item);
+        bool dequeue();
+        bool dequeue(T &item);
+        void clear();
+
+        // <public accessor functions>
+        int  getSize()     const;
+        int  getCapacity() const;
+        bool isEmpty()     const;
+        bool isFull()      const;
+
+        // <overloaded operators>
+        SpscQueue<T>& operator =(const SpscQueue<T> &q);
+
+    protected:
+
+        // <protected data members>
+        T                     *items;
+        unsigned int           mask;
+        char                   pad0[RING_QUEUE_CACHE_LINE];
+        atomic<unsigned int>   head;   // next slot to dequeue (consumer)
+        char                   pad1[RING_QUEUE_CACHE_LINE];
+        atomic<unsigned int>   tail;   // next slot to enqueue (producer)
+        char                   pad2[RING_QUEUE_CACHE_LINE];
+};  // SpscQueue<T>
+
+template <class T>
+class MpscQueue
+{
+
+    public:
+
+        // <constructors>
+        MpscQueue(const int n = DEFAULT_RING_QUEUE_SIZE);
+        MpscQueue(const MpscQueue<T> &q);
+
+        // <destructors>
+        ~MpscQueue();
+
+        // <public mutator functions>
+        bool enqueue(const T &item);
+        bool dequeue();
+        bool dequeue(T &item);
+        void clear();
+
+        // <public accessor functions>
+        int  getSize()     const;
+        int  getCapacity() const;
+        bool isEmpty()     const;
+
+        // <overloaded operators>
+        MpscQueue<T>& operator =(const MpscQueue<T> &q);
+
+    protected:
+
+        // <protected data types>
+        struct Slot
+        {
+            atomic<unsigned int> seq;
+            T                    item;
+        };  // Slot
+
+        // <protected data members>
+        Slot                  *slots;
+        unsigned int           mask;
+        char                   pad0[RING_QUEUE_CACHE_LINE];
+        atomic<unsigned int>   head;   // next slot to dequeue (consumer)
+        char                   pad1[RING_QUEUE_CACHE_LINE];
+        atomic<unsigned int>   tail;   // next slot to claim (producers)
+        char                   pad2[RING_QUEUE_CACHE_LINE];
+
+        // <protected utility functions>
+        void init(const int n);
+};  // MpscQueue<T>
+
+
+
+//
+// <SpscQueue>
+// Last modified: 17Oct2026
+//
+// This class implements a bounded single-producer, single-consumer queue.
+//
+
+
+
+// <constructors>
+
+//
+// SpscQueue(n)
+// Last modified: 17Oct2026
+//
+// Default constructor that preallocates room for
+// (at least) the parameterized number of items.
+//
+// Returns:     <none>
+// Parameters:
+//      n       in      the number of items the queue can hold
+//
+template <class T>
+SpscQueue<T>::SpscQueue(const int n)
+    : items(new T[ringQueueCapacity(n)]), mask(ringQueueCapacity(n) - 1),
+      head(0), tail(0)
+{
+}   // SpscQueue(const int)
+
+
+
+//
+// SpscQueue(q)
+// Last modified: 17Oct2026
+//
+// Copy constructor that copies the contents
+// of the parameterized queue into this queue.
+//
+// Returns:     <none>
+// Parameters:
+//      q       in/out      the queue being copied
+//
+template <class T>
+SpscQueue<T>::SpscQueue(const SpscQueue<T> &q)
+    : items(new T[q.getCapacity()]), mask(q.getCapacity() - 1),
+      head(0), tail(0)
+{
+    *this = q;
+}   // SpscQueue(const SpscQueue<T> &)
+
+
+
+// <destructors>
+
+//
+// ~SpscQueue()
+// Last modified: 17Oct2026
+//
+// Destructor that releases the slots of this queue.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+template <class T>
+SpscQueue<T>::~SpscQueue()
+{
+    delete [] items;
+}   // ~SpscQueue()
+
+
+
+// <public mutator functions>
+
+//
+// bool enqueue(item)
+// Last modified: 17Oct2026
+//
+// Attempts to copy the parameterized item into the back of the queue
+// (producer thread only), returning true if successful, false if full.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    in      the item being enqueued
+//
+template <class T>
+bool SpscQueue<T>::enqueue(const T &item)
+{
+    unsigned int t = tail.load(memory_order_relaxed);
+    if (t - head.load(memory_order_acquire) > mask) return false;
+    items[t & mask] = item;
+    tail.store(t + 1, memory_order_release);
+    return true;
+}   // enqueue(const T &)
+
+
+
+//
+// bool dequeue()
+// Last modified: 17Oct2026
+//
+// Attempts to discard the item at the front of the queue
+// (consumer thread only), returning true if successful, false if empty.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:  <none>
+//
+template <class T>
+bool SpscQueue<T>::dequeue()
+{
+    T item;
+    return dequeue(item);
+}   // dequeue()
+
+
+
+//
+// bool dequeue(item)
+// Last modified: 17Oct2026
+//
+// Attempts to move the item at the front of the queue into the
+// parameterized item (consumer thread only), returning true
+// if successful, false if empty.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    out     set to the value of the front item
+//
+template <class T>
+bool SpscQueue<T>::dequeue(T &item)
+{
+    unsigned int h = head.load(memory_order_relaxed);
+    if (h == tail.load(memory_order_acquire)) return false;
+    item = std::move(items[h & mask]);
+    head.store(h + 1, memory_order_release);
+    return true;
+}   // dequeue(T &)
+
+
+
+//
+// void clear()
+// Last modified: 17Oct2026
+//
+// Discards every item in the queue (consumer thread only).
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+template <class T>
+void SpscQueue<T>::clear()
+{
+    while (dequeue());
+}   // clear()
+
+
+
+// <public accessor functions>
+
+//
+// int getSize() const
+// Last modified: 17Oct2026
+//
+// Returns the number of items in the queue (a snapshot
+// if other threads are using the queue).
+//
+// Returns:     the number of items in the queue
+// Parameters:  <none>
+//
+template <class T>
+int SpscQueue<T>::getSize() const
+{
+    return (int)(tail.load(memory_order_acquire) -
+                 head.load(memory_order_acquire));
+}   // getSize() const
+
+
+
+//
+// int getCapacity() const
+// Last modified: 17Oct2026
+//
+// Returns the number of items the queue can hold.
+//
+// Returns:     the number of items the queue can hold
+// Parameters:  <none>
+//
+template <class T>
+int SpscQueue<T>::getCapacity() const
+{
+    return (int)mask + 1;
+}   // getCapacity() const
+
+
+
+//
+// bool isEmpty() const
+// Last modified: 17Oct2026
+//
+// Returns true if the queue is empty, false otherwise.
+//
+// Returns:     true if the queue is empty, false otherwise
+// Parameters:  <none>
+//
+template <class T>
+bool SpscQueue<T>::isEmpty() const
+{
+    return getSize() == 0;
+}   // isEmpty() const
+
+
+
+//
+// bool isFull() const
+// Last modified: 17Oct2026
+//
+// Returns true if the queue is full, false otherwise.
+//
+// Returns:     true if the queue is full, false otherwise
+// Parameters:  <none>
+//
+template <class T>
+bool SpscQueue<T>::isFull() const
+{
+    return getSize() == getCapacity();
+}   // isFull() const
+
+
+
+// <overloaded operators>
+
+//
+// SpscQueue<T>& =(q)
+// Last modified: 17Oct2026
+//
+// Copies the contents of the parameterized queue into this queue,
+// resizing this queue to the capacity of the parameterized queue.
+//
+// Returns:     this queue
+// Parameters:
+//      q       in/out  the queue being copied
+//
+template <class T>
+SpscQueue<T>& SpscQueue<T>::operator =(const SpscQueue<T> &q)
+{
+    if (this == &q) return *this;
+    if (getCapacity() != q.getCapacity())
+    {
+        delete [] items;
+        items = new T[q.getCapacity()];
+        mask  = q.mask;
+    }
+    unsigned int h = q.head.load(memory_order_acquire);
+    unsigned int t = q.tail.load(memory_order_acquire);
+    for (unsigned int i = h; i != t; ++i) items[i & mask] = q.items[i & mask];
+    head.store(h, memory_order_relaxed);
+    tail.store(t, memory_order_release);
+    return *this;
+}   // =(const SpscQueue<T> &)
+
+
+
+//
+// <MpscQueue>
+// Last modified: 17Oct2026
+//
+// This class implements a bounded multi-producer, single-consumer queue.
+//
+
+
+
+// <constructors>
+
+//
+// MpscQueue(n)
+// Last modified: 17Oct2026
+//
+// Default constructor that preallocates room for
+// (at least) the parameterized number of items.
+//
+// Returns:     <none>
+// Parameters:
+//      n       in      the number of items the queue can hold
+//
+template <class T>
+MpscQueue<T>::MpscQueue(const int n): slots(NULL), mask(0), head(0), tail(0)
+{
+    init(n);
+}   // MpscQueue(const int)
+
+
+
+//
+// MpscQueue(q)
+// Last modified: 17Oct2026
+//
+// Copy constructor that copies the contents
+// of the parameterized queue into this queue.
+//
+// Returns:     <none>
+// Parameters:
+//      q       in/out      the queue being copied
+//
+template <class T>
+MpscQueue<T>::MpscQueue(const MpscQueue<T> &q)
+    : slots(NULL), mask(0), head(0), tail(0)
+{
+    *this = q;
+}   // MpscQueue(const MpscQueue<T> &)
+
+
+
+// <destructors>
+
+//
+// ~MpscQueue()
+// Last modified: 17Oct2026
+//
+// Destructor that releases the slots of this queue.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+template <class T>
+MpscQueue<T>::~MpscQueue()
+{
+    delete [] slots;
+}   // ~MpscQueue()
+
+
+
+// <public mutator functions>
+
+//
+// bool enqueue(item)
+// Last modified: 17Oct2026
+//
+// Attempts to copy the parameterized item into the back of the queue
+// (any thread), returning true if successful, false if full.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    in      the item being enqueued
+//
+template <class T>
+bool MpscQueue<T>::enqueue(const T &item)
+{
+    unsigned int t = tail.load(memory_order_relaxed);
+    Slot        *s = NULL;
+    for (;;)
+    {
+        s = &slots[t & mask];
+        int diff = (int)(s->seq.load(memory_order_acquire) - t);
+
+        // the slot is free, so try to claim it
+        if (diff == 0)
+        {
+            if (tail.compare_exchange_weak(t, t + 1, memory_order_relaxed))
+                break;
+        }
+
+        // the slot still holds an item from the previous lap, so we are full
+        else if (diff < 0) return false;
+
+        // another producer claimed the slot first
+        else t = tail.load(memory_order_relaxed);
+    }
+    s->item = item;
+    s->seq.store(t + 1, memory_order_release);
+    return true;
+}   // enqueue(const T &)
+
+
+
+//
+// bool dequeue()
+// Last modified: 17Oct2026
+//
+// Attempts to discard the item at the front of the queue
+// (consumer thread only), returning true if successful, false if empty.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:  <none>
+//
+template <class T>
+bool MpscQueue<T>::dequeue()
+{
+    T item;
+    return dequeue(item);
+}   // dequeue()
+
+
+
+//
+// bool dequeue(item)
+// Last modified: 17Oct2026
+//
+// Attempts to move the item at the front of the queue into the
+// parameterized item (consumer thread only), returning true
+// if successful, false if empty.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      item    out     set to the value of the front item
+//
+template <class T>
+bool MpscQueue<T>::dequeue(T &item)
+{
+    unsigned int h = head.load(memory_order_relaxed);
+    Slot        *s = &slots[h & mask];
+    if (s->seq.load(memory_order_acquire) != h + 1) return false;
+    item = std::move(s->item);
+    s->seq.store(h + mask + 1, memory_order_release);
+    head.store(h + 1, memory_order_release);
+    return true;
+}   // dequeue(T &)
+
+
+
+//
+// void clear()
+// Last modified: 17Oct2026
+//
+// Discards every item in the queue (consumer thread only).
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+template <class T>
+void MpscQueue<T>::clear()
+{
+    while (dequeue());
+}   // clear()
+
+
+
+// <public accessor functions>
+
+//
+// int getSize() const
+// Last modified: 17Oct2026
+//
+// Returns the number of items claimed in the queue (a snapshot
+// if other threads are using the queue).
+//
+// Returns:     the number of items in the queue
+// Parameters:  <none>
+//
+template <class T>
+int MpscQueue<T>::getSize() const
+{
+    return (int)(tail.load(memory_order_acquire) -
+                 head.load(memory_order_acquire));
+}   // getSize() const
+
+
+
+//
+// int getCapacity() const
+// Last modified: 17Oct2026
+//
+// Returns the number of items the queue can hold.
+//
+// Returns:     the number of items the queue can hold
+// Parameters:  <none>
+//
+template <class T>
+int MpscQueue<T>::getCapacity() const
+{
+    return (int)mask + 1;
+}   // getCapacity() const
+
+
+
+//
+// bool isEmpty() const
+// Last modified: 17Oct2026
+//
+// Returns true if the queue is empty, false otherwise.
+//
+// Returns:     true if the queue is empty, false otherwise
+// Parameters:  <none>
+//
+template <class T>
+bool MpscQueue<T>::isEmpty() const
+{
+    return getSize() == 0;
+}   // isEmpty() const
+
+
+
+// <overloaded operators>
+
+//
+// MpscQueue<T>& =(q)
+// Last modified: 17Oct2026
+//
+// Copies the contents of the parameterized queue into this queue,
+// resizing this queue to the capacity of the parameterized queue.
+//
+// Returns:     this queue
+// Parameters:
+//      q       in/out  the queue being copied
+//
+template <class T>
+MpscQueue<T>& MpscQueue<T>::operator =(const MpscQueue<T> &q)
+{
+    if (this == &q) return *this;
+    if ((slots == NULL) || (getCapacity() != q.getCapacity()))
+    {
+        delete [] slots;
+        init(q.getCapacity());
+    }
+    else clear();
+    unsigned int h = q.head.load(memory_order_acquire);
+    unsigned int t = q.tail.load(memory_order_acquire);
+    for (unsigned int i = h; i != t; ++i)
+        if (!enqueue(q.slots[i & q.mask].item)) break;
+    return *this;
+}   // =(const MpscQueue<T> &)
+
+
+
+// <protected utility functions>
+
+//
+// void init(n)
+// Last modified: 17Oct2026
+//
+// Allocates room for (at least) the parameterized number of items,
+// marking each slot as free for the first lap.
+//
+// Returns:     <none>
+// Parameters:
+//      n       in      the number of items the queue can hold
+//
+template <class T>
+void MpscQueue<T>::init(const int n)
+{
+    int capacity = ringQueueCapacity(n);
+    slots = new Slot[capacity];
+    mask  = capacity - 1;
+    for (int i = 0; i < capacity; ++i)
+        slots[i].seq.store(i, memory_order_relaxed);
+    head.store(0, memory_order_relaxed);
+    tail.store(0, memory_order_relaxed);
+}   // init(const int)
+#endif
@@ -8,12 +8,11 @@
 //
 
 // preprocessor directives
+#include <algorithm>
 #include "Environment.h"
 #include "Robot.h"
-#include "../formationcontrol/helpers.h"
-#include <QtCore/QString>
-#include "simulator.h"
-#include "../formationcontrol/types.h"
+#include "../FormationControl/helpers.h"
+#include "Simulator.h"
 
 const float MAX_ROBOT_SPEED_DPS        = 360.0;
 const float MAX_ROBOT_SPEED_MPS        = 130.375985 / 1000;
@@ -42,6 +41,7 @@ Robot::Robot(const GLfloat dx,    const GLfloat dy, const GLfloat dz,
 {
 	linearSpeedSteps = 0;
 	angularSpeedSteps = 0;
+    nDroppedPackets   = 0;
     init(dx, dy, dz, theta, colorIndex);
     ID = nRobots++;
 }   // Robot(const GLfloat..<4>, const Color)
@@ -76,6 +76,8 @@ Robot::Robot(const Robot &r)
     ID          = r.ID;
     env         = r.env;
     msgQueue    = r.msgQueue;
+    sendQueue   = r.sendQueue;
+    nDroppedPackets = r.nDroppedPackets;
 	linearSpeedSteps = 0;
 	angularSpeedSteps = 0;
 }   // Robot(const Robot &)
@@ -179,7 +181,7 @@ void Robot::translateRelative(Vector v)
 
 //
 // void translateRelative(dx, dy)
-// Last modified: 03Sep2006
+// Last modified: 17Oct2026
 //
 // Translates the robot relative to itself based
 // on the parameterized x-/y-coordinate translations.
@@ -192,28 +194,14 @@ void Robot::translateRelative(Vector v)
 void Robot::translateRelative(const GLfloat dx, const GLfloat dy)
 {
     translateRelative(Vector(dx, dy));
-	int xi;
-    f2idx(dx, &xi, windowSize[0], windowSize[1]);
-    float dist_m = ((float)xi) / ((float)gCameraScalePPM); //dist_mm / 1000;
-    //float elapsed = 0;
-    //if(pElapsedTimer)
-    //    elapsed = pElapsedTimer->elapsed();
-    float mps = dist_m / (STI_SEC + 0);
-    linearSpeedSteps = MPS_TO_SPS(mps);
-    //if(terminalList.count() && ID == 0)
-    //    terminalList.at(ID).pSerPort->write(QByteArray((QString("D,") +
-    //                                                   QString::number(linearSpeedSteps-angularSpeedSteps) +
-    //                                                   QString(",") +
-    //                                                   QString::number(linearSpeedSteps+angularSpeedSteps) +
-    //                                                   QString("\r")).toAscii()));
-    //linearSpeedSteps = 0;
+    updateLinearSpeed(dx);
 }   // translateRelative(const GLfloat, const GLfloat)
 
 
 
 //
 // void rotateRelative(theta)
-// Last modified: 03Sep2006
+// Last modified: 17Oct2026
 //
 // Rotates the robot about itself (in 2-dimensions)
 // based on the parameterized rotation angle.
@@ -225,22 +213,42 @@ void Robot::translateRelative(const GLfloat dx, const GLfloat dy)
 void Robot::rotateRelative(GLfloat theta)
 {
     heading.rotateRelative(theta);
-    float elapsed = 0;
-    //if(pElapsedTimer)
-        //elapsed = pElapsedTimer->elapsed();
-    float dps = theta / (STI_SEC - 0);
-    angularSpeedSteps = (DPS_TO_SPS(dps))*(1.2);
-    if(terminalList.count()/* && ID == 0*/)
-        terminalList.at(ID).pSerPort->write(QByteArray((QString("D,") +
-                                                        QString::number(linearSpeedSteps-angularSpeedSteps) +
-                                                        QString(",") +
-                                                        QString::number(linearSpeedSteps+angularSpeedSteps) +
-														QString("\r")).toStdString().c_str()));
-	//angularSpeedSteps = 0;
+    updateAngularSpeed(theta);
 }   // rotateRelative(GLfloat)
 
 
 
+// <public mutator functions>
+
+//
+// bool setQueueSizes(nIn, nOut)
+// Last modified: 17Oct2026
+//
+// Attempts to resize the message queue and the send queue of the robot
+// to hold (at least) the parameterized numbers of packets, keeping the
+// packets already queued, returning true if successful, false otherwise.
+// No other thread may be using the queues.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      nIn     in      the packets the message queue can hold
+//      nOut    in      the packets the send queue can hold
+//
+bool Robot::setQueueSizes(const GLint nIn, const GLint nOut)
+{
+    if ((nIn <= 0) || (nOut <= 0)) return false;
+    MpscQueue<Packet> inbox(max(nIn, (GLint)msgQueue.getSize()));
+    SpscQueue<Packet> outbox(max(nOut, (GLint)sendQueue.getSize()));
+    Packet            p;
+    while (msgQueue.dequeue(p))  inbox.enqueue(p);
+    while (sendQueue.dequeue(p)) outbox.enqueue(p);
+    msgQueue  = inbox;
+    sendQueue = outbox;
+    return true;
+}   // setQueueSizes(const GLint, const GLint)
+
+
+
 // <virtual public accessor functions>
 
 //
@@ -375,11 +383,28 @@ GLfloat Robot::getArcRadius() const
 
 
 
+//
+// long getNDroppedPackets() const
+// Last modified: 17Oct2026
+//
+// Returns the number of packets this robot has dropped because
+// its send queue was full (read only between steps).
+//
+// Returns:     the number of packets dropped
+// Parameters:  <none>
+//
+long Robot::getNDroppedPackets() const
+{
+    return nDroppedPackets;
+}   // getNDroppedPackets() const
+
+
+
 // <virtual public utility functions>
 
 //
 // void draw()
-// Last modified: 27Aug2006
+// Last modified: 17Oct2026
 //
 // Renders the robot as a circle with a vector heading.
 //
@@ -388,6 +413,7 @@ GLfloat Robot::getArcRadius() const
 //
 void Robot::draw()
 {
+#ifndef ROSS_HEADLESS
     if ((color[GLUT_RED]   == COLOR[INVISIBLE][GLUT_RED])   &&
         (color[GLUT_GREEN] == COLOR[INVISIBLE][GLUT_GREEN]) &&
         (color[GLUT_BLUE]  == COLOR[INVISIBLE][GLUT_BLUE])) return;
@@ -410,33 +436,90 @@ void Robot::draw()
             heading.draw();
         glPopMatrix();
     }
+#endif
 }   // draw()
 
 
 
 //
 // void step()
-// Last modified: 03Sep2006
+// Last modified: 17Oct2026
 //
-// Executes the appropriate active behavior.
+// Decides upon and executes the appropriate active behavior.
 //
 // Returns:     <none>
 // Parameters:  <none>
 //
 void Robot::step()
 {
-	if(terminalList.count()/* && ID == 0*/)
-        terminalList.at(ID).pSerPort->write(QByteArray((QString("D,") +
-                                                        QString::number(0) +
-                                                        QString(",") +
-                                                        QString::number(0) +
-														QString("\r")).toStdString().c_str()));
+    compute();
+    commit();
+}   // step()
+
+
+
+//
+// void compute()
+// Last modified: 17Oct2026
+//
+// Decides upon the appropriate active behavior without moving
+// (a plain robot keeps whatever behavior it was given).
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void Robot::compute()
+{
+}   // compute()
+
+
+
+//
+// void commit()
+// Last modified: 17Oct2026
+//
+// Executes the appropriate active behavior.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void Robot::commit()
+{
+    sendDrive(0, 0);
     if (behavior.isActive())
 	{
         translateRelative(getTransVel());
         rotateRelative(getAngVel());
     }
-}   // step()
+}   // commit()
+
+
+
+//
+// void moveTo(dx, dy, theta)
+// Last modified: 17Oct2026
+//
+// Executes the appropriate active behavior, given the pose it leads to
+// (as integrated by the environment for the whole swarm at once).
+//
+// Returns:     <none>
+// Parameters:
+//      dx      in      the x-coordinate the robot moves to
+//      dy      in      the y-coordinate the robot moves to
+//      theta   in      the heading the robot turns to
+//
+void Robot::moveTo(const GLfloat dx, const GLfloat dy, const GLfloat theta)
+{
+    sendDrive(0, 0);
+    if (behavior.isActive())
+	{
+        x = dx;
+        y = dy;
+        updateLinearSpeed(getTransVel());
+        setHeading(theta);
+        updateAngularSpeed(getAngVel());
+    }
+}   // moveTo(const GLfloat, const GLfloat, const GLfloat)
 
 
 
@@ -581,8 +664,8 @@ GLfloat Robot::collisionRadius() const
 // <virtual public environment functions>
 
 //
-// Vector getRelationship(toID)
-// Last modified: 03Sep2006
+// Vec2f getRelationship(toID)
+// Last modified: 17Oct2026
 //
 // Returns the relationship from this robot
 // to the robot with the parameterized ID.
@@ -591,13 +674,36 @@ GLfloat Robot::collisionRadius() const
 // Parameters:
 //      toID    in      the ID of the robot being related to
 //
-Vector Robot::getRelationship(const GLint toID) const
+Vec2f Robot::getRelationship(const GLint toID) const
 {
-    return (env == NULL) ? Vector() : env->getRelationship(toID, ID);
+    return (env == NULL) ? Vec2f() : env->getRelationship(toID, ID);
 }   // getRelationship(const GLint) const
 
 
 
+//
+// void getRelationshipsTo(toIDs, rels, n) const
+// Last modified: 17Oct2026
+//
+// Stores the relationships from this robot to each of
+// the robots with the parameterized ID's (all at once).
+//
+// Returns:     <none>
+// Parameters:
+//      toIDs   in      the ID's of the robots being related to
+//      rels    out     the relationships to the robots
+//      n       in      the number of robots being related to
+//
+void Robot::getRelationshipsTo(const GLint toIDs[],
+                               Vec2f       rels[],
+                               const GLint n) const
+{
+    if (env != NULL) env->getRelationshipsTo(ID, toIDs, rels, n);
+    else for (GLint i = 0; i < n; ++i) rels[i] = Vec2f();
+}   // getRelationshipsTo(const GLint [], Vec2f [], const GLint) const
+
+
+
 //
 // GLfloat getDistance(toID)
 // Last modified: 03Sep2006
@@ -637,34 +743,34 @@ GLfloat Robot::getAngleTo(const GLint toID) const
 // <virtual public environment functions>
 
 //
-// bool sendMsg(msg, toID, type)
-// Last modified: 07Sep2006
+// bool sendMsg(s, toID, type)
+// Last modified: 17Oct2026
 //
-// Attempts to send a packet to its destination
-// based upon the given parameters, returning
-// true if successful, false otherwise.
+// Attempts to send a packet carrying the parameterized state
+// to its destination based upon the given parameters,
+// returning true if successful, false otherwise.
 //
 // Returns:     true if successful, false otherwise
 // Parameters:
-//      msg     in/out  the message being sent
+//      s       in      the state being sent
 //      toID    in      the ID of the cell receiving the packet
 //      type    in      the type of message being sent
 //
-bool Robot::sendMsg(const Message &msg, const GLint toID, const GLint type)
+bool Robot::sendMsg(const State &s, const GLint toID, const GLint type)
 {
-    if (sendPacket(Packet(msg, toID, ID, type))) return true;
-    delete msg;
-    return false;
-}   // sendMsg(const Message &, const GLint, const GLint)
+    return sendPacket(Packet(s, toID, ID, type));
+}   // sendMsg(const State &, const GLint, const GLint)
 
 
 
 //
 // bool sendPacket(p)
-// Last modified: 07Sep2006
+// Last modified: 17Oct2026
 //
-// Attempts to send a packet to its destination,
-// returning true if successful, false otherwise.
+// Attempts to queue a packet to be forwarded to its destination
+// by the environment once every robot has been stepped,
+// returning true if successful, false otherwise (counting
+// the packet as dropped if the send queue is full).
 //
 // Returns:     true if successful, false otherwise
 // Parameters:
@@ -672,8 +778,9 @@ bool Robot::sendMsg(const Message &msg, const GLint toID, const GLint type)
 //
 bool Robot::sendPacket(const Packet &p)
 {
-    if ((env != NULL) && (env->sendPacket(p))) return true;
-    delete p.msg;
+    if (env == NULL)          return false;
+    if (sendQueue.enqueue(p)) return true;
+    ++nDroppedPackets;
     return false;
 }   // sendPacket(const Packet &)
 
@@ -699,9 +806,27 @@ Behavior Robot::moveArc(const Vector &target)
 
 
 
+//
+// Behavior moveArc(target)
+// Last modified: 17Oct2026
+//
+// Moves the robot using the parameterized movement vector,
+// activating and returning the appropriate robot behavior.
+//
+// Returns:     the appropriate robot behavior
+// Parameters:
+//      target  in      the target move of the behavior
+//
+Behavior Robot::moveArc(const Vec2f &target)
+{
+    return behavior = moveArcBehavior(target);
+}   // moveArc(const Vec2f &)
+
+
+
 //
 // Behavior moveArcBehavior(target)
-// Last modified: 17May2007
+// Last modified: 17Oct2026
 //
 // Moves the robot using the parameterized movement vector,
 // returning the appropriate robot behavior.
@@ -711,6 +836,24 @@ Behavior Robot::moveArc(const Vector &target)
 //      target  in/out  the target move of the behavior
 //
 Behavior Robot::moveArcBehavior(const Vector &target)
+{
+    return moveArcBehavior(Vec2f(target.x, target.y));
+}   // moveArcBehavior(const Vector &)
+
+
+
+//
+// Behavior moveArcBehavior(target)
+// Last modified: 17Oct2026
+//
+// Moves the robot using the parameterized movement vector,
+// returning the appropriate robot behavior.
+//
+// Returns:     the appropriate robot behavior
+// Parameters:
+//      target  in      the target move of the behavior
+//
+Behavior Robot::moveArcBehavior(const Vec2f &target)
 {
     GLfloat r     = target.norm();
     if (r <= threshold()) return moveStop();
@@ -720,7 +863,7 @@ Behavior Robot::moveArcBehavior(const Vector &target)
                                 degreesToRadians(angThreshold())) ?
                                 0.0f :
                                 r * theta / sin(theta), getDiameter() * theta);
-}   // moveArcBehavior(const Vector &)
+}   // moveArcBehavior(const Vec2f &)
 
 
 
@@ -1093,6 +1236,26 @@ Behavior Robot::orbitBehavior(const Vector &target, const GLfloat dist)
 
 
 
+// <public static functions>
+
+//
+// void resetIDs()
+// Last modified: 17Oct2026
+//
+// Restarts the numbering of robots at 0, so that the cells of an
+// environment created after all others are destroyed have the
+// ID's 0..n-1 expected by the environment and formation tables.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void Robot::resetIDs()
+{
+    nRobots = 0;
+}   // resetIDs()
+
+
+
 // <virtual protected utility functions>
 
 //
@@ -1123,3 +1286,70 @@ bool Robot::init(const GLfloat dx,    const GLfloat dy, const GLfloat dz,
     setEnvironment(NULL);
     return true;
 }   // init(const GLfloat..<4>, const Color)
+
+
+
+// <protected utility functions>
+
+//
+// void updateLinearSpeed(dx)
+// Last modified: 17Oct2026
+//
+// Updates the wheel speed (in steps) matching
+// the parameterized translation per step.
+//
+// Returns:     <none>
+// Parameters:
+//      dx      in      the translation per step
+//
+void Robot::updateLinearSpeed(const GLfloat dx)
+{
+	int xi;
+    f2idx(dx, &xi, windowSize[0], windowSize[1]);
+    float dist_m = ((float)xi) / ((float)gCameraScalePPM); //dist_mm / 1000;
+    float mps = dist_m / STI_SEC;
+    linearSpeedSteps = MPS_TO_SPS(mps);
+}   // updateLinearSpeed(const GLfloat)
+
+
+
+//
+// void updateAngularSpeed(theta)
+// Last modified: 17Oct2026
+//
+// Updates the wheel speed (in steps) matching the parameterized
+// rotation per step, sending both wheel speeds to the robot (if any).
+//
+// Returns:     <none>
+// Parameters:
+//      theta   in      the rotation angle per step
+//
+void Robot::updateAngularSpeed(const GLfloat theta)
+{
+    float dps = theta / STI_SEC;
+    angularSpeedSteps = DPS_TO_SPS(dps) * ANGULAR_SPEED_GAIN;
+    sendDrive(linearSpeedSteps - angularSpeedSteps,
+              linearSpeedSteps + angularSpeedSteps);
+}   // updateAngularSpeed(const GLfloat)
+
+
+
+//
+// void sendDrive(left, right)
+// Last modified: 17Oct2026
+//
+// Posts the parameterized wheel speeds to the command scheduler of the
+// environment (if any), which sends the last ones posted during a step
+// to the robot at the end of it (unless they have not changed).
+//
+// Returns:     <none>
+// Parameters:
+//      left    in      the speed of the left wheel (in steps per second)
+//      right   in      the speed of the right wheel (in steps per second)
+//
+void Robot::sendDrive(const GLint left, const GLint right)
+{
+    CommandScheduler *scheduler = (env == NULL) ? NULL
+                                                : env->getCommandScheduler();
+    if (scheduler != NULL) scheduler->post(ID, left, right);
+}   // sendDrive(const GLint, const GLint)
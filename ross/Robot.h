@@ -2,7 +2,7 @@
 // Filename:        "Robot.h"
 //
 // Programmer:      Ross Mead
-// Last modified:   07Sep2006
+// Last modified:   17Oct2026
 //
 // Description:     This class describes a 2-dimensional robot.
 //
@@ -13,7 +13,8 @@
 #include "Behavior.h"
 #include "Circle.h"
 #include "Packet.h"
-#include "Queue.h"
+#include "RingQueue.h"
+#include "Vec.h"
 using namespace std;
 
 // global constants
@@ -26,6 +27,8 @@ static const bool     DEFAULT_ROBOT_SHOW_HEAD    = true;
 static const GLfloat  FACTOR_MAX_SPEED           = 0.3f;
 static const GLfloat  FACTOR_THRESHOLD           = 1.0f;
 static const GLfloat  FACTOR_COLLISION_RADIUS    = 5.0f;
+static const GLint    PACKET_QUEUE_HEADROOM      = 8;   // beyond one per nbr
+static const GLfloat  ANGULAR_SPEED_GAIN         = 1.2f; // wheel steps/rotation
 
 class Environment;
 class Robot: public Circle
@@ -58,6 +61,9 @@ class Robot: public Circle
                                        const GLfloat dy = 0.0f);
         virtual void rotateRelative(GLfloat theta);
 
+        // <public mutator functions>
+        bool setQueueSizes(const GLint nIn, const GLint nOut);
+
         // <virtual public accessor functions>
         virtual Environment* getEnvironment() const;
 
@@ -69,10 +75,16 @@ class Robot: public Circle
         GLfloat getAngVel()    const;
         GLfloat getVelocity()  const;
         GLfloat getArcRadius() const;
+        long    getNDroppedPackets() const;
 
         // <virtual public utility functions>
         virtual void draw();
         virtual void step();
+        virtual void compute();
+        virtual void commit();
+        virtual void moveTo(const GLfloat dx,
+                            const GLfloat dy,
+                            const GLfloat theta);
 
         // <public utility functions>
         Vector  getRelationship(Vector &target) const;
@@ -85,19 +97,24 @@ class Robot: public Circle
         GLfloat collisionRadius()               const;
 
         // <public environment functions>
-        Vector  getRelationship(const GLint toID) const;
+        Vec2f   getRelationship(const GLint toID) const;
+        void    getRelationshipsTo(const GLint toIDs[],
+                                   Vec2f       rels[],
+                                   const GLint n) const;
         GLfloat getDistanceTo(const GLint toID)   const;
         GLfloat getAngleTo(const GLint toID)      const;
 
         // <virtual public environment functions>
-        virtual bool sendMsg(const Message &msg  = NULL,
-                             const GLint    toID = ID_BROADCAST,
-                             const GLint    type = 0);
+        virtual bool sendMsg(const State &s,
+                             const GLint  toID = ID_BROADCAST,
+                             const GLint  type = 0);
         virtual bool sendPacket(const Packet &p = Packet());
 
         // <public primitive behaviors>
         Behavior moveArc(const Vector &target);
         Behavior moveArcBehavior(const Vector &target);
+        Behavior moveArc(const Vec2f &target);
+        Behavior moveArcBehavior(const Vec2f &target);
         Behavior moveArc(const GLfloat t = 0.0f,
                          const GLfloat r = 0.0f,
                          const Status  s = ACTIVE);
@@ -125,6 +142,9 @@ class Robot: public Circle
         Behavior orbit(const Vector &target, const GLfloat dist);
         Behavior orbitBehavior(const Vector &target, const GLfloat dist);
 
+        // <public static functions>
+        static void resetIDs();
+
     protected:
 
         // <protected data members>
@@ -133,7 +153,9 @@ class Robot: public Circle
         static GLint  nRobots;      // number of total robots
         GLint         ID;           // identification number of robot
         Environment  *env;          // the environment of the robot
-        Queue<Packet> msgQueue;     // message packet queue for communication
+        MpscQueue<Packet> msgQueue;  // message packet queue for communication
+        SpscQueue<Packet> sendQueue; // packets waiting to be forwarded
+        long          nDroppedPackets; // packets the send queue had no room for
 
         // <virtual protected utility functions>
         virtual bool init(const GLfloat dx         = 0.0f,
@@ -141,5 +163,10 @@ class Robot: public Circle
                           const GLfloat dz         = 0.0f,
                           const GLfloat theta      = 0.0f,
                           const Color   colorIndex = DEFAULT_ROBOT_COLOR);
+
+        // <protected utility functions>
+        void updateLinearSpeed(const GLfloat dx);
+        void updateAngularSpeed(const GLfloat theta);
+        void sendDrive(const GLint left, const GLint right);
 };  // Robot
 #endif
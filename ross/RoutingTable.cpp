@@ -0,0 +1,262 @@
+//
+// Filename:        "RoutingTable.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements a table of the links that reach
+//                  the robots, mapping the ID of each robot to the port it
+//                  is reached on and its address on that port (if it
+//                  shares the port with others), and back.
+//
+
+// preprocessor directives
+#include <cstdio>
+#include "RoutingTable.h"
+
+// global constants
+static const GLint MAX_ROUTE_LINE = 128;    // characters per line of a file
+
+
+
+// <constructors>
+
+//
+// RoutingTable()
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this table to no routes
+// (so that each robot is reached alone on the port of its ID).
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+RoutingTable::RoutingTable(): nRoutes(0)
+{
+}   // RoutingTable()
+
+
+
+// <public mutator functions>
+
+//
+// bool setRoute(ID, port, address)
+// Last modified: 17Oct2026
+//
+// Attempts to route the parameterized robot to the parameterized port
+// and address (replacing its route), returning true if successful,
+// false otherwise.  A port is either direct (one robot, unaddressed) or
+// shared (up to MAX_ROUTE_ADDRESS + 1 robots, each addressed), and no
+// two robots may share an address.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      ID          in      the ID of the robot
+//      port        in      the port the robot is reached on
+//      address     in      the address on the port (default direct)
+//
+bool RoutingTable::setRoute(const GLint ID,
+                            const GLint port,
+                            const GLint address)
+{
+    if ((ID < 0) || (port < 0) || (address < ROUTE_DIRECT) ||
+        (address > MAX_ROUTE_ADDRESS)) return false;
+    lock_guard<mutex> lock(tableMutex);
+    if (port >= (GLint)ids.size())
+        ids.resize(port + 1, vector<GLint>(ROUTE_MULTIPLEX + 1, -1));
+    vector<GLint> &portIDs = ids[port];
+
+    // a direct port cannot be shared, nor a shared port made direct
+    const GLint slot = address + 1;
+    if ((portIDs[slot] >= 0) && (portIDs[slot] != ID)) return false;
+    for (GLint i = 0; i <= ROUTE_MULTIPLEX; ++i)
+        if ((portIDs[i] >= 0) && (portIDs[i] != ID) &&
+            ((i == 0) || (slot == 0))) return false;
+
+    unlink(ID);
+    if (ID >= (GLint)routes.size())
+    {
+        Route none = {ROUTE_NONE, ROUTE_DIRECT};
+        routes.resize(ID + 1, none);
+    }
+    routes[ID].port    = port;
+    routes[ID].address = address;
+    portIDs[slot]      = ID;
+    ++nRoutes;
+    return true;
+}   // setRoute(const GLint, const GLint, const GLint)
+
+
+
+//
+// bool removeRoute(ID)
+// Last modified: 17Oct2026
+//
+// Attempts to remove the route of the parameterized robot,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      ID      in      the ID of the robot
+//
+bool RoutingTable::removeRoute(const GLint ID)
+{
+    lock_guard<mutex> lock(tableMutex);
+    return unlink(ID);
+}   // removeRoute(const GLint)
+
+
+
+//
+// void clear()
+// Last modified: 17Oct2026
+//
+// Removes every route.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void RoutingTable::clear()
+{
+    lock_guard<mutex> lock(tableMutex);
+    routes.clear();
+    ids.clear();
+    nRoutes = 0;
+}   // clear()
+
+
+
+//
+// bool load(filename)
+// Last modified: 17Oct2026
+//
+// Attempts to replace the routes with those in the parameterized file,
+// one "<ID> <port> [<address>]" per line (ignoring blank lines and lines
+// starting with '#'), returning true if successful, false otherwise
+// (leaving the routes as they were).
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      filename    in      the name of the file
+//
+bool RoutingTable::load(const char *filename)
+{
+    FILE *file = (filename == NULL) ? NULL : fopen(filename, "r");
+    if (file == NULL) return false;
+
+    // the routes are parsed aside, so a bad file replaces none of them
+    RoutingTable loaded;
+    char         line[MAX_ROUTE_LINE];
+    bool         success = true;
+    while ((success) && (fgets(line, MAX_ROUTE_LINE, file) != NULL))
+    {
+        GLint ID, port, address = ROUTE_DIRECT;
+        char  first = '\0';
+        if ((sscanf(line, " %c", &first) < 1) || (first == '#')) continue;
+        success = (sscanf(line, "%d %d %d", &ID, &port, &address) >= 2) &&
+                  (loaded.setRoute(ID, port, address));
+    }
+    success = (!ferror(file)) && (success);
+    fclose(file);
+    if (!success) return false;
+
+    lock_guard<mutex> lock(tableMutex);
+    routes.swap(loaded.routes);
+    ids.swap(loaded.ids);
+    nRoutes = loaded.nRoutes;
+    return true;
+}   // load(const char *)
+
+
+
+// <public accessor functions>
+
+//
+// Route getRoute(ID) const
+// Last modified: 17Oct2026
+//
+// Returns the route of the parameterized robot, which is the port of its
+// ID (direct) if no routes are set, unreachable if others are.
+//
+// Returns:     the route of the robot
+// Parameters:
+//      ID      in      the ID of the robot
+//
+Route RoutingTable::getRoute(const GLint ID) const
+{
+    Route route = {ROUTE_NONE, ROUTE_DIRECT};
+    if (ID < 0) return route;
+    lock_guard<mutex> lock(tableMutex);
+    if (nRoutes == 0)                   route.port = ID;
+    else if (ID < (GLint)routes.size()) route      = routes[ID];
+    return route;
+}   // getRoute(const GLint) const
+
+
+
+//
+// GLint getID(port, address) const
+// Last modified: 17Oct2026
+//
+// Returns the robot reached at the parameterized port and address,
+// which is that of the port if no routes are set (robot i alone on
+// port i, whatever address it reports).
+//
+// Returns:     the ID of the robot, -1 if none
+// Parameters:
+//      port        in      the port the robot is reached on
+//      address     in      the address on the port (direct if negative)
+//
+GLint RoutingTable::getID(const GLint port, const GLint address) const
+{
+    if ((port < 0) || (address > MAX_ROUTE_ADDRESS)) return -1;
+    const GLint slot = (address < 0) ? 0 : address + 1;
+    lock_guard<mutex> lock(tableMutex);
+    if (nRoutes == 0)              return port;
+    if (port >= (GLint)ids.size()) return -1;
+    return ids[port][slot];
+}   // getID(const GLint, const GLint) const
+
+
+
+//
+// GLint getNRoutes() const
+// Last modified: 17Oct2026
+//
+// Returns the number of routes set.
+//
+// Returns:     the number of routes
+// Parameters:  <none>
+//
+GLint RoutingTable::getNRoutes() const
+{
+    lock_guard<mutex> lock(tableMutex);
+    return nRoutes;
+}   // getNRoutes() const
+
+
+
+// <protected utility functions>
+
+//
+// bool unlink(ID)
+// Last modified: 17Oct2026
+//
+// Attempts to remove the route of the parameterized robot
+// (with the table mutex held), returning true if successful,
+// false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      ID      in      the ID of the robot
+//
+bool RoutingTable::unlink(const GLint ID)
+{
+    if ((ID < 0) || (ID >= (GLint)routes.size()) ||
+        (routes[ID].port == ROUTE_NONE)) return false;
+    ids[routes[ID].port][routes[ID].address + 1] = -1;
+    routes[ID].port    = ROUTE_NONE;
+    routes[ID].address = ROUTE_DIRECT;
+    --nRoutes;
+    return true;
+}   // unlink(const GLint)
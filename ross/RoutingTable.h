@@ -0,0 +1,77 @@
+//
+// Filename:        "RoutingTable.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes a table of the links that reach
+//                  the robots, mapping the ID of each robot to the port it
+//                  is reached on and its address on that port (if it
+//                  shares the port with others), and back.
+//
+
+// preprocessor directives
+#ifndef ROUTING_TABLE_H
+#define ROUTING_TABLE_H
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include "GLTypes.h"
+using namespace std;
+
+// global constants
+static const GLint ROUTE_NONE        = -2;    // the robot cannot be reached
+static const GLint ROUTE_DIRECT      = -1;    // the only robot on its port
+static const GLint MAX_ROUTE_ADDRESS = 254;   // addresses on a shared port
+static const GLint ROUTE_MULTIPLEX   = 255;   // addresses a batch of robots
+
+//
+// Route
+//
+// Describes the link that reaches a robot.
+//
+struct Route
+{
+    GLint port;         // the port (ROUTE_NONE if unreachable)
+    GLint address;      // the address on the port (ROUTE_DIRECT if alone)
+};  // Route
+
+class RoutingTable
+{
+
+    public:
+
+        // <constructors>
+        RoutingTable();
+
+        // <public mutator functions>
+        bool setRoute(const GLint ID,
+                      const GLint port,
+                      const GLint address = ROUTE_DIRECT);
+        bool removeRoute(const GLint ID);
+        void clear();
+        bool load(const char *filename);
+
+        // <public accessor functions>
+        Route getRoute(const GLint ID)                       const;
+        GLint getID(const GLint port, const GLint address)   const;
+        GLint getNRoutes()                                   const;
+
+    protected:
+
+        // <protected data members>
+        vector<Route>          routes;   // indexed by robot ID
+        vector< vector<GLint> > ids;     // indexed by port, then address + 1
+        GLint                  nRoutes;
+        mutable mutex          tableMutex;
+
+        // <protected utility functions>
+        bool unlink(const GLint ID);
+
+    private:
+
+        // <private constructors>
+        RoutingTable(const RoutingTable &);
+        RoutingTable& operator =(const RoutingTable &);
+};  // RoutingTable
+#endif
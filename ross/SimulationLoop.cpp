@@ -0,0 +1,443 @@
+//
+// Filename:        "SimulationLoop.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements a thread that steps an environment
+//                  at a fixed timestep (catching up on late ticks, up to a
+//                  limit), publishing an immutable snapshot of the poses of
+//                  the cells after each tick for a viewer to interpolate.
+//
+
+// preprocessor directives
+#include "SimulationLoop.h"
+
+
+
+// <constructors>
+
+//
+// SimulationLoop(e, dt, maxSteps)
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this (stopped) loop
+// to the parameterized values.
+//
+// Returns:     <none>
+// Parameters:
+//      e           in      the environment being stepped
+//      dt          in      the timestep (in seconds)
+//      maxSteps    in      the maximum ticks to catch up at once
+//
+SimulationLoop::SimulationLoop(Environment   *e,
+                               const GLdouble dt,
+                               const GLint    maxSteps)
+    : env(e), timestep(DEFAULT_SIM_TIMESTEP),
+      maxCatchUp(DEFAULT_SIM_MAX_CATCH_UP),
+      running(false), nTicks(0), nDropped(0), nFailed(0)
+{
+    setTimestep(dt);
+    setMaxCatchUp(maxSteps);
+}   // SimulationLoop(Environment *, const GLdouble, const GLint)
+
+
+
+// <destructors>
+
+//
+// ~SimulationLoop()
+// Last modified: 17Oct2026
+//
+// Destructor that stops this loop.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+SimulationLoop::~SimulationLoop()
+{
+    stop();
+}   // ~SimulationLoop()
+
+
+
+// <public mutator functions>
+
+//
+// bool setEnvironment(e)
+// Last modified: 17Oct2026
+//
+// Attempts to set the environment stepped by this (stopped) loop,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      e       in      the environment being stepped
+//
+bool SimulationLoop::setEnvironment(Environment *e)
+{
+    if (isRunning()) return false;
+    env = e;
+    return true;
+}   // setEnvironment(Environment *)
+
+
+
+//
+// bool setTimestep(dt)
+// Last modified: 17Oct2026
+//
+// Attempts to set the timestep of this (stopped) loop,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      dt      in      the timestep (in seconds)
+//
+bool SimulationLoop::setTimestep(const GLdouble dt)
+{
+    if ((isRunning()) || (dt <= 0.0)) return false;
+    timestep = dt;
+    return true;
+}   // setTimestep(const GLdouble)
+
+
+
+//
+// bool setMaxCatchUp(maxSteps)
+// Last modified: 17Oct2026
+//
+// Attempts to set the maximum number of late ticks this (stopped) loop
+// runs back to back before dropping the rest,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      maxSteps    in      the maximum ticks to catch up at once
+//
+bool SimulationLoop::setMaxCatchUp(const GLint maxSteps)
+{
+    if ((isRunning()) || (maxSteps < 1)) return false;
+    maxCatchUp = maxSteps;
+    return true;
+}   // setMaxCatchUp(const GLint)
+
+
+
+//
+// bool start()
+// Last modified: 17Oct2026
+//
+// Attempts to start stepping the environment on the thread of this loop,
+// publishing the current poses first, returning true if successful,
+// false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:  <none>
+//
+bool SimulationLoop::start()
+{
+    if ((isRunning()) || (env == NULL)) return false;
+    startTime = chrono::steady_clock::now();
+    nTicks    = 0;
+    nDropped  = 0;
+    nFailed   = 0;
+    {
+        lock_guard<mutex> lock(snapMutex);
+        prevSnap.reset();
+        currSnap.reset();
+    }
+    publish(0);
+    running = true;
+    worker  = thread(&SimulationLoop::run, this);
+    return true;
+}   // start()
+
+
+
+//
+// void stop()
+// Last modified: 17Oct2026
+//
+// Stops stepping the environment (after the current tick, if any).
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void SimulationLoop::stop()
+{
+    {
+        lock_guard<mutex> lock(snapMutex);
+        running = false;
+    }
+    stopped.notify_all();
+    if (worker.joinable()) worker.join();
+}   // stop()
+
+
+
+// <public accessor functions>
+
+//
+// bool isRunning() const
+// Last modified: 17Oct2026
+//
+// Returns true if this loop is stepping the environment, false otherwise.
+//
+// Returns:     true if this loop is running, false otherwise
+// Parameters:  <none>
+//
+bool SimulationLoop::isRunning() const
+{
+    return running;
+}   // isRunning() const
+
+
+
+//
+// GLdouble getTimestep() const
+// Last modified: 17Oct2026
+//
+// Returns the timestep (in seconds) of this loop.
+//
+// Returns:     the timestep of this loop
+// Parameters:  <none>
+//
+GLdouble SimulationLoop::getTimestep() const
+{
+    return timestep;
+}   // getTimestep() const
+
+
+
+//
+// GLint getNTicks() const
+// Last modified: 17Oct2026
+//
+// Returns the number of ticks run since this loop was started.
+//
+// Returns:     the number of ticks run
+// Parameters:  <none>
+//
+GLint SimulationLoop::getNTicks() const
+{
+    return nTicks;
+}   // getNTicks() const
+
+
+
+//
+// GLint getNDroppedTicks() const
+// Last modified: 17Oct2026
+//
+// Returns the number of ticks dropped (beyond the catch-up limit)
+// since this loop was started.
+//
+// Returns:     the number of ticks dropped
+// Parameters:  <none>
+//
+GLint SimulationLoop::getNDroppedTicks() const
+{
+    return nDropped;
+}   // getNDroppedTicks() const
+
+
+
+//
+// GLint getNFailedTicks() const
+// Last modified: 17Oct2026
+//
+// Returns the number of ticks whose step of the environment failed
+// since this loop was started (their snapshots are still published).
+//
+// Returns:     the number of ticks that failed
+// Parameters:  <none>
+//
+GLint SimulationLoop::getNFailedTicks() const
+{
+    return nFailed;
+}   // getNFailedTicks() const
+
+
+
+//
+// mutex& getEnvMutex()
+// Last modified: 17Oct2026
+//
+// Returns the mutex held by this loop during each tick, which must be
+// held by any other thread accessing the environment while running.
+//
+// Returns:     the mutex of the environment
+// Parameters:  <none>
+//
+mutex& SimulationLoop::getEnvMutex()
+{
+    return envMutex;
+}   // getEnvMutex()
+
+
+
+// <public utility functions>
+
+//
+// bool getSnapshots(prev, curr) const
+// Last modified: 17Oct2026
+//
+// Attempts to get the two latest snapshots (which are never modified
+// while held), returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      prev    out     set to the snapshot before the latest (if any)
+//      curr    out     set to the latest snapshot
+//
+bool SimulationLoop::getSnapshots(shared_ptr<const PoseSnapshot> &prev,
+                                  shared_ptr<const PoseSnapshot> &curr) const
+{
+    lock_guard<mutex> lock(snapMutex);
+    prev = prevSnap;
+    curr = currSnap;
+    return curr.get() != NULL;
+}   // getSnapshots(shared_ptr<const PoseSnapshot> &, ...) const
+
+
+
+//
+// bool interpolate(p) const
+// Last modified: 17Oct2026
+//
+// Attempts to interpolate the poses of the cells between the two latest
+// snapshots by the time since the latest one (so the view trails the
+// simulation by at most one tick), returning true if successful,
+// false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      p       out     set to the interpolated poses
+//
+bool SimulationLoop::interpolate(PoseStore &p) const
+{
+    shared_ptr<const PoseSnapshot> prev, curr;
+    if (!getSnapshots(prev, curr)) return false;
+    const PoseStore &to = curr->poses;
+    p = to;
+    if ((prev.get() == NULL) || (prev->poses.getSize() != to.getSize()))
+        return true;
+
+    const PoseStore &from = prev->poses;
+    GLdouble alpha = (getTime() - curr->time) / timestep;
+    GLfloat  t     = (alpha <= 0.0) ? 0.0f :
+                     (alpha >= 1.0) ? 1.0f : (GLfloat)alpha;
+    for (GLint i = 0; i < to.getSize(); ++i)
+    {
+        GLfloat dTheta = to.heading[i] - from.heading[i];
+        while (dTheta >  180.0f) dTheta -= 360.0f;
+        while (dTheta < -180.0f) dTheta += 360.0f;
+        p.x[i]       = from.x[i] + t * (to.x[i] - from.x[i]);
+        p.y[i]       = from.y[i] + t * (to.y[i] - from.y[i]);
+        p.heading[i] = from.heading[i] + t * dTheta;
+    }
+    return true;
+}   // interpolate(PoseStore &) const
+
+
+
+// <protected utility functions>
+
+//
+// void run()
+// Last modified: 17Oct2026
+//
+// Steps the environment once per elapsed timestep (running up to the
+// catch-up limit of late ticks back to back, and dropping the rest),
+// publishing a snapshot after each tick (counting those that failed),
+// until stopped.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void SimulationLoop::run()
+{
+    GLdouble last = getTime(), lag = 0.0;
+    while (running)
+    {
+        GLdouble now = getTime();
+        lag += now - last;
+        last = now;
+
+        // run each tick that is due (up to the catch-up limit)
+        for (GLint i = 0; (i < maxCatchUp) && (lag >= timestep); ++i)
+        {
+            {
+                lock_guard<mutex> lock(envMutex);
+                if (!env->step()) ++nFailed;
+            }
+            publish(++nTicks);
+            lag -= timestep;
+        }
+        if (lag >= timestep)
+        {
+            GLint nLate = (GLint)(lag / timestep);
+            nDropped   += nLate;
+            lag        -= nLate * timestep;
+        }
+
+        // sleep until the next tick is due (or this loop is stopped)
+        unique_lock<mutex> lock(snapMutex);
+        if (running)
+            stopped.wait_for(lock, chrono::duration<GLdouble>(
+                timestep - (lag + getTime() - last)));
+    }
+}   // run()
+
+
+
+//
+// void publish(tick)
+// Last modified: 17Oct2026
+//
+// Publishes a snapshot of the current poses of the cells, reusing the
+// storage of a retired snapshot whenever no viewer still holds it.
+//
+// Returns:     <none>
+// Parameters:
+//      tick    in      the tick that ended with the current poses
+//
+void SimulationLoop::publish(const GLint tick)
+{
+    shared_ptr<PoseSnapshot> next;
+    {
+        lock_guard<mutex> lock(snapMutex);
+        next.swap(spareSnap);
+    }
+    if ((next.get() == NULL) || (next.use_count() != 1))
+        next.reset(new PoseSnapshot());
+    {
+        lock_guard<mutex> lock(envMutex);
+        next->poses = env->getPoses();
+    }
+    next->tick = tick;
+    next->time = getTime();
+
+    lock_guard<mutex> lock(snapMutex);
+    spareSnap = prevSnap;
+    prevSnap  = currSnap;
+    currSnap  = next;
+}   // publish(const GLint)
+
+
+
+//
+// GLdouble getTime() const
+// Last modified: 17Oct2026
+//
+// Returns the time (in seconds) since this loop was started.
+//
+// Returns:     the time since the start
+// Parameters:  <none>
+//
+GLdouble SimulationLoop::getTime() const
+{
+    return chrono::duration<GLdouble>(
+        chrono::steady_clock::now() - startTime).count();
+}   // getTime() const
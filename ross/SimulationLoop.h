@@ -0,0 +1,101 @@
+//
+// Filename:        "SimulationLoop.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes a thread that steps an environment
+//                  at a fixed timestep (catching up on late ticks, up to a
+//                  limit), publishing an immutable snapshot of the poses of
+//                  the cells after each tick for a viewer to interpolate.
+//
+
+// preprocessor directives
+#ifndef SIMULATION_LOOP_H
+#define SIMULATION_LOOP_H
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "Environment.h"
+#include "PoseStore.h"
+using namespace std;
+
+// global constants
+static const GLdouble DEFAULT_SIM_TIMESTEP     = 0.1;  // seconds per tick
+static const GLint    DEFAULT_SIM_MAX_CATCH_UP = 5;    // ticks per wake-up
+
+//
+// PoseSnapshot
+//
+// Describes the poses of the cells at the end of a tick.
+//
+struct PoseSnapshot
+{
+    PoseStore poses;    // the poses of the cells
+    GLint     tick;     // the tick that ended with these poses
+    GLdouble  time;     // the time (in seconds since the start) of the tick
+};  // PoseSnapshot
+
+class SimulationLoop
+{
+
+    public:
+
+        // <constructors>
+        SimulationLoop(Environment   *e        = NULL,
+                       const GLdouble dt       = DEFAULT_SIM_TIMESTEP,
+                       const GLint    maxSteps = DEFAULT_SIM_MAX_CATCH_UP);
+
+        // <destructors>
+        ~SimulationLoop();
+
+        // <public mutator functions>
+        bool setEnvironment(Environment *e);
+        bool setTimestep(const GLdouble dt = DEFAULT_SIM_TIMESTEP);
+        bool setMaxCatchUp(const GLint maxSteps = DEFAULT_SIM_MAX_CATCH_UP);
+        bool start();
+        void stop();
+
+        // <public accessor functions>
+        bool     isRunning()        const;
+        GLdouble getTimestep()      const;
+        GLint    getNTicks()        const;
+        GLint    getNDroppedTicks() const;
+        GLint    getNFailedTicks()  const;
+        mutex&   getEnvMutex();
+
+        // <public utility functions>
+        bool getSnapshots(shared_ptr<const PoseSnapshot> &prev,
+                          shared_ptr<const PoseSnapshot> &curr) const;
+        bool interpolate(PoseStore &p) const;
+
+    protected:
+
+        // <protected data members>
+        Environment                      *env;
+        GLdouble                          timestep;
+        GLint                             maxCatchUp;
+        thread                            worker;
+        atomic<bool>                      running;
+        atomic<GLint>                     nTicks, nDropped, nFailed;
+        chrono::steady_clock::time_point  startTime;
+        mutex                             envMutex;     // held during ticks
+        mutable mutex                     snapMutex;
+        condition_variable                stopped;
+        shared_ptr<PoseSnapshot>          prevSnap, currSnap, spareSnap;
+
+        // <protected utility functions>
+        void     run();
+        void     publish(const GLint tick);
+        GLdouble getTime() const;
+
+    private:
+
+        // <private constructors>
+        SimulationLoop(const SimulationLoop &);
+        SimulationLoop& operator =(const SimulationLoop &);
+};  // SimulationLoop
+#endif
@@ -10,14 +10,16 @@
 // preprocessor directives
 #include "Environment.h"
 #include "Simulator.h"
+#ifndef ROSS_HEADLESS
 #include "../formationcontrol/GLWindow.h"
+#endif
 using namespace std;
 
 
 
 // global constants
 const GLint INIT_WINDOW_POSITION[2] = {0, 0};       // window offset
-const GLint DT                      = 50;           // number of milliseconds
+const GLint DT                      = (GLint)STI_MS; // number of milliseconds
 
 // global variables
 GLint       windowSize[2]           = {640, 480};   // window size in pixels
@@ -28,6 +30,18 @@ Function formations[] = {line,        x,       absX,     negHalfX,
                          negAbsHalfX, negAbsX, parabola, cubic,
                          condSqrt,    sine,    xRoot3,   negXRoot3};
 
+// describes the formation functions whose intersections have a closed form
+// (parabola, cubic, condSqrt and sine are searched for instead)
+const bool FORMATIONS_DESCRIBED =
+    Formation::describeFunction(line,        LINEAR_SHAPE,      0.0f)     &&
+    Formation::describeFunction(x,           LINEAR_SHAPE,      1.0f)     &&
+    Formation::describeFunction(absX,        ABS_LINEAR_SHAPE,  1.0f)     &&
+    Formation::describeFunction(negHalfX,    LINEAR_SHAPE,     -0.5f)     &&
+    Formation::describeFunction(negAbsHalfX, ABS_LINEAR_SHAPE, -0.5f)     &&
+    Formation::describeFunction(negAbsX,     ABS_LINEAR_SHAPE, -1.0f)     &&
+    Formation::describeFunction(xRoot3,      LINEAR_SHAPE,      sqrt(3.0f)) &&
+    Formation::describeFunction(negXRoot3,   LINEAR_SHAPE,     -sqrt(3.0f));
+
 // global simulation constants
 const GLfloat   SELECT_RADIUS     = 1.5f * DEFAULT_ROBOT_RADIUS;
 const GLint     N_CELLS           = 4;
@@ -35,12 +49,13 @@ const GLint     MIDDLE_CELL       = 0;//N_CELLS == 1 ? 1 : (N_CELLS - 1) / 2;
 const Formation DEFAULT_FORMATION = Formation(formations[0],
                                               DEFAULT_ROBOT_RADIUS *
                                               FACTOR_COLLISION_RADIUS,
-                                              Vector(), MIDDLE_CELL, 0,
+                                              Vec2f(), MIDDLE_CELL, 0,
                                               90.0f);
 
 // global simulation variables
 //Environment env(N_CELLS,    DEFAULT_FORMATION);
 Environment env;
+SimulationLoop simLoop(&env, STI_SEC);  // steps env at a fixed timestep
 GLfloat     fRadius       = DEFAULT_FORMATION.getRadius();
 GLint       sID           = DEFAULT_FORMATION.getSeedID();
 GLint       fID           = DEFAULT_FORMATION.getFormationID();
@@ -82,7 +97,7 @@ GLint main(GLint argc, char **argv)
 	glutMotionFunc(mouseDrag );
 	glutReshapeFunc(resizeWindow);
     glutSpecialFunc(keyboardPressSpecial);
-	glutTimerFunc(50, timerFunction, 1);
+	glutTimerFunc(DT, timerFunction, 1);
 
     // initialize and execute the robot cell environment
     initWindow();
@@ -117,23 +132,28 @@ bool changeFormation(const GLint index)
     }
 
     // send the new formation definition to the seed
-    return env.sendMsg(new Formation(formations[index], fRadius, Vector(),
-                                     sID,             ++fID,     fHeading),
+    return env.sendMsg(Formation(formations[index], fRadius, Vec2f(),
+                                 sID,               ++fID,   fHeading),
                        sID, ID_OPERATOR, CHANGE_FORMATION);
 }   // changeFormation(const GLint)
 
 
 
+// <display and interaction functions (not built headless)>
+#ifndef ROSS_HEADLESS
 //
-// void display()
-// Last modified:   04Sep2006
+// void display(glwindow, poses)
+// Last modified:   17Oct2026
 //
-// Clears the frame buffer and draws the simulated cells within the window.
+// Clears the frame buffer and draws the simulated cells within the window
+// (at the parameterized poses, if any).
 //
 // Returns:     <none>
-// Parameters:  <none>
+// Parameters:
+//      glwindow    in      the window being drawn in
+//      poses       in      the poses of the cells (default current poses)
 //
-void display(GLWindow* glwindow)
+void display(GLWindow* glwindow, const PoseStore *poses)
 {
 	glClear(GL_COLOR_BUFFER_BIT);   // clear background color
     glMatrixMode(GL_MODELVIEW);     // modeling transformation
@@ -141,10 +161,11 @@ void display(GLWindow* glwindow)
     // draws environment robot cells
 	if (env.getCell(sID))
 		env.getCell(sID)->setColor(GREEN);
-    env.draw();
+    if (poses != NULL) env.draw(*poses);
+    else               env.draw();
 
 	glFlush();                      // force the execution of OpenGL commands
-}   // display()
+}   // display(GLWindow *, const PoseStore *)
 
 
 
@@ -489,6 +510,7 @@ void timerFunction(GLint value)
 	glutPostRedisplay();            // redraw the scene
 	glutTimerFunc(DT, timerFunction, 1);
 }   // timerFunction(GLint)
+#endif
 
 
 
@@ -2,19 +2,25 @@
 #define ROSS_SIMULATOR_H
 
 #include "Environment.h"
+#include "SimulationLoop.h"
 
 // global constants
+#define SIMULATOR_TIME_INTERVAL_MS  100.0
+#define SIMULATOR_TIME_INTERVAL_SEC (SIMULATOR_TIME_INTERVAL_MS / 1000.0)
+#define STI_MS                      SIMULATOR_TIME_INTERVAL_MS
+#define STI_SEC                     SIMULATOR_TIME_INTERVAL_SEC
 extern const GLint INIT_WINDOW_POSITION[2];
 extern const GLint DT;
 
 // global variables
+extern int         gCameraScalePPM;     // defined by the host application
 extern GLint       windowSize[2];
 extern GLfloat     windowWidth;
 extern GLfloat     windowHeight;
 
 // function prototypes
 class GLWindow;
-void display(GLWindow* glwindow);
+void display(GLWindow* glwindow, const PoseStore *poses = NULL);
 void initConsole();
 void initWindow();
 void keyboardPress(unsigned char keyPressed, GLint mouseX, GLint mouseY);
@@ -49,6 +55,7 @@ extern const Formation DEFAULT_FORMATION;
 
 // global simulation variables
 extern Environment env;
+extern SimulationLoop simLoop;
 extern GLfloat     fRadius;
 extern GLint       sID;
 extern GLint       fID;
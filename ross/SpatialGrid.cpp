@@ -0,0 +1,524 @@
+//
+// Filename:        "SpatialGrid.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements a uniform-grid spatial index
+//                  over a set of points, which finds the nearest points,
+//                  the points within a radius, and collisions.
+//
+
+// preprocessor directives
+#include <utility>
+#include "SpatialGrid.h"
+
+
+
+// <constructors>
+
+//
+// SpatialGrid(size)
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this grid
+// to hold no items in cells of the parameterized size.
+//
+// Returns:     <none>
+// Parameters:
+//      size    in      the width of each grid cell
+//
+SpatialGrid::SpatialGrid(const GLfloat size): cellSize(DEFAULT_GRID_CELL_SIZE)
+{
+    setCellSize(size);
+    clear();
+}   // SpatialGrid(const GLfloat)
+
+
+
+// <public mutator functions>
+
+//
+// bool setCellSize(size)
+// Last modified: 17Oct2026
+//
+// Attempts to set the width of each grid cell to the parameterized size
+// (rehashing every item), returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      size    in      the width of each grid cell
+//
+bool SpatialGrid::setCellSize(const GLfloat size)
+{
+    if (size <= 0.0f) return false;
+    cellSize = size;
+    if (!xs.empty())
+    {
+        vector<GLfloat> x(xs), y(ys);
+        build(&x[0], &y[0], (GLint)x.size());
+    }
+    return true;
+}   // setCellSize(const GLfloat)
+
+
+
+//
+// bool build(x, y, n)
+// Last modified: 17Oct2026
+//
+// Attempts to replace the items of this grid with the parameterized
+// points, returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      x       in      the x-coordinates of the points
+//      y       in      the y-coordinates of the points
+//      n       in      the number of points
+//
+bool SpatialGrid::build(const GLfloat x[], const GLfloat y[], const GLint n)
+{
+    if ((n < 0) || ((n > 0) && ((x == NULL) || (y == NULL)))) return false;
+    clear();
+    GLint nBuckets = MIN_GRID_N_BUCKETS;
+    while (nBuckets < n) nBuckets *= 2;
+    buckets.assign(nBuckets, vector<GLint>());
+    xs.assign(x, x + n);
+    ys.assign(y, y + n);
+    cxs.resize(n);
+    cys.resize(n);
+    for (GLint i = 0; i < n; ++i) addToBucket(i);
+    return true;
+}   // build(const GLfloat [], const GLfloat [], const GLint)
+
+
+
+//
+// bool insert(x, y)
+// Last modified: 17Oct2026
+//
+// Attempts to add the parameterized point to the end of this grid
+// (as item getSize()), returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      x       in      the x-coordinate of the point
+//      y       in      the y-coordinate of the point
+//
+bool SpatialGrid::insert(const GLfloat x, const GLfloat y)
+{
+    xs.push_back(x);
+    ys.push_back(y);
+    cxs.push_back(0);
+    cys.push_back(0);
+    if (getSize() > (GLint)buckets.size())
+        rehash(2 * (GLint)buckets.size());
+    else addToBucket(getSize() - 1);
+    return true;
+}   // insert(const GLfloat, const GLfloat)
+
+
+
+//
+// bool update(i, x, y)
+// Last modified: 17Oct2026
+//
+// Attempts to move the parameterized item to the parameterized point
+// (only rehashing it if it changes grid cells),
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      i       in      the index of the item
+//      x       in      the x-coordinate of the point
+//      y       in      the y-coordinate of the point
+//
+bool SpatialGrid::update(const GLint i, const GLfloat x, const GLfloat y)
+{
+    if ((i < 0) || (i >= getSize())) return false;
+    xs[i] = x;
+    ys[i] = y;
+    if ((toCell(x) != cxs[i]) || (toCell(y) != cys[i]))
+    {
+        removeFromBucket(i);
+        addToBucket(i);
+    }
+    return true;
+}   // update(const GLint, const GLfloat, const GLfloat)
+
+
+
+//
+// bool removeTail()
+// Last modified: 17Oct2026
+//
+// Attempts to remove the last item from this grid,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:  <none>
+//
+bool SpatialGrid::removeTail()
+{
+    if (xs.empty()) return false;
+    removeFromBucket(getSize() - 1);
+    xs.pop_back();
+    ys.pop_back();
+    cxs.pop_back();
+    cys.pop_back();
+    return true;
+}   // removeTail()
+
+
+
+//
+// void clear()
+// Last modified: 17Oct2026
+//
+// Removes every item from this grid.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void SpatialGrid::clear()
+{
+    xs.clear();
+    ys.clear();
+    cxs.clear();
+    cys.clear();
+    buckets.assign(MIN_GRID_N_BUCKETS, vector<GLint>());
+    minCX = minCY = 0;
+    maxCX = maxCY = -1;
+}   // clear()
+
+
+
+// <public accessor functions>
+
+//
+// GLint getSize() const
+// Last modified: 17Oct2026
+//
+// Returns the number of items in this grid.
+//
+// Returns:     the number of items in this grid
+// Parameters:  <none>
+//
+GLint SpatialGrid::getSize() const
+{
+    return (GLint)xs.size();
+}   // getSize() const
+
+
+
+//
+// GLfloat getCellSize() const
+// Last modified: 17Oct2026
+//
+// Returns the width of each grid cell.
+//
+// Returns:     the width of each grid cell
+// Parameters:  <none>
+//
+GLfloat SpatialGrid::getCellSize() const
+{
+    return cellSize;
+}   // getCellSize() const
+
+
+
+// <public utility functions>
+
+//
+// bool getNearest(x, y, k, items, exclude) const
+// Last modified: 17Oct2026
+//
+// Finds (up to) the parameterized number of items nearest to the
+// parameterized point, searching rings of grid cells outward until
+// no unsearched item could be any nearer, returning true if any
+// items are found, false otherwise.
+//
+// Returns:     true if any items are found, false otherwise
+// Parameters:
+//      x       in      the x-coordinate of the point
+//      y       in      the y-coordinate of the point
+//      k       in      the number of items to find
+//      items   out     the nearest items (nearest first)
+//      exclude in      the index of an item to skip (default none)
+//
+bool SpatialGrid::getNearest(const GLfloat     x,
+                             const GLfloat     y,
+                             const GLint       k,
+                             ArrayList<GLint> &items,
+                             const GLint       exclude) const
+{
+    items.clear();
+    if ((k <= 0) || (xs.empty())) return false;
+
+    // the farthest ring that could hold an item
+    const GLint cx = toCell(x), cy = toCell(y);
+    GLint maxRing  = 0;
+    maxRing = (cx - minCX > maxRing) ? cx - minCX : maxRing;
+    maxRing = (maxCX - cx > maxRing) ? maxCX - cx : maxRing;
+    maxRing = (cy - minCY > maxRing) ? cy - minCY : maxRing;
+    maxRing = (maxCY - cy > maxRing) ? maxCY - cy : maxRing;
+
+    // nearest items so far, sorted by squared distance
+    vector< pair<GLfloat, GLint> > nearest;
+    for (GLint ring = 0; ring <= maxRing; ++ring)
+    {
+        for (GLint i = cx - ring; i <= cx + ring; ++i)
+            for (GLint j = cy - ring; j <= cy + ring; ++j)
+            {
+                if ((i != cx - ring) && (i != cx + ring) &&
+                    (j != cy - ring) && (j != cy + ring)) continue;
+                const vector<GLint> &bucket = buckets[getBucket(i, j)];
+                for (size_t b = 0; b < bucket.size(); ++b)
+                {
+                    const GLint item = bucket[b];
+                    if ((item == exclude) ||
+                        (cxs[item] != i)  || (cys[item] != j)) continue;
+                    const GLfloat dx = xs[item] - x, dy = ys[item] - y;
+                    const GLfloat d  = dx * dx + dy * dy;
+                    if (((GLint)nearest.size() == k) &&
+                        (d >= nearest.back().first)) continue;
+                    if ((GLint)nearest.size() == k) nearest.pop_back();
+                    size_t pos = nearest.size();
+                    while ((pos > 0) && (nearest[pos - 1].first > d)) --pos;
+                    nearest.insert(nearest.begin() + pos, make_pair(d, item));
+                }
+            }
+
+        // every unsearched item is at least this ring away
+        const GLfloat reach = (GLfloat)ring * cellSize;
+        if (((GLint)nearest.size() == k) &&
+            (nearest.back().first <= reach * reach)) break;
+    }
+    for (size_t i = 0; i < nearest.size(); ++i)
+        items.insertTail(nearest[i].second);
+    return !items.isEmpty();
+}   // getNearest(const GLfloat, const GLfloat, const GLint, ...) const
+
+
+
+//
+// bool getWithin(x, y, r, items, exclude) const
+// Last modified: 17Oct2026
+//
+// Finds every item within the parameterized radius of the parameterized
+// point, returning true if any items are found, false otherwise.
+//
+// Returns:     true if any items are found, false otherwise
+// Parameters:
+//      x       in      the x-coordinate of the point
+//      y       in      the y-coordinate of the point
+//      r       in      the radius being searched
+//      items   out     the items within the radius (in no order)
+//      exclude in      the index of an item to skip (default none)
+//
+bool SpatialGrid::getWithin(const GLfloat     x,
+                            const GLfloat     y,
+                            const GLfloat     r,
+                            ArrayList<GLint> &items,
+                            const GLint       exclude) const
+{
+    items.clear();
+    if ((r < 0.0f) || (xs.empty())) return false;
+    GLint loX = toCell(x - r), hiX = toCell(x + r);
+    GLint loY = toCell(y - r), hiY = toCell(y + r);
+    loX = (loX < minCX) ? minCX : loX;
+    hiX = (hiX > maxCX) ? maxCX : hiX;
+    loY = (loY < minCY) ? minCY : loY;
+    hiY = (hiY > maxCY) ? maxCY : hiY;
+    for (GLint i = loX; i <= hiX; ++i)
+        for (GLint j = loY; j <= hiY; ++j)
+            searchCell(i, j, x, y, r * r, exclude, &items);
+    return !items.isEmpty();
+}   // getWithin(const GLfloat, const GLfloat, const GLfloat, ...) const
+
+
+
+//
+// bool collides(x, y, r, exclude) const
+// Last modified: 17Oct2026
+//
+// Returns true if any item is within the parameterized radius
+// of the parameterized point, false otherwise.
+//
+// Returns:     true if any item is within the radius, false otherwise
+// Parameters:
+//      x       in      the x-coordinate of the point
+//      y       in      the y-coordinate of the point
+//      r       in      the collision radius
+//      exclude in      the index of an item to skip (default none)
+//
+bool SpatialGrid::collides(const GLfloat x,
+                           const GLfloat y,
+                           const GLfloat r,
+                           const GLint   exclude) const
+{
+    if ((r < 0.0f) || (xs.empty())) return false;
+    GLint loX = toCell(x - r), hiX = toCell(x + r);
+    GLint loY = toCell(y - r), hiY = toCell(y + r);
+    loX = (loX < minCX) ? minCX : loX;
+    hiX = (hiX > maxCX) ? maxCX : hiX;
+    loY = (loY < minCY) ? minCY : loY;
+    hiY = (hiY > maxCY) ? maxCY : hiY;
+    for (GLint i = loX; i <= hiX; ++i)
+        for (GLint j = loY; j <= hiY; ++j)
+            if (searchCell(i, j, x, y, r * r, exclude, NULL)) return true;
+    return false;
+}   // collides(const GLfloat, const GLfloat, const GLfloat, const GLint) const
+
+
+
+// <protected utility functions>
+
+//
+// GLint toCell(v) const
+// Last modified: 17Oct2026
+//
+// Returns the grid cell (along one axis) of the parameterized coordinate.
+//
+// Returns:     the grid cell of the coordinate
+// Parameters:
+//      v       in      the coordinate
+//
+GLint SpatialGrid::toCell(const GLfloat v) const
+{
+    return (GLint)floor(v / cellSize);
+}   // toCell(const GLfloat) const
+
+
+
+//
+// GLint getBucket(cx, cy) const
+// Last modified: 17Oct2026
+//
+// Returns the bucket that the parameterized grid cell hashes to.
+//
+// Returns:     the bucket of the grid cell
+// Parameters:
+//      cx      in      the column of the grid cell
+//      cy      in      the row of the grid cell
+//
+GLint SpatialGrid::getBucket(const GLint cx, const GLint cy) const
+{
+    unsigned int hash = ((unsigned int)cx * 73856093u) ^
+                        ((unsigned int)cy * 19349663u);
+    return (GLint)(hash & (unsigned int)(buckets.size() - 1));
+}   // getBucket(const GLint, const GLint) const
+
+
+
+//
+// void addToBucket(i)
+// Last modified: 17Oct2026
+//
+// Adds the parameterized item to the bucket of its grid cell,
+// widening the occupied cells to include it.
+//
+// Returns:     <none>
+// Parameters:
+//      i       in      the index of the item
+//
+void SpatialGrid::addToBucket(const GLint i)
+{
+    const GLint cx = cxs[i] = toCell(xs[i]), cy = cys[i] = toCell(ys[i]);
+    if (minCX > maxCX)
+    {
+        minCX = maxCX = cx;
+        minCY = maxCY = cy;
+    }
+    minCX = (cx < minCX) ? cx : minCX;
+    maxCX = (cx > maxCX) ? cx : maxCX;
+    minCY = (cy < minCY) ? cy : minCY;
+    maxCY = (cy > maxCY) ? cy : maxCY;
+    buckets[getBucket(cx, cy)].push_back(i);
+}   // addToBucket(const GLint)
+
+
+
+//
+// void removeFromBucket(i)
+// Last modified: 17Oct2026
+//
+// Removes the parameterized item from the bucket of its grid cell
+// (the occupied cells are only ever widened, so they may be loose).
+//
+// Returns:     <none>
+// Parameters:
+//      i       in      the index of the item
+//
+void SpatialGrid::removeFromBucket(const GLint i)
+{
+    vector<GLint> &bucket = buckets[getBucket(cxs[i], cys[i])];
+    for (size_t b = 0; b < bucket.size(); ++b)
+        if (bucket[b] == i)
+        {
+            bucket[b] = bucket.back();
+            bucket.pop_back();
+            return;
+        }
+}   // removeFromBucket(const GLint)
+
+
+
+//
+// void rehash(nBuckets)
+// Last modified: 17Oct2026
+//
+// Redistributes every item among the parameterized number of buckets.
+//
+// Returns:     <none>
+// Parameters:
+//      nBuckets    in      the number of buckets (a power of 2)
+//
+void SpatialGrid::rehash(const GLint nBuckets)
+{
+    buckets.assign(nBuckets, vector<GLint>());
+    for (GLint i = 0; i < getSize(); ++i) addToBucket(i);
+}   // rehash(const GLint)
+
+
+
+//
+// bool searchCell(cx, cy, x, y, rSq, exclude, items) const
+// Last modified: 17Oct2026
+//
+// Finds the items of the parameterized grid cell within the parameterized
+// (squared) radius of the parameterized point, stopping at the first one
+// if no list is given, returning true if any are found, false otherwise.
+//
+// Returns:     true if any items are found, false otherwise
+// Parameters:
+//      cx      in      the column of the grid cell
+//      cy      in      the row of the grid cell
+//      x       in      the x-coordinate of the point
+//      y       in      the y-coordinate of the point
+//      rSq     in      the squared radius being searched
+//      exclude in      the index of an item to skip
+//      items   out     the items found (may be NULL)
+//
+bool SpatialGrid::searchCell(const GLint       cx,
+                             const GLint       cy,
+                             const GLfloat     x,
+                             const GLfloat     y,
+                             const GLfloat     rSq,
+                             const GLint       exclude,
+                             ArrayList<GLint> *items) const
+{
+    bool found = false;
+    const vector<GLint> &bucket = buckets[getBucket(cx, cy)];
+    for (size_t b = 0; b < bucket.size(); ++b)
+    {
+        const GLint i = bucket[b];
+        if ((i == exclude) || (cxs[i] != cx) || (cys[i] != cy)) continue;
+        const GLfloat dx = xs[i] - x, dy = ys[i] - y;
+        if (dx * dx + dy * dy > rSq) continue;
+        found = true;
+        if (items == NULL) return true;
+        items->insertTail(i);
+    }
+    return found;
+}   // searchCell(const GLint, const GLint, const GLfloat, ...) const
@@ -0,0 +1,83 @@
+//
+// Filename:        "SpatialGrid.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes a uniform-grid spatial index
+//                  over a set of points, which finds the nearest points,
+//                  the points within a radius, and collisions.
+//
+
+// preprocessor directives
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+#include <vector>
+#include "ArrayList.h"
+#include "Vec.h"
+using namespace std;
+
+// global constants
+static const GLfloat DEFAULT_GRID_CELL_SIZE = 0.15f; // one collision radius
+static const GLint   MIN_GRID_N_BUCKETS     = 64;
+
+class SpatialGrid
+{
+
+    public:
+
+        // <constructors>
+        SpatialGrid(const GLfloat size = DEFAULT_GRID_CELL_SIZE);
+
+        // <public mutator functions>
+        bool setCellSize(const GLfloat size = DEFAULT_GRID_CELL_SIZE);
+        bool build(const GLfloat x[], const GLfloat y[], const GLint n);
+        bool insert(const GLfloat x, const GLfloat y);
+        bool update(const GLint i, const GLfloat x, const GLfloat y);
+        bool removeTail();
+        void clear();
+
+        // <public accessor functions>
+        GLint   getSize()     const;
+        GLfloat getCellSize() const;
+
+        // <public utility functions>
+        bool getNearest(const GLfloat     x,
+                        const GLfloat     y,
+                        const GLint       k,
+                        ArrayList<GLint> &items,
+                        const GLint       exclude = -1) const;
+        bool getWithin(const GLfloat     x,
+                       const GLfloat     y,
+                       const GLfloat     r,
+                       ArrayList<GLint> &items,
+                       const GLint       exclude = -1) const;
+        bool collides(const GLfloat x,
+                      const GLfloat y,
+                      const GLfloat r,
+                      const GLint   exclude = -1) const;
+
+    protected:
+
+        // <protected data members>
+        GLfloat                 cellSize;
+        vector<GLfloat>         xs, ys;     // positions of the items
+        vector<GLint>           cxs, cys;   // grid cells of the items
+        vector< vector<GLint> > buckets;    // items hashed by grid cell
+        GLint                   minCX, maxCX, minCY, maxCY; // occupied cells
+
+        // <protected utility functions>
+        GLint toCell(const GLfloat v)                   const;
+        GLint getBucket(const GLint cx, const GLint cy) const;
+        void  addToBucket(const GLint i);
+        void  removeFromBucket(const GLint i);
+        void  rehash(const GLint nBuckets);
+        bool  searchCell(const GLint       cx,
+                         const GLint       cy,
+                         const GLfloat     x,
+                         const GLfloat     y,
+                         const GLfloat     rSq,
+                         const GLint       exclude,
+                         ArrayList<GLint> *items) const;
+};  // SpatialGrid
+#endif
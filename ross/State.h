@@ -18,9 +18,9 @@ struct State
 
     // <data members>
 	Formation                formation;     // the current formation
-	Vector                   gradient;      // the formation gradient
-	LinkedList<Relationship> rels;          // the formation relationships
-    Vector                   transError;    // the summed translational error
+	Vec2f                    gradient;      // the formation gradient
+	ArrayList<Relationship>  rels;          // the formation relationships
+    Vec2f                    transError;    // the summed translational error
     GLfloat                  rotError;      // the summed rotational error
 	GLint                    step;          // the step in the formation
 
@@ -45,14 +45,14 @@ struct State
     //      s       in      the default step
     //
     State(const Formation                f      = Formation(),
-          const Vector                   grad   = Vector(),
-          const LinkedList<Relationship> r      = LinkedList<Relationship>(),
-          const Vector                   tError = Vector(),
+          const Vec2f                    grad   = Vec2f(),
+          const ArrayList<Relationship>  r      = ArrayList<Relationship>(),
+          const Vec2f                    tError = Vec2f(),
           const GLfloat                  rError = 0.0f,
           const GLint                    s      = 0)
           : formation(f),       gradient(grad),   rels(r),
             transError(tError), rotError(rError), step(s)
     {
-    }   // State(const..{Formation, Vector, LL<Relationship>, Vector, GLint})
+    }   // State(const..{Formation, Vec2f, LL<Relationship>, Vec2f, GLint})
 };  // State
 #endif
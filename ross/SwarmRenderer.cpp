@@ -0,0 +1,291 @@
+//
+// Filename:        "SwarmRenderer.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements a retained-mode renderer that
+//                  batches the outlines and headings of a swarm of robot
+//                  cells into vertex arrays, drawing the whole swarm with
+//                  a constant number of draw calls.
+//
+
+// preprocessor directives
+#include "SwarmRenderer.h"
+
+
+
+// <constructors>
+
+//
+// SwarmRenderer()
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes the unit circle
+// geometry shared by every robot outline.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+SwarmRenderer::SwarmRenderer()
+{
+    unitCos.resize(CIRCLE_N_LINKS + 1);
+    unitSin.resize(CIRCLE_N_LINKS + 1);
+    for (GLint i = 0; i <= CIRCLE_N_LINKS; ++i)
+    {
+        GLfloat theta = degreesToRadians((GLfloat)i * CIRCLE_THETA);
+        unitCos[i]    = cos(theta);
+        unitSin[i]    = sin(theta);
+    }
+}   // SwarmRenderer()
+
+
+
+// <public mutator functions>
+
+//
+// bool build(p, c)
+// Last modified: 17Oct2026
+//
+// Attempts to rebuild the vertex arrays from the parameterized poses
+// and (for their radii, colors, and display options) cells,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      p       in      the poses of the cells
+//      c       in      the cells
+//
+bool SwarmRenderer::build(const PoseStore &p, const ArrayList<Cell *> &c)
+{
+    clear();
+    if (p.getSize() != c.getSize()) return false;
+    for (GLint i = 0; i < c.getSize(); ++i)
+    {
+        const Cell *cell = c[i];
+        if ((cell->color[GLUT_RED]   == COLOR[INVISIBLE][GLUT_RED])   &&
+            (cell->color[GLUT_GREEN] == COLOR[INVISIBLE][GLUT_GREEN]) &&
+            (cell->color[GLUT_BLUE]  == COLOR[INVISIBLE][GLUT_BLUE]))
+            continue;
+        GLfloat cx = p.x[i] + cell->translate[0],
+                cy = p.y[i] + cell->translate[1];
+
+        // vector position of the cell
+        if (cell->showPos)
+            addArrow(cell->translate[0], cell->translate[1],
+                     radiansToDegrees(atan2(p.y[i], p.x[i])),
+                     sqrt(p.x[i] * p.x[i] + p.y[i] * p.y[i]),
+                     cell->scale[0], cell->showLine, cell->showHead,
+                     cell->color);
+
+        // outline and vector heading of the cell
+        addCircle(cx, cy, cell->getRadius() * cell->scale[0], cell->color);
+        if (cell->showHeading)
+            addArrow(cx, cy, p.heading[i], cell->heading.norm(),
+                     cell->getRadius() / DEFAULT_ROBOT_RADIUS,
+                     cell->heading.showLine, cell->heading.showHead,
+                     cell->color);
+    }
+    return true;
+}   // build(const PoseStore &, const ArrayList<Cell *> &)
+
+
+
+//
+// void clear()
+// Last modified: 17Oct2026
+//
+// Clears the vertex arrays (keeping their storage for the next frame).
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void SwarmRenderer::clear()
+{
+    lineVerts.clear();
+    lineColors.clear();
+    triVerts.clear();
+    triColors.clear();
+}   // clear()
+
+
+
+// <public accessor functions>
+
+//
+// GLint getNLineVertices() const
+// Last modified: 17Oct2026
+//
+// Returns the number of line vertices (two per line segment).
+//
+// Returns:     the number of line vertices
+// Parameters:  <none>
+//
+GLint SwarmRenderer::getNLineVertices() const
+{
+    return (GLint)lineVerts.size() / 2;
+}   // getNLineVertices() const
+
+
+
+//
+// GLint getNTriangleVertices() const
+// Last modified: 17Oct2026
+//
+// Returns the number of triangle vertices (three per triangle).
+//
+// Returns:     the number of triangle vertices
+// Parameters:  <none>
+//
+GLint SwarmRenderer::getNTriangleVertices() const
+{
+    return (GLint)triVerts.size() / 2;
+}   // getNTriangleVertices() const
+
+
+
+// <public utility functions>
+
+//
+// void draw() const
+// Last modified: 17Oct2026
+//
+// Renders the vertex arrays with one draw call for all line segments
+// and one for all triangles, regardless of the number of cells.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void SwarmRenderer::draw() const
+{
+#ifndef ROSS_HEADLESS
+    glLineWidth(VECTOR_LINE_WIDTH);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    if (!lineVerts.empty())
+    {
+        glVertexPointer(2, GL_FLOAT, 0, &lineVerts[0]);
+        glColorPointer(3, GL_FLOAT, 0, &lineColors[0]);
+        glDrawArrays(GL_LINES, 0, getNLineVertices());
+    }
+    if (!triVerts.empty())
+    {
+        glVertexPointer(2, GL_FLOAT, 0, &triVerts[0]);
+        glColorPointer(3, GL_FLOAT, 0, &triColors[0]);
+        glDrawArrays(GL_TRIANGLES, 0, getNTriangleVertices());
+    }
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+#endif
+}   // draw() const
+
+
+
+// <protected utility functions>
+
+//
+// void addVertex(verts, colors, x, y, clr)
+// Last modified: 17Oct2026
+//
+// Appends a vertex of the parameterized position and color
+// to the parameterized vertex arrays.
+//
+// Returns:     <none>
+// Parameters:
+//      verts   in/out  the vertex positions
+//      colors  in/out  the vertex colors
+//      x       in      the x-coordinate of the vertex
+//      y       in      the y-coordinate of the vertex
+//      clr     in      the color of the vertex
+//
+void SwarmRenderer::addVertex(vector<GLfloat> &verts,
+                              vector<GLfloat> &colors,
+                              const GLfloat    x,
+                              const GLfloat    y,
+                              const GLfloat    clr[3])
+{
+    verts.push_back(x);
+    verts.push_back(y);
+    colors.push_back(clr[GLUT_RED]);
+    colors.push_back(clr[GLUT_GREEN]);
+    colors.push_back(clr[GLUT_BLUE]);
+}   // addVertex(vector<GLfloat> &, vector<GLfloat> &, const GLfloat..<2>, ...)
+
+
+
+//
+// void addCircle(cx, cy, r, clr)
+// Last modified: 17Oct2026
+//
+// Appends the line segments of a polygonal approximation
+// to the parameterized circle.
+//
+// Returns:     <none>
+// Parameters:
+//      cx      in      the x-coordinate of the center
+//      cy      in      the y-coordinate of the center
+//      r       in      the radius
+//      clr     in      the color of the circle
+//
+void SwarmRenderer::addCircle(const GLfloat cx,
+                              const GLfloat cy,
+                              const GLfloat r,
+                              const GLfloat clr[3])
+{
+    for (GLint i = 0; i < CIRCLE_N_LINKS; ++i)
+    {
+        addVertex(lineVerts, lineColors,
+                  cx + r * unitCos[i],     cy + r * unitSin[i],     clr);
+        addVertex(lineVerts, lineColors,
+                  cx + r * unitCos[i + 1], cy + r * unitSin[i + 1], clr);
+    }
+}   // addCircle(const GLfloat..<3>, const GLfloat [])
+
+
+
+//
+// void addArrow(ox, oy, theta, magnitude, s, showLine, showHead, clr)
+// Last modified: 17Oct2026
+//
+// Appends the line and/or head of the parameterized vector
+// (as drawn by Vector::draw()).
+//
+// Returns:     <none>
+// Parameters:
+//      ox          in      the x-coordinate of the origin
+//      oy          in      the y-coordinate of the origin
+//      theta       in      the angle (in degrees) of the vector
+//      magnitude   in      the magnitude of the vector
+//      s           in      the scale of the vector
+//      showLine    in      true to append the line of the vector
+//      showHead    in      true to append the head of the vector
+//      clr         in      the color of the vector
+//
+void SwarmRenderer::addArrow(const GLfloat ox,
+                             const GLfloat oy,
+                             const GLfloat theta,
+                             const GLfloat magnitude,
+                             const GLfloat s,
+                             const bool    showLine,
+                             const bool    showHead,
+                             const GLfloat clr[3])
+{
+    GLfloat c  = s * cos(degreesToRadians(theta)),
+            sn = s * sin(degreesToRadians(theta));
+    GLfloat tipX = ox + c * magnitude, tipY = oy + sn * magnitude;
+    if ((showHead) && (magnitude >= VECTOR_HEAD_HEIGHT))
+    {
+        GLfloat baseX = ox + c  * (magnitude - VECTOR_HEAD_HEIGHT),
+                baseY = oy + sn * (magnitude - VECTOR_HEAD_HEIGHT);
+        addVertex(triVerts, triColors, tipX, tipY, clr);
+        addVertex(triVerts, triColors, baseX - sn * VECTOR_HEAD_WIDTH,
+                                       baseY + c  * VECTOR_HEAD_WIDTH, clr);
+        addVertex(triVerts, triColors, baseX + sn * VECTOR_HEAD_WIDTH,
+                                       baseY - c  * VECTOR_HEAD_WIDTH, clr);
+    }
+    if (showLine)
+    {
+        addVertex(lineVerts, lineColors, ox,   oy,   clr);
+        addVertex(lineVerts, lineColors, tipX, tipY, clr);
+    }
+}   // addArrow(const GLfloat..<5>, const bool, const bool, const GLfloat [])
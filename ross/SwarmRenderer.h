@@ -0,0 +1,66 @@
+//
+// Filename:        "SwarmRenderer.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes a retained-mode renderer that
+//                  batches the outlines and headings of a swarm of robot
+//                  cells into vertex arrays, drawing the whole swarm with
+//                  a constant number of draw calls.
+//
+
+// preprocessor directives
+#ifndef SWARM_RENDERER_H
+#define SWARM_RENDERER_H
+#include <vector>
+#include "Cell.h"
+#include "PoseStore.h"
+using namespace std;
+
+class SwarmRenderer
+{
+
+    public:
+
+        // <constructors>
+        SwarmRenderer();
+
+        // <public mutator functions>
+        bool build(const PoseStore &p, const ArrayList<Cell *> &c);
+        void clear();
+
+        // <public accessor functions>
+        GLint getNLineVertices()     const;
+        GLint getNTriangleVertices() const;
+
+        // <public utility functions>
+        void draw() const;
+
+    protected:
+
+        // <protected data members>
+        vector<GLfloat> lineVerts, lineColors;  // (x, y) and (r, g, b)
+        vector<GLfloat> triVerts,  triColors;   // of each vertex
+        vector<GLfloat> unitCos,   unitSin;     // unit circle geometry
+
+        // <protected utility functions>
+        void addVertex(vector<GLfloat> &verts,
+                       vector<GLfloat> &colors,
+                       const GLfloat    x,
+                       const GLfloat    y,
+                       const GLfloat    clr[3]);
+        void addCircle(const GLfloat cx,
+                       const GLfloat cy,
+                       const GLfloat r,
+                       const GLfloat clr[3]);
+        void addArrow(const GLfloat ox,
+                      const GLfloat oy,
+                      const GLfloat theta,
+                      const GLfloat magnitude,
+                      const GLfloat s,
+                      const bool    showLine,
+                      const bool    showHead,
+                      const GLfloat clr[3]);
+};  // SwarmRenderer
+#endif
@@ -0,0 +1,450 @@
+//
+// Filename:        "TelemetryParser.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements an incremental parser of the replies
+//                  that arrive from the robots on a port, either as text
+//                  ("q,<left>,<right>\r") or as binary frames checked with
+//                  a CRC, which keeps the state of a partial frame between
+//                  reads so the bytes are parsed where they were read to.
+//
+
+// preprocessor directives
+#include "TelemetryParser.h"
+
+// global constants
+static const GLint TELEMETRY_IDLE        = 0;   // between frames
+static const GLint TELEMETRY_SKIP        = 1;   // discarding a bad line
+static const GLint TELEMETRY_TYPE        = 2;   // after the type of a line
+static const GLint TELEMETRY_VALUE_START = 3;   // before a value of a line
+static const GLint TELEMETRY_VALUE       = 4;   // within a value of a line
+static const GLint TELEMETRY_ADDRESS     = 5;   // the address of a frame
+static const GLint TELEMETRY_FRAME_TYPE  = 6;   // the type of a frame
+static const GLint TELEMETRY_LENGTH      = 7;   // the payload length
+static const GLint TELEMETRY_PAYLOAD     = 8;   // within the payload
+static const GLint TELEMETRY_CRC_LOW     = 9;   // the low byte of the CRC
+static const GLint TELEMETRY_CRC_HIGH    = 10;  // the high byte of the CRC
+static const GLint MAX_TELEMETRY_DIGITS  = 10;  // digits per value
+
+// the CRC-16/CCITT (polynomial 0x1021) of each nibble
+static const unsigned short CRC16_NIBBLE[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+
+
+// <file functions>
+
+//
+// unsigned short crcByte(crc, b)
+// Last modified: 17Oct2026
+//
+// Returns the parameterized CRC extended by the parameterized byte.
+//
+// Returns:     the extended CRC
+// Parameters:
+//      crc     in      the CRC so far
+//      b       in      the next byte
+//
+static inline unsigned short crcByte(unsigned short crc, const unsigned char b)
+{
+    crc = (unsigned short)((crc << 4) ^ CRC16_NIBBLE[(crc >> 12) ^ (b >> 4)]);
+    crc = (unsigned short)((crc << 4) ^ CRC16_NIBBLE[(crc >> 12) ^ (b & 0xF)]);
+    return crc;
+}   // crcByte(unsigned short, const unsigned char)
+
+
+
+// <constructors>
+
+//
+// TelemetryParser(p, l)
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this parser
+// to the parameterized values.
+//
+// Returns:     <none>
+// Parameters:
+//      p       in      the port the bytes arrive on
+//      l       in      the receiver of the parsed frames (default none)
+//
+TelemetryParser::TelemetryParser(const GLint p, TelemetryListener *l)
+    : listener(l), metrics(NULL), port(p), nFrames(0), nErrors(0)
+{
+    reset();
+}   // TelemetryParser(const GLint, TelemetryListener *)
+
+
+
+// <public mutator functions>
+
+//
+// bool setPort(p)
+// Last modified: 17Oct2026
+//
+// Attempts to set the port that the parsed frames are marked with,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      p       in      the port the bytes arrive on
+//
+bool TelemetryParser::setPort(const GLint p)
+{
+    if (p < 0) return false;
+    port = p;
+    return true;
+}   // setPort(const GLint)
+
+
+
+//
+// bool setListener(l)
+// Last modified: 17Oct2026
+//
+// Attempts to set the receiver of the parsed frames (none if NULL),
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      l       in      the receiver of the parsed frames
+//
+bool TelemetryParser::setListener(TelemetryListener *l)
+{
+    listener = l;
+    return true;
+}   // setListener(TelemetryListener *)
+
+
+
+//
+// bool setMetrics(m)
+// Last modified: 17Oct2026
+//
+// Attempts to set the registry that the bytes read and the frames parsed
+// and discarded are counted in (none if NULL),
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      m       in      the registry of the health of the links
+//
+bool TelemetryParser::setMetrics(LinkMetrics *m)
+{
+    metrics = m;
+    return true;
+}   // setMetrics(LinkMetrics *)
+
+
+
+//
+// GLint feed(data, n, timestamp)
+// Last modified: 17Oct2026
+//
+// Parses the parameterized bytes (as read from the port) in place,
+// handing each frame they complete to the listener (if any), marked with
+// the parameterized time, and counting them in the registry (if any).  A frame cut off by the end of the bytes is
+// finished by the next call.
+//
+// Returns:     the number of frames completed
+// Parameters:
+//      data        in      the bytes read from the port
+//      n           in      the number of bytes
+//      timestamp   in      the time the bytes arrived (in microseconds)
+//
+GLint TelemetryParser::feed(const char *data, const GLint n,
+                            const long long timestamp)
+{
+    const unsigned char *bytes   = (const unsigned char *)data;
+    const long           errors  = nErrors;
+    GLint                nParsed = 0;
+    frame.timestamp = timestamp;
+    for (GLint i = 0; i < n; ++i)
+        if (parse(bytes[i])) ++nParsed;
+    if (metrics != NULL)
+        metrics->received(port, n, nParsed, (GLint)(nErrors - errors));
+    return nParsed;
+}   // feed(const char *, const GLint, const long long)
+
+
+
+//
+// void reset()
+// Last modified: 17Oct2026
+//
+// Discards any partial frame.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void TelemetryParser::reset()
+{
+    state         = TELEMETRY_IDLE;
+    frame.address = -1;
+    frame.type    = '\0';
+    frame.nValues = 0;
+    value         = 0;
+    negative      = false;
+    nDigits       = nBytes = length = 0;
+    crc           = frameCrc = 0xFFFF;
+}   // reset()
+
+
+
+// <public accessor functions>
+
+//
+// GLint getPort() const
+// Last modified: 17Oct2026
+//
+// Returns the port that the parsed frames are marked with.
+//
+// Returns:     the port the bytes arrive on
+// Parameters:  <none>
+//
+GLint TelemetryParser::getPort() const
+{
+    return port;
+}   // getPort() const
+
+
+
+//
+// long getNFrames() const
+// Last modified: 17Oct2026
+//
+// Returns the number of frames parsed so far.
+//
+// Returns:     the number of frames parsed so far
+// Parameters:  <none>
+//
+long TelemetryParser::getNFrames() const
+{
+    return nFrames;
+}   // getNFrames() const
+
+
+
+//
+// long getNErrors() const
+// Last modified: 17Oct2026
+//
+// Returns the number of malformed lines and frames discarded so far.
+//
+// Returns:     the number of errors so far
+// Parameters:  <none>
+//
+long TelemetryParser::getNErrors() const
+{
+    return nErrors;
+}   // getNErrors() const
+
+
+
+// <public static functions>
+
+//
+// unsigned short crc16(data, n, crc)
+// Last modified: 17Oct2026
+//
+// Returns the CRC-16/CCITT of the parameterized bytes (that of a binary
+// frame covers its address, type, length, and payload).
+//
+// Returns:     the CRC of the bytes
+// Parameters:
+//      data    in      the bytes
+//      n       in      the number of bytes
+//      crc     in      the CRC so far (default none)
+//
+unsigned short TelemetryParser::crc16(const unsigned char *data,
+                                      const GLint          n,
+                                      unsigned short       crc)
+{
+    for (GLint i = 0; i < n; ++i) crc = crcByte(crc, data[i]);
+    return crc;
+}   // crc16(const unsigned char *, const GLint, unsigned short)
+
+
+
+// <protected utility functions>
+
+//
+// bool parse(c)
+// Last modified: 17Oct2026
+//
+// Advances the parser by the parameterized byte.  A line is a letter
+// followed by up to MAX_TELEMETRY_VALUES comma-separated integers and
+// ended by a carriage return (or line feed).  A binary frame is
+// TELEMETRY_SOF, the address of the robot, the type, the length of the
+// payload, the payload (32-bit little-endian integers), and the CRC
+// (low byte first).
+//
+// Returns:     true if the byte completed a frame, false otherwise
+// Parameters:
+//      c       in      the next byte
+//
+bool TelemetryParser::parse(const unsigned char c)
+{
+    switch (state)
+    {
+        case TELEMETRY_SKIP:
+            if ((c == '\r') || (c == '\n')) state = TELEMETRY_IDLE;
+            else if (c == TELEMETRY_SOF)
+            {
+                crc   = 0xFFFF;
+                state = TELEMETRY_ADDRESS;
+            }
+            return false;
+
+        case TELEMETRY_IDLE:
+            if (c == TELEMETRY_SOF)
+            {
+                crc   = 0xFFFF;
+                state = TELEMETRY_ADDRESS;
+            }
+            else if (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')))
+            {
+                frame.address = -1;
+                frame.type    = (char)c;
+                frame.nValues = 0;
+                state         = TELEMETRY_TYPE;
+            }
+            else if ((c != '\r') && (c != '\n')) return fail(c);
+            return false;
+
+        case TELEMETRY_TYPE:
+            if (c == ',') state = TELEMETRY_VALUE_START;
+            else if ((c == '\r') || (c == '\n')) break;
+            else return fail(c);
+            return false;
+
+        case TELEMETRY_VALUE_START:
+            value    = 0;
+            nDigits  = 0;
+            negative = (c == '-');
+            state    = TELEMETRY_VALUE;
+            if (negative) return false;
+            // fall through
+
+        case TELEMETRY_VALUE:
+            if ((c >= '0') && (c <= '9') && (nDigits < MAX_TELEMETRY_DIGITS))
+            {
+                value = value * 10 + (c - '0');
+                ++nDigits;
+                return false;
+            }
+            if ((c == ',') && (endValue()))
+            {
+                state = TELEMETRY_VALUE_START;
+                return false;
+            }
+            if (((c == '\r') || (c == '\n')) && (endValue())) break;
+            return fail(c);
+
+        case TELEMETRY_ADDRESS:
+            crc           = crcByte(crc, c);
+            frame.address = c;
+            state         = TELEMETRY_FRAME_TYPE;
+            return false;
+
+        case TELEMETRY_FRAME_TYPE:
+            crc        = crcByte(crc, c);
+            frame.type = (char)c;
+            state      = TELEMETRY_LENGTH;
+            return false;
+
+        case TELEMETRY_LENGTH:
+            crc = crcByte(crc, c);
+            if ((c % 4 != 0) || (c > 4 * MAX_TELEMETRY_VALUES)) return fail(c);
+            length        = c;
+            nBytes        = 0;
+            value         = 0;
+            frame.nValues = length / 4;
+            state         = (length > 0) ? TELEMETRY_PAYLOAD : TELEMETRY_CRC_LOW;
+            return false;
+
+        case TELEMETRY_PAYLOAD:
+            crc    = crcByte(crc, c);
+            value |= (long long)c << (8 * (nBytes % 4));
+            if (nBytes % 4 == 3)
+            {
+                frame.values[nBytes / 4] = (GLint)(unsigned int)value;
+                value                    = 0;
+            }
+            if (++nBytes == length) state = TELEMETRY_CRC_LOW;
+            return false;
+
+        case TELEMETRY_CRC_LOW:
+            frameCrc = c;
+            state    = TELEMETRY_CRC_HIGH;
+            return false;
+
+        case TELEMETRY_CRC_HIGH:
+            frameCrc = (unsigned short)(frameCrc | (c << 8));
+            if (frameCrc != crc) return fail(c);
+            break;
+
+        default:
+            return fail(c);
+    }
+
+    // the frame is complete
+    frame.port = port;
+    state      = TELEMETRY_IDLE;
+    ++nFrames;
+    if (listener != NULL) listener->frameParsed(frame);
+    return true;
+}   // parse(const unsigned char)
+
+
+
+//
+// bool endValue()
+// Last modified: 17Oct2026
+//
+// Attempts to add the value just parsed to the frame,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:  <none>
+//
+bool TelemetryParser::endValue()
+{
+    if ((nDigits == 0) || (frame.nValues >= MAX_TELEMETRY_VALUES) ||
+        (value > 2147483647LL + (negative ? 1 : 0))) return false;
+    frame.values[frame.nValues++] = (GLint)(negative ? -value : value);
+    return true;
+}   // endValue()
+
+
+
+//
+// bool fail(c)
+// Last modified: 17Oct2026
+//
+// Discards the partial frame that the parameterized byte does not fit,
+// along with the rest of its line (if text, unless the byte starts
+// a binary frame).
+//
+// Returns:     false (no frame was completed)
+// Parameters:
+//      c       in      the byte that does not fit
+//
+bool TelemetryParser::fail(const unsigned char c)
+{
+    ++nErrors;
+    if (state > TELEMETRY_VALUE) state = TELEMETRY_IDLE;
+    else if (c == TELEMETRY_SOF)
+    {
+        crc   = 0xFFFF;
+        state = TELEMETRY_ADDRESS;
+    }
+    else if ((c == '\r') || (c == '\n')) state = TELEMETRY_IDLE;
+    else                                 state = TELEMETRY_SKIP;
+    return false;
+}   // fail(const unsigned char)
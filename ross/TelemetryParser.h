@@ -0,0 +1,107 @@
+//
+// Filename:        "TelemetryParser.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes an incremental parser of the replies
+//                  that arrive from the robots on a port, either as text
+//                  ("q,<left>,<right>\r") or as binary frames checked with
+//                  a CRC, which keeps the state of a partial frame between
+//                  reads so the bytes are parsed where they were read to.
+//
+
+// preprocessor directives
+#ifndef TELEMETRY_PARSER_H
+#define TELEMETRY_PARSER_H
+#include <cstddef>
+#include "GLTypes.h"
+#include "LinkMetrics.h"
+using namespace std;
+
+// global constants
+static const GLint         MAX_TELEMETRY_VALUES = 4;     // values per frame
+static const unsigned char TELEMETRY_SOF        = 0xA5;  // binary frame start
+static const char          TELEMETRY_ACK        = 'd';   // drive acknowledged
+static const char          TELEMETRY_SPEED      = 'e';   // wheel speeds
+static const char          TELEMETRY_POSITION   = 'q';   // wheel positions
+
+//
+// TelemetryFrame
+//
+// Describes a reply from a robot.
+//
+struct TelemetryFrame
+{
+    long long timestamp;                    // arrival (in microseconds)
+    GLint     port;                         // the port it arrived on
+    GLint     address;                      // the robot (-1 if the port's)
+    char      type;                         // the kind of reply
+    GLint     nValues;                      // the number of values
+    GLint     values[MAX_TELEMETRY_VALUES]; // the values
+};  // TelemetryFrame
+
+//
+// TelemetryListener
+//
+// Describes a receiver of the frames parsed from a port.
+//
+class TelemetryListener
+{
+    public:
+
+        // <destructors>
+        virtual ~TelemetryListener() { }
+
+        // <virtual public utility functions>
+        virtual void frameParsed(const TelemetryFrame &f) = 0;
+};  // TelemetryListener
+
+class TelemetryParser
+{
+
+    public:
+
+        // <constructors>
+        TelemetryParser(const GLint p = 0, TelemetryListener *l = NULL);
+
+        // <public mutator functions>
+        bool  setPort(const GLint p);
+        bool  setListener(TelemetryListener *l = NULL);
+        bool  setMetrics(LinkMetrics *m = NULL);
+        GLint feed(const char *data, const GLint n, const long long timestamp);
+        void  reset();
+
+        // <public accessor functions>
+        GLint getPort()     const;
+        long  getNFrames()  const;
+        long  getNErrors()  const;
+
+        // <public static functions>
+        static unsigned short crc16(const unsigned char *data,
+                                    const GLint          n,
+                                    unsigned short       crc = 0xFFFF);
+
+    protected:
+
+        // <protected data members>
+        TelemetryListener *listener;
+        LinkMetrics       *metrics;     // the health of the port (if any)
+        GLint              port;
+        GLint              state;       // where in a frame the parser is
+        TelemetryFrame     frame;       // the frame being parsed
+        long long          value;       // the value being parsed
+        bool               negative;    // true if the value is negative
+        GLint              nDigits;     // the digits of the value so far
+        GLint              nBytes;      // the bytes of the payload so far
+        GLint              length;      // the bytes of the payload
+        unsigned short     crc;         // the CRC of the frame so far
+        unsigned short     frameCrc;    // the CRC the frame carries
+        long               nFrames, nErrors;
+
+        // <protected utility functions>
+        bool  parse(const unsigned char c);
+        bool  endValue();
+        bool  fail(const unsigned char c);
+};  // TelemetryParser
+#endif
@@ -0,0 +1,174 @@
+//
+// Filename:        "TrajectoryWriter.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements a writer that streams the poses
+//                  of a swarm at each tick to a CSV or binary file.
+//
+
+// preprocessor directives
+#include "TrajectoryWriter.h"
+
+
+
+// <constructors>
+
+//
+// TrajectoryWriter()
+// Last modified: 17Oct2026
+//
+// Default constructor that initializes this writer to no file.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+TrajectoryWriter::TrajectoryWriter(): file(NULL), format(CSV_TRAJECTORY)
+{
+}   // TrajectoryWriter()
+
+
+
+// <destructors>
+
+//
+// ~TrajectoryWriter()
+// Last modified: 17Oct2026
+//
+// Destructor that closes the file of this writer.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+TrajectoryWriter::~TrajectoryWriter()
+{
+    close();
+}   // ~TrajectoryWriter()
+
+
+
+// <public mutator functions>
+
+//
+// bool open(filename, fmt)
+// Last modified: 17Oct2026
+//
+// Attempts to open (and truncate) the parameterized file, writing the
+// header of the parameterized format, returning true if successful,
+// false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      filename    in      the name of the file to be written
+//      fmt         in      the format of the file (default CSV)
+//
+bool TrajectoryWriter::open(const char             *filename,
+                            const TrajectoryFormat  fmt)
+{
+    close();
+    if ((filename == NULL) ||
+        ((file = fopen(filename, (fmt == CSV_TRAJECTORY) ? "w" : "wb"))
+         == NULL)) return false;
+    format = fmt;
+    buffer.resize(TRAJECTORY_BUFFER_SIZE);
+    setvbuf(file, &buffer[0], _IOFBF, buffer.size());
+    bool success = true;
+    if (format == CSV_TRAJECTORY)
+        success = fputs("tick,index,x,y,heading\n", file) >= 0;
+    else
+        success = (fwrite(TRAJECTORY_MAGIC, 1, 4, file) == 4) &&
+                  (fwrite(&TRAJECTORY_VERSION, 4, 1, file) == 1);
+    if (!success) close();
+    return success;
+}   // open(const char *, const TrajectoryFormat)
+
+
+
+//
+// bool close()
+// Last modified: 17Oct2026
+//
+// Attempts to flush and close the file of this writer,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:  <none>
+//
+bool TrajectoryWriter::close()
+{
+    if (file == NULL) return false;
+    bool success = fclose(file) == 0;
+    file = NULL;
+    return success;
+}   // close()
+
+
+
+// <public accessor functions>
+
+//
+// bool isOpen() const
+// Last modified: 17Oct2026
+//
+// Returns true if this writer has a file open, false otherwise.
+//
+// Returns:     true if this writer has a file open, false otherwise
+// Parameters:  <none>
+//
+bool TrajectoryWriter::isOpen() const
+{
+    return file != NULL;
+}   // isOpen() const
+
+
+
+//
+// TrajectoryFormat getFormat() const
+// Last modified: 17Oct2026
+//
+// Returns the format of the file of this writer.
+//
+// Returns:     the format of the file of this writer
+// Parameters:  <none>
+//
+TrajectoryFormat TrajectoryWriter::getFormat() const
+{
+    return format;
+}   // getFormat() const
+
+
+
+// <public utility functions>
+
+//
+// bool write(tick, poses)
+// Last modified: 17Oct2026
+//
+// Attempts to write the parameterized poses as the given tick,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      tick    in      the tick of the poses
+//      poses   in      the poses being written
+//
+bool TrajectoryWriter::write(const GLint tick, const PoseStore &poses)
+{
+    if (file == NULL) return false;
+    const GLint n = poses.getSize();
+    if (format == CSV_TRAJECTORY)
+    {
+        for (GLint i = 0; i < n; ++i)
+            if (fprintf(file, "%d,%d,%.9g,%.9g,%.9g\n", tick, i,
+                        poses.x[i], poses.y[i], poses.heading[i]) < 0)
+                return false;
+        return true;
+    }
+    if ((fwrite(&tick, 4, 1, file) != 1) ||
+        (fwrite(&n,    4, 1, file) != 1)) return false;
+    return (n == 0) ||
+           ((fwrite(&poses.x[0],       4, n, file) == (size_t)n) &&
+            (fwrite(&poses.y[0],       4, n, file) == (size_t)n) &&
+            (fwrite(&poses.heading[0], 4, n, file) == (size_t)n));
+}   // write(const GLint, const PoseStore &)
@@ -0,0 +1,70 @@
+//
+// Filename:        "TrajectoryWriter.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes a writer that streams the poses
+//                  of a swarm at each tick to a CSV or binary file.
+//
+//                  CSV files hold a "tick,index,x,y,heading" header line
+//                  followed by one line per cell per tick.  Binary files
+//                  hold the 4-byte magic "RTRJ" and a 32-bit version,
+//                  followed by one record per tick: the 32-bit tick and
+//                  number of cells n, then n x-coordinates, n
+//                  y-coordinates, and n headings (in degrees) as 32-bit
+//                  floats, all in the byte order of the writing machine.
+//
+
+// preprocessor directives
+#ifndef TRAJECTORY_WRITER_H
+#define TRAJECTORY_WRITER_H
+#include <cstdio>
+#include "PoseStore.h"
+using namespace std;
+
+// global constants
+static const char  TRAJECTORY_MAGIC[4]    = {'R', 'T', 'R', 'J'};
+static const GLint TRAJECTORY_VERSION     = 1;
+static const GLint TRAJECTORY_BUFFER_SIZE = 1 << 20;
+
+// Describes the format of a trajectory file.
+enum TrajectoryFormat {CSV_TRAJECTORY, BINARY_TRAJECTORY};
+
+class TrajectoryWriter
+{
+
+    public:
+
+        // <constructors>
+        TrajectoryWriter();
+
+        // <destructors>
+        virtual ~TrajectoryWriter();
+
+        // <public mutator functions>
+        bool open(const char             *filename,
+                  const TrajectoryFormat  fmt = CSV_TRAJECTORY);
+        bool close();
+
+        // <public accessor functions>
+        bool             isOpen()    const;
+        TrajectoryFormat getFormat() const;
+
+        // <public utility functions>
+        bool write(const GLint tick, const PoseStore &poses);
+
+    protected:
+
+        // <protected data members>
+        FILE             *file;
+        TrajectoryFormat  format;
+        vector<char>      buffer;
+
+    private:
+
+        // <private constructors>
+        TrajectoryWriter(const TrajectoryWriter &);
+        TrajectoryWriter& operator =(const TrajectoryWriter &);
+};  // TrajectoryWriter
+#endif
@@ -11,7 +11,7 @@
 #ifndef UTILS_H
 #define UTILS_H
 #include <iostream>
-#include "../GL/glut.h"
+#include "GLTypes.h"
 using namespace std;
 
 // debug definitions
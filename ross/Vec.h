@@ -0,0 +1,467 @@
+//
+// Filename:        "Vec.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This file defines plain 2- and 3-dimensional math vectors
+//                  (no color, transformation, or display state) along with
+//                  functions that work on whole arrays of vectors.
+//
+
+// preprocessor directives
+#ifndef VEC_H
+#define VEC_H
+#include <cmath>
+#include "Utils.h"
+using namespace std;
+
+
+
+//
+// Vec2f
+//
+// Describes a plain 2-dimensional math vector.
+//
+struct Vec2f
+{
+
+    // <data members>
+    GLfloat x, y;
+
+
+
+    // <constructors>
+
+    //
+    // Vec2f(dx, dy)
+    // Last modified: 17Oct2026
+    //
+    // Default constructor that initializes
+    // this vector to the parameterized values.
+    //
+    // Returns:     <none>
+    // Parameters:
+    //      dx      in      the initial x-coordinate (default 0)
+    //      dy      in      the initial y-coordinate (default 0)
+    //
+    constexpr Vec2f(const GLfloat dx = 0.0f, const GLfloat dy = 0.0f)
+        : x(dx), y(dy)
+    {
+    }   // Vec2f(const GLfloat, const GLfloat)
+
+
+
+    // <mutator functions>
+
+    //
+    // void rotateRelative(theta)
+    // Last modified: 17Oct2026
+    //
+    // Rotates this vector by the parameterized angle.
+    //
+    // Returns:     <none>
+    // Parameters:
+    //      theta   in      the rotation angle (in degrees)
+    //
+    void rotateRelative(const GLfloat theta)
+    {
+        *this = rotated(theta);
+    }   // rotateRelative(const GLfloat)
+
+
+
+    // <utility functions>
+
+    //
+    // GLfloat dot(v) const
+    // Last modified: 17Oct2026
+    //
+    // Returns the dot product of this vector and the parameterized vector.
+    //
+    // Returns:     the dot product of the vectors
+    // Parameters:
+    //      v       in      the other vector
+    //
+    constexpr GLfloat dot(const Vec2f &v) const
+    {
+        return x * v.x + y * v.y;
+    }   // dot(const Vec2f &) const
+
+
+
+    //
+    // GLfloat norm() const
+    // Last modified: 17Oct2026
+    //
+    // Returns the magnitude of this vector.
+    //
+    // Returns:     the magnitude of this vector
+    // Parameters:  <none>
+    //
+    GLfloat norm() const
+    {
+        return sqrt(x * x + y * y);
+    }   // norm() const
+
+
+
+    //
+    // GLfloat angle() const
+    // Last modified: 17Oct2026
+    //
+    // Returns the angle (in degrees) of this vector.
+    //
+    // Returns:     the angle of this vector
+    // Parameters:  <none>
+    //
+    GLfloat angle() const
+    {
+        if ((x == 0.0f) && (y == 0.0f)) return 0.0f;
+        return sign(y) * radiansToDegrees(acos(x / norm()));
+    }   // angle() const
+
+
+
+    //
+    // Vec2f perp() const
+    // Last modified: 17Oct2026
+    //
+    // Returns this vector turned 90 degrees counterclockwise.
+    //
+    // Returns:     the perpendicular vector of this vector
+    // Parameters:  <none>
+    //
+    constexpr Vec2f perp() const
+    {
+        return Vec2f(-y, x);
+    }   // perp() const
+
+
+
+    //
+    // Vec2f unit() const
+    // Last modified: 17Oct2026
+    //
+    // Returns the unit vector of this vector
+    // (the zero vector stays as it is).
+    //
+    // Returns:     the unit vector of this vector
+    // Parameters:  <none>
+    //
+    Vec2f unit() const
+    {
+        GLfloat magnitude = norm();
+        return (magnitude == 0.0f)
+            ? *this : Vec2f(x / magnitude, y / magnitude);
+    }   // unit() const
+
+
+
+    //
+    // Vec2f rotated(theta) const
+    // Last modified: 17Oct2026
+    //
+    // Returns this vector rotated by the parameterized angle.
+    //
+    // Returns:     the rotated vector
+    // Parameters:
+    //      theta   in      the rotation angle (in degrees)
+    //
+    Vec2f rotated(GLfloat theta) const
+    {
+        theta = degreesToRadians(theta);
+        const GLfloat c = cos(theta), s = sin(theta);
+        return Vec2f(x * c - y * s, x * s + y * c);
+    }   // rotated(GLfloat) const
+};  // Vec2f
+
+
+
+//
+// Vec3f
+//
+// Describes a plain 3-dimensional math vector.
+//
+struct Vec3f
+{
+
+    // <data members>
+    GLfloat x, y, z;
+
+
+
+    // <constructors>
+
+    //
+    // Vec3f(dx, dy, dz)
+    // Last modified: 17Oct2026
+    //
+    // Default constructor that initializes
+    // this vector to the parameterized values.
+    //
+    // Returns:     <none>
+    // Parameters:
+    //      dx      in      the initial x-coordinate (default 0)
+    //      dy      in      the initial y-coordinate (default 0)
+    //      dz      in      the initial z-coordinate (default 0)
+    //
+    constexpr Vec3f(const GLfloat dx = 0.0f,
+                    const GLfloat dy = 0.0f,
+                    const GLfloat dz = 0.0f): x(dx), y(dy), z(dz)
+    {
+    }   // Vec3f(const GLfloat, const GLfloat, const GLfloat)
+
+
+
+    // <utility functions>
+
+    //
+    // GLfloat dot(v) const
+    // Last modified: 17Oct2026
+    //
+    // Returns the dot product of this vector and the parameterized vector.
+    //
+    // Returns:     the dot product of the vectors
+    // Parameters:
+    //      v       in      the other vector
+    //
+    constexpr GLfloat dot(const Vec3f &v) const
+    {
+        return x * v.x + y * v.y + z * v.z;
+    }   // dot(const Vec3f &) const
+
+
+
+    //
+    // Vec3f cross(v) const
+    // Last modified: 17Oct2026
+    //
+    // Returns the cross product of this vector and the parameterized vector.
+    //
+    // Returns:     the cross product of the vectors
+    // Parameters:
+    //      v       in      the other vector
+    //
+    constexpr Vec3f cross(const Vec3f &v) const
+    {
+        return Vec3f(y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x);
+    }   // cross(const Vec3f &) const
+
+
+
+    //
+    // GLfloat norm() const
+    // Last modified: 17Oct2026
+    //
+    // Returns the magnitude of this vector.
+    //
+    // Returns:     the magnitude of this vector
+    // Parameters:  <none>
+    //
+    GLfloat norm() const
+    {
+        return sqrt(dot(*this));
+    }   // norm() const
+};  // Vec3f
+
+
+
+// <Vec2f operators>
+
+inline constexpr Vec2f operator +(const Vec2f &a, const Vec2f &b)
+{
+    return Vec2f(a.x + b.x, a.y + b.y);
+}   // +(const Vec2f &, const Vec2f &)
+
+inline constexpr Vec2f operator -(const Vec2f &a, const Vec2f &b)
+{
+    return Vec2f(a.x - b.x, a.y - b.y);
+}   // -(const Vec2f &, const Vec2f &)
+
+inline constexpr Vec2f operator -(const Vec2f &v)
+{
+    return Vec2f(-v.x, -v.y);
+}   // -(const Vec2f &)
+
+inline constexpr Vec2f operator *(const GLfloat s, const Vec2f &v)
+{
+    return Vec2f(s * v.x, s * v.y);
+}   // *(const GLfloat, const Vec2f &)
+
+inline constexpr Vec2f operator *(const Vec2f &v, const GLfloat s)
+{
+    return s * v;
+}   // *(const Vec2f &, const GLfloat)
+
+inline Vec2f& operator +=(Vec2f &a, const Vec2f &b)
+{
+    a.x += b.x;
+    a.y += b.y;
+    return a;
+}   // +=(Vec2f &, const Vec2f &)
+
+inline Vec2f& operator -=(Vec2f &a, const Vec2f &b)
+{
+    a.x -= b.x;
+    a.y -= b.y;
+    return a;
+}   // -=(Vec2f &, const Vec2f &)
+
+inline Vec2f& operator *=(Vec2f &v, const GLfloat s)
+{
+    v.x *= s;
+    v.y *= s;
+    return v;
+}   // *=(Vec2f &, const GLfloat)
+
+inline constexpr bool operator ==(const Vec2f &a, const Vec2f &b)
+{
+    return (a.x == b.x) && (a.y == b.y);
+}   // ==(const Vec2f &, const Vec2f &)
+
+inline constexpr bool operator !=(const Vec2f &a, const Vec2f &b)
+{
+    return !(a == b);
+}   // !=(const Vec2f &, const Vec2f &)
+
+
+
+// <Vec3f operators>
+
+inline constexpr Vec3f operator +(const Vec3f &a, const Vec3f &b)
+{
+    return Vec3f(a.x + b.x, a.y + b.y, a.z + b.z);
+}   // +(const Vec3f &, const Vec3f &)
+
+inline constexpr Vec3f operator -(const Vec3f &a, const Vec3f &b)
+{
+    return Vec3f(a.x - b.x, a.y - b.y, a.z - b.z);
+}   // -(const Vec3f &, const Vec3f &)
+
+inline constexpr Vec3f operator -(const Vec3f &v)
+{
+    return Vec3f(-v.x, -v.y, -v.z);
+}   // -(const Vec3f &)
+
+inline constexpr Vec3f operator *(const GLfloat s, const Vec3f &v)
+{
+    return Vec3f(s * v.x, s * v.y, s * v.z);
+}   // *(const GLfloat, const Vec3f &)
+
+inline constexpr Vec3f operator *(const Vec3f &v, const GLfloat s)
+{
+    return s * v;
+}   // *(const Vec3f &, const GLfloat)
+
+inline constexpr bool operator ==(const Vec3f &a, const Vec3f &b)
+{
+    return (a.x == b.x) && (a.y == b.y) && (a.z == b.z);
+}   // ==(const Vec3f &, const Vec3f &)
+
+inline constexpr bool operator !=(const Vec3f &a, const Vec3f &b)
+{
+    return !(a == b);
+}   // !=(const Vec3f &, const Vec3f &)
+
+
+
+// <Vec2f batch functions>
+
+//
+// void dotAll(a, b, out, n)
+// Last modified: 17Oct2026
+//
+// Stores the dot product of each pair of the parameterized vectors.
+//
+// Returns:     <none>
+// Parameters:
+//      a       in      the first vectors
+//      b       in      the second vectors
+//      out     out     the dot products
+//      n       in      the number of vectors
+//
+inline void dotAll(const Vec2f a[],
+                   const Vec2f b[],
+                   GLfloat     out[],
+                   const GLint n)
+{
+    for (GLint i = 0; i < n; ++i) out[i] = a[i].x * b[i].x + a[i].y * b[i].y;
+}   // dotAll(const Vec2f [], const Vec2f [], GLfloat [], const GLint)
+
+
+
+//
+// void perpAll(v, out, n)
+// Last modified: 17Oct2026
+//
+// Stores each of the parameterized vectors turned 90 degrees
+// counterclockwise (the vectors may be stored in place).
+//
+// Returns:     <none>
+// Parameters:
+//      v       in      the vectors
+//      out     out     the perpendicular vectors
+//      n       in      the number of vectors
+//
+inline void perpAll(const Vec2f v[], Vec2f out[], const GLint n)
+{
+    for (GLint i = 0; i < n; ++i)
+    {
+        const GLfloat x = v[i].x;
+        out[i].x        = -v[i].y;
+        out[i].y        = x;
+    }
+}   // perpAll(const Vec2f [], Vec2f [], const GLint)
+
+
+
+//
+// void normAll(v, out, n)
+// Last modified: 17Oct2026
+//
+// Stores the magnitude of each of the parameterized vectors.
+//
+// Returns:     <none>
+// Parameters:
+//      v       in      the vectors
+//      out     out     the magnitudes
+//      n       in      the number of vectors
+//
+inline void normAll(const Vec2f v[], GLfloat out[], const GLint n)
+{
+    for (GLint i = 0; i < n; ++i)
+        out[i] = sqrt(v[i].x * v[i].x + v[i].y * v[i].y);
+}   // normAll(const Vec2f [], GLfloat [], const GLint)
+
+
+
+//
+// void rotateAll(v, out, n, theta)
+// Last modified: 17Oct2026
+//
+// Stores each of the parameterized vectors rotated by the
+// parameterized angle (the vectors may be stored in place).
+//
+// Returns:     <none>
+// Parameters:
+//      v       in      the vectors
+//      out     out     the rotated vectors
+//      n       in      the number of vectors
+//      theta   in      the rotation angle (in degrees)
+//
+inline void rotateAll(const Vec2f v[],
+                      Vec2f       out[],
+                      const GLint n,
+                      GLfloat     theta)
+{
+    theta = degreesToRadians(theta);
+    const GLfloat c = cos(theta), s = sin(theta);
+    for (GLint i = 0; i < n; ++i)
+    {
+        const GLfloat x = v[i].x, y = v[i].y;
+        out[i].x        = x * c - y * s;
+        out[i].y        = x * s + y * c;
+    }
+}   // rotateAll(const Vec2f [], Vec2f [], const GLint, GLfloat)
+#endif
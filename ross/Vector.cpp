@@ -426,7 +426,7 @@ bool Vector::normalize()
 
 //
 // void draw()
-// Last modified: 04Sep2006
+// Last modified: 17Oct2026
 //
 // Renders the vector as a line segment with a triangle head.
 //
@@ -435,6 +435,7 @@ bool Vector::normalize()
 //
 void Vector::draw()
 {
+#ifndef ROSS_HEADLESS
     if ((color[GLUT_RED]   == COLOR[INVISIBLE][GLUT_RED])   &&
         (color[GLUT_GREEN] == COLOR[INVISIBLE][GLUT_GREEN]) &&
         (color[GLUT_BLUE]  == COLOR[INVISIBLE][GLUT_BLUE])) return;
@@ -474,6 +475,7 @@ void Vector::draw()
 	        glEnd();
         }
     glPopMatrix();
+#endif
 }   // draw()
 
 
@@ -0,0 +1,238 @@
+//
+// Filename:        "WorkerPool.cpp"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class implements a pool of worker threads
+//                  that split a range of items between them.
+//
+
+// preprocessor directives
+#include "WorkerPool.h"
+
+
+
+// <constructors>
+
+//
+// WorkerPool(n)
+// Last modified: 17Oct2026
+//
+// Default constructor that starts a pool of the parameterized number of
+// threads (counting the calling thread), one per core if n is 0.
+//
+// Returns:     <none>
+// Parameters:
+//      n       in      the number of threads (default one per core)
+//
+WorkerPool::WorkerPool(const int n)
+    : job(NULL), jobSize(0), jobChunks(0), nPending(0),
+      generation(0), quit(false)
+{
+    startWorkers(n);
+}   // WorkerPool(const int)
+
+
+
+// <destructors>
+
+//
+// ~WorkerPool()
+// Last modified: 17Oct2026
+//
+// Destructor that stops every worker thread of this pool.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+WorkerPool::~WorkerPool()
+{
+    stopWorkers();
+}   // ~WorkerPool()
+
+
+
+// <public mutator functions>
+
+//
+// bool setNThreads(n)
+// Last modified: 17Oct2026
+//
+// Restarts this pool with the parameterized number of threads
+// (counting the calling thread), one per core if n is 0,
+// returning true if successful, false otherwise.
+//
+// Returns:     true if successful, false otherwise
+// Parameters:
+//      n       in      the number of threads (default one per core)
+//
+bool WorkerPool::setNThreads(const int n)
+{
+    if (n < 0) return false;
+    stopWorkers();
+    startWorkers(n);
+    return true;
+}   // setNThreads(const int)
+
+
+
+// <public accessor functions>
+
+//
+// int getNThreads() const
+// Last modified: 17Oct2026
+//
+// Returns the number of threads (counting the calling thread) of this pool.
+//
+// Returns:     the number of threads of this pool
+// Parameters:  <none>
+//
+int WorkerPool::getNThreads() const
+{
+    return (int)workers.size() + 1;
+}   // getNThreads() const
+
+
+
+// <public utility functions>
+
+//
+// void parallelFor(n, f, grain)
+// Last modified: 17Oct2026
+//
+// Calls the parameterized function on the items [0, n), split into one
+// contiguous chunk per thread, and returns once every chunk is done.
+// Ranges of fewer than two grains are run on the calling thread alone.
+//
+// Returns:     <none>
+// Parameters:
+//      n       in      the number of items
+//      f       in      the function handling a chunk [begin, end)
+//      grain   in      the fewest items worth giving a thread
+//
+void WorkerPool::parallelFor(const int            n,
+                             const RangeFunction &f,
+                             const int            grain)
+{
+    int nChunks = n / ((grain > 1) ? grain : 1);
+    if (nChunks > getNThreads()) nChunks = getNThreads();
+    if (nChunks <= 1)
+    {
+        if (n > 0) f(0, n);
+        return;
+    }
+
+    // hand out the chunks beyond the first to the workers
+    unique_lock<mutex> lock(jobMutex);
+    job       = &f;
+    jobSize   = n;
+    jobChunks = nChunks;
+    nPending  = (int)workers.size();
+    ++generation;
+    lock.unlock();
+    jobStarted.notify_all();
+
+    // the calling thread takes the first chunk itself
+    runChunk(0);
+
+    lock.lock();
+    while (nPending > 0) jobDone.wait(lock);
+    job = NULL;
+}   // parallelFor(const int, const RangeFunction &, const int)
+
+
+
+// <protected utility functions>
+
+//
+// void startWorkers(n)
+// Last modified: 17Oct2026
+//
+// Starts the parameterized number of threads (counting
+// the calling thread), one per core if n is 0.
+//
+// Returns:     <none>
+// Parameters:
+//      n       in      the number of threads (default one per core)
+//
+void WorkerPool::startWorkers(const int n)
+{
+    int nThreads = (n > 0) ? n : (int)thread::hardware_concurrency();
+    quit         = false;
+    for (int i = 1; i < nThreads; ++i)
+        workers.push_back(thread(&WorkerPool::work, this, i, generation));
+}   // startWorkers(const int)
+
+
+
+//
+// void stopWorkers()
+// Last modified: 17Oct2026
+//
+// Stops and joins every worker thread.
+//
+// Returns:     <none>
+// Parameters:  <none>
+//
+void WorkerPool::stopWorkers()
+{
+    {
+        lock_guard<mutex> lock(jobMutex);
+        quit = true;
+    }
+    jobStarted.notify_all();
+    for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+    workers.clear();
+}   // stopWorkers()
+
+
+
+//
+// void work(index, seen)
+// Last modified: 17Oct2026
+//
+// Waits for jobs newer than the parameterized generation and runs
+// the chunk with the parameterized index of each of them,
+// until this pool is stopped.
+//
+// Returns:     <none>
+// Parameters:
+//      index   in      the index of this worker thread (from 1)
+//      seen    in      the generation of the last job already handled
+//
+void WorkerPool::work(const int index, unsigned long seen)
+{
+    unique_lock<mutex> lock(jobMutex);
+    for (;;)
+    {
+        while ((!quit) && (generation == seen)) jobStarted.wait(lock);
+        if (quit) return;
+        seen = generation;
+        lock.unlock();
+        runChunk(index);
+        lock.lock();
+        if (--nPending == 0) jobDone.notify_one();
+    }
+}   // work(const int, unsigned long)
+
+
+
+//
+// void runChunk(index) const
+// Last modified: 17Oct2026
+//
+// Runs the current job on the chunk with the parameterized index
+// (an empty chunk if the job has fewer chunks than threads).
+//
+// Returns:     <none>
+// Parameters:
+//      index   in      the index of the chunk
+//
+void WorkerPool::runChunk(const int index) const
+{
+    if (index >= jobChunks) return;
+    int begin = (int)((long long)jobSize *  index      / jobChunks);
+    int end   = (int)((long long)jobSize * (index + 1) / jobChunks);
+    if (begin < end) (*job)(begin, end);
+}   // runChunk(const int) const
@@ -0,0 +1,72 @@
+//
+// Filename:        "WorkerPool.h"
+//
+// Programmer:      Ross Mead
+// Last modified:   17Oct2026
+//
+// Description:     This class describes a pool of worker threads
+//                  that split a range of items between them.
+//
+
+// preprocessor directives
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// global constants
+static const int DEFAULT_WORKER_GRAIN = 64;
+
+// Refer to a function that handles the items [begin, end) of a range.
+typedef function<void(const int begin, const int end)> RangeFunction;
+
+class WorkerPool
+{
+
+    public:
+
+        // <constructors>
+        WorkerPool(const int n = 0);
+
+        // <destructors>
+        ~WorkerPool();
+
+        // <public mutator functions>
+        bool setNThreads(const int n = 0);
+
+        // <public accessor functions>
+        int  getNThreads() const;
+
+        // <public utility functions>
+        void parallelFor(const int            n,
+                         const RangeFunction &f,
+                         const int            grain = DEFAULT_WORKER_GRAIN);
+
+    protected:
+
+        // <protected data members>
+        vector<thread>      workers;
+        mutex               jobMutex;
+        condition_variable  jobStarted, jobDone;
+        const RangeFunction *job;
+        int                 jobSize, jobChunks, nPending;
+        unsigned long       generation;
+        bool                quit;
+
+        // <protected utility functions>
+        void startWorkers(const int n);
+        void stopWorkers();
+        void work(const int index, unsigned long seen);
+        void runChunk(const int index) const;
+
+    private:
+
+        // <private constructors>
+        WorkerPool(const WorkerPool &);
+        WorkerPool& operator =(const WorkerPool &);
+};  // WorkerPool
+#endif